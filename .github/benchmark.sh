@@ -0,0 +1,67 @@
+#!/bin/bash
+
+# Cycle-accurate loop() benchmark of the Proton Pack and Neutrona Wand using simavr.
+# Builds benchmark images with the Arduino-CLI (as for compile.sh) for each supported cyclotron
+# LED configuration, runs each under simavr and reports cycles per loop() stage.
+#
+# Requires simavr with its development headers (eg. libsimavr-dev), libelf and pkg-config.
+# Exits non-zero if any configuration exceeds the worst-case loop() budget.
+#
+# Environment overrides:
+#   OUTER_LEDS    Outer cyclotron LED counts to measure (default "12 20 36 40")
+#   INNER_LEDS    Inner cyclotron cake LED counts to measure (default "12 24 35 36")
+#   BENCH_SECONDS Simulated seconds per run (default 10)
+#   BUDGET_US     Worst-case loop() budget in microseconds, excluding FastLED.show() (default 3000)
+
+BINDIR="../binaries"
+SRCDIR="../source"
+BENCHDIR="${BINDIR}/benchmark"
+
+OUTER_LEDS=${OUTER_LEDS:-"12 20 36 40"}
+INNER_LEDS=${INNER_LEDS:-"12 24 35 36"}
+BENCH_SECONDS=${BENCH_SECONDS:-10}
+BUDGET_US=${BUDGET_US:-3000}
+
+RESULT=0
+
+mkdir -p ${BENCHDIR}
+
+echo ""
+
+echo "Building simavr benchmark runner..."
+cc -O2 -o ${BENCHDIR}/simavr_bench ${SRCDIR}/Benchmark/simavr_bench.c $(pkg-config --cflags --libs simavr) -lelf
+
+if [ ! -f ${BENCHDIR}/simavr_bench ]; then
+  echo "Unable to build the benchmark runner."
+  exit 1
+fi
+
+# Proton Pack, once per cyclotron configuration.
+for OUTER in ${OUTER_LEDS}; do
+  for INNER in ${INNER_LEDS}; do
+    OUTDIR="${BENCHDIR}/pack_${OUTER}_${INNER}"
+
+    echo ""
+    echo "Benchmarking Proton Pack (outer cyclotron ${OUTER} LEDs, inner cyclotron ${INNER} LEDs)..."
+
+    arduino-cli compile --output-dir ${OUTDIR} --fqbn arduino:avr:mega --build-property "compiler.cpp.extra_flags=-DGPSTAR_BENCHMARK -DBENCHMARK_CYCLOTRON_LEDS=${OUTER} -DBENCHMARK_INNER_CYCLOTRON_LEDS=${INNER}" ${SRCDIR}/ProtonPack/ProtonPack.ino > /dev/null
+
+    ${BENCHDIR}/simavr_bench --seconds ${BENCH_SECONDS} --budget-us ${BUDGET_US} ${OUTDIR}/ProtonPack.ino.elf || RESULT=1
+  done
+done
+
+# Neutrona Wand
+OUTDIR="${BENCHDIR}/wand"
+
+echo ""
+echo "Benchmarking Neutrona Wand..."
+
+arduino-cli compile --output-dir ${OUTDIR} --fqbn arduino:avr:mega --build-property "compiler.cpp.extra_flags=-DGPSTAR_BENCHMARK" ${SRCDIR}/NeutronaWand/NeutronaWand.ino > /dev/null
+
+${BENCHDIR}/simavr_bench --wand --seconds ${BENCH_SECONDS} --budget-us ${BUDGET_US} ${OUTDIR}/NeutronaWand.ino.elf || RESULT=1
+
+echo ""
+echo "Done."
+echo ""
+
+exit ${RESULT}
@@ -0,0 +1,37 @@
+#!/bin/bash
+
+# Check that the files shared between the Proton Pack, Neutrona Wand and other devices are still identical.
+# Arduino sketches can only include files from their own folder, so each device keeps its own copy and a
+# change made to one copy must be made to all of them.
+#
+# Exits non-zero if any copy differs from the first one listed.
+
+SRCDIR="../source"
+
+RESULT=0
+
+# Compare every copy of a file against the first, eg. check_shared Reliable.h ProtonPack NeutronaWand
+check_shared() {
+  FILE=$1
+  shift
+  FIRST="${SRCDIR}/$1/${FILE}"
+  shift
+
+  for PROJECT in "$@"; do
+    if ! diff -u "${FIRST}" "${SRCDIR}/${PROJECT}/${FILE}"; then
+      echo "${PROJECT}/${FILE} differs from ${FIRST}"
+      RESULT=1
+    fi
+  done
+}
+
+check_shared Reliable.h ProtonPack NeutronaWand
+check_shared LinkStats.h ProtonPack NeutronaWand AttenuatorESP32/include
+check_shared AudioQueue.h ProtonPack NeutronaWand SingleShot/include
+check_shared AudioFades.h ProtonPack NeutronaWand
+
+if [ ${RESULT} -eq 0 ]; then
+  echo "Shared files match."
+fi
+
+exit ${RESULT}
@@ -339,3 +339,27 @@ CRGB getHueAsGRB(uint8_t i_device, uint8_t i_colour, uint8_t i_brightness = 255)
   // Forward to getHueAsRGB() with the flag set for GRB colour swap.
   return getHueAsRGB(i_device, i_colour, i_brightness, true);
 }
+
+/*
+ * LED Frame Commit
+ *
+ * The RMT peripheral sends the device LEDs without holding interrupts off, but show() still waits for the
+ * previous frame to go out, so a frame is only sent when it differs from the one last sent.
+ */
+CRGB device_leds_sent[DEVICE_NUM_LEDS]; // Colours as last sent.
+uint8_t i_led_brightness_sent = 0;
+bool b_led_frame_sent = false; // A frame has been sent since startup.
+
+// Replaces FastLED.show(), skipping frames which are unchanged.
+void commitLedFrame() {
+  uint8_t i_brightness = FastLED.getBrightness();
+
+  if(b_led_frame_sent && i_brightness == i_led_brightness_sent && memcmp(device_leds, device_leds_sent, sizeof(device_leds)) == 0) {
+    return;
+  }
+
+  FastLED.show();
+  memcpy(device_leds_sent, device_leds, sizeof(device_leds));
+  i_led_brightness_sent = i_brightness;
+  b_led_frame_sent = true;
+}
@@ -230,6 +230,7 @@ bool b_master_muted = false;
 bool b_playing_music = false;
 bool b_music_paused = false;
 bool b_repeat_track = false;
+bool b_music_shuffle = false;
 String s_track_listing = "";
 
 /*
@@ -247,6 +248,21 @@ millisDelay ms_packsync;
 const uint16_t i_sync_initial_delay = 750; // Delay to re-try the initial handshake with a proton pack.
 const uint16_t i_sync_disconnect_delay = 8000; // Delay before we consider the pack missing.
 
+// Serial link speed, which the pack may raise once synchronized.
+const unsigned long i_serial_baud_default = 9600;
+const unsigned long i_serial_baud_fast = 57600;
+bool b_serial_baud_fast = false; // The pack link is at the faster rate.
+
+// Serial link telemetry, shown on the link status page.
+unsigned long i_pack_link_last_frame = 0; // When the last frame arrived from the pack, or 0 while not connected.
+unsigned long i_pack_link_request_time = 0; // When link counters were requested from the pack, or 0 once answered.
+unsigned long i_link_report_time = 0; // When the pack last sent its link counters, or 0 if it has not yet.
+unsigned long i_profile_report_time = 0; // When the pack last sent its loop stage timings, or 0 if it has not yet.
+unsigned long i_link_status_time = 0; // When the link status was last read over the web, or 0 if it has not been.
+millisDelay ms_link_poll; // Timer for asking the pack for fresh link counters while the link status is being read.
+const uint16_t i_link_poll_delay = 2000; // Time between requests for link counters, and so how old the link status may be.
+const uint16_t i_link_poll_idle = 10000; // Stop asking for link counters once the link status has gone unread this long.
+
 // Flags for denoting when requested data was received.
 bool b_received_prefs_pack = false;
 bool b_received_prefs_wand = false;
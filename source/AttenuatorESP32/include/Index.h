@@ -126,6 +126,7 @@ const char INDEX_page[] PROGMEM = R"=====(
         <button type="button" onclick="musicNext()" title="Next Track">&#9654;&#9654;</button>
       </div>
       <select id="tracks" class="custom-select" onchange="musicSelect(this)"></select>
+      <button type="button" class="orange" id="btnShuffle" onclick="musicShuffle()">Shuffle Off</button>
     </div>
   </div>
 
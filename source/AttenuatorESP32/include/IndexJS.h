@@ -479,6 +479,7 @@ function updateEquipment(jObj) {
       musicTrackCurrent = jObj.musicCurrent || 0;
       updateTrackListing();
     }
+    setHtml("btnShuffle", jObj.musicShuffle ? "Shuffle On" : "Shuffle Off");
 
     // Connected Wifi Clients - Private AP vs. WebSocket
     setHtml("clientInfo", "AP Clients: " + (jObj.apClients || 0) + " / WebSocket Clients: " + (jObj.wsClients || 0));
@@ -645,4 +646,8 @@ function musicPrev() {
 function musicLoop() {
   sendCommand("/music/loop");
 }
+
+function musicShuffle() {
+  sendCommand("/music/shuffle");
+}
 )=====";
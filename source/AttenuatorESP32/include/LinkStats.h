@@ -0,0 +1,62 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Serial link telemetry.
+ *
+ * Counters kept by each end of each serial link, which show a link degrading before it drops out entirely.
+ * The Attenuator asks the pack for them with A_REQUEST_LINK_STATS and receives one PACKET_LINK_STATS per link end.
+ *
+ * The counters are sent between the pack, wand and Attenuator as they are laid out here.
+ */
+struct __attribute__((packed)) LinkStats {
+  uint32_t framesSent;
+  uint16_t framesReceived[12]; // Frames received by packet type (PACKET_TYPE).
+  uint16_t retransmits; // Reliable commands sent again.
+  uint16_t crcErrors; // Frames dropped for a bad CRC, payload length or stop byte.
+  uint16_t markerErrors; // Frames dropped for start or end markers which did not match the sender.
+  uint16_t handshakeTime; // Time for the last handshake or request to be answered (ms).
+  uint16_t maxFrameGap; // Longest time between frames while connected (ms).
+};
+
+// Counts a frame received over a link, along with the longest wait since the one before it.
+void linkFrameReceived(struct LinkStats &stats, unsigned long &i_last_frame, uint8_t i_packet_id) {
+  unsigned long i_now = millis();
+
+  if(i_packet_id < sizeof(stats.framesReceived) / sizeof(stats.framesReceived[0]) && stats.framesReceived[i_packet_id] < 0xFFFF) {
+    stats.framesReceived[i_packet_id]++;
+  }
+
+  if(i_last_frame > 0 && i_now - i_last_frame > stats.maxFrameGap) {
+    stats.maxFrameGap = min(i_now - i_last_frame, 0xFFFFUL);
+  }
+
+  // Never 0, which means no frame has arrived since connecting.
+  i_last_frame = max(i_now, 1UL);
+}
+
+// Records how long the other end took to answer a handshake or request.
+void linkRequestAnswered(struct LinkStats &stats, unsigned long &i_request_time) {
+  if(i_request_time > 0) {
+    stats.handshakeTime = min(millis() - i_request_time, 0xFFFFUL);
+    i_request_time = 0;
+  }
+}
@@ -35,7 +35,12 @@ enum PACKET_TYPE : uint8_t {
   PACKET_PACK = 3,
   PACKET_WAND = 4,
   PACKET_SMOKE = 5,
-  PACKET_SYNC = 6
+  PACKET_SYNC = 6,
+  PACKET_PROFILE = 7,
+  PACKET_SYNC_DELTA = 8,
+  PACKET_COMMAND_BATCH = 9,
+  PACKET_RELIABLE = 10,
+  PACKET_LINK_STATS = 11
 };
 
 // For command signals (1 byte ID, 2 byte optional data).
@@ -49,6 +54,23 @@ struct __attribute__((packed)) CommandPacket {
 struct CommandPacket sendCmd;
 struct CommandPacket recvCmd;
 
+// For several commands sent in one frame (1 byte ID, 2 byte optional data each).
+// The pack, wand and Attenuator must all agree on i_command_batch_max, the most commands one frame can hold.
+const uint8_t i_command_batch_max = 16;
+
+struct __attribute__((packed)) BatchedCommand {
+  uint8_t c;
+  uint16_t d1;
+};
+
+struct __attribute__((packed)) CommandBatchPacket {
+  uint8_t s;
+  uint8_t e;
+  struct BatchedCommand cmd[i_command_batch_max];
+};
+
+struct CommandBatchPacket recvBatch;
+
 // For generic data communication (1 byte ID, 4 byte array).
 struct __attribute__((packed)) MessagePacket {
   uint8_t s;
@@ -166,8 +188,50 @@ struct __attribute__((packed)) AttenuatorSyncData {
   uint16_t currentTrack;
   uint16_t musicCount;
   uint16_t packVoltage;
+  uint8_t musicShuffle;
 } attenuatorSyncData;
 
+// Changed bytes of AttenuatorSyncData, with one bit in the mask for each byte of the struct.
+struct __attribute__((packed)) SyncDeltaPacket {
+  uint8_t version;
+  uint8_t crc; // Checksum of the complete state once the change is applied.
+  uint32_t changed;
+  uint8_t d[sizeof(AttenuatorSyncData)]; // Only the changed bytes are sent, in order.
+} syncDelta;
+
+// Identifies which end of which link the counters in a PACKET_LINK_STATS were kept by.
+enum LINK_ID : uint8_t {
+  LINK_PACK_WAND = 0,
+  LINK_WAND_PACK = 1,
+  LINK_PACK_SERIAL1 = 2
+};
+
+// For link telemetry (1 byte link ID, counters).
+struct __attribute__((packed)) LinkStatsPacket {
+  uint8_t link;
+  struct LinkStats stats;
+};
+
+struct LinkStatsPacket recvLinkStats;
+struct LinkStats linkReport[3]; // As last reported by the pack, indexed by LINK_ID.
+struct LinkStats packLink; // Frames to and from the pack, as seen by the Attenuator.
+
+// Loop stage timings sent by a pack built with GPSTAR_PROFILING, one PACKET_PROFILE per stage (see Benchmark.h on the pack).
+const uint8_t PROFILE_BUCKETS = 9; // Powers of two, from under 32us up to 4096us and over.
+const uint8_t PROFILE_STAGES = 15; // Stage IDs from the pack are below this.
+
+struct __attribute__((packed)) ProfileData {
+  uint8_t stage;
+  uint32_t samples;
+  uint16_t minimum; // us
+  uint16_t average; // us
+  uint16_t maximum; // us
+  uint16_t buckets[PROFILE_BUCKETS];
+};
+
+struct ProfileData recvProfile;
+struct ProfileData profileReport[PROFILE_STAGES]; // As last reported by the pack, indexed by stage. Unreported stages have no samples.
+
 /*
  * Serial API Communication Handlers
  */
@@ -188,6 +252,15 @@ void attenuatorSerialSend(uint8_t i_command, uint16_t i_value = 0) {
 
   i_send_size = packComs.txObj(sendCmd);
   packComs.sendData(i_send_size, (uint8_t) PACKET_COMMAND);
+  packLink.framesSent++;
+}
+
+// Moves the pack link to a new rate once any queued bytes have been sent.
+void setPackBaudRate(unsigned long i_baud) {
+  Serial2.flush();
+  Serial2.updateBaudRate(i_baud);
+
+  b_serial_baud_fast = (i_baud != i_serial_baud_default);
 }
 
 // Sends an API to the Proton Pack
@@ -214,6 +287,7 @@ void attenuatorSerialSendData(uint8_t i_message) {
 
       i_send_size = packComs.txObj(packConfig);
       packComs.sendData(i_send_size, (uint8_t) PACKET_PACK);
+      packLink.framesSent++;
     break;
 
     case A_SAVE_PREFERENCES_WAND:
@@ -223,6 +297,7 @@ void attenuatorSerialSendData(uint8_t i_message) {
 
       i_send_size = packComs.txObj(wandConfig);
       packComs.sendData(i_send_size, (uint8_t) PACKET_WAND);
+      packLink.framesSent++;
     break;
 
     case A_SAVE_PREFERENCES_SMOKE:
@@ -232,6 +307,7 @@ void attenuatorSerialSendData(uint8_t i_message) {
 
       i_send_size = packComs.txObj(smokeConfig);
       packComs.sendData(i_send_size, (uint8_t) PACKET_SMOKE);
+      packLink.framesSent++;
     break;
 
     default:
@@ -243,6 +319,172 @@ void attenuatorSerialSendData(uint8_t i_message) {
 // Forward function declaration.
 bool handleCommand(uint8_t i_command, uint16_t i_value);
 
+// Asks the pack for its link counters, which arrive one PACKET_LINK_STATS per link.
+void requestLinkStats() {
+  if(!b_wait_for_pack) {
+    i_pack_link_request_time = millis();
+    attenuatorSerialSend(A_REQUEST_LINK_STATS);
+  }
+}
+
+// Asks the pack for its loop stage timings, which only a pack built with GPSTAR_PROFILING sends.
+void requestProfile() {
+  if(!b_wait_for_pack) {
+    attenuatorSerialSend(A_REQUEST_PROFILE);
+  }
+}
+
+// Writes the pack state mirrored in attenuatorSyncData to the runtime variables.
+void applySyncData() {
+  // Sync all required variables.
+  switch(attenuatorSyncData.systemYear) {
+    case 1:
+      SYSTEM_YEAR = SYSTEM_1984;
+    break;
+    case 2:
+      SYSTEM_YEAR = SYSTEM_1989;
+    break;
+    case 3:
+      SYSTEM_YEAR = SYSTEM_AFTERLIFE;
+    default:
+    break;
+    case 4:
+      SYSTEM_YEAR = SYSTEM_FROZEN_EMPIRE;
+    break;
+  }
+
+  switch(attenuatorSyncData.streamMode) {
+    case 1:
+    default:
+      STREAM_MODE = PROTON;
+    break;
+    case 2:
+      STREAM_MODE = SLIME;
+    break;
+    case 3:
+      STREAM_MODE = STASIS;
+    break;
+    case 4:
+      STREAM_MODE = MESON;
+    break;
+    case 5:
+      STREAM_MODE = SPECTRAL;
+    break;
+    case 6:
+      STREAM_MODE = HOLIDAY;
+      b_christmas = false;
+    break;
+    case 7:
+      STREAM_MODE = HOLIDAY;
+      b_christmas = true;
+    break;
+    case 8:
+      STREAM_MODE = SPECTRAL_CUSTOM;
+    break;
+  }
+
+  POWER_LEVEL_PREV = POWER_LEVEL;
+  switch(attenuatorSyncData.powerLevel) {
+    case 1:
+    default:
+      POWER_LEVEL = LEVEL_1;
+    break;
+    case 2:
+      POWER_LEVEL = LEVEL_2;
+    break;
+    case 3:
+      POWER_LEVEL = LEVEL_3;
+    break;
+    case 4:
+      POWER_LEVEL = LEVEL_4;
+    break;
+    case 5:
+      POWER_LEVEL = LEVEL_5;
+    break;
+  }
+
+  // Common actions to all hardware.
+  b_pack_on = attenuatorSyncData.packOn == 1;
+  b_firing = attenuatorSyncData.wandFiring == 1;
+  b_overheating = attenuatorSyncData.overheatingNow == 1;
+  i_speed_multiplier = attenuatorSyncData.speedMultiplier;
+  i_spectral_custom_colour = attenuatorSyncData.spectralColour;
+  i_spectral_custom_saturation = attenuatorSyncData.spectralSaturation;
+
+  // Specific to the ESP32 and Web UI
+  SYSTEM_MODE = attenuatorSyncData.systemMode == 1 ? MODE_SUPER_HERO : MODE_ORIGINAL;
+  RED_SWITCH_MODE = attenuatorSyncData.ionArmSwitch == 2 ? SWITCH_ON : SWITCH_OFF;
+  BARREL_STATE = attenuatorSyncData.barrelExtended == 1 ? BARREL_EXTENDED : BARREL_RETRACTED;
+  b_wand_present = attenuatorSyncData.wandPresent == 1;
+  b_cyclotron_lid_on = attenuatorSyncData.cyclotronLidState == 1;
+  f_batt_volts = (float) attenuatorSyncData.packVoltage / 100;
+  i_volume_master_percentage = attenuatorSyncData.masterVolume;
+  i_volume_effects_percentage = attenuatorSyncData.effectsVolume;
+  i_volume_music_percentage = attenuatorSyncData.musicVolume;
+  i_music_track_current = attenuatorSyncData.currentTrack;
+  i_music_track_count = attenuatorSyncData.musicCount;
+  b_repeat_track = attenuatorSyncData.trackLooped == 2;
+  b_music_shuffle = attenuatorSyncData.musicShuffle == 2;
+  b_playing_music = attenuatorSyncData.musicPlaying == 1;
+  b_music_paused = attenuatorSyncData.musicPaused == 1;
+  b_master_muted = attenuatorSyncData.masterMuted == 2;
+
+  if(i_music_track_count > 0) {
+    i_music_track_min = i_music_track_offset; // First music track possible (eg. 500)
+    i_music_track_max = i_music_track_offset + i_music_track_count - 1; // 500 + N - 1 to be inclusive of the offset value.
+  }
+}
+
+// CRC-8 of a block of state, matching the checksum the pack sends with each change.
+uint8_t syncChecksum(const uint8_t *p_data, uint8_t i_length) {
+  uint8_t i_crc = 0;
+
+  for(uint8_t i = 0; i < i_length; i++) {
+    i_crc ^= p_data[i];
+
+    for(uint8_t j = 0; j < 8; j++) {
+      i_crc = (i_crc & 0x80) ? (i_crc << 1) ^ 0x9B : (i_crc << 1);
+    }
+  }
+
+  return i_crc;
+}
+
+// Applies the changed bytes of the pack state and confirms that the result matches the pack.
+bool applySyncDelta(uint8_t i_length) {
+  uint8_t *p_state = (uint8_t *) &attenuatorSyncData;
+  uint8_t i_header = offsetof(struct SyncDeltaPacket, d);
+  uint8_t i_changed = 0;
+
+  if(i_length < i_header || i_length > sizeof(syncDelta)) {
+    return false;
+  }
+
+  packComs.rxObj(syncDelta, 0, i_length);
+
+  for(uint8_t i = 0; i < sizeof(AttenuatorSyncData); i++) {
+    if((syncDelta.changed >> i) & 1) {
+      if(i_changed >= i_length - i_header) {
+        break;
+      }
+
+      p_state[i] = syncDelta.d[i_changed++];
+    }
+  }
+
+  if(syncChecksum(p_state, sizeof(AttenuatorSyncData)) != syncDelta.crc) {
+    // Our copy no longer matches, so ask for the whole state again.
+    debug("Pack Sync Mismatch");
+    attenuatorSerialSend(A_SYNC_DELTA_RESYNC);
+    return false;
+  }
+
+  attenuatorSerialSend(A_SYNC_DELTA_ACK, syncDelta.version);
+  applySyncData();
+
+  return true; // Indicates a status change.
+}
+
 // Handles an API (and data) sent from the Proton Pack
 bool checkPack() {
   // Pack communication to the Attenuator device.
@@ -254,6 +496,8 @@ bool checkPack() {
     #endif
 
     if(i_packet_id > 0) {
+      linkFrameReceived(packLink, i_pack_link_last_frame, i_packet_id);
+
       if(ms_packsync.isRunning() && !b_wait_for_pack) {
         // If the timer is still running and Pack is connected, consider any request as proof of life.
         ms_packsync.restart();
@@ -269,6 +513,36 @@ bool checkPack() {
             #endif
             return handleCommand(recvCmd.c, recvCmd.d1);
           }
+          else {
+            packLink.markerErrors++;
+            return false;
+          }
+        break;
+
+        case PACKET_COMMAND_BATCH:
+          if(packComs.bytesRead >= offsetof(struct CommandBatchPacket, cmd) && packComs.bytesRead <= sizeof(recvBatch)) {
+            uint8_t i_commands = (packComs.bytesRead - offsetof(struct CommandBatchPacket, cmd)) / sizeof(struct BatchedCommand);
+            bool b_state_changed = false;
+
+            packComs.rxObj(recvBatch, 0, packComs.bytesRead);
+
+            if(recvBatch.s == P_COM_START && recvBatch.e == P_COM_END) {
+              // Commands are handled in the order the pack sent them.
+              for(uint8_t i = 0; i < i_commands; i++) {
+                if(recvBatch.cmd[i].c > 0) {
+                  #if defined(DEBUG_SERIAL_COMMS)
+                    debug("Recv. Command: " + String(recvBatch.cmd[i].c));
+                  #endif
+                  b_state_changed = handleCommand(recvBatch.cmd[i].c, recvBatch.cmd[i].d1) || b_state_changed;
+                }
+              }
+            }
+            else {
+              packLink.markerErrors++;
+            }
+
+            return b_state_changed;
+          }
           else {
             return false;
           }
@@ -370,109 +644,49 @@ bool checkPack() {
           debug("Pack Sync Packet Received");
 
           packComs.rxObj(attenuatorSyncData);
+          applySyncData();
 
-          // Sync all required variables.
-          switch(attenuatorSyncData.systemYear) {
-            case 1:
-              SYSTEM_YEAR = SYSTEM_1984;
-            break;
-            case 2:
-              SYSTEM_YEAR = SYSTEM_1989;
-            break;
-            case 3:
-              SYSTEM_YEAR = SYSTEM_AFTERLIFE;
-            default:
-            break;
-            case 4:
-              SYSTEM_YEAR = SYSTEM_FROZEN_EMPIRE;
-            break;
-          }
+          return true; // Indicates a status change.
+        break;
 
-          switch(attenuatorSyncData.streamMode) {
-            case 1:
-            default:
-              STREAM_MODE = PROTON;
-            break;
-            case 2:
-              STREAM_MODE = SLIME;
-            break;
-            case 3:
-              STREAM_MODE = STASIS;
-            break;
-            case 4:
-              STREAM_MODE = MESON;
-            break;
-            case 5:
-              STREAM_MODE = SPECTRAL;
-            break;
-            case 6:
-              STREAM_MODE = HOLIDAY;
-              b_christmas = false;
-            break;
-            case 7:
-              STREAM_MODE = HOLIDAY;
-              b_christmas = true;
-            break;
-            case 8:
-              STREAM_MODE = SPECTRAL_CUSTOM;
-            break;
+        case PACKET_SYNC_DELTA:
+          if(b_wait_for_pack) {
+            // Can't proceed if the Pack isn't connected; prevents phantom actions from occurring.
+            return false;
           }
 
-          POWER_LEVEL_PREV = POWER_LEVEL;
-          switch(attenuatorSyncData.powerLevel) {
-            case 1:
-            default:
-              POWER_LEVEL = LEVEL_1;
-            break;
-            case 2:
-              POWER_LEVEL = LEVEL_2;
-            break;
-            case 3:
-              POWER_LEVEL = LEVEL_3;
-            break;
-            case 4:
-              POWER_LEVEL = LEVEL_4;
-            break;
-            case 5:
-              POWER_LEVEL = LEVEL_5;
-            break;
+          return applySyncDelta(packComs.bytesRead);
+        break;
+
+        case PACKET_LINK_STATS:
+          packComs.rxObj(recvLinkStats);
+          linkRequestAnswered(packLink, i_pack_link_request_time);
+
+          if(recvLinkStats.link < sizeof(linkReport) / sizeof(linkReport[0])) {
+            linkReport[recvLinkStats.link] = recvLinkStats.stats;
+            i_link_report_time = millis();
           }
 
-          // Common actions to all hardware.
-          b_pack_on = attenuatorSyncData.packOn == 1;
-          b_firing = attenuatorSyncData.wandFiring == 1;
-          b_overheating = attenuatorSyncData.overheatingNow == 1;
-          i_speed_multiplier = attenuatorSyncData.speedMultiplier;
-          i_spectral_custom_colour = attenuatorSyncData.spectralColour;
-          i_spectral_custom_saturation = attenuatorSyncData.spectralSaturation;
-
-          // Specific to the ESP32 and Web UI
-          SYSTEM_MODE = attenuatorSyncData.systemMode == 1 ? MODE_SUPER_HERO : MODE_ORIGINAL;
-          RED_SWITCH_MODE = attenuatorSyncData.ionArmSwitch == 2 ? SWITCH_ON : SWITCH_OFF;
-          BARREL_STATE = attenuatorSyncData.barrelExtended == 1 ? BARREL_EXTENDED : BARREL_RETRACTED;
-          b_wand_present = attenuatorSyncData.wandPresent == 1;
-          b_cyclotron_lid_on = attenuatorSyncData.cyclotronLidState == 1;
-          f_batt_volts = (float) attenuatorSyncData.packVoltage / 100;
-          i_volume_master_percentage = attenuatorSyncData.masterVolume;
-          i_volume_effects_percentage = attenuatorSyncData.effectsVolume;
-          i_volume_music_percentage = attenuatorSyncData.musicVolume;
-          i_music_track_current = attenuatorSyncData.currentTrack;
-          i_music_track_count = attenuatorSyncData.musicCount;
-          b_repeat_track = attenuatorSyncData.trackLooped == 2;
-          b_playing_music = attenuatorSyncData.musicPlaying == 1;
-          b_music_paused = attenuatorSyncData.musicPaused == 1;
-          b_master_muted = attenuatorSyncData.masterMuted == 2;
-
-          if(i_music_track_count > 0) {
-            i_music_track_min = i_music_track_offset; // First music track possible (eg. 500)
-            i_music_track_max = i_music_track_offset + i_music_track_count - 1; // 500 + N - 1 to be inclusive of the offset value.
+          return false;
+        break;
+
+        case PACKET_PROFILE:
+          packComs.rxObj(recvProfile);
+
+          if(recvProfile.stage < PROFILE_STAGES) {
+            profileReport[recvProfile.stage] = recvProfile;
+            i_profile_report_time = millis();
           }
 
-          return true; // Indicates a status change.
+          return false;
         break;
       }
     }
   }
+  else if(packComs.status <= CRC_ERROR) {
+    // The last frame read was corrupted.
+    packLink.crcErrors++;
+  }
 
   return false; // Returns false if still here.
 }
@@ -504,6 +718,21 @@ bool handleCommand(uint8_t i_command, uint16_t i_value) {
       ms_packsync.start(i_sync_disconnect_delay);
 
       attenuatorSerialSend(A_SYNC_END); // Signal end of sync.
+      attenuatorSerialSend(A_SYNC_DELTA_ACK); // Tell the pack we mirror its state, so it only needs to send changes.
+      attenuatorSerialSend(A_COMMAND_BATCH); // Tell the pack it can send us several commands in one frame.
+    break;
+
+    case A_BAUD_RATE:
+      // Pack has offered a faster link rate. Acknowledge at the current rate and then switch.
+      if(!b_serial_baud_fast && i_value == i_serial_baud_fast / 100) {
+        debug("Baud Rate Increased");
+        attenuatorSerialSend(A_BAUD_RATE, i_value);
+        setPackBaudRate(i_serial_baud_fast);
+      }
+    break;
+
+    case A_BAUD_RATE_CONFIRM:
+      debug("Baud Rate Confirmed");
     break;
 
     case A_WAND_CONNECTED:
@@ -580,6 +809,11 @@ bool handleCommand(uint8_t i_command, uint16_t i_value) {
       b_repeat_track = i_value == 2;
     break;
 
+    case A_MUSIC_SHUFFLE_TOGGLE:
+      debug("Received shuffle value: " + String(i_value));
+      b_music_shuffle = i_value == 2;
+    break;
+
     case A_MUSIC_IS_PLAYING:
       debug("Music Playing: " + String(i_value));
 
@@ -546,6 +546,7 @@ String getEquipmentStatus() {
     jsonBody["temperature"] = (b_overheating ? "Venting" : "Normal");
     jsonBody["musicPlaying"] = b_playing_music;
     jsonBody["musicPaused"] = b_music_paused;
+    jsonBody["musicShuffle"] = b_music_shuffle;
     jsonBody["musicCurrent"] = i_music_track_current;
     jsonBody["musicStart"] = i_music_track_min;
     jsonBody["musicEnd"] = i_music_track_max;
@@ -563,6 +564,81 @@ String getEquipmentStatus() {
   return equipStatus;
 }
 
+// Adds the counters kept by one end of a serial link.
+// Fields of the packed struct are copied out, as they cannot be passed by reference.
+void addLinkStats(JsonObject jsonLink, const struct LinkStats &stats) {
+  uint32_t i_received = 0;
+  JsonArray jsonByType = jsonLink["receivedByType"].to<JsonArray>();
+
+  for(uint8_t i = 0; i < sizeof(stats.framesReceived) / sizeof(stats.framesReceived[0]); i++) {
+    jsonByType.add((uint16_t) stats.framesReceived[i]); // Indexed by packet type.
+    i_received += stats.framesReceived[i];
+  }
+
+  jsonLink["sent"] = (uint32_t) stats.framesSent;
+  jsonLink["received"] = i_received;
+  jsonLink["retransmits"] = (uint16_t) stats.retransmits;
+  jsonLink["crcErrors"] = (uint16_t) stats.crcErrors;
+  jsonLink["markerErrors"] = (uint16_t) stats.markerErrors;
+  jsonLink["handshakeTime"] = (uint16_t) stats.handshakeTime; // ms
+  jsonLink["maxFrameGap"] = (uint16_t) stats.maxFrameGap; // ms
+}
+
+// Names of the pack's loop stages, indexed by stage ID.
+const char* profileStageNames[PROFILE_STAGES] = {
+  "none", "loop", "mainLoop", "serial", "switches", "cyclotron", "powercell", "ledShow",
+  "audio", "powerMeter", "handshake", "serial1", "music", "packState", "timers"
+};
+
+// Adds the timings of one loop stage, copying fields out of the packed struct as above.
+void addProfileStage(JsonObject jsonStage, const struct ProfileData &profile) {
+  JsonArray jsonBuckets = jsonStage["buckets"].to<JsonArray>();
+
+  for(uint8_t i = 0; i < PROFILE_BUCKETS; i++) {
+    jsonBuckets.add((uint16_t) profile.buckets[i]);
+  }
+
+  jsonStage["stage"] = profileStageNames[profile.stage];
+  jsonStage["samples"] = (uint32_t) profile.samples;
+  jsonStage["min"] = (uint16_t) profile.minimum; // us
+  jsonStage["avg"] = (uint16_t) profile.average; // us
+  jsonStage["max"] = (uint16_t) profile.maximum; // us
+}
+
+String getLinkStatus() {
+  // Prepare a JSON object with the counters for both ends of each serial link.
+  String linkStatus;
+  jsonBody.clear();
+
+  // Our own end of the pack link is always available.
+  addLinkStats(jsonBody["attenuatorPack"].to<JsonObject>(), packLink);
+
+  if(i_link_report_time > 0) {
+    // Counters from the pack are as of its last report, which is at most i_link_poll_delay old while polling.
+    jsonBody["reportAge"] = millis() - i_link_report_time; // ms
+    addLinkStats(jsonBody["packAttenuator"].to<JsonObject>(), linkReport[LINK_PACK_SERIAL1]);
+    addLinkStats(jsonBody["packWand"].to<JsonObject>(), linkReport[LINK_PACK_WAND]);
+    addLinkStats(jsonBody["wandPack"].to<JsonObject>(), linkReport[LINK_WAND_PACK]);
+  }
+
+  if(i_profile_report_time > 0) {
+    // Only a pack built with GPSTAR_PROFILING reports its loop stage timings.
+    JsonArray jsonProfile = jsonBody["profile"].to<JsonArray>();
+
+    jsonBody["profileAge"] = millis() - i_profile_report_time; // ms
+
+    for(uint8_t i = 0; i < PROFILE_STAGES; i++) {
+      if(profileReport[i].samples > 0) {
+        addProfileStage(jsonProfile.add<JsonObject>(), profileReport[i]);
+      }
+    }
+  }
+
+  // Serialize JSON object to string.
+  serializeJson(jsonBody, linkStatus);
+  return linkStatus;
+}
+
 String getWifiSettings() {
   // Prepare a JSON object with information stored in preferences (or a blank default).
   String wifiNetwork;
@@ -633,6 +709,13 @@ void handleGetStatus(AsyncWebServerRequest *request) {
   request->send(200, "application/json", getEquipmentStatus());
 }
 
+void handleGetLinkStatus(AsyncWebServerRequest *request) {
+  // Return the serial link counters as a stringified JSON object.
+  // The pack's counters are only as fresh as the last poll, which the serial task keeps running while this is read.
+  i_link_status_time = millis();
+  request->send(200, "application/json", getLinkStatus());
+}
+
 void handleGetWifi(AsyncWebServerRequest *request) {
   // Return current system status as a stringified JSON object.
   request->send(200, "application/json", getWifiSettings());
@@ -763,6 +846,12 @@ void handleLoopMusicTrack(AsyncWebServerRequest *request) {
   request->send(200, "application/json", status);
 }
 
+void handleShuffleMusic(AsyncWebServerRequest *request) {
+  debug("Web: Toggle Music Shuffle");
+  attenuatorSerialSend(A_MUSIC_SHUFFLE_TOGGLE);
+  request->send(200, "application/json", status);
+}
+
 void handleSelectMusicTrack(AsyncWebServerRequest *request) {
   String c_music_track = "";
 
@@ -1343,6 +1432,7 @@ void setupRouting() {
   httpServer.on("/eeprom/all", HTTP_PUT, handleSaveAllEEPROM);
   httpServer.on("/eeprom/pack", HTTP_PUT, handleSavePackEEPROM);
   httpServer.on("/eeprom/wand", HTTP_PUT, handleSaveWandEEPROM);
+  httpServer.on("/status/links", HTTP_GET, handleGetLinkStatus); // Before "/status", which also matches sub-paths.
   httpServer.on("/status", HTTP_GET, handleGetStatus);
   httpServer.on("/restart", HTTP_DELETE, handleRestart);
   httpServer.on("/pack/on", HTTP_PUT, handlePackOn);
@@ -1364,6 +1454,7 @@ void setupRouting() {
   httpServer.on("/music/select", HTTP_PUT, handleSelectMusicTrack);
   httpServer.on("/music/prev", HTTP_PUT, handlePrevMusicTrack);
   httpServer.on("/music/loop", HTTP_PUT, handleLoopMusicTrack);
+  httpServer.on("/music/shuffle", HTTP_PUT, handleShuffleMusic);
   httpServer.on("/wifi/settings", HTTP_GET, handleGetWifi);
 
   // Body Handlers
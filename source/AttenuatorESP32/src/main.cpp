@@ -43,6 +43,7 @@
 // Local Files
 #include "Configuration.h"
 #include "Communication.h"
+#include "LinkStats.h"
 #include "Header.h"
 #include "Bargraph.h"
 #include "Colours.h"
@@ -141,7 +142,7 @@ void AnimationTask(void *parameter) {
     bargraphUpdate(i_speed_multiplier);
 
     // Update the device LEDs and restart the timer.
-    FastLED.show();
+    commitLedFrame();
 
     vTaskDelay(8 / portTICK_PERIOD_MS); // 8ms delay
   }
@@ -296,6 +297,27 @@ void SerialCommsTask(void *parameter) {
         // The pack just went missing, so treat as disconnected.
         b_wait_for_pack = true;
         ms_packsync.start(i_sync_initial_delay);
+
+        if(b_serial_baud_fast) {
+          // Listen at the default rate for the next sync.
+          setPackBaudRate(i_serial_baud_default);
+        }
+
+        // The time until the pack answers again is not a gap in the link.
+        i_pack_link_last_frame = 0;
+        i_pack_link_request_time = 0;
+      }
+
+      if(i_link_status_time > 0 && millis() - i_link_status_time < i_link_poll_idle) {
+        if(!ms_link_poll.isRunning() || ms_link_poll.justFinished()) {
+          // Keep the link status current while someone is reading it, since a web request cannot wait on the pack.
+          requestLinkStats();
+          requestProfile();
+          ms_link_poll.start(i_link_poll_delay);
+        }
+      }
+      else if(ms_link_poll.isRunning()) {
+        ms_link_poll.stop();
       }
 
       /**
@@ -413,7 +435,7 @@ void setup() {
   delay(1000); // Provide a delay to allow serial output.
 
   // Expect a Serial2 connection with communication to a GPStar Proton Pack PCB.
-  Serial2.begin(9600, SERIAL_8N1, RXD2, TXD2);
+  Serial2.begin(i_serial_baud_default, SERIAL_8N1, RXD2, TXD2);
   packComs.begin(Serial2, false);
 
   // Prepare the on-board (non-power) LED to be used as an output pin for indication.
@@ -120,5 +120,15 @@ enum api_messages : uint8_t {
   A_SEND_PREFERENCES_SMOKE,
   A_SAVE_PREFERENCES_PACK,
   A_SAVE_PREFERENCES_WAND,
-  A_SAVE_PREFERENCES_SMOKE
+  A_SAVE_PREFERENCES_SMOKE,
+  A_REQUEST_PROFILE, // Only used by the ESP32, but kept so later commands are numbered as on the pack.
+  A_SEND_PROFILE,
+  A_BAUD_RATE,
+  A_BAUD_RATE_CONFIRM,
+  A_SYNC_DELTA_ACK,
+  A_SYNC_DELTA_RESYNC,
+  A_COMMAND_BATCH,
+  A_REQUEST_LINK_STATS,
+  A_SEND_LINK_STATS,
+  A_MUSIC_SHUFFLE_TOGGLE
 };
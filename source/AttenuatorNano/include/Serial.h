@@ -33,7 +33,11 @@ enum PACKET_TYPE : uint8_t {
   PACKET_PACK = 3,
   PACKET_WAND = 4,
   PACKET_SMOKE = 5,
-  PACKET_SYNC = 6
+  PACKET_SYNC = 6,
+  PACKET_SYNC_DELTA = 8,
+  PACKET_COMMAND_BATCH = 9,
+  PACKET_RELIABLE = 10,
+  PACKET_LINK_STATS = 11
 };
 
 // For command signals (1 byte ID, 2 byte optional data).
@@ -47,6 +51,23 @@ struct __attribute__((packed)) CommandPacket {
 struct CommandPacket sendCmd;
 struct CommandPacket recvCmd;
 
+// For several commands sent in one frame (1 byte ID, 2 byte optional data each).
+// The pack, wand and Attenuator must all agree on i_command_batch_max, the most commands one frame can hold.
+const uint8_t i_command_batch_max = 16;
+
+struct __attribute__((packed)) BatchedCommand {
+  uint8_t c;
+  uint16_t d1;
+};
+
+struct __attribute__((packed)) CommandBatchPacket {
+  uint8_t s;
+  uint8_t e;
+  struct BatchedCommand cmd[i_command_batch_max];
+};
+
+struct CommandBatchPacket recvBatch;
+
 // For generic data communication (1 byte ID, 4 byte array).
 struct __attribute__((packed)) MessagePacket {
   uint8_t s;
@@ -83,6 +104,7 @@ struct __attribute__((packed)) AttenuatorSyncData {
   uint16_t currentTrack;
   uint16_t musicCount;
   uint16_t packVoltage;
+  uint8_t musicShuffle;
 } attenuatorSyncData;
 
 /*
@@ -129,6 +151,29 @@ bool checkPack() {
           }
         break;
 
+        case PACKET_COMMAND_BATCH:
+          if(packComs.bytesRead >= offsetof(struct CommandBatchPacket, cmd) && packComs.bytesRead <= sizeof(recvBatch)) {
+            uint8_t i_commands = (packComs.bytesRead - offsetof(struct CommandBatchPacket, cmd)) / sizeof(struct BatchedCommand);
+            bool b_state_changed = false;
+
+            packComs.rxObj(recvBatch, 0, packComs.bytesRead);
+
+            if(recvBatch.s == P_COM_START && recvBatch.e == P_COM_END) {
+              // Commands are handled in the order the pack sent them.
+              for(uint8_t i = 0; i < i_commands; i++) {
+                if(recvBatch.cmd[i].c > 0) {
+                  b_state_changed = handleCommand(recvBatch.cmd[i].c, recvBatch.cmd[i].d1) || b_state_changed;
+                }
+              }
+            }
+
+            return b_state_changed;
+          }
+          else {
+            return false;
+          }
+        break;
+
         case PACKET_DATA:
           if(b_wait_for_pack) {
             // Can't proceed if the Pack isn't connected; prevents phantom actions from occurring.
@@ -272,6 +317,7 @@ bool handleCommand(uint8_t i_command, uint16_t i_value) {
       ms_packsync.start(i_sync_disconnect_delay);
 
       attenuatorSerialSend(A_SYNC_END); // Signal end of sync.
+      attenuatorSerialSend(A_COMMAND_BATCH); // Tell the pack it can send us several commands in one frame.
     break;
 
     case A_WAND_CONNECTED:
@@ -522,7 +522,7 @@ void mainLoop() {
 
   // Update the device LEDs and restart the timer.
   if(ms_fast_led.justFinished()) {
-    FastLED.show();
+    commitLedFrame();
     ms_fast_led.start(i_fast_led_delay);
   }
 
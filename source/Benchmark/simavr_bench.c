@@ -0,0 +1,297 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*
+ * Cycle benchmark for the Proton Pack and Neutrona Wand firmware.
+ *
+ * Runs an ATmega2560 image built with GPSTAR_BENCHMARK (see Benchmark.h in each sketch) under
+ * simavr and records the simulated cycle counter every time the firmware enters or leaves a
+ * loop stage. Reports the cost of each stage per call and per loop() iteration, and checks the
+ * worst-case loop() time against a budget.
+ *
+ * Usage: simavr_bench [--wand] [--seconds N] [--budget-us N] firmware.elf
+ *
+ * Exits with 1 if the firmware could not be run, or 2 if the worst-case loop() time (excluding
+ * FastLED.show(), whose cost is fixed by the LED count) exceeds the budget.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <simavr/sim_avr.h>
+#include <simavr/sim_elf.h>
+#include <simavr/sim_io.h>
+#include <simavr/avr_uart.h>
+
+#define MCU_NAME "atmega2560"
+#define MCU_FREQUENCY 16000000UL
+#define CYCLES_PER_US (MCU_FREQUENCY / 1000000UL)
+
+// Data space addresses of GPIOR0 (stage enter) and GPIOR1 (stage leave) on the ATmega2560.
+#define GPIOR0_ADDR 0x3E
+#define GPIOR1_ADDR 0x4A
+
+// Loop time histogram, in 10us buckets up to 20ms.
+#define HISTOGRAM_BUCKET_US 10
+#define HISTOGRAM_BUCKETS 2000
+
+// Must be kept in sync with the BENCHMARK_STAGES enum in Benchmark.h.
+enum BENCHMARK_STAGES {
+  BENCH_NONE,
+  BENCH_LOOP,
+  BENCH_MAIN_LOOP,
+  BENCH_SERIAL,
+  BENCH_SWITCHES,
+  BENCH_CYCLOTRON,
+  BENCH_POWERCELL,
+  BENCH_LED_SHOW,
+  BENCH_AUDIO,
+  BENCH_POWER_METER,
+  BENCH_HANDSHAKE,
+  BENCH_SERIAL1,
+  BENCH_MUSIC,
+  BENCH_PACK_STATE,
+  BENCH_TIMERS,
+  BENCH_STAGE_COUNT
+};
+
+static const char *pack_stage_names[BENCH_STAGE_COUNT] = {
+  "", "loop()", "mainLoop()", "checkWand()", "checkSwitches()", "cyclotronControl()", "powercellLoop()", "FastLED.show()",
+  "updateAudio()", "checkPowerMeter()", "serial1HandShake()", "checkSerial1()", "checkMusic()", "PACK_STATE",
+  "runScheduledTimers()"
+};
+
+static const char *wand_stage_names[BENCH_STAGE_COUNT] = {
+  "", "loop()", "mainLoop()", "checkPack()", "checkSwitches()", "cyclotronControl()", "powercellLoop()", "FastLED.show()",
+  "updateAudio()", "checkPowerMeter()", "serial1HandShake()", "checkSerial1()", "checkMusic()", "PACK_STATE",
+  "runScheduledTimers()"
+};
+
+struct stage_stats {
+  uint64_t calls;
+  uint64_t total;
+  uint64_t min;
+  uint64_t max;
+  avr_cycle_count_t start;
+  int open;
+};
+
+static struct stage_stats stages[BENCH_STAGE_COUNT];
+static uint64_t loop_histogram[HISTOGRAM_BUCKETS + 1];
+static uint64_t i_show_this_loop = 0;
+static uint64_t i_loop_work_max = 0;
+static uint64_t i_unmatched = 0;
+
+static void stageBegin(struct avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param) {
+  (void) param;
+  avr->data[addr] = v;
+
+  if(v == BENCH_NONE || v >= BENCH_STAGE_COUNT) {
+    i_unmatched++;
+    return;
+  }
+
+  if(v == BENCH_LOOP) {
+    i_show_this_loop = 0;
+  }
+
+  stages[v].start = avr->cycle;
+  stages[v].open = 1;
+}
+
+static void stageEnd(struct avr_t *avr, avr_io_addr_t addr, uint8_t v, void *param) {
+  (void) param;
+  avr->data[addr] = v;
+
+  if(v == BENCH_NONE || v >= BENCH_STAGE_COUNT || !stages[v].open) {
+    i_unmatched++;
+    return;
+  }
+
+  struct stage_stats *s = &stages[v];
+  uint64_t i_cycles = avr->cycle - s->start;
+
+  s->open = 0;
+  s->calls++;
+  s->total += i_cycles;
+
+  if(s->calls == 1 || i_cycles < s->min) {
+    s->min = i_cycles;
+  }
+
+  if(i_cycles > s->max) {
+    s->max = i_cycles;
+  }
+
+  if(v == BENCH_LED_SHOW) {
+    i_show_this_loop += i_cycles;
+  }
+  else if(v == BENCH_LOOP) {
+    uint64_t i_work = i_cycles - i_show_this_loop;
+    uint64_t i_bucket = (i_cycles / CYCLES_PER_US) / HISTOGRAM_BUCKET_US;
+
+    if(i_work > i_loop_work_max) {
+      i_loop_work_max = i_work;
+    }
+
+    loop_histogram[i_bucket < HISTOGRAM_BUCKETS ? i_bucket : HISTOGRAM_BUCKETS]++;
+  }
+}
+
+// Return the loop() time in microseconds below which the given fraction of iterations fall.
+static double loopPercentile(double f_fraction) {
+  uint64_t i_target = (uint64_t) (stages[BENCH_LOOP].calls * f_fraction);
+  uint64_t i_seen = 0;
+
+  for(int i = 0; i <= HISTOGRAM_BUCKETS; i++) {
+    i_seen += loop_histogram[i];
+
+    if(i_seen > i_target) {
+      return (double) (i + 1) * HISTOGRAM_BUCKET_US;
+    }
+  }
+
+  return (double) HISTOGRAM_BUCKETS * HISTOGRAM_BUCKET_US;
+}
+
+static double cyclesToMicros(uint64_t i_cycles) {
+  return (double) i_cycles / CYCLES_PER_US;
+}
+
+static void usage(const char *s_name) {
+  fprintf(stderr, "Usage: %s [--wand] [--seconds N] [--budget-us N] firmware.elf\n", s_name);
+  fprintf(stderr, "  --wand         Label stages for the Neutrona Wand image\n");
+  fprintf(stderr, "  --seconds N    Simulated run time in seconds (default 10)\n");
+  fprintf(stderr, "  --budget-us N  Worst-case loop() budget excluding FastLED.show() (default 3000)\n");
+}
+
+int main(int argc, char *argv[]) {
+  const char **stage_names = pack_stage_names;
+  const char *s_firmware = NULL;
+  unsigned long i_seconds = 10;
+  unsigned long i_budget_us = 3000;
+
+  for(int i = 1; i < argc; i++) {
+    if(strcmp(argv[i], "--wand") == 0) {
+      stage_names = wand_stage_names;
+    }
+    else if(strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+      i_seconds = strtoul(argv[++i], NULL, 10);
+    }
+    else if(strcmp(argv[i], "--budget-us") == 0 && i + 1 < argc) {
+      i_budget_us = strtoul(argv[++i], NULL, 10);
+    }
+    else if(argv[i][0] != '-' && s_firmware == NULL) {
+      s_firmware = argv[i];
+    }
+    else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  if(s_firmware == NULL) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  elf_firmware_t firmware;
+  memset(&firmware, 0, sizeof(firmware));
+
+  if(elf_read_firmware(s_firmware, &firmware) != 0) {
+    fprintf(stderr, "Unable to read firmware %s\n", s_firmware);
+    return 1;
+  }
+
+  avr_t *avr = avr_make_mcu_by_name(MCU_NAME);
+
+  if(avr == NULL) {
+    fprintf(stderr, "simavr does not support %s\n", MCU_NAME);
+    return 1;
+  }
+
+  avr_init(avr);
+  avr_load_firmware(avr, &firmware);
+  avr->frequency = MCU_FREQUENCY;
+
+  // Nothing is attached to the UARTs; keep their output off the report.
+  for(char c = '0'; c <= '3'; c++) {
+    uint32_t i_flags = 0;
+
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS(c), &i_flags);
+    i_flags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS(c), &i_flags);
+  }
+
+  avr_register_io_write(avr, GPIOR0_ADDR, stageBegin, NULL);
+  avr_register_io_write(avr, GPIOR1_ADDR, stageEnd, NULL);
+
+  avr_cycle_count_t i_limit = (avr_cycle_count_t) i_seconds * MCU_FREQUENCY;
+  int state = cpu_Running;
+
+  while(state != cpu_Done && state != cpu_Crashed && avr->cycle < i_limit) {
+    state = avr_run(avr);
+  }
+
+  if(state == cpu_Crashed) {
+    fprintf(stderr, "Firmware crashed after %llu cycles\n", (unsigned long long) avr->cycle);
+    return 1;
+  }
+
+  struct stage_stats *loop_stats = &stages[BENCH_LOOP];
+
+  if(loop_stats->calls == 0) {
+    fprintf(stderr, "No loop() iterations recorded; was the image built with GPSTAR_BENCHMARK?\n");
+    return 1;
+  }
+
+  printf("%s: %.2f s simulated, %llu loop() iterations\n", s_firmware, (double) avr->cycle / MCU_FREQUENCY, (unsigned long long) loop_stats->calls);
+  printf("%-20s %10s %12s %10s %10s %10s %10s\n", "Stage", "Calls", "Cycles/loop", "Avg cyc", "Max cyc", "Avg us", "Max us");
+
+  for(int i = BENCH_LOOP; i < BENCH_STAGE_COUNT; i++) {
+    struct stage_stats *s = &stages[i];
+
+    if(s->calls == 0) {
+      continue;
+    }
+
+    printf("%-20s %10llu %12.1f %10.1f %10llu %10.1f %10.1f\n", stage_names[i], (unsigned long long) s->calls,
+      (double) s->total / loop_stats->calls, (double) s->total / s->calls, (unsigned long long) s->max,
+      cyclesToMicros(s->total) / s->calls, cyclesToMicros(s->max));
+  }
+
+  printf("loop() percentiles:  p50 %.0f us, p99 %.0f us, p99.9 %.0f us\n", loopPercentile(0.5), loopPercentile(0.99), loopPercentile(0.999));
+
+  if(i_unmatched > 0) {
+    printf("Unmatched stage markers: %llu\n", (unsigned long long) i_unmatched);
+  }
+
+  double f_worst_us = cyclesToMicros(i_loop_work_max);
+
+  if(f_worst_us > i_budget_us) {
+    printf("FAIL: worst-case loop() %.1f us (excluding FastLED.show()) exceeds the %lu us budget\n", f_worst_us, i_budget_us);
+    return 2;
+  }
+
+  printf("PASS: worst-case loop() %.1f us (excluding FastLED.show()) within the %lu us budget\n", f_worst_us, i_budget_us);
+
+  return 0;
+}
@@ -683,7 +683,7 @@ void checkWandAction() {
 
                   wandSerialSend(W_VIBRATION_ENABLED);
 
-                  ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+                  startMenuVibration(250); // Confirmation buzz for 250ms.
                 break;
                 case VIBRATION_ALWAYS:
                   VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
@@ -699,7 +699,7 @@ void checkWandAction() {
 
                   wandSerialSend(W_VIBRATION_FIRING_ENABLED);
 
-                  ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+                  startMenuVibration(250); // Confirmation buzz for 250ms.
                 break;
                 case VIBRATION_FIRING_ONLY:
                   VIBRATION_MODE_EEPROM = VIBRATION_NONE;
@@ -727,7 +727,7 @@ void checkWandAction() {
 
                   wandSerialSend(W_VIBRATION_DEFAULT);
 
-                  ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+                  startMenuVibration(250); // Confirmation buzz for 250ms.
                 break;
               }
             }
@@ -1345,7 +1345,7 @@ void checkWandAction() {
 
                   wandSerialSend(W_VIBRATION_FIRING_ENABLED);
 
-                  ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+                  startMenuVibration(250); // Confirmation buzz for 250ms.
                 break;
                 case VIBRATION_FIRING_ONLY:
                 default:
@@ -1371,7 +1371,7 @@ void checkWandAction() {
 
                   wandSerialSend(W_VIBRATION_ENABLED);
 
-                  ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+                  startMenuVibration(250); // Confirmation buzz for 250ms.
                 break;
               }
             }
@@ -45,6 +45,7 @@ uint16_t i_current_music_track = 0;
 const uint16_t i_music_track_start = 500; // Music tracks start on file named 500_ and higher.
 const int8_t i_volume_abs_min = -70; // System (absolute) minimum volume possible.
 int8_t i_volume_abs_max = 0; // System (absolute) maximum volume possible. 0 dB for WAV Trigger, +12 dB for GPStar Audio.
+const int8_t i_gpstar_volume_abs_max = 12; // GPStar Audio can achieve higher amplification than the WAV Trigger.
 const int8_t i_track_volume_abs_max = 0; // Maximum gain for effects/music is 0 dB (unity gain).
 bool b_playing_music = false;
 bool b_music_paused = false;
@@ -67,16 +68,52 @@ uint8_t i_volume_master_percentage = STARTUP_VOLUME; // Master overall volume
 uint8_t i_volume_effects_percentage = STARTUP_VOLUME_EFFECTS; // Sound effects
 uint8_t i_volume_music_percentage = STARTUP_VOLUME_MUSIC; // Music volume
 
+/*
+ * Volume Gain Tables
+ * The gain in dB for each volume percentage from 0 to 100, going from the given floor at 0% up to the given ceiling.
+ * One table is kept for each floor and ceiling in use, built when compiling.
+ */
+constexpr int8_t volumePercentageGain(int8_t i_floor, int8_t i_ceiling, uint8_t i_percentage) {
+  return i_floor - ((i_floor - i_ceiling) * i_percentage / 100);
+}
+
+// The numbers 0 to N - 1 as a template parameter list, used to fill each table.
+template<uint8_t... I> struct IndexList {};
+template<uint8_t N, uint8_t... I> struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+template<uint8_t... I> struct MakeIndexList<0, I...> { typedef IndexList<I...> type; };
+
+template<int8_t FLOOR, int8_t CEILING, typename PERCENTAGES = typename MakeIndexList<101>::type> struct VolumeGains;
+
+template<int8_t FLOOR, int8_t CEILING, uint8_t... I> struct VolumeGains<FLOOR, CEILING, IndexList<I...>> {
+  static const int8_t table[101];
+};
+
+template<int8_t FLOOR, int8_t CEILING, uint8_t... I> const int8_t VolumeGains<FLOOR, CEILING, IndexList<I...>>::table[101] PROGMEM = { volumePercentageGain(FLOOR, CEILING, I)... };
+
+// Gain for an effects or music volume percentage.
+int8_t volumeGain(uint8_t i_percentage) {
+  return (int8_t) pgm_read_byte(&(VolumeGains<i_volume_abs_min, i_track_volume_abs_max>::table[i_percentage]));
+}
+
+// Gain for a master volume percentage, whose ceiling depends on the audio board.
+int8_t masterVolumeGain(uint8_t i_percentage) {
+  if(i_volume_abs_max == i_gpstar_volume_abs_max) {
+    return (int8_t) pgm_read_byte(&(VolumeGains<MINIMUM_VOLUME, i_gpstar_volume_abs_max>::table[i_percentage]));
+  }
+
+  return (int8_t) pgm_read_byte(&(VolumeGains<MINIMUM_VOLUME, 0>::table[i_percentage]));
+}
+
 /*
  * General Volume
  * Master Volume: MINIMUM_VOLUME = Quietest, i_volume_abs_max = Loudest
  * Effects/Music: i_volume_abs_min = Quietest, i_track_volume_abs_max = Loudest
  */
-int8_t i_volume_master = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100); // Master overall volume
+int8_t i_volume_master = volumePercentageGain(MINIMUM_VOLUME, 0, i_volume_master_percentage); // Master overall volume
 int8_t i_volume_master_eeprom = i_volume_master; // Master overall volume that is saved into the eeprom menu and loaded during bootup in standalone mode
 int8_t i_volume_revert = i_volume_master; // Used to restore volume level from a muted state.
-int8_t i_volume_effects = i_volume_abs_min - (i_volume_abs_min * i_volume_effects_percentage / 100); // Sound effects
-int8_t i_volume_music = i_volume_abs_min - (i_volume_abs_min * i_volume_music_percentage / 100); // Music volume
+int8_t i_volume_effects = volumePercentageGain(i_volume_abs_min, i_track_volume_abs_max, i_volume_effects_percentage); // Sound effects
+int8_t i_volume_music = volumePercentageGain(i_volume_abs_min, i_track_volume_abs_max, i_volume_music_percentage); // Music volume
 
 /*
  * Function Prototypes
@@ -85,6 +122,257 @@ void playEffect(uint16_t i_track_id, bool b_track_loop = false, int8_t i_track_v
 void stopEffect(uint16_t i_track_id);
 void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume = i_volume_effects, bool b_fade = false, uint16_t i_fade_time = 0);
 void updateMasterVolume(bool startup = false);
+bool crossfadeHasTrack(uint16_t i_track);
+void updateCrossfadeGains(uint8_t i_bus);
+
+#include "AudioQueue.h"
+
+/*
+ * Sound effect activity.
+ *
+ * Many stopEffect() calls are made just in case, for effects which are almost never playing. Each effect track has a
+ * bit here which is set when it is played and cleared when it is stopped, and a stop for a track whose bit is clear
+ * is not sent, as the board has nothing to stop. A track which has finished by itself keeps its bit until it is next
+ * stopped, as the effect lengths are not known here and the board's track reports arrive some time after a play, so
+ * one stop is still sent for it. Music tracks are not kept here and are always assumed to be playing.
+ */
+uint8_t audioTracksActive[i_last_effects_track / 8 + 1];
+uint32_t i_audio_stops_skipped = 0; // Stop commands not sent because the track was idle.
+
+// Whether the track may still be playing.
+bool audioTrackActive(uint16_t i_track) {
+  if(i_track > i_last_effects_track) {
+    return true;
+  }
+
+  return audioTracksActive[i_track / 8] & (1 << (i_track % 8));
+}
+
+void setAudioTrackActive(uint16_t i_track, bool b_active) {
+  if(i_track > i_last_effects_track) {
+    return;
+  }
+
+  if(b_active) {
+    audioTracksActive[i_track / 8] |= 1 << (i_track % 8);
+  }
+  else {
+    audioTracksActive[i_track / 8] &= ~(1 << (i_track % 8));
+  }
+}
+
+void audioTrackPlay(uint16_t i_track, bool b_lock) {
+  setAudioTrackActive(i_track, true);
+  queueAudioCommand(b_lock ? AUDIO_PLAY_LOCKED : AUDIO_PLAY, i_track);
+}
+
+void audioTrackStop(uint16_t i_track) {
+  if(!audioTrackActive(i_track)) {
+    i_audio_stops_skipped++;
+    return;
+  }
+
+  setAudioTrackActive(i_track, false);
+  queueAudioCommand(AUDIO_STOP, i_track);
+}
+
+void audioTrackGain(uint16_t i_track, int8_t i_gain) {
+  queueAudioCommand(AUDIO_GAIN, i_track, i_gain);
+}
+
+void audioTrackFade(uint16_t i_track, int8_t i_gain, uint16_t i_time) {
+  queueAudioCommand(AUDIO_FADE, i_track, i_gain, i_time);
+}
+
+void audioTrackLoop(uint16_t i_track, bool b_loop) {
+  queueAudioCommand(AUDIO_LOOP, i_track, b_loop);
+}
+
+void audioTrackPause(uint16_t i_track) {
+  queueAudioCommand(AUDIO_PAUSE, i_track);
+}
+
+void audioTrackResume(uint16_t i_track) {
+  queueAudioCommand(AUDIO_RESUME, i_track);
+}
+
+/*
+ * Volume buses.
+ *
+ * Each volume control sets the level of a bus: the master bus is the audio board's own master gain, the music bus
+ * the gain of the music track, and the effects bus the gain of sound effects. Voice lines (see voiceTracks) are on
+ * the voice bus, which follows the effects volume as there is no separate voice control.
+ *
+ * Sound effects which may go on long enough for a volume change to be heard are listed in busTracks with their bus.
+ * Whenever one is played or has its gain adjusted, how far that gain is from its bus level is kept. When a bus level
+ * changes, only the tracks listed for that bus which may still be playing (see audioTrackActive()) are sent a new
+ * gain, being the new bus level with the same offset as before. Only one voice line plays at a time, so the voice
+ * bus keeps just the last one played along with its offset.
+ */
+enum AUDIO_BUSES : uint8_t { BUS_MASTER, BUS_EFFECTS, BUS_MUSIC, BUS_VOICE };
+
+struct TrackRange {
+  uint16_t i_first;
+  uint16_t i_last;
+};
+
+const struct TrackRange voiceTracks[] PROGMEM = {
+  { S_VOICE_1984, S_VOICE_AFTERLIFE },
+  { S_VOICE_CROSS_THE_STREAMS_MIX, S_VOICE_NEUTRONA_WAND_VIBRATION_FIRING_DISABLED },
+  { S_VOICE_VIDEO_GAME_COLOURS_DISABLED, S_VOICE_VIDEO_GAME_COLOURS_CYCLOTRON_ENABLED },
+  { S_VOICE_POWERCELL_BRIGHTNESS, S_VOICE_PROTON_MIX_EFFECTS_DISABLED },
+  { S_VOICE_POWERCELL_15, S_VOICE_EEPROM_SAVE },
+  { S_VOICE_NEUTRONA_WAND_SOUNDS_ENABLED, S_VOICE_SPECTRAL_MODES_DISABLED },
+  { S_VOICE_QUICK_VENT_ENABLED, S_VOICE_BOOTUP_ERRORS_DISABLED },
+  { S_VOICE_NEUTRONA_WAND_1984, S_VOICE_NEUTRONA_WAND_BEEPING_ENABLED },
+  { S_VOICE_NEUTRONA_WAND_VIBRATION_DEFAULT, S_VOICE_PROTON_PACK_VIBRATION_DEFAULT },
+  { S_VOICE_CYCLOTRON_36, S_VOICE_NEUTRONA_WAND_SPEAKER_AMP_DISABLED },
+  { S_VOICE_EEPROM_LOADING_FAILED_RESET, S_VOICE_EEPROM_LOADING_FAILED_RESET },
+  { S_VOICE_INNER_CYCLOTRON_LED_PANEL_DISABLED, S_VOICE_INNER_CYCLOTRON_PANEL_BRIGHTNESS },
+  { S_VOICE_INNER_CYCLOTRON_36, S_VOICE_INNER_CYCLOTRON_26 },
+  { S_VOICE_INNER_CYCLOTRON_LED_PANEL_STATIC_COLORS, S_VOICE_INNER_CYCLOTRON_LED_PANEL_DYNAMIC_COLORS },
+  { S_VOICE_POWERCELL_NOT_INVERTED, S_VOICE_POWERCELL_INVERTED },
+  { S_VOICE_MOTORIZED_CYCLOTRON_ENABLED, S_VOICE_MOTORIZED_CYCLOTRON_ENABLED },
+  { S_VOICE_BARGRAPH_28_SEGMENTS, S_VOICE_CYCLOTRON_FADING_ENABLED }
+};
+
+const uint8_t VOICE_TRACK_RANGES = sizeof(voiceTracks) / sizeof(voiceTracks[0]);
+
+bool isVoiceTrack(uint16_t i_track) {
+  for(uint8_t i = 0; i < VOICE_TRACK_RANGES; i++) {
+    if(i_track >= pgm_read_word(&voiceTracks[i].i_first) && i_track <= pgm_read_word(&voiceTracks[i].i_last)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+struct BusTrack {
+  uint16_t i_track;
+  uint8_t i_bus;
+};
+
+const struct BusTrack busTracks[] PROGMEM = {
+  { S_BEEP_8, BUS_EFFECTS },
+  { S_PACK_BEEPS_OVERHEAT, BUS_EFFECTS },
+  { S_SMASH_ERROR_LOOP, BUS_EFFECTS },
+  { S_IDLE_LOOP_GUN_1, BUS_EFFECTS },
+  { S_IDLE_LOOP_GUN_2, BUS_EFFECTS },
+  { S_IDLE_LOOP_GUN_3, BUS_EFFECTS },
+  { S_IDLE_LOOP_GUN_4, BUS_EFFECTS },
+  { S_IDLE_LOOP_GUN_5, BUS_EFFECTS },
+  { S_WAND_SLIME_IDLE_LOOP, BUS_EFFECTS },
+  { S_WAND_STASIS_IDLE_LOOP, BUS_EFFECTS },
+  { S_MESON_IDLE_LOOP, BUS_EFFECTS },
+  { S_GB1_1984_FIRE_LOOP_GUN, BUS_EFFECTS },
+  { S_GB1_1984_FIRE_HIGH_POWER_LOOP, BUS_EFFECTS },
+  { S_GB2_FIRE_LOOP, BUS_EFFECTS },
+  { S_FIRING_LOOP_GB1, BUS_EFFECTS },
+  { S_GB1_FIRE_HIGH_POWER_LOOP, BUS_EFFECTS },
+  { S_SLIME_LOOP, BUS_EFFECTS },
+  { S_STASIS_LOOP, BUS_EFFECTS },
+  { S_AFTERLIFE_WAND_IDLE_1, BUS_EFFECTS },
+  { S_AFTERLIFE_WAND_IDLE_2, BUS_EFFECTS },
+  { S_AFTERLIFE_WAND_RAMP_1, BUS_EFFECTS },
+  { S_AFTERLIFE_WAND_RAMP_2, BUS_EFFECTS },
+  { S_AFTERLIFE_WAND_RAMP_2_FADE_IN, BUS_EFFECTS },
+  { S_AFTERLIFE_WAND_RAMP_DOWN_1, BUS_EFFECTS },
+  { S_AFTERLIFE_WAND_RAMP_DOWN_2, BUS_EFFECTS },
+  { S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT, BUS_EFFECTS },
+  { S_AFTERLIFE_BEEP_WAND_S1, BUS_EFFECTS },
+  { S_AFTERLIFE_BEEP_WAND_S2, BUS_EFFECTS },
+  { S_AFTERLIFE_BEEP_WAND_S3, BUS_EFFECTS },
+  { S_AFTERLIFE_BEEP_WAND_S4, BUS_EFFECTS },
+  { S_AFTERLIFE_BEEP_WAND_S5, BUS_EFFECTS }
+};
+
+const uint8_t BUS_TRACK_COUNT = sizeof(busTracks) / sizeof(busTracks[0]);
+int8_t busTrackOffsets[BUS_TRACK_COUNT]; // Gain of each listed track relative to its bus, as last played or adjusted.
+uint16_t i_bus_voice_track = 0; // The voice line last played.
+int8_t i_bus_voice_offset = 0; // Gain of that voice line relative to the voice bus.
+
+// The current level of a bus in dB.
+int8_t busGain(uint8_t i_bus) {
+  switch(i_bus) {
+    case BUS_MASTER:
+      return i_volume_master;
+    break;
+
+    case BUS_MUSIC:
+      return i_volume_music;
+    break;
+
+    case BUS_VOICE:
+    case BUS_EFFECTS:
+    default:
+      return i_volume_effects;
+    break;
+  }
+}
+
+// Where the track is in busTracks, or BUS_TRACK_COUNT if it is not listed.
+uint8_t busTrackIndex(uint16_t i_track) {
+  for(uint8_t i = 0; i < BUS_TRACK_COUNT; i++) {
+    if(pgm_read_word(&busTracks[i].i_track) == i_track) {
+      return i;
+    }
+  }
+
+  return BUS_TRACK_COUNT;
+}
+
+// Notes the gain a listed track or voice line has been given, relative to its bus.
+void setBusTrackGain(uint16_t i_track, int8_t i_gain) {
+  uint8_t i_index = busTrackIndex(i_track);
+
+  if(i_index < BUS_TRACK_COUNT) {
+    busTrackOffsets[i_index] = i_gain - busGain(pgm_read_byte(&busTracks[i_index].i_bus));
+  }
+  else if(isVoiceTrack(i_track)) {
+    i_bus_voice_track = i_track;
+    i_bus_voice_offset = i_gain - busGain(BUS_VOICE);
+  }
+}
+
+// Sends a track its gain on a bus, kept within what a track may be given.
+void sendBusTrackGain(uint16_t i_track, int16_t i_gain) {
+  if(i_gain < i_volume_abs_min) {
+    i_gain = i_volume_abs_min;
+  }
+
+  if(i_gain > i_track_volume_abs_max) {
+    i_gain = i_track_volume_abs_max;
+  }
+
+  audioTrackGain(i_track, i_gain);
+}
+
+// Sends the new gain of each track on the bus which may still be playing.
+void updateBusTracks(uint8_t i_bus) {
+  int8_t i_bus_gain = busGain(i_bus);
+
+  if(i_bus == BUS_VOICE) {
+    if(i_bus_voice_track > 0 && audioTrackActive(i_bus_voice_track)) {
+      sendBusTrackGain(i_bus_voice_track, i_bus_gain + i_bus_voice_offset);
+    }
+
+    return;
+  }
+
+  for(uint8_t i = 0; i < BUS_TRACK_COUNT; i++) {
+    uint16_t i_track = pgm_read_word(&busTracks[i].i_track);
+
+    if(pgm_read_byte(&busTracks[i].i_bus) == i_bus && audioTrackActive(i_track) && !crossfadeHasTrack(i_track)) {
+      sendBusTrackGain(i_track, i_bus_gain + busTrackOffsets[i]);
+    }
+  }
+
+  // Tracks in a crossfade take the gains for how far it has got instead.
+  updateCrossfadeGains(i_bus);
+}
+
+#include "AudioFades.h"
 
 /*
  * Audio playback functions.
@@ -92,6 +380,9 @@ void updateMasterVolume(bool startup = false);
 
 // Play a sound effect using certain defaults.
 void playEffect(uint16_t i_track_id, bool b_track_loop, int8_t i_track_volume, bool b_fade_in, uint16_t i_fade_time, bool b_lock) {
+  setBusTrackGain(i_track_id, i_track_volume);
+  duckMusicForVoice(i_track_id);
+
   if(i_track_volume < i_volume_abs_min) {
     i_track_volume = i_volume_abs_min;
   }
@@ -104,20 +395,20 @@ void playEffect(uint16_t i_track_id, bool b_track_loop, int8_t i_track_volume, b
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(b_fade_in) {
-        audio.trackGain(i_track_id, i_volume_abs_min);
-        audio.trackPlayPoly(i_track_id, b_lock);
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackGain(i_track_id, i_volume_abs_min);
+        audioTrackPlay(i_track_id, b_lock);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
-        audio.trackPlayPoly(i_track_id, b_lock);
+        audioTrackGain(i_track_id, i_track_volume);
+        audioTrackPlay(i_track_id, b_lock);
       }
 
       if(b_track_loop) {
-        audio.trackLoop(i_track_id, 1);
+        audioTrackLoop(i_track_id, true);
       }
       else {
-        audio.trackLoop(i_track_id, 0);
+        audioTrackLoop(i_track_id, false);
       }
     break;
 
@@ -129,10 +420,12 @@ void playEffect(uint16_t i_track_id, bool b_track_loop, int8_t i_track_volume, b
 }
 
 void stopEffect(uint16_t i_track_id) {
+  cancelCrossfade(i_track_id);
+
   switch(AUDIO_DEVICE) {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
-      audio.trackStop(i_track_id);
+      audioTrackStop(i_track_id);
     break;
 
     case A_NONE:
@@ -154,14 +447,14 @@ void playMusic() {
         if(b_gpstar_benchtest) {
           // Loop the music track.
           if(b_repeat_track) {
-            audio.trackLoop(i_current_music_track, 1);
+            audioTrackLoop(i_current_music_track, 1);
           }
           else {
-            audio.trackLoop(i_current_music_track, 0);
+            audioTrackLoop(i_current_music_track, 0);
           }
 
-          audio.trackGain(i_current_music_track, i_volume_music);
-          audio.trackPlayPoly(i_current_music_track, true);
+          audioTrackGain(i_current_music_track, musicGain());
+          audioTrackPlay(i_current_music_track, true);
           audio.update();
 
           audio.resetTrackCounter();
@@ -187,7 +480,7 @@ void stopMusic() {
     case A_GPSTAR_AUDIO:
       if(b_gpstar_benchtest) {
         if(i_music_count > 0 && i_current_music_track >= i_music_track_start) {
-          audio.trackStop(i_current_music_track);
+          audioTrackStop(i_current_music_track);
         }
 
         audio.update();
@@ -214,7 +507,7 @@ void pauseMusic() {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
         if(b_gpstar_benchtest) {
-          audio.trackPause(i_current_music_track);
+          audioTrackPause(i_current_music_track);
           audio.update();
         }
       break;
@@ -240,7 +533,7 @@ void resumeMusic() {
       case A_GPSTAR_AUDIO:
         if(b_gpstar_benchtest) {
           audio.resetTrackCounter();
-          audio.trackResume(i_current_music_track);
+          audioTrackResume(i_current_music_track);
           audio.update();
         }
       break;
@@ -313,6 +606,8 @@ void musicPrevTrack() {
 
 // Adjust the gain of a single track.
 void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume, bool b_fade, uint16_t i_fade_time) {
+  setBusTrackGain(i_track_id, i_track_volume);
+
   if(i_track_volume < i_volume_abs_min) {
     i_track_volume = i_volume_abs_min;
   }
@@ -325,10 +620,10 @@ void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume, bool b_fade, u
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(b_fade) {
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
+        audioTrackGain(i_track_id, i_track_volume);
       }
     break;
 
@@ -374,7 +669,7 @@ void increaseVolumeEEPROM() {
       i_volume_master_percentage += VOLUME_MULTIPLIER;
     }
 
-    i_volume_master_eeprom = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100);
+    i_volume_master_eeprom = masterVolumeGain(i_volume_master_percentage);
     i_volume_master = i_volume_master_eeprom;
     i_volume_revert = i_volume_master_eeprom;
 
@@ -394,7 +689,7 @@ void decreaseVolumeEEPROM() {
       i_volume_master_percentage -= VOLUME_MULTIPLIER;
     }
 
-    i_volume_master_eeprom = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100);
+    i_volume_master_eeprom = masterVolumeGain(i_volume_master_percentage);
     i_volume_master = i_volume_master_eeprom;
     i_volume_revert = i_volume_master_eeprom;
 
@@ -414,7 +709,7 @@ void increaseVolume() {
       i_volume_master_percentage += VOLUME_MULTIPLIER;
     }
 
-    i_volume_master = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100);
+    i_volume_master = masterVolumeGain(i_volume_master_percentage);
     i_volume_revert = i_volume_master;
 
     updateMasterVolume();
@@ -433,7 +728,7 @@ void decreaseVolume() {
       i_volume_master_percentage -= VOLUME_MULTIPLIER;
     }
 
-    i_volume_master = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100);
+    i_volume_master = masterVolumeGain(i_volume_master_percentage);
     i_volume_revert = i_volume_master;
 
     updateMasterVolume();
@@ -444,63 +739,9 @@ void updateEffectsVolume() {
   switch(AUDIO_DEVICE) {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
-      // Only continuous effects really need to be adjusted on the fly.
-      audio.trackGain(S_BEEP_8, i_volume_effects);
-      audio.trackGain(S_PACK_BEEPS_OVERHEAT, i_volume_effects);
-      audio.trackGain(S_SMASH_ERROR_LOOP, i_volume_effects);
-
-      audio.trackGain(S_IDLE_LOOP_GUN_1, i_volume_effects);
-      audio.trackGain(S_IDLE_LOOP_GUN_2, i_volume_effects);
-      audio.trackGain(S_IDLE_LOOP_GUN_3, i_volume_effects);
-      audio.trackGain(S_IDLE_LOOP_GUN_4, i_volume_effects);
-      audio.trackGain(S_IDLE_LOOP_GUN_5, i_volume_effects);
-
-      // Standalone wand has additional idle effects.
-      if(b_gpstar_benchtest) {
-        audio.trackGain(S_WAND_SLIME_IDLE_LOOP, i_volume_effects);
-        audio.trackGain(S_WAND_STASIS_IDLE_LOOP, i_volume_effects);
-        audio.trackGain(S_MESON_IDLE_LOOP, i_volume_effects);
-      }
-
-      if(b_firing) {
-        switch(STREAM_MODE) {
-          case PROTON:
-          default:
-            audio.trackGain(S_GB1_1984_FIRE_LOOP_GUN, i_volume_effects);
-            audio.trackGain(S_GB1_1984_FIRE_HIGH_POWER_LOOP, i_volume_effects);
-            audio.trackGain(S_GB2_FIRE_LOOP, i_volume_effects);
-            audio.trackGain(S_FIRING_LOOP_GB1, i_volume_effects);
-            audio.trackGain(S_GB1_FIRE_HIGH_POWER_LOOP, i_volume_effects);
-          break;
-
-          case SLIME:
-            audio.trackGain(S_SLIME_LOOP, i_volume_effects);
-          break;
-
-          case STASIS:
-            audio.trackGain(S_STASIS_LOOP, i_volume_effects);
-          break;
-
-          case MESON:
-            // Do nothing.
-          break;
-        }
-      }
-
-      // Special volume in use.
-      audio.trackGain(S_AFTERLIFE_WAND_IDLE_1, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_WAND_IDLE_2, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_WAND_RAMP_1, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_WAND_RAMP_2, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_WAND_RAMP_2_FADE_IN, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_WAND_RAMP_DOWN_1, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_WAND_RAMP_DOWN_2, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_BEEP_WAND_S1, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_BEEP_WAND_S2, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_BEEP_WAND_S3, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_BEEP_WAND_S4, i_volume_effects);
-      audio.trackGain(S_AFTERLIFE_BEEP_WAND_S5, i_volume_effects);
+      // The voice bus follows the effects bus.
+      updateBusTracks(BUS_EFFECTS);
+      updateBusTracks(BUS_VOICE);
     break;
 
     case A_NONE:
@@ -522,7 +763,7 @@ void increaseVolumeEffects() {
     i_volume_effects_percentage += VOLUME_EFFECTS_MULTIPLIER;
   }
 
-  i_volume_effects = i_volume_abs_min - (i_volume_abs_min * i_volume_effects_percentage / 100);
+  i_volume_effects = volumeGain(i_volume_effects_percentage);
 
   updateEffectsVolume();
 }
@@ -539,7 +780,7 @@ void decreaseVolumeEffects() {
     i_volume_effects_percentage -= VOLUME_EFFECTS_MULTIPLIER;
   }
 
-  i_volume_effects = i_volume_abs_min - (i_volume_abs_min * i_volume_effects_percentage / 100);
+  i_volume_effects = volumeGain(i_volume_effects_percentage);
 
   updateEffectsVolume();
 }
@@ -550,7 +791,7 @@ void updateMusicVolume() {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
         if(b_gpstar_benchtest) {
-          audio.trackGain(i_current_music_track, i_volume_music);
+          audioTrackGain(i_current_music_track, musicGain());
         }
       break;
 
@@ -574,7 +815,7 @@ void increaseVolumeMusic() {
     i_volume_music_percentage += VOLUME_MUSIC_MULTIPLIER;
   }
 
-  i_volume_music = i_volume_abs_min - (i_volume_abs_min * i_volume_music_percentage / 100);
+  i_volume_music = volumeGain(i_volume_music_percentage);
 
   updateMusicVolume();
 }
@@ -591,7 +832,7 @@ void decreaseVolumeMusic() {
     i_volume_music_percentage -= VOLUME_MUSIC_MULTIPLIER;
   }
 
-  i_volume_music = i_volume_abs_min - (i_volume_abs_min * i_volume_music_percentage / 100);
+  i_volume_music = volumeGain(i_volume_music_percentage);
 
   updateMusicVolume();
 }
@@ -718,14 +959,14 @@ void toggleMusicLoop() {
         b_repeat_track = true;
 
         if(i_music_count > 0) {
-          audio.trackLoop(i_current_music_track, 1);
+          audioTrackLoop(i_current_music_track, 1);
         }
       }
       else {
         b_repeat_track = false;
 
         if(i_music_count > 0) {
-          audio.trackLoop(i_current_music_track, 0);
+          audioTrackLoop(i_current_music_track, 0);
         }
       }
     break;
@@ -764,6 +1005,7 @@ bool setupAudioDevice() {
 
   // Stop all tracks.
   audio.stopAllTracks();
+  memset(audioTracksActive, 0, sizeof(audioTracksActive));
 
   // Reset the sample rate offset. Only for the WAV Trigger.
   audio.samplerateOffset(0);
@@ -802,7 +1044,7 @@ bool setupAudioDevice() {
 
   if(audio.gpstarAudioHello()) {
     AUDIO_DEVICE = A_GPSTAR_AUDIO;
-    i_volume_abs_max = 12; // GPStar Audio can achieve higher amplification than the WAV Trigger.
+    i_volume_abs_max = i_gpstar_volume_abs_max;
 
     debugln(F("Using GPStar Audio"));
 
@@ -824,6 +1066,7 @@ void updateAudio() {
   switch(AUDIO_DEVICE) {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
+      flushAudioQueue();
       audio.update();
     break;
 
@@ -0,0 +1,187 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Outbound audio command queue.
+ *
+ * Audio commands are held here during a loop pass rather than written to the audio board straight away, and
+ * updateAudio() sends them at the start of the next pass. While a command waits, a later one for the same track can
+ * take its place: a new gain or fade replaces one still waiting, a loop flag already waiting is not added again, and a
+ * stop replaces everything waiting for the track except its gain. Commands for different tracks are never merged and
+ * keep their order. Each pass sends at most i_audio_queue_bytes bytes (always at least one command), so a burst of
+ * effects is spread over a few passes instead of holding up the loop while the serial buffer drains.
+ *
+ * Music tracks go through the queue as well, so a music gain or fade never overtakes a play or stop for the same
+ * track. A pause or resume is kept in order like a play.
+ */
+enum AUDIO_COMMANDS : uint8_t { AUDIO_PLAY, AUDIO_PLAY_LOCKED, AUDIO_STOP, AUDIO_GAIN, AUDIO_FADE, AUDIO_LOOP, AUDIO_PAUSE, AUDIO_RESUME };
+
+struct AudioCommand {
+  uint16_t i_track;
+  uint16_t i_time; // Length of a fade.
+  int8_t i_value; // Gain, or the loop flag.
+  uint8_t i_type;
+};
+
+const uint8_t AUDIO_QUEUE_SIZE = 24;
+const uint8_t i_audio_queue_bytes = 32; // Bytes sent per loop pass, half the serial transmit buffer.
+
+struct AudioCommand audioQueue[AUDIO_QUEUE_SIZE];
+uint8_t i_audio_queue_count = 0;
+
+// Length on the wire of each command, as framed by the WAV Trigger and GPStar Audio serial protocol.
+uint8_t audioCommandBytes(uint8_t i_type) {
+  switch(i_type) {
+    case AUDIO_PLAY_LOCKED:
+    case AUDIO_GAIN:
+      return 9;
+    break;
+
+    case AUDIO_FADE:
+      return 12;
+    break;
+
+    case AUDIO_PLAY:
+    case AUDIO_STOP:
+    case AUDIO_LOOP:
+    case AUDIO_PAUSE:
+    case AUDIO_RESUME:
+    default:
+      return 8;
+    break;
+  }
+}
+
+void sendAudioCommand(const struct AudioCommand &command) {
+  switch(command.i_type) {
+    case AUDIO_PLAY:
+    case AUDIO_PLAY_LOCKED:
+      audio.trackPlayPoly(command.i_track, command.i_type == AUDIO_PLAY_LOCKED);
+    break;
+
+    case AUDIO_STOP:
+      audio.trackStop(command.i_track);
+    break;
+
+    case AUDIO_GAIN:
+      audio.trackGain(command.i_track, command.i_value);
+    break;
+
+    case AUDIO_FADE:
+      audio.trackFade(command.i_track, command.i_value, command.i_time, 0);
+    break;
+
+    case AUDIO_LOOP:
+      audio.trackLoop(command.i_track, command.i_value);
+    break;
+
+    case AUDIO_PAUSE:
+      audio.trackPause(command.i_track);
+    break;
+
+    case AUDIO_RESUME:
+      audio.trackResume(command.i_track);
+    break;
+  }
+}
+
+void removeAudioCommands(uint8_t i_index, uint8_t i_count) {
+  i_audio_queue_count -= i_count;
+
+  for(uint8_t i = i_index; i < i_audio_queue_count; i++) {
+    audioQueue[i] = audioQueue[i + i_count];
+  }
+}
+
+// Sends the waiting commands in order, up to the byte budget for one loop pass.
+void flushAudioQueue(uint8_t i_bytes = i_audio_queue_bytes) {
+  uint8_t i_sent = 0;
+  uint16_t i_used = 0;
+
+  while(i_sent < i_audio_queue_count) {
+    i_used += audioCommandBytes(audioQueue[i_sent].i_type);
+
+    if(i_sent > 0 && i_used > i_bytes) {
+      break;
+    }
+
+    sendAudioCommand(audioQueue[i_sent]);
+    i_sent++;
+  }
+
+  removeAudioCommands(0, i_sent);
+}
+
+// Whether a command changes what the track is doing, so nothing for the same track may move past it.
+bool audioCommandIsControl(uint8_t i_type) {
+  return i_type == AUDIO_PLAY || i_type == AUDIO_PLAY_LOCKED || i_type == AUDIO_STOP || i_type == AUDIO_PAUSE || i_type == AUDIO_RESUME;
+}
+
+// Whether two commands for the same track have the same effect in either order, which is so for a loop flag and a gain or fade.
+bool audioCommandsCommute(uint8_t i_first, uint8_t i_second) {
+  return (i_first == AUDIO_LOOP) != (i_second == AUDIO_LOOP);
+}
+
+void queueAudioCommand(uint8_t i_type, uint16_t i_track, int8_t i_value = 0, uint16_t i_time = 0) {
+  for(uint8_t i = i_audio_queue_count; i > 0; i--) {
+    struct AudioCommand &waiting = audioQueue[i - 1];
+
+    if(waiting.i_track != i_track) {
+      continue;
+    }
+
+    if(i_type == AUDIO_STOP) {
+      // Nothing else waiting for the track matters once it is stopped, apart from the gain its next play will use.
+      if(waiting.i_type != AUDIO_GAIN) {
+        removeAudioCommands(i - 1, 1);
+      }
+
+      continue;
+    }
+
+    if(audioCommandIsControl(i_type) || audioCommandIsControl(waiting.i_type)) {
+      break;
+    }
+
+    if(waiting.i_type == i_type) {
+      // A loop flag which matches the one waiting is dropped, and a new gain or fade takes the place of the old one.
+      waiting.i_value = i_value;
+      waiting.i_time = i_time;
+      return;
+    }
+
+    if(!audioCommandsCommute(i_type, waiting.i_type)) {
+      // The order of a gain and a fade for the same track matters, so neither can move past the other.
+      break;
+    }
+  }
+
+  if(i_audio_queue_count == AUDIO_QUEUE_SIZE) {
+    // Make room by sending the oldest command now.
+    flushAudioQueue(0);
+  }
+
+  audioQueue[i_audio_queue_count].i_track = i_track;
+  audioQueue[i_audio_queue_count].i_time = i_time;
+  audioQueue[i_audio_queue_count].i_value = i_value;
+  audioQueue[i_audio_queue_count].i_type = i_type;
+  i_audio_queue_count++;
+}
@@ -0,0 +1,57 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Loop stage markers for the simavr cycle benchmark (.github/benchmark.sh).
+ * When built with GPSTAR_BENCHMARK defined, entering a stage writes its ID to GPIOR0 and leaving
+ * it writes the ID to GPIOR1. These general purpose registers are unused by the firmware and a
+ * write costs a single cycle; the simulator records the cycle count at each write.
+ * In a normal build the markers compile to nothing.
+ *
+ * The stage IDs must be kept in sync with source/Benchmark/simavr_bench.c and across devices.
+ * Profiling with GPSTAR_PROFILING is only available on the Proton Pack.
+ */
+enum BENCHMARK_STAGES : uint8_t {
+  BENCH_NONE,
+  BENCH_LOOP,
+  BENCH_MAIN_LOOP,
+  BENCH_SERIAL,
+  BENCH_SWITCHES,
+  BENCH_CYCLOTRON,
+  BENCH_POWERCELL,
+  BENCH_LED_SHOW,
+  BENCH_AUDIO,
+  BENCH_POWER_METER,
+  BENCH_HANDSHAKE,
+  BENCH_SERIAL1,
+  BENCH_MUSIC,
+  BENCH_PACK_STATE,
+  BENCH_TIMERS,
+  BENCH_STAGE_COUNT
+};
+
+#ifdef GPSTAR_BENCHMARK
+  #define BENCHMARK_BEGIN(x) GPIOR0 = (x)
+  #define BENCHMARK_END(x) GPIOR1 = (x)
+#else
+  #define BENCHMARK_BEGIN(x)
+  #define BENCHMARK_END(x)
+#endif
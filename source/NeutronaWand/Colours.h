@@ -313,3 +313,27 @@ CRGB getHueColour(uint8_t i_colour, WAND_BARREL_LED_COUNTS NUM_LEDS_ENUM, uint8_
     break;
   }
 }
+
+/*
+ * LED Frame Commit
+ *
+ * Sending the barrel LEDs holds interrupts off for about 30us per LED, long enough to lose bytes from the pack,
+ * so a frame is only sent when it differs from the one last sent.
+ */
+CRGB barrel_leds_sent[BARREL_LEDS_MAX]; // Colours as last sent.
+uint8_t i_led_brightness_sent = 0;
+bool b_led_frame_sent = false; // A frame has been sent since startup.
+
+// Replaces FastLED.show(), skipping frames which are unchanged.
+void commitLedFrame() {
+  uint8_t i_brightness = FastLED.getBrightness();
+
+  if(b_led_frame_sent && i_brightness == i_led_brightness_sent && memcmp(barrel_leds, barrel_leds_sent, sizeof(barrel_leds)) == 0) {
+    return;
+  }
+
+  FastLED.show();
+  memcpy(barrel_leds_sent, barrel_leds, sizeof(barrel_leds));
+  i_led_brightness_sent = i_brightness;
+  b_led_frame_sent = true;
+}
@@ -141,7 +141,11 @@ enum pack_messages : uint8_t {
   P_INNER_CYCLOTRON_PANEL_DYNAMIC,
   P_POWERCELL_NOT_INVERTED,
   P_POWERCELL_INVERTED,
-  P_POST_FINISH
+  P_POST_FINISH,
+  P_BAUD_RATE,
+  P_BAUD_RATE_CONFIRM,
+  P_RELIABLE,
+  P_REQUEST_LINK_STATS
 };
 
 enum wand_messages : uint8_t {
@@ -356,5 +360,9 @@ enum wand_messages : uint8_t {
   W_TOGGLE_CYCLOTRON_FADING,
   W_BARGRAPH_28_SEGMENTS,
   W_BARGRAPH_30_SEGMENTS,
-  W_COM_SOUND_NUMBER
+  W_COM_SOUND_NUMBER,
+  W_BAUD_RATE,
+  W_COMMAND_BATCH,
+  W_RELIABLE,
+  W_SEND_LINK_STATS
 };
\ No newline at end of file
@@ -165,7 +165,7 @@ enum WAND_BARREL_LED_COUNTS WAND_BARREL_LED_COUNT;
  */
 #define FAST_LED_UPDATE_MS 3
 uint8_t i_fast_led_delay = FAST_LED_UPDATE_MS;
-millisDelay ms_fast_led;
+bool b_fast_led_due = false; // Set by the timer scheduler when the barrel LEDs are due.
 
 /*
  * Time in milliseconds for blinking the top white LED while the wand is on.
@@ -205,7 +205,6 @@ enum VIBRATION_MODES VIBRATION_MODE;
 const uint8_t i_vibration_level_min = 65;
 uint8_t i_vibration_level = i_vibration_level_min;
 uint8_t i_vibration_level_prev = 0;
-millisDelay ms_menu_vibration; // Timer to do non-blocking confirmation buzzing in the vibration menu.
 
 /*
  * Enable or disable vibration control for the Neutrona Wand.
@@ -237,12 +236,11 @@ const uint8_t i_bargraph_5_led_normal[i_bargraph_segments_5_led] PROGMEM = {BARG
 bool b_bargraph_status_5[i_bargraph_segments_5_led] = {};
 
 /*
- * Afterlife/Frozen Empire wand idle ramp transition timers.
+ * Afterlife/Frozen Empire wand idle ramp transition times.
  */
-millisDelay ms_gun_loop_1; // Used when transitioning to S_AFTERLIFE_WAND_IDLE_1.
-millisDelay ms_gun_loop_2; // Used when transitioning to S_AFTERLIFE_WAND_IDLE_2.
 const uint16_t i_gun_loop_1 = 1768; // S_AFTERLIFE_WAND_RAMP_1 is 1768ms long.
 const uint16_t i_gun_loop_2 = 1881; // S_AFTERLIFE_WAND_RAMP_2 is 1881ms long.
+const uint16_t i_gun_loop_crossfade = 150; // Time taken to hand over from the end of a ramp to its idle loop.
 
 /*
  * Overheat timers
@@ -397,6 +395,51 @@ uint16_t i_last_firing_effect_mix = 0; // Used by standalone Neutrona Wand.
  */
 SerialTransfer wandComs;
 
+/*
+ * Serial Packet Draining
+ * Every complete packet waiting from the pack is handled in the same loop pass, up to a packet count and time limit.
+ * The counters record how deep the backlog has been.
+ */
+const uint8_t i_serial_drain_max_packets = 8; // Most packets handled in a single loop pass.
+const uint16_t i_serial_drain_budget_us = 1000; // Stop draining once this much time has been spent in a loop pass.
+
+struct SerialDrainStats {
+  uint8_t lastPackets; // Packets handled by the most recent pass which found any.
+  uint8_t maxPackets; // Most packets handled in a single pass.
+  uint16_t deferred; // Passes which reached a limit with more data still waiting.
+};
+
+struct SerialDrainStats packDrain;
+
+/*
+ * Pack Link Speed
+ * The link starts at the default rate so that a pack with older firmware can always connect.
+ * Once synchronized the pack may offer a faster rate. If the pack stops answering at that rate,
+ * the wand falls back to the default rate and synchronizes again.
+ */
+const unsigned long i_serial_baud_default = 9600;
+const unsigned long i_serial_baud_fast = 115200;
+const uint16_t i_baud_check_delay = 8000; // Time without hearing from the pack before falling back to the default rate.
+millisDelay ms_baud_check; // Timer for confirming that the pack is still answering at the faster rate.
+bool b_baud_fast = false; // The pack link is at the faster rate.
+bool b_baud_check_sent = false; // A handshake has been sent to prompt the pack for a confirmation.
+
+/*
+ * Reliable Pack Commands
+ * Once the pack says it supports them, commands for critical state changes are numbered and kept until the pack acknowledges them (see Reliable.h).
+ * The pack says so with P_RELIABLE, or by sending a numbered command should that be lost. Should the pack stop acknowledging, commands go back to being sent plainly.
+ */
+bool b_pack_reliable = false; // The pack supports reliable commands.
+
+/*
+ * Serial Link Telemetry
+ * Counters which show a link degrading before it drops out entirely (see LinkStats.h).
+ * The pack asks for them with P_REQUEST_LINK_STATS and passes them on to the Attenuator.
+ */
+struct LinkStats packLink; // Frames to and from the pack, as seen by the wand.
+unsigned long i_pack_link_last_frame = 0; // When the last frame arrived from the pack, or 0 while not connected.
+unsigned long i_pack_link_request_time = 0; // When a handshake was sent which the pack confirms, or 0 once answered.
+
 /*
  * Wand Connection State
  * Used to identify the state of the wand as it connects to a Proton Pack.
@@ -418,6 +461,7 @@ millisDelay ms_packsync; // Timer for attempting synchronization with a connecte
 millisDelay ms_handshake; // Timer for attempting a keepalive handshake with a connected pack.
 const uint16_t i_sync_initial_delay = 750; // Delay to re-try the initial handshake with a proton pack.
 const uint16_t i_heartbeat_delay = 3250; // Delay to send a heartbeat (handshake) to a connected proton pack.
+const uint16_t i_reliable_heartbeat_delay = 1000; // Heartbeat delay once the pack supports reliable commands, which no longer rely on resyncs to be put right.
 
 /*
  * Wand Menu
@@ -482,7 +526,10 @@ const uint16_t i_ms_power_indicator_blink = 1000;
 void wandSerialSend(uint8_t i_command, uint16_t i_value);
 void wandSerialSend(uint8_t i_command);
 void wandSerialSendData(uint8_t i_message);
+void wandSerialSendReliable(uint8_t i_command, uint16_t i_value);
+void wandSerialSendReliable(uint8_t i_command);
 void checkPack();
+void checkPackBaudRate();
 void checkWandAction();
 void ventSwitched(void* n = nullptr);
 void wandSwitched(void* n = nullptr);
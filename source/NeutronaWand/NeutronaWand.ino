@@ -61,15 +61,19 @@
 #include "Configuration.h"
 #include "MusicSounds.h"
 #include "Communication.h"
+#include "LinkStats.h"
 #include "Header.h"
 #include "Colours.h"
+#include "Scheduler.h"
+#include "Reliable.h"
 #include "Audio.h"
 #include "Preferences.h"
+#include "Benchmark.h"
 
 void setup() {
   Serial.begin(9600); // Standard serial (USB) console.
 
-  Serial1.begin(9600); // Communication to the Proton Pack.
+  Serial1.begin(i_serial_baud_default); // Communication to the Proton Pack.
   wandComs.begin(Serial1, false);
 
   // Setup the audio device for this controller.
@@ -186,11 +190,16 @@ void setup() {
   ms_slo_blo_blink.start(i_slo_blo_blink_delay);
 
   // Initialize the fastLED state update timer.
-  ms_fast_led.start(i_fast_led_delay);
+  scheduleTimer(fastLedDue, i_fast_led_delay);
 
   // Initialize the timer for initial handshake.
   ms_packsync.start(0);
 
+#ifdef GPSTAR_BENCHMARK
+  // Benchmark builds run standalone so that mainLoop() is reached without a Proton Pack.
+  b_gpstar_benchtest = true;
+#endif
+
   if(b_gpstar_benchtest) {
     WAND_CONN_STATE = NC_BENCHTEST;
 
@@ -211,6 +220,13 @@ void setup() {
 }
 
 void loop() {
+  BENCHMARK_BEGIN(BENCH_LOOP);
+
+  // Run anything left on the timer scheduler which is now due.
+  BENCHMARK_BEGIN(BENCH_TIMERS);
+  runScheduledTimers();
+  BENCHMARK_END(BENCH_TIMERS);
+
   switch(WAND_CONN_STATE) {
     case PACK_DISCONNECTED:
       // While waiting for a proton pack, issue a request for synchronization.
@@ -222,19 +238,32 @@ void loop() {
         digitalWriteFast(WAND_STATUS_LED_PIN, (digitalReadFast(WAND_STATUS_LED_PIN) == LOW) ? HIGH : LOW); // Blink the onboard LED on the Neutrona Wand board.
       }
 
+      BENCHMARK_BEGIN(BENCH_SERIAL);
       checkPack(); // Check for any response from the pack while still waiting.
+      BENCHMARK_END(BENCH_SERIAL);
+
+      flushAudioQueue(); // Send any sound effects started while waiting.
     break;
 
     case PACK_CONNECTED:
       // When connected to a pack, prepare to send a regular handshake to indicate presence.
       if(ms_handshake.justFinished()) {
+        if(b_baud_fast) {
+          // At the faster rate the pack confirms each handshake, which shows how quickly it answers.
+          i_pack_link_request_time = millis();
+        }
+
         wandSerialSend(W_HANDSHAKE); // Remind the pack that a wand is still present.
         ms_handshake.restart(); // Restart the handshake timer.
       }
 
       updateAudio(); // Update the state of the selected sound board.
 
+      BENCHMARK_BEGIN(BENCH_SERIAL);
       checkPack(); // Get the latest communications from the connected Proton Pack.
+      BENCHMARK_END(BENCH_SERIAL);
+
+      checkPackBaudRate(); // Make sure the pack is still answering if the link is at the faster rate.
 
       if(b_pack_post_finish) {
         mainLoop(); // Continue on to the main loop.
@@ -249,12 +278,20 @@ void loop() {
       mainLoop(); // Continue on to the main loop.
     break;
   }
+
+  BENCHMARK_END(BENCH_LOOP);
 }
 
 void mainLoop() {
+  BENCHMARK_BEGIN(BENCH_MAIN_LOOP);
+
   // Get the current state of any input devices (toggles, buttons, and switches).
   switchLoops();
+
+  BENCHMARK_BEGIN(BENCH_SWITCHES);
   checkSwitches();
+  BENCHMARK_END(BENCH_SWITCHES);
+
   checkRotaryEncoder();
   checkMenuVibration();
 
@@ -491,17 +528,6 @@ void mainLoop() {
           // Bargraph idling loop.
           bargraphPowerCheck();
         }
-
-        if(getNeutronaWandYearMode() == SYSTEM_AFTERLIFE || getNeutronaWandYearMode() == SYSTEM_FROZEN_EMPIRE) {
-          if(ms_gun_loop_1.justFinished() && switch_vent.on() == false) {
-            playEffect(S_AFTERLIFE_WAND_IDLE_1, true, i_volume_effects);
-            b_sound_afterlife_idle_2_fade = false;
-
-            if(b_extra_pack_sounds == true) {
-              wandSerialSend(W_AFTERLIFE_GUN_LOOP_1);
-            }
-          }
-        }
       }
 
       // Top white light.
@@ -546,10 +572,21 @@ void mainLoop() {
   }
 
   // Update the barrel LEDs and restart the timer.
-  if(ms_fast_led.justFinished()) {
-    FastLED.show();
-    ms_fast_led.start(i_fast_led_delay);
+  if(b_fast_led_due) {
+    BENCHMARK_BEGIN(BENCH_LED_SHOW);
+    commitLedFrame();
+    BENCHMARK_END(BENCH_LED_SHOW);
+
+    b_fast_led_due = false;
+    scheduleTimer(fastLedDue, i_fast_led_delay);
   }
+
+  BENCHMARK_END(BENCH_MAIN_LOOP);
+}
+
+// Timer scheduler callback which marks the barrel LEDs as due to be written at the end of the next main loop pass.
+void fastLedDue() {
+  b_fast_led_due = true;
 }
 
 // Sets the Neutrona Wand to video game mode.
@@ -1684,7 +1721,7 @@ void wandOff() {
   }
   else {
     // Full wand shutdown in all other situations.
-    wandSerialSend(W_OFF);
+    wandSerialSendReliable(W_OFF);
     WAND_STATUS = MODE_OFF;
     WAND_ACTION_STATUS = ACTION_IDLE;
 
@@ -2343,7 +2380,7 @@ void modeActivate() {
         playEffect(S_WAND_HEATUP_ALT);
       }
 
-      wandSerialSend(W_ON);
+      wandSerialSendReliable(W_ON);
 
       postActivation();
     break;
@@ -2361,7 +2398,7 @@ void modeActivate() {
         WAND_ACTION_STATUS = ACTION_IDLE;
 
         // Tell the pack the wand is turned on.
-        wandSerialSend(W_ON);
+        wandSerialSendReliable(W_ON);
       }
 
       postActivation(); // Enable lights and bargraph after wand activation.
@@ -2560,6 +2597,8 @@ void soundIdleLoopStop(bool stopAlts) {
 
 void soundIdleStart() {
   if(!b_sound_idle) {
+    uint16_t i_ramp_track = S_AFTERLIFE_WAND_RAMP_2;
+
     switch(getNeutronaWandYearMode()) {
       case SYSTEM_1984:
       case SYSTEM_1989:
@@ -2595,10 +2634,8 @@ void soundIdleStart() {
       case SYSTEM_AFTERLIFE:
       case SYSTEM_FROZEN_EMPIRE:
       default:
-        ms_gun_loop_1.stop();
-        ms_gun_loop_2.start(i_gun_loop_2);
-
         if(b_sound_afterlife_idle_2_fade) {
+          i_ramp_track = S_AFTERLIFE_WAND_RAMP_2_FADE_IN;
           playEffect(S_AFTERLIFE_WAND_RAMP_2_FADE_IN);
 
           if(b_extra_pack_sounds) {
@@ -2626,21 +2663,14 @@ void soundIdleStart() {
         stopEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2);
         stopEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT);
 
+        // Hand over to the idle loop as the ramp ends.
+        crossfadeTracks(i_ramp_track, S_AFTERLIFE_WAND_IDLE_2, i_gun_loop_crossfade, FADE_EQUAL_POWER, i_volume_effects, i_gun_loop_2 - i_gun_loop_crossfade, afterlifeIdleLoop2Start);
+
         b_sound_idle = true;
       break;
     }
   }
 
-  if(getNeutronaWandYearMode() == SYSTEM_AFTERLIFE || getNeutronaWandYearMode() == SYSTEM_FROZEN_EMPIRE) {
-    if(ms_gun_loop_2.justFinished()) {
-      playEffect(S_AFTERLIFE_WAND_IDLE_2, true, i_volume_effects);
-
-      if(b_extra_pack_sounds) {
-        wandSerialSend(W_AFTERLIFE_GUN_LOOP_2);
-      }
-    }
-  }
-
   // Reset all special startup flags.
   b_all_switch_activation = false;
   b_overheat_recovery = false;
@@ -2682,10 +2712,8 @@ void soundIdleStop() {
             }
           }
           else if(WAND_STATUS != MODE_OFF) {
-            ms_gun_loop_1.start(i_gun_loop_2);
-            ms_gun_loop_2.stop();
-
             playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2);
+            crossfadeTracks(S_AFTERLIFE_WAND_RAMP_DOWN_2, S_AFTERLIFE_WAND_IDLE_1, i_gun_loop_crossfade, FADE_EQUAL_POWER, i_volume_effects, i_gun_loop_2 - i_gun_loop_crossfade, afterlifeIdleLoop1Start);
 
             if(b_extra_pack_sounds == true) {
               wandSerialSend(W_AFTERLIFE_GUN_RAMP_DOWN_2);
@@ -2708,11 +2736,11 @@ void soundBeepLoopStop() {
 
     if(switch_wand.on()) {
       // Set all beep looping to false so they stop naturally.
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S1, false);
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S2, false);
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S3, false);
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S4, false);
-      audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S5, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S1, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S2, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S3, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S4, false);
+      audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S5, false);
 
       if(b_extra_pack_sounds) {
         wandSerialSend(W_WAND_BEEP_STOP_LOOP);
@@ -3056,6 +3084,7 @@ void modeFireStart() {
   i_fast_led_delay = FAST_LED_UPDATE_MS;
 
   modeFireStartSounds();
+  setMusicDuck(DUCK_FIRING, true);
 
   // Tell the pack the wand is firing, and if in Intensify (1) or Alt (2) mode.
   wandSerialSend(W_FIRING, b_firing_intensify ? 1 : 2);
@@ -3363,9 +3392,10 @@ void modeFireStopSounds() {
 
 void modeFireStop() {
   ms_overheat_initiate.stop();
+  setMusicDuck(DUCK_FIRING, false);
 
   // Tell the pack the wand stopped firing.
-  wandSerialSend(W_FIRING_STOPPED);
+  wandSerialSendReliable(W_FIRING_STOPPED);
 
   WAND_ACTION_STATUS = ACTION_IDLE;
 
@@ -10188,16 +10218,18 @@ void vibrationSetting() {
 }
 
 void checkMenuVibration() {
-  if(ms_menu_vibration.justFinished()) {
-    vibrationOff();
-  }
-  else if(ms_menu_vibration.isRunning()) {
+  if(timerScheduled(vibrationOff)) {
     analogWrite(VIBRATION_PIN, 150);
   }
 }
 
+// Non-blocking confirmation buzz for the menus, ended by the timer scheduler.
+void startMenuVibration(uint16_t i_length) {
+  scheduleTimer(vibrationOff, i_length);
+}
+
 void vibrationOff() {
-  ms_menu_vibration.stop();
+  cancelTimer(vibrationOff);
   i_vibration_level_prev = 0;
   analogWrite(VIBRATION_PIN, 0);
 }
@@ -10400,12 +10432,39 @@ void stopAfterLifeSounds() {
   stopEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT);
 }
 
+// Called as S_AFTERLIFE_WAND_IDLE_1 takes over from a ramp, which only goes ahead if the wand is still idling with the vent switch off.
+bool afterlifeIdleLoop1Start() {
+  if(WAND_STATUS != MODE_ON || b_pack_alarm || switch_vent.on() || (getNeutronaWandYearMode() != SYSTEM_AFTERLIFE && getNeutronaWandYearMode() != SYSTEM_FROZEN_EMPIRE)) {
+    return false;
+  }
+
+  b_sound_afterlife_idle_2_fade = false;
+
+  if(b_extra_pack_sounds == true) {
+    wandSerialSend(W_AFTERLIFE_GUN_LOOP_1);
+  }
+
+  return true;
+}
+
+// Called as S_AFTERLIFE_WAND_IDLE_2 takes over from S_AFTERLIFE_WAND_RAMP_2, which only goes ahead while the idle sounds are still on.
+bool afterlifeIdleLoop2Start() {
+  if(!b_sound_idle || (getNeutronaWandYearMode() != SYSTEM_AFTERLIFE && getNeutronaWandYearMode() != SYSTEM_FROZEN_EMPIRE)) {
+    return false;
+  }
+
+  if(b_extra_pack_sounds) {
+    wandSerialSend(W_AFTERLIFE_GUN_LOOP_2);
+  }
+
+  return true;
+}
+
 void afterlifeRampSound1() {
   stopAfterLifeSounds();
 
-  ms_gun_loop_1.start(i_gun_loop_1);
-
   playEffect(S_AFTERLIFE_WAND_RAMP_1);
+  crossfadeTracks(S_AFTERLIFE_WAND_RAMP_1, S_AFTERLIFE_WAND_IDLE_1, i_gun_loop_crossfade, FADE_EQUAL_POWER, i_volume_effects, i_gun_loop_1 - i_gun_loop_crossfade, afterlifeIdleLoop1Start);
   b_sound_afterlife_idle_2_fade = false;
 
   if(b_extra_pack_sounds == true) {
@@ -27,7 +27,12 @@ enum PACKET_TYPE : uint8_t {
   PACKET_PACK = 3,
   PACKET_WAND = 4,
   PACKET_SMOKE = 5,
-  PACKET_SYNC = 6
+  PACKET_SYNC = 6,
+  PACKET_PROFILE = 7,
+  PACKET_SYNC_DELTA = 8,
+  PACKET_COMMAND_BATCH = 9,
+  PACKET_RELIABLE = 10,
+  PACKET_LINK_STATS = 11
 };
 
 // For command signals (1 byte ID, 2 byte optional data).
@@ -41,6 +46,42 @@ struct __attribute__((packed)) CommandPacket {
 struct CommandPacket sendCmd;
 struct CommandPacket recvCmd;
 
+// For several commands sent in one frame (1 byte ID, 2 byte optional data each).
+// The pack, wand and Attenuator must all agree on i_command_batch_max, the most commands one frame can hold.
+const uint8_t i_command_batch_max = 16;
+
+struct __attribute__((packed)) BatchedCommand {
+  uint8_t c;
+  uint16_t d1;
+};
+
+struct __attribute__((packed)) CommandBatchPacket {
+  uint8_t s;
+  uint8_t e;
+  struct BatchedCommand cmd[i_command_batch_max];
+};
+
+struct CommandBatchPacket recvBatch;
+
+// Identifies which end of which link the counters in a PACKET_LINK_STATS were kept by.
+enum LINK_ID : uint8_t {
+  LINK_PACK_WAND = 0,
+  LINK_WAND_PACK = 1,
+  LINK_PACK_SERIAL1 = 2
+};
+
+// For link telemetry (1 byte link ID, counters).
+struct __attribute__((packed)) LinkStatsPacket {
+  uint8_t link;
+  struct LinkStats stats;
+};
+
+struct LinkStatsPacket sendLinkStats;
+
+struct ReliablePacket sendReliable;
+struct ReliablePacket recvReliable;
+struct ReliableLink packReliable;
+
 // For generic data communication (1 byte ID, 4 byte array).
 struct __attribute__((packed)) MessagePacket {
   uint8_t s;
@@ -143,6 +184,7 @@ void wandSerialSend(uint8_t i_command, uint16_t i_value) {
 
   i_send_size = wandComs.txObj(sendCmd);
   wandComs.sendData(i_send_size, (uint8_t) PACKET_COMMAND);
+  packLink.framesSent++;
 }
 // Override function to handle calls with a single parameter.
 void wandSerialSend(uint8_t i_command) {
@@ -294,6 +336,7 @@ void wandSerialSendData(uint8_t i_message) {
 
       i_send_size = wandComs.txObj(wandConfig);
       wandComs.sendData(i_send_size, (uint8_t) PACKET_WAND);
+      packLink.framesSent++;
     break;
 
     case W_SEND_PREFERENCES_SMOKE:
@@ -313,6 +356,16 @@ void wandSerialSendData(uint8_t i_message) {
 
       i_send_size = wandComs.txObj(smokeConfig);
       wandComs.sendData(i_send_size, (uint8_t) PACKET_SMOKE);
+      packLink.framesSent++;
+    break;
+
+    case W_SEND_LINK_STATS:
+      sendLinkStats.link = LINK_WAND_PACK;
+      sendLinkStats.stats = packLink;
+
+      i_send_size = wandComs.txObj(sendLinkStats);
+      wandComs.sendData(i_send_size, (uint8_t) PACKET_LINK_STATS);
+      packLink.framesSent++;
     break;
 
     default:
@@ -324,472 +377,684 @@ void wandSerialSendData(uint8_t i_message) {
 // Forward function declaration.
 bool handlePackCommand(uint8_t i_command, uint16_t i_value);
 
-// Pack communication to the wand.
-void checkPack() {
-  // Leave when a pack is not intended to be connected.
-  if(b_gpstar_benchtest == true) {
+// Records how many packets one pass of a drain loop handled.
+void updateSerialDrainStats(struct SerialDrainStats &stats, uint8_t i_packets, bool b_deferred) {
+  if(i_packets == 0) {
     return;
   }
 
-  if(wandComs.available() > 0) {
-    uint8_t i_packet_id = wandComs.currentPacketID();
-    // debug(F("PacketID: "));
-    // debugln(i_packet_id);
-
-    if(i_packet_id > 0) {
-      // Determine the type of packet which was sent by the serial1 device.
-      switch(i_packet_id) {
-        case PACKET_COMMAND:
-          wandComs.rxObj(recvCmd);
-          if(recvCmd.c > 0 && recvCmd.s == P_COM_START && recvCmd.e == P_COM_END) {
-            debug(F("Recv. Command: "));
-            debugln(recvCmd.c);
-            if(handlePackCommand(recvCmd.c, recvCmd.d1)) {
-              // Begin timer for future keepalive handshakes from the wand.
-              ms_handshake.start(i_heartbeat_delay);
-
-              // Turn off the sync indicator LED as the sync is completed.
-              digitalWriteFast(TOP_LED_PIN, HIGH);
-              digitalWriteFast(WAND_STATUS_LED_PIN, LOW);
-
-              // Indicate that a pack is now connected.
-              WAND_CONN_STATE = PACK_CONNECTED;
-            }
-          }
-          else if(recvCmd.s == W_COM_START && recvCmd.c == W_SYNC_NOW && recvCmd.d1 == 0 && recvCmd.e == W_COM_END) {
-            // We just received our own heartbeat echoed back, so switch to standalone mode.
-            WAND_CONN_STATE = NC_BENCHTEST;
-            b_gpstar_benchtest = true;
-            b_pack_on = true; // Pretend that the pack (not really attached) has been powered on.
+  stats.lastPackets = i_packets;
 
-            // Turn off the sync indicator LED as it is no longer necessary.
-            digitalWriteFast(TOP_LED_PIN, HIGH);
-            digitalWriteFast(WAND_STATUS_LED_PIN, LOW);
+  if(i_packets > stats.maxPackets) {
+    stats.maxPackets = i_packets;
+    debug(F("New Serial Backlog Max: "));
+    debugln(i_packets);
+  }
 
-            // Reset the audio device now that we are in standalone mode and need music playback.
-            setupAudioDevice();
+  if(b_deferred && stats.deferred < 0xFFFF) {
+    stats.deferred++;
+  }
+}
 
-            // Start the music check timer for standalone mode.
-            ms_check_music.start(i_music_check_delay);
+// Moves the pack link to a new rate once any queued bytes have been sent.
+void setPackBaudRate(unsigned long i_baud) {
+  Serial1.flush();
+  Serial1.begin(i_baud);
 
-            // Re-read the EEPROM now that we are in standalone mode to make sure system mode and volume are correct.
-            if(b_eeprom) {
-              readEEPROM();
-            }
+  b_baud_fast = (i_baud != i_serial_baud_default);
+  b_baud_check_sent = false;
 
-            // Sanity check to make sure that a firing mode was set as default.
-            if(FIRING_MODE != CTS_MODE && FIRING_MODE != CTS_MIX_MODE) {
-              FIRING_MODE = VG_MODE;
-              LAST_FIRING_MODE = FIRING_MODE;
-            }
+  if(b_baud_fast) {
+    ms_baud_check.start(i_baud_check_delay);
+  }
+  else {
+    ms_baud_check.stop();
+  }
+}
 
-            // Check if we should be in video game mode or not.
-            vgModeCheck();
+// Falls back to the default rate if the pack has stopped answering at the faster rate.
+void checkPackBaudRate() {
+  if(b_baud_fast != true) {
+    return;
+  }
 
-            // Reset the bargraph.
-            bargraphYearModeUpdate();
+  if(ms_baud_check.justFinished()) {
+    debugln(F("Pack Baud Rate Fallback"));
+    setPackBaudRate(i_serial_baud_default);
 
-            // Stop the pack sync timer since we are no longer syncing to a pack.
-            ms_packsync.stop();
+    // Synchronize again, as a pack which has restarted would expect.
+    WAND_CONN_STATE = PACK_DISCONNECTED;
+    ms_packsync.start(0);
 
-            // No pack to do a volume sync with, so reset our master volume manually.
-            updateMasterVolume(true);
+    // The time until the pack answers again is not a gap in the link.
+    i_pack_link_last_frame = 0;
+    i_pack_link_request_time = 0;
+  }
+  else if(ms_baud_check.remaining() < (ms_baud_check.delay() / 2) && !b_baud_check_sent) {
+    // Haven't heard from the pack recently, so send a handshake which the pack will confirm.
+    b_baud_check_sent = true;
+    i_pack_link_request_time = millis();
+    wandSerialSend(W_HANDSHAKE);
+  }
+}
 
-            // Immediately exit the serial data functions.
-            return;
-          }
-        break;
+// Acts on a single command from the pack, whether sent alone or in a batch.
+void handlePackCommandPacket(uint8_t i_command, uint16_t i_value) {
+  debug(F("Recv. Command: "));
+  debugln(i_command);
 
-        case PACKET_DATA:
-          wandComs.rxObj(recvData);
-          if(recvData.m > 0 && recvData.s == P_COM_START && recvData.e == P_COM_END) {
-            debug(F("Recv. Message: "));
-            debugln(recvData.m);
+  if(handlePackCommand(i_command, i_value)) {
+    // Begin timer for future keepalive handshakes from the wand.
+    ms_handshake.start(i_heartbeat_delay);
 
-            switch(recvData.m) {
-              default:
-                // Nothing here yet.
-              break;
-            }
-          }
-        break;
+    // Turn off the sync indicator LED as the sync is completed.
+    digitalWriteFast(TOP_LED_PIN, HIGH);
+    digitalWriteFast(WAND_STATUS_LED_PIN, LOW);
 
-        case PACKET_WAND:
-          wandComs.rxObj(wandConfig);
-          debugln(F("Recv. Wand Config"));
+    // Indicate that a pack is now connected.
+    WAND_CONN_STATE = PACK_CONNECTED;
+  }
+}
 
-          // Writes new preferences back to runtime variables.
-          // This action does not save changes to the EEPROM!
-          // Entering the EEPROM menu afterwards and saving settings will.
-          switch(wandConfig.ledWandCount) {
-            case 0:
-            default:
-              WAND_BARREL_LED_COUNT = LEDS_5;
-              i_num_barrel_leds = 5;
-            break;
-            case 1:
-              WAND_BARREL_LED_COUNT = LEDS_48;
-              i_num_barrel_leds = 48;
-            break;
-          }
+// Sends a reliable command frame to the pack, along with an acknowledgement of what we have received.
+void wandSerialSendReliableFrame(uint8_t i_seq, uint8_t i_command, uint16_t i_value) {
+  uint16_t i_send_size = 0;
 
-          b_overheat_enabled = (wandConfig.overheatEnabled == 1);
-          i_spectral_wand_custom_colour = wandConfig.ledWandHue;
-          i_spectral_wand_custom_saturation = wandConfig.ledWandSat;
-          b_spectral_mode_enabled = (wandConfig.spectralModesEnabled == 1);
-          b_spectral_custom_mode_enabled = b_spectral_mode_enabled;
-          b_holiday_mode_enabled = b_spectral_mode_enabled;
+  sendReliable.s = W_COM_START;
+  sendReliable.seq = i_seq;
+  sendReliable.ack = reliableAck(packReliable);
+  sendReliable.c = i_command;
+  sendReliable.d1 = i_value;
+  sendReliable.e = W_COM_END;
 
-          switch(wandConfig.defaultFiringMode) {
-            case 1:
-            default:
-              // Default: Video Game
-              FIRING_MODE = VG_MODE;
-              setVGMode();
-              wandSerialSend(W_VIDEO_GAME_MODE);
-            break;
+  if(WAND_CONN_STATE == PACK_CONNECTED) {
+    // Once connected, each send of data should restart the timer.
+    ms_handshake.restart();
+  }
 
-            case 2:
-              // Cross the Streams (CTS)
-              FIRING_MODE = CTS_MODE;
+  i_send_size = wandComs.txObj(sendReliable);
+  wandComs.sendData(i_send_size, (uint8_t) PACKET_RELIABLE);
+  packLink.framesSent++;
+}
 
-              // Force into Proton mode.
-              STREAM_MODE = PROTON;
-              wandSerialSend(W_PROTON_MODE);
-              wandSerialSend(W_CROSS_THE_STREAMS);
-            break;
+// Outgoing commands to the pack which must not be lost.
+void wandSerialSendReliable(uint8_t i_command, uint16_t i_value) {
+  uint8_t i_seq = 0;
 
-            case 3:
-              // CTS Mix
-              FIRING_MODE = CTS_MIX_MODE;
+  if(!b_pack_reliable || !reliableKeep(packReliable, i_command, i_value, i_seq)) {
+    // Older pack firmware, or so many commands unacknowledged that the link is failing anyway.
+    wandSerialSend(i_command, i_value);
+    return;
+  }
 
-              // Force into Proton mode.
-              STREAM_MODE = PROTON;
-              wandSerialSend(W_PROTON_MODE);
-              wandSerialSend(W_CROSS_THE_STREAMS_MIX);
-            break;
-          }
+  debug(F("Reliable Command to Pack: "));
+  debugln(i_command);
 
-          LAST_FIRING_MODE = FIRING_MODE;
+  wandSerialSendReliableFrame(i_seq, i_command, i_value);
+}
+// Override function to handle calls with a single parameter.
+void wandSerialSendReliable(uint8_t i_command) {
+  wandSerialSendReliable(i_command, 0);
+}
 
-          switch(wandConfig.wandVibration) {
-            case 1:
-              b_vibration_switch_on = true; // Override the Proton Pack vibration toggle switch.
-              VIBRATION_MODE_EEPROM = VIBRATION_ALWAYS;
-              VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-            break;
+// Starts numbering commands to the pack, and confirms to the pack that we are doing so.
+void startPackReliable() {
+  debugln(F("Pack Reliable Commands"));
+  b_pack_reliable = true;
+  wandSerialSendReliableFrame(0, 0, 0);
 
-            case 2:
-              b_vibration_switch_on = true; // Override the Proton Pack vibration toggle switch.
-              VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
-              VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-            break;
+  // Lost state changes are now sent again rather than waiting for a resync, so the pack can expect handshakes more often.
+  ms_handshake.start(i_reliable_heartbeat_delay);
+}
 
-            case 3:
-              VIBRATION_MODE_EEPROM = VIBRATION_NONE;
-              VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-            break;
+// Handles a reliable command frame from the pack.
+void handlePackReliable() {
+  wandComs.rxObj(recvReliable);
 
-            case 4:
-            default:
-              VIBRATION_MODE_EEPROM = VIBRATION_DEFAULT;
-              VIBRATION_MODE = VIBRATION_FIRING_ONLY;
-            break;
-          }
+  if(recvReliable.s != P_COM_START || recvReliable.e != P_COM_END) {
+    packLink.markerErrors++;
+    return;
+  }
 
-          b_extra_pack_sounds = (wandConfig.wandSoundsToPack == 1);
-          b_quick_vent = (wandConfig.quickVenting == 1);
-          b_vent_light_control = (wandConfig.autoVentLight == 1);
-          b_beep_loop = (wandConfig.wandBeepLoop == 1);
-          b_wand_boot_errors = (wandConfig.wandBootError == 1);
+  if(!b_pack_reliable) {
+    // The pack only numbers commands once it has sent P_RELIABLE, so that must have been lost.
+    startPackReliable();
+  }
 
-          switch(wandConfig.defaultYearModeWand) {
-            case 1:
-            default:
-              WAND_YEAR_MODE = YEAR_DEFAULT;
-            break;
-            case 2:
-              WAND_YEAR_MODE = YEAR_1984;
-            break;
-            case 3:
-              WAND_YEAR_MODE = YEAR_1989;
-            break;
-            case 4:
-              WAND_YEAR_MODE = YEAR_AFTERLIFE;
-            break;
-            case 5:
-              WAND_YEAR_MODE = YEAR_FROZEN_EMPIRE;
-            break;
-          }
+  reliableReceive(packReliable, recvReliable, handlePackCommandPacket);
+}
 
-          switch(wandConfig.defaultYearModeCTS) {
-            case 1:
-            default:
-              WAND_YEAR_CTS = CTS_DEFAULT;
-            break;
-            case 2:
-              WAND_YEAR_CTS = CTS_1984;
-            break;
-            case 4:
-              WAND_YEAR_CTS = CTS_AFTERLIFE;
-            break;
-          }
+// Sends again any reliable commands the pack has not acknowledged, and acknowledges any the pack sent.
+void checkPackReliable() {
+  if(!b_pack_reliable) {
+    return;
+  }
 
-          b_bargraph_invert = (wandConfig.invertWandBargraph == 1);
-          b_overheat_bargraph_blink = (wandConfig.bargraphOverheatBlink == 1);
+  packLink.retransmits += reliableCheck(packReliable, wandSerialSendReliableFrame);
 
-          switch(wandConfig.numBargraphSegments) {
-            case 28:
-            default:
-              BARGRAPH_TYPE_EEPROM = SEGMENTS_28;
-            break;
-            case 30:
-              BARGRAPH_TYPE_EEPROM = SEGMENTS_30;
-            break;
-          }
+  if(reliableFailed(packReliable)) {
+    // The pack has stopped acknowledging, so send it what it missed as plain commands and stop numbering them.
+    debugln(F("Pack Reliable Commands Failed"));
+    b_pack_reliable = false;
+    reliableAbandon(packReliable, wandSerialSend);
+    ms_handshake.start(i_heartbeat_delay);
+  }
+}
 
-          if(BARGRAPH_TYPE != SEGMENTS_5) {
-            // Only change bargraph types if we are not using the stock Hasbro bargraph.
-            BARGRAPH_TYPE = BARGRAPH_TYPE_EEPROM;
-          }
+// Handles a single packet from the pack.
+void handlePackPacket(uint8_t i_packet_id) {
+  // debug(F("PacketID: "));
+  // debugln(i_packet_id);
 
-          switch(wandConfig.bargraphIdleAnimation) {
-            case 1:
-            default:
-              BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_DEFAULT;
-            break;
-            case 2:
-              BARGRAPH_MODE = BARGRAPH_SUPER_HERO;
-              BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_SUPER_HERO;
-            break;
-            case 3:
-              BARGRAPH_MODE = BARGRAPH_ORIGINAL;
-              BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_ORIGINAL;
-            break;
+  if(i_packet_id > 0) {
+    if(b_baud_fast) {
+      // Any valid packet proves the pack is still answering at the faster rate.
+      ms_baud_check.start(i_baud_check_delay);
+      b_baud_check_sent = false;
+    }
+
+    // Determine the type of packet which was sent by the serial1 device.
+    switch(i_packet_id) {
+      case PACKET_COMMAND:
+        wandComs.rxObj(recvCmd);
+        if(recvCmd.c > 0 && recvCmd.s == P_COM_START && recvCmd.e == P_COM_END) {
+          handlePackCommandPacket(recvCmd.c, recvCmd.d1);
+        }
+        else if(recvCmd.s == W_COM_START && recvCmd.c == W_SYNC_NOW && recvCmd.d1 == 0 && recvCmd.e == W_COM_END) {
+          // We just received our own heartbeat echoed back, so switch to standalone mode.
+          WAND_CONN_STATE = NC_BENCHTEST;
+          b_gpstar_benchtest = true;
+          b_pack_on = true; // Pretend that the pack (not really attached) has been powered on.
+
+          // Turn off the sync indicator LED as it is no longer necessary.
+          digitalWriteFast(TOP_LED_PIN, HIGH);
+          digitalWriteFast(WAND_STATUS_LED_PIN, LOW);
+
+          // Reset the audio device now that we are in standalone mode and need music playback.
+          setupAudioDevice();
+
+          // Start the music check timer for standalone mode.
+          ms_check_music.start(i_music_check_delay);
+
+          // Re-read the EEPROM now that we are in standalone mode to make sure system mode and volume are correct.
+          if(b_eeprom) {
+            readEEPROM();
           }
 
-          switch(wandConfig.bargraphFireAnimation) {
-            case 1:
-            default:
-              BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_DEFAULT;
-            break;
-            case 2:
-              BARGRAPH_FIRING_ANIMATION = BARGRAPH_ANIMATION_SUPER_HERO;
-              BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_SUPER_HERO;
-            break;
-            case 3:
-              BARGRAPH_FIRING_ANIMATION = BARGRAPH_ANIMATION_ORIGINAL;
-              BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_ORIGINAL;
-            break;
+          // Sanity check to make sure that a firing mode was set as default.
+          if(FIRING_MODE != CTS_MODE && FIRING_MODE != CTS_MIX_MODE) {
+            FIRING_MODE = VG_MODE;
+            LAST_FIRING_MODE = FIRING_MODE;
           }
 
-          // Update and reset wand components.
+          // Check if we should be in video game mode or not.
+          vgModeCheck();
+
+          // Reset the bargraph.
           bargraphYearModeUpdate();
-          resetOverheatLevels();
-          resetWhiteLEDBlinkRate();
-        break;
 
-        case PACKET_SMOKE:
-          wandComs.rxObj(smokeConfig);
-          debugln(F("Recv. Smoke Config"));
-
-          // Writes new preferences back to runtime variables.
-          // This action does not save changes to the EEPROM!
-          b_overheat_level_5 = (smokeConfig.overheatLevel5 == 1);
-          b_overheat_level_4 = (smokeConfig.overheatLevel4 == 1);
-          b_overheat_level_3 = (smokeConfig.overheatLevel3 == 1);
-          b_overheat_level_2 = (smokeConfig.overheatLevel2 == 1);
-          b_overheat_level_1 = (smokeConfig.overheatLevel1 == 1);
-
-          // Values are sent as seconds, must convert to milliseconds.
-          i_ms_overheat_initiate_level_5 = smokeConfig.overheatDelay5 * 1000;
-          i_ms_overheat_initiate_level_4 = smokeConfig.overheatDelay4 * 1000;
-          i_ms_overheat_initiate_level_3 = smokeConfig.overheatDelay3 * 1000;
-          i_ms_overheat_initiate_level_2 = smokeConfig.overheatDelay2 * 1000;
-          i_ms_overheat_initiate_level_1 = smokeConfig.overheatDelay1 * 1000;
-
-          // Update and reset wand components.
-          resetOverheatLevels();
-        break;
+          // Stop the pack sync timer since we are no longer syncing to a pack.
+          ms_packsync.stop();
+
+          // No pack to do a volume sync with, so reset our master volume manually.
+          updateMasterVolume(true);
 
-        case PACKET_SYNC:
-          wandComs.rxObj(wandSyncData);
-          debugln(F("Recv. Sync Payload"));
+          // Immediately exit the serial data functions.
+          return;
+        }
+        else {
+          packLink.markerErrors++;
+        }
+      break;
+
+      case PACKET_DATA:
+        wandComs.rxObj(recvData);
+        if(recvData.m > 0 && recvData.s == P_COM_START && recvData.e == P_COM_END) {
+          debug(F("Recv. Message: "));
+          debugln(recvData.m);
 
-          // Write the received data to runtime variables.
-          // This will not save to the EEPROM!
-          switch(wandSyncData.systemMode) {
-            case 1:
+          switch(recvData.m) {
             default:
-              SYSTEM_MODE = MODE_SUPER_HERO;
-            break;
-            case 2:
-              SYSTEM_MODE = MODE_ORIGINAL;
+              // Nothing here yet.
             break;
           }
+        }
+        else {
+          packLink.markerErrors++;
+        }
+      break;
 
-          vgModeCheck(); // Re-check VG/CTS mode.
+      case PACKET_WAND:
+        wandComs.rxObj(wandConfig);
+        debugln(F("Recv. Wand Config"));
 
-          // Set whether the switch under the ion arm is on or off.
-          switch(wandSyncData.ionArmSwitch) {
-            case 1:
-            default:
-              b_pack_ion_arm_switch_on = false;
+        // Writes new preferences back to runtime variables.
+        // This action does not save changes to the EEPROM!
+        // Entering the EEPROM menu afterwards and saving settings will.
+        switch(wandConfig.ledWandCount) {
+          case 0:
+          default:
+            WAND_BARREL_LED_COUNT = LEDS_5;
+            i_num_barrel_leds = 5;
+          break;
+          case 1:
+            WAND_BARREL_LED_COUNT = LEDS_48;
+            i_num_barrel_leds = 48;
+          break;
+        }
 
-              // If the ion arm switch is turned off in MODE_ORIGINAL, start the power indicator timer.
-              if(SYSTEM_MODE == MODE_ORIGINAL && b_power_on_indicator) {
-                ms_power_indicator.start(i_ms_power_indicator);
-              }
-            break;
-            case 2:
-              b_pack_ion_arm_switch_on = true;
+        b_overheat_enabled = (wandConfig.overheatEnabled == 1);
+        i_spectral_wand_custom_colour = wandConfig.ledWandHue;
+        i_spectral_wand_custom_saturation = wandConfig.ledWandSat;
+        b_spectral_mode_enabled = (wandConfig.spectralModesEnabled == 1);
+        b_spectral_custom_mode_enabled = b_spectral_mode_enabled;
+        b_holiday_mode_enabled = b_spectral_mode_enabled;
+
+        switch(wandConfig.defaultFiringMode) {
+          case 1:
+          default:
+            // Default: Video Game
+            FIRING_MODE = VG_MODE;
+            setVGMode();
+            wandSerialSend(W_VIDEO_GAME_MODE);
+          break;
+
+          case 2:
+            // Cross the Streams (CTS)
+            FIRING_MODE = CTS_MODE;
+
+            // Force into Proton mode.
+            STREAM_MODE = PROTON;
+            wandSerialSend(W_PROTON_MODE);
+            wandSerialSend(W_CROSS_THE_STREAMS);
+          break;
+
+          case 3:
+            // CTS Mix
+            FIRING_MODE = CTS_MIX_MODE;
+
+            // Force into Proton mode.
+            STREAM_MODE = PROTON;
+            wandSerialSend(W_PROTON_MODE);
+            wandSerialSend(W_CROSS_THE_STREAMS_MIX);
+          break;
+        }
+
+        LAST_FIRING_MODE = FIRING_MODE;
+
+        switch(wandConfig.wandVibration) {
+          case 1:
+            b_vibration_switch_on = true; // Override the Proton Pack vibration toggle switch.
+            VIBRATION_MODE_EEPROM = VIBRATION_ALWAYS;
+            VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+          break;
+
+          case 2:
+            b_vibration_switch_on = true; // Override the Proton Pack vibration toggle switch.
+            VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
+            VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+          break;
+
+          case 3:
+            VIBRATION_MODE_EEPROM = VIBRATION_NONE;
+            VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+          break;
+
+          case 4:
+          default:
+            VIBRATION_MODE_EEPROM = VIBRATION_DEFAULT;
+            VIBRATION_MODE = VIBRATION_FIRING_ONLY;
+          break;
+        }
+
+        b_extra_pack_sounds = (wandConfig.wandSoundsToPack == 1);
+        b_quick_vent = (wandConfig.quickVenting == 1);
+        b_vent_light_control = (wandConfig.autoVentLight == 1);
+        b_beep_loop = (wandConfig.wandBeepLoop == 1);
+        b_wand_boot_errors = (wandConfig.wandBootError == 1);
 
-              // If the ion arm switch is on in MODE_ORIGINAL, we do not need a power indicator.
-              if(SYSTEM_MODE == MODE_ORIGINAL && b_power_on_indicator) {
-                ms_power_indicator.stop();
-                ms_power_indicator_blink.stop();
+        switch(wandConfig.defaultYearModeWand) {
+          case 1:
+          default:
+            WAND_YEAR_MODE = YEAR_DEFAULT;
+          break;
+          case 2:
+            WAND_YEAR_MODE = YEAR_1984;
+          break;
+          case 3:
+            WAND_YEAR_MODE = YEAR_1989;
+          break;
+          case 4:
+            WAND_YEAR_MODE = YEAR_AFTERLIFE;
+          break;
+          case 5:
+            WAND_YEAR_MODE = YEAR_FROZEN_EMPIRE;
+          break;
+        }
+
+        switch(wandConfig.defaultYearModeCTS) {
+          case 1:
+          default:
+            WAND_YEAR_CTS = CTS_DEFAULT;
+          break;
+          case 2:
+            WAND_YEAR_CTS = CTS_1984;
+          break;
+          case 4:
+            WAND_YEAR_CTS = CTS_AFTERLIFE;
+          break;
+        }
+
+        b_bargraph_invert = (wandConfig.invertWandBargraph == 1);
+        b_overheat_bargraph_blink = (wandConfig.bargraphOverheatBlink == 1);
+
+        switch(wandConfig.numBargraphSegments) {
+          case 28:
+          default:
+            BARGRAPH_TYPE_EEPROM = SEGMENTS_28;
+          break;
+          case 30:
+            BARGRAPH_TYPE_EEPROM = SEGMENTS_30;
+          break;
+        }
+
+        if(BARGRAPH_TYPE != SEGMENTS_5) {
+          // Only change bargraph types if we are not using the stock Hasbro bargraph.
+          BARGRAPH_TYPE = BARGRAPH_TYPE_EEPROM;
+        }
+
+        switch(wandConfig.bargraphIdleAnimation) {
+          case 1:
+          default:
+            BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_DEFAULT;
+          break;
+          case 2:
+            BARGRAPH_MODE = BARGRAPH_SUPER_HERO;
+            BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_SUPER_HERO;
+          break;
+          case 3:
+            BARGRAPH_MODE = BARGRAPH_ORIGINAL;
+            BARGRAPH_MODE_EEPROM = BARGRAPH_EEPROM_ORIGINAL;
+          break;
+        }
+
+        switch(wandConfig.bargraphFireAnimation) {
+          case 1:
+          default:
+            BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_DEFAULT;
+          break;
+          case 2:
+            BARGRAPH_FIRING_ANIMATION = BARGRAPH_ANIMATION_SUPER_HERO;
+            BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_SUPER_HERO;
+          break;
+          case 3:
+            BARGRAPH_FIRING_ANIMATION = BARGRAPH_ANIMATION_ORIGINAL;
+            BARGRAPH_EEPROM_FIRING_ANIMATION = BARGRAPH_EEPROM_ANIMATION_ORIGINAL;
+          break;
+        }
+
+        // Update and reset wand components.
+        bargraphYearModeUpdate();
+        resetOverheatLevels();
+        resetWhiteLEDBlinkRate();
+      break;
+
+      case PACKET_SMOKE:
+        wandComs.rxObj(smokeConfig);
+        debugln(F("Recv. Smoke Config"));
+
+        // Writes new preferences back to runtime variables.
+        // This action does not save changes to the EEPROM!
+        b_overheat_level_5 = (smokeConfig.overheatLevel5 == 1);
+        b_overheat_level_4 = (smokeConfig.overheatLevel4 == 1);
+        b_overheat_level_3 = (smokeConfig.overheatLevel3 == 1);
+        b_overheat_level_2 = (smokeConfig.overheatLevel2 == 1);
+        b_overheat_level_1 = (smokeConfig.overheatLevel1 == 1);
+
+        // Values are sent as seconds, must convert to milliseconds.
+        i_ms_overheat_initiate_level_5 = smokeConfig.overheatDelay5 * 1000;
+        i_ms_overheat_initiate_level_4 = smokeConfig.overheatDelay4 * 1000;
+        i_ms_overheat_initiate_level_3 = smokeConfig.overheatDelay3 * 1000;
+        i_ms_overheat_initiate_level_2 = smokeConfig.overheatDelay2 * 1000;
+        i_ms_overheat_initiate_level_1 = smokeConfig.overheatDelay1 * 1000;
+
+        // Update and reset wand components.
+        resetOverheatLevels();
+      break;
+
+      case PACKET_RELIABLE:
+        handlePackReliable();
+      break;
+
+      case PACKET_COMMAND_BATCH:
+        if(wandComs.bytesRead >= offsetof(struct CommandBatchPacket, cmd) && wandComs.bytesRead <= sizeof(recvBatch)) {
+          uint8_t i_commands = (wandComs.bytesRead - offsetof(struct CommandBatchPacket, cmd)) / sizeof(struct BatchedCommand);
+
+          wandComs.rxObj(recvBatch, 0, wandComs.bytesRead);
+
+          if(recvBatch.s == P_COM_START && recvBatch.e == P_COM_END) {
+            // Commands are handled in the order the pack sent them.
+            for(uint8_t i = 0; i < i_commands; i++) {
+              if(recvBatch.cmd[i].c > 0) {
+                handlePackCommandPacket(recvBatch.cmd[i].c, recvBatch.cmd[i].d1);
               }
-            break;
+            }
           }
+        }
+      break;
 
-          // Update the System Year setting.
-          switch(wandSyncData.systemYear) {
-            case 1:
-              SYSTEM_YEAR = SYSTEM_1984;
-            break;
-            case 2:
-              SYSTEM_YEAR = SYSTEM_1989;
-            break;
-            case 3:
-            default:
-              SYSTEM_YEAR = SYSTEM_AFTERLIFE;
-            break;
-            case 4:
-              SYSTEM_YEAR = SYSTEM_FROZEN_EMPIRE;
-            break;
-          }
+      case PACKET_SYNC:
+        wandComs.rxObj(wandSyncData);
+        debugln(F("Recv. Sync Payload"));
 
-          // Reset the bargraph now that we have our SYSTEM_MODE and SYSTEM_YEAR set.
-          bargraphYearModeUpdate();
+        // Write the received data to runtime variables.
+        // This will not save to the EEPROM!
+        switch(wandSyncData.systemMode) {
+          case 1:
+          default:
+            SYSTEM_MODE = MODE_SUPER_HERO;
+          break;
+          case 2:
+            SYSTEM_MODE = MODE_ORIGINAL;
+          break;
+        }
 
-          // Reset the white LED blink rate in case we changed wand year.
-          resetWhiteLEDBlinkRate();
+        vgModeCheck(); // Re-check VG/CTS mode.
 
-          // Set whether the Proton Pack is currently on or off.
-          switch(wandSyncData.packOn) {
-            case 1:
-            default:
-              // Pack is off.
-              if(b_pack_on == true) {
-                // Turn wand off.
-                if(WAND_STATUS != MODE_OFF) {
-                  if(WAND_STATUS == MODE_ERROR) {
-                    b_wand_mash_error = false;
-                    wandOff();
-                  }
-                  else {
-                    b_wand_mash_error = false;
-                    WAND_ACTION_STATUS = ACTION_OFF;
-                  }
+        // Set whether the switch under the ion arm is on or off.
+        switch(wandSyncData.ionArmSwitch) {
+          case 1:
+          default:
+            b_pack_ion_arm_switch_on = false;
+
+            // If the ion arm switch is turned off in MODE_ORIGINAL, start the power indicator timer.
+            if(SYSTEM_MODE == MODE_ORIGINAL && b_power_on_indicator) {
+              ms_power_indicator.start(i_ms_power_indicator);
+            }
+          break;
+          case 2:
+            b_pack_ion_arm_switch_on = true;
+
+            // If the ion arm switch is on in MODE_ORIGINAL, we do not need a power indicator.
+            if(SYSTEM_MODE == MODE_ORIGINAL && b_power_on_indicator) {
+              ms_power_indicator.stop();
+              ms_power_indicator_blink.stop();
+            }
+          break;
+        }
+
+        // Update the System Year setting.
+        switch(wandSyncData.systemYear) {
+          case 1:
+            SYSTEM_YEAR = SYSTEM_1984;
+          break;
+          case 2:
+            SYSTEM_YEAR = SYSTEM_1989;
+          break;
+          case 3:
+          default:
+            SYSTEM_YEAR = SYSTEM_AFTERLIFE;
+          break;
+          case 4:
+            SYSTEM_YEAR = SYSTEM_FROZEN_EMPIRE;
+          break;
+        }
+
+        // Reset the bargraph now that we have our SYSTEM_MODE and SYSTEM_YEAR set.
+        bargraphYearModeUpdate();
+
+        // Reset the white LED blink rate in case we changed wand year.
+        resetWhiteLEDBlinkRate();
+
+        // Set whether the Proton Pack is currently on or off.
+        switch(wandSyncData.packOn) {
+          case 1:
+          default:
+            // Pack is off.
+            if(b_pack_on == true) {
+              // Turn wand off.
+              if(WAND_STATUS != MODE_OFF) {
+                if(WAND_STATUS == MODE_ERROR) {
+                  b_wand_mash_error = false;
+                  wandOff();
+                }
+                else {
+                  b_wand_mash_error = false;
+                  WAND_ACTION_STATUS = ACTION_OFF;
                 }
               }
+            }
 
-              b_pack_on = false;
-            break;
-            case 2:
-              // Pack is on.
-              b_pack_on = true;
-            break;
-          }
+            b_pack_on = false;
+          break;
+          case 2:
+            // Pack is on.
+            b_pack_on = true;
+          break;
+        }
 
-          // Set our starting power level.
-          i_power_level = wandSyncData.powerLevel;
-          i_power_level_prev = i_power_level;
+        // Set our starting power level.
+        i_power_level = wandSyncData.powerLevel;
+        i_power_level_prev = i_power_level;
 
-          // Set our firing mode.
-          switch(wandSyncData.streamMode) {
-            case 1:
-            default:
-              STREAM_MODE = PROTON;
-            break;
-            case 2:
-              STREAM_MODE = SLIME;
-              setVGMode();
-            break;
-            case 3:
-              STREAM_MODE = STASIS;
-              setVGMode();
-            break;
-            case 4:
-              STREAM_MODE = MESON;
+        // Set our firing mode.
+        switch(wandSyncData.streamMode) {
+          case 1:
+          default:
+            STREAM_MODE = PROTON;
+          break;
+          case 2:
+            STREAM_MODE = SLIME;
+            setVGMode();
+          break;
+          case 3:
+            STREAM_MODE = STASIS;
+            setVGMode();
+          break;
+          case 4:
+            STREAM_MODE = MESON;
 
-              if(AUDIO_DEVICE == A_GPSTAR_AUDIO) {
-                // Tell GPStar Audio we need short audio mode.
-                audio.gpstarShortTrackOverload(false);
-              }
+            if(AUDIO_DEVICE == A_GPSTAR_AUDIO) {
+              // Tell GPStar Audio we need short audio mode.
+              audio.gpstarShortTrackOverload(false);
+            }
 
-              setVGMode();
-            break;
-            case 5:
-              STREAM_MODE = SPECTRAL;
-              setVGMode();
-            break;
-            case 6:
-              STREAM_MODE = HOLIDAY;
-              b_christmas = false; // Halloween mode.
-              setVGMode();
-            break;
-            case 7:
-              STREAM_MODE = HOLIDAY;
-              b_christmas = true; // Christmas mode.
-              setVGMode();
-            break;
-            case 8:
-              STREAM_MODE = SPECTRAL_CUSTOM;
-              setVGMode();
-            break;
-          }
+            setVGMode();
+          break;
+          case 5:
+            STREAM_MODE = SPECTRAL;
+            setVGMode();
+          break;
+          case 6:
+            STREAM_MODE = HOLIDAY;
+            b_christmas = false; // Halloween mode.
+            setVGMode();
+          break;
+          case 7:
+            STREAM_MODE = HOLIDAY;
+            b_christmas = true; // Christmas mode.
+            setVGMode();
+          break;
+          case 8:
+            STREAM_MODE = SPECTRAL_CUSTOM;
+            setVGMode();
+          break;
+        }
 
-          // Set up master vibration switch if not configured to override it.
-          if(VIBRATION_MODE_EEPROM == VIBRATION_DEFAULT) {
-            b_vibration_switch_on = wandSyncData.vibrationEnabled == 2;
-          }
+        // Set up master vibration switch if not configured to override it.
+        if(VIBRATION_MODE_EEPROM == VIBRATION_DEFAULT) {
+          b_vibration_switch_on = wandSyncData.vibrationEnabled == 2;
+        }
 
-          // Update cyclotron lid status and music loop status.
-          b_pack_cyclotron_lid_on = wandSyncData.cyclotronLidState == 2;
-          b_repeat_track = wandSyncData.repeatMusicTrack == 2;
+        // Update cyclotron lid status and music loop status.
+        b_pack_cyclotron_lid_on = wandSyncData.cyclotronLidState == 2;
+        b_repeat_track = wandSyncData.repeatMusicTrack == 2;
 
-          // Set the percentage volume.
-          i_volume_master_percentage = wandSyncData.masterVolume;
-          i_volume_effects_percentage = wandSyncData.effectsVolume;
+        // Set the percentage volume.
+        i_volume_master_percentage = wandSyncData.masterVolume;
+        i_volume_effects_percentage = wandSyncData.effectsVolume;
 
-          // Set the decibel volume.
-          i_volume_master = MINIMUM_VOLUME - ((MINIMUM_VOLUME - i_volume_abs_max) * i_volume_master_percentage / 100);
-          i_volume_effects = i_volume_abs_min - (i_volume_abs_min * i_volume_effects_percentage / 100);
-          i_volume_music = i_volume_abs_min - (i_volume_abs_min * i_volume_music_percentage / 100);
+        // Set the decibel volume.
+        i_volume_master = masterVolumeGain(i_volume_master_percentage);
+        i_volume_effects = volumeGain(i_volume_effects_percentage);
+        i_volume_music = volumeGain(i_volume_music_percentage);
 
-          // Update volume levels.
-          i_volume_revert = i_volume_master;
-          updateMasterVolume();
+        // Update volume levels.
+        i_volume_revert = i_volume_master;
+        updateMasterVolume();
 
-          switch(wandSyncData.masterMuted) {
-            case 1:
-            default:
-              // Do nothing; we already have our volumes set correctly.
-            break;
-            case 2:
-              // Remember the current master volume level.
-              i_volume_revert = i_volume_master;
+        switch(wandSyncData.masterMuted) {
+          case 1:
+          default:
+            // Do nothing; we already have our volumes set correctly.
+          break;
+          case 2:
+            // Remember the current master volume level.
+            i_volume_revert = i_volume_master;
 
-              // The pack is telling us to be silent.
-              i_volume_master = i_volume_abs_min;
-              updateMasterVolume();
-            break;
-          }
-        break;
-      }
+            // The pack is telling us to be silent.
+            i_volume_master = i_volume_abs_min;
+            updateMasterVolume();
+          break;
+        }
+      break;
+    }
+  }
+}
+
+// Pack communication to the wand.
+void checkPack() {
+  // Leave when a pack is not intended to be connected.
+  if(b_gpstar_benchtest == true) {
+    return;
+  }
+
+  uint8_t i_packets = 0;
+  bool b_deferred = false;
+  unsigned long i_start = micros();
+
+  // Handle every complete packet already waiting, within the per-loop limits.
+  // Stop early if a packet put the wand into standalone mode.
+  while(b_gpstar_benchtest != true && wandComs.available() > 0) {
+    linkFrameReceived(packLink, i_pack_link_last_frame, wandComs.currentPacketID());
+    handlePackPacket(wandComs.currentPacketID());
+    i_packets++;
+
+    if(i_packets >= i_serial_drain_max_packets || micros() - i_start >= i_serial_drain_budget_us) {
+      // Leave anything else for the next loop pass.
+      b_deferred = Serial1.available() > 0;
+      break;
     }
   }
+
+  if(wandComs.status <= CRC_ERROR) {
+    // The last frame read was corrupted.
+    packLink.crcErrors++;
+  }
+
+  updateSerialDrainStats(packDrain, i_packets, b_deferred);
+
+  checkPackReliable();
 }
 
 bool handlePackCommand(uint8_t i_command, uint16_t i_value) {
@@ -822,6 +1087,10 @@ bool handlePackCommand(uint8_t i_command, uint16_t i_value) {
 
       // Stop regular sync attempts while communicating with the pack.
       ms_packsync.stop();
+
+      // Commands are sent singly and unnumbered until the pack says what it supports.
+      b_pack_reliable = false;
+      resetReliableLink(packReliable);
     break;
 
     case P_SYNC_END:
@@ -830,6 +1099,12 @@ bool handlePackCommand(uint8_t i_command, uint16_t i_value) {
       // Acknowledgement that the wand is now synchronized.
       wandSerialSend(W_SYNCHRONIZED);
 
+      // Tell the pack it can send us several commands in one frame.
+      wandSerialSend(W_COMMAND_BATCH);
+
+      // Tell the pack it can send us numbered commands which we will acknowledge.
+      wandSerialSend(W_RELIABLE);
+
       // Tell the pack the status of the Neutrona Wand barrel. We only need to tell if its extended.
       // Otherwise the switchBarrel() will tell it if it's retracted during bootup.
       if(switchBarrel() == true) {
@@ -844,6 +1119,32 @@ bool handlePackCommand(uint8_t i_command, uint16_t i_value) {
       b_pack_post_finish = true;
     break;
 
+    case P_BAUD_RATE:
+      // Pack has offered a faster link rate. Acknowledge at the current rate and then switch.
+      if(!b_baud_fast && i_value == i_serial_baud_fast / 100) {
+        debugln(F("Pack Baud Rate Increased"));
+        wandSerialSend(W_BAUD_RATE, i_value);
+        setPackBaudRate(i_serial_baud_fast);
+      }
+    break;
+
+    case P_BAUD_RATE_CONFIRM:
+      // Pack is answering at the faster rate; receiving this packet has already restarted the check.
+      linkRequestAnswered(packLink, i_pack_link_request_time);
+    break;
+
+    case P_REQUEST_LINK_STATS:
+      // The pack passes these on to the Attenuator.
+      wandSerialSendData(W_SEND_LINK_STATS);
+    break;
+
+    case P_RELIABLE:
+      // The pack supports reliable commands, so start numbering them unless a numbered command from the pack already has.
+      if(!b_pack_reliable) {
+        startPackReliable();
+      }
+    break;
+
     case P_ON:
       // Pack is on.
       b_pack_on = true;
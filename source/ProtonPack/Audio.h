@@ -46,20 +46,43 @@ const uint16_t i_music_track_start = 500; // Music tracks start on file named 50
 const int8_t i_volume_abs_min = -70; // System (absolute) minimum volume possible.
 const int8_t i_volume_abs_max = 0; // System (absolute) maximum volume possible.
 uint8_t i_volume_min_adj = 0; // Adjustment factor for minimum volume. 0 for WAV Trigger, 10 for GPStar Audio.
+const uint8_t i_gpstar_volume_min_adj = 10; // GPStar Audio's minimum is higher than the WAV Trigger's.
 const uint8_t i_wand_idle_level = 20; // This adjusts the volume of certain Afterlife / Frozen Empire Neutrona Wand idle sounds that the Proton pack can play.
+const uint8_t i_slime_startup_level = 30; // How far below the effects volume the Afterlife / Frozen Empire pack startup plays in slime mode.
+const uint8_t i_slime_idle_level = 40; // How far below the effects volume the Afterlife / Frozen Empire pack idle loop plays in slime mode.
+const uint8_t i_idle_fire_level = 2; // How far below the effects volume the Afterlife / Frozen Empire pack idle loop settles while firing.
 bool b_playing_music = false;
 bool b_music_paused = false;
 bool b_repeat_track = false;
+bool b_music_shuffle = false;
 
 /*
  * Music Control/Checking
  */
 const uint16_t i_music_check_delay = 2000;
-const uint16_t i_music_next_track_delay = 500;
 millisDelay ms_check_music;
-millisDelay ms_music_next_track;
 millisDelay ms_music_status_check;
 
+/*
+ * Music Playlist
+ *
+ * The tracks to play after the current one are chosen ahead of time and kept in musicQueue, soonest first, and the
+ * tracks played before it are kept in musicHistory so that the previous track can be played again when shuffling.
+ * The playlist starts again from the first track after the last, unless b_repeat_track has the board loop the
+ * current track. With b_music_shuffle the queue is filled with tracks picked at random, avoiding any which are queued
+ * or were played recently while there are enough tracks to choose from.
+ *
+ * A WAV Trigger reports each track as it starts and stops, so the next track is started as soon as audio.update()
+ * reads the report that the current one has ended. Until that report has been seen for the current track, and always
+ * for GPStar Audio, the board is asked every i_music_check_delay whether the track is still playing instead.
+ */
+const uint8_t MUSIC_QUEUE_SIZE = 4;
+uint16_t musicQueue[MUSIC_QUEUE_SIZE];
+uint16_t musicHistory[MUSIC_QUEUE_SIZE]; // Most recently played last.
+uint8_t i_music_queue_count = 0;
+uint8_t i_music_history_count = 0;
+bool b_music_track_reported = false; // The board has reported the current track as playing.
+
 /*
  * Volume percentage values (0 to 100)
  */
@@ -67,16 +90,47 @@ uint8_t i_volume_master_percentage = STARTUP_VOLUME; // Master overall volume
 uint8_t i_volume_effects_percentage = STARTUP_VOLUME_EFFECTS; // Sound effects
 uint8_t i_volume_music_percentage = STARTUP_VOLUME_MUSIC; // Music volume
 
+/*
+ * Volume Gain Tables
+ * The gain in dB for each volume percentage from 0 to 100, going from the given floor at 0% up to i_volume_abs_max.
+ * One table is kept for each floor in use, built when compiling.
+ */
+constexpr int8_t volumePercentageGain(int8_t i_floor, uint8_t i_percentage) {
+  return i_floor - (i_floor * i_percentage / 100);
+}
+
+template<int8_t FLOOR, typename PERCENTAGES = typename MakeIndexList<101>::type> struct VolumeGains;
+
+template<int8_t FLOOR, uint8_t... I> struct VolumeGains<FLOOR, IndexList<I...>> {
+  static const int8_t table[101];
+};
+
+template<int8_t FLOOR, uint8_t... I> const int8_t VolumeGains<FLOOR, IndexList<I...>>::table[101] PROGMEM = { volumePercentageGain(FLOOR, I)... };
+
+// Gain for an effects or music volume percentage.
+int8_t volumeGain(uint8_t i_percentage) {
+  return (int8_t) pgm_read_byte(&VolumeGains<i_volume_abs_min>::table[i_percentage]);
+}
+
+// Gain for a master volume percentage, whose floor depends on the audio board.
+int8_t masterVolumeGain(uint8_t i_percentage) {
+  if(i_volume_min_adj == i_gpstar_volume_min_adj) {
+    return (int8_t) pgm_read_byte(&VolumeGains<MINIMUM_VOLUME + i_gpstar_volume_min_adj>::table[i_percentage]);
+  }
+
+  return (int8_t) pgm_read_byte(&VolumeGains<MINIMUM_VOLUME>::table[i_percentage]);
+}
+
 /*
  * General Volume
  * Master Volume: (MINIMUM_VOLUME + i_volume_min_adj) = Quietest, i_volume_abs_max = Loudest
  * Effects/Music: i_volume_abs_min = Quietest, i_volume_abs_max = Loudest
  */
-int8_t i_volume_master = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * i_volume_master_percentage / 100); // Master overall volume
+int8_t i_volume_master = volumePercentageGain(MINIMUM_VOLUME, i_volume_master_percentage); // Master overall volume
 int8_t i_volume_master_eeprom = i_volume_master; // Master overall volume that is saved into the eeprom menu and loaded during bootup
 int8_t i_volume_revert = i_volume_master; // Used to restore volume level from a muted state.
-int8_t i_volume_effects = i_volume_abs_min - (i_volume_abs_min * i_volume_effects_percentage / 100); // Sound effects
-int8_t i_volume_music = i_volume_abs_min - (i_volume_abs_min * i_volume_music_percentage / 100); // Music volume
+int8_t i_volume_effects = volumePercentageGain(i_volume_abs_min, i_volume_effects_percentage); // Sound effects
+int8_t i_volume_music = volumePercentageGain(i_volume_abs_min, i_volume_music_percentage); // Music volume
 
 /*
  * Function Prototypes
@@ -85,6 +139,279 @@ void playEffect(uint16_t i_track_id, bool b_track_loop = false, int8_t i_track_v
 void stopEffect(uint16_t i_track_id);
 void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume = i_volume_effects, bool b_fade = false, uint16_t i_fade_time = 0);
 void updateMasterVolume(bool startup = false);
+bool crossfadeHasTrack(uint16_t i_track);
+void updateCrossfadeGains(uint8_t i_bus);
+
+#include "AudioQueue.h"
+
+/*
+ * Sound effect activity.
+ *
+ * Many stopEffect() calls are made just in case, for effects which are almost never playing. Each effect track has a
+ * bit here which is set when it is played and cleared when it is stopped, and a stop for a track whose bit is clear
+ * is not sent, as the board has nothing to stop. A track which has finished by itself keeps its bit until it is next
+ * stopped, as the effect lengths are not known here and the board's track reports arrive some time after a play, so
+ * one stop is still sent for it. Music tracks are not kept here and are always assumed to be playing.
+ */
+uint8_t audioTracksActive[i_last_effects_track / 8 + 1];
+uint32_t i_audio_stops_skipped = 0; // Stop commands not sent because the track was idle.
+
+// Whether the track may still be playing.
+bool audioTrackActive(uint16_t i_track) {
+  if(i_track > i_last_effects_track) {
+    return true;
+  }
+
+  return audioTracksActive[i_track / 8] & (1 << (i_track % 8));
+}
+
+void setAudioTrackActive(uint16_t i_track, bool b_active) {
+  if(i_track > i_last_effects_track) {
+    return;
+  }
+
+  if(b_active) {
+    audioTracksActive[i_track / 8] |= 1 << (i_track % 8);
+  }
+  else {
+    audioTracksActive[i_track / 8] &= ~(1 << (i_track % 8));
+  }
+}
+
+void audioTrackPlay(uint16_t i_track, bool b_lock) {
+  setAudioTrackActive(i_track, true);
+  queueAudioCommand(b_lock ? AUDIO_PLAY_LOCKED : AUDIO_PLAY, i_track);
+}
+
+void audioTrackStop(uint16_t i_track) {
+  if(!audioTrackActive(i_track)) {
+    i_audio_stops_skipped++;
+    return;
+  }
+
+  setAudioTrackActive(i_track, false);
+  queueAudioCommand(AUDIO_STOP, i_track);
+}
+
+void audioTrackGain(uint16_t i_track, int8_t i_gain) {
+  queueAudioCommand(AUDIO_GAIN, i_track, i_gain);
+}
+
+void audioTrackFade(uint16_t i_track, int8_t i_gain, uint16_t i_time) {
+  queueAudioCommand(AUDIO_FADE, i_track, i_gain, i_time);
+}
+
+void audioTrackLoop(uint16_t i_track, bool b_loop) {
+  queueAudioCommand(AUDIO_LOOP, i_track, b_loop);
+}
+
+void audioTrackPause(uint16_t i_track) {
+  queueAudioCommand(AUDIO_PAUSE, i_track);
+}
+
+void audioTrackResume(uint16_t i_track) {
+  queueAudioCommand(AUDIO_RESUME, i_track);
+}
+
+/*
+ * Volume buses.
+ *
+ * Each volume control sets the level of a bus: the master bus is the audio board's own master gain, the music bus
+ * the gain of the music track, and the effects bus the gain of sound effects. The Afterlife wand idle sounds the
+ * pack plays for the wand are on the wand idle bus, which stays i_wand_idle_level below the effects bus. Voice lines
+ * (see voiceTracks) are on the voice bus, which follows the effects volume as there is no separate voice control.
+ *
+ * Sound effects which may go on long enough for a volume change to be heard are listed in busTracks with their bus.
+ * Whenever one is played or has its gain adjusted, how far that gain is from its bus level is kept. When a bus level
+ * changes, only the tracks listed for that bus which may still be playing (see audioTrackActive()) are sent a new
+ * gain, being the new bus level with the same offset as before. Only one voice line plays at a time, so the voice
+ * bus keeps just the last one played along with its offset.
+ */
+enum AUDIO_BUSES : uint8_t { BUS_MASTER, BUS_EFFECTS, BUS_MUSIC, BUS_WAND_IDLE, BUS_VOICE };
+
+struct TrackRange {
+  uint16_t i_first;
+  uint16_t i_last;
+};
+
+const struct TrackRange voiceTracks[] PROGMEM = {
+  { S_VOICE_1984, S_VOICE_AFTERLIFE },
+  { S_VOICE_CROSS_THE_STREAMS_MIX, S_VOICE_NEUTRONA_WAND_VIBRATION_FIRING_DISABLED },
+  { S_VOICE_VIDEO_GAME_COLOURS_DISABLED, S_VOICE_VIDEO_GAME_COLOURS_CYCLOTRON_ENABLED },
+  { S_VOICE_POWERCELL_BRIGHTNESS, S_VOICE_PROTON_MIX_EFFECTS_DISABLED },
+  { S_VOICE_POWERCELL_15, S_VOICE_EEPROM_SAVE },
+  { S_VOICE_NEUTRONA_WAND_SOUNDS_ENABLED, S_VOICE_SPECTRAL_MODES_DISABLED },
+  { S_VOICE_QUICK_VENT_ENABLED, S_VOICE_BOOTUP_ERRORS_DISABLED },
+  { S_VOICE_NEUTRONA_WAND_1984, S_VOICE_NEUTRONA_WAND_BEEPING_ENABLED },
+  { S_VOICE_NEUTRONA_WAND_VIBRATION_DEFAULT, S_VOICE_PROTON_PACK_VIBRATION_DEFAULT },
+  { S_VOICE_CYCLOTRON_36, S_VOICE_NEUTRONA_WAND_SPEAKER_AMP_DISABLED },
+  { S_VOICE_EEPROM_LOADING_FAILED_RESET, S_VOICE_EEPROM_LOADING_FAILED_RESET },
+  { S_VOICE_INNER_CYCLOTRON_LED_PANEL_DISABLED, S_VOICE_INNER_CYCLOTRON_PANEL_BRIGHTNESS },
+  { S_VOICE_INNER_CYCLOTRON_36, S_VOICE_INNER_CYCLOTRON_26 },
+  { S_VOICE_INNER_CYCLOTRON_LED_PANEL_STATIC_COLORS, S_VOICE_INNER_CYCLOTRON_LED_PANEL_DYNAMIC_COLORS },
+  { S_VOICE_POWERCELL_NOT_INVERTED, S_VOICE_POWERCELL_INVERTED },
+  { S_VOICE_MOTORIZED_CYCLOTRON_ENABLED, S_VOICE_MOTORIZED_CYCLOTRON_ENABLED },
+  { S_VOICE_BARGRAPH_28_SEGMENTS, S_VOICE_CYCLOTRON_FADING_ENABLED }
+};
+
+const uint8_t VOICE_TRACK_RANGES = sizeof(voiceTracks) / sizeof(voiceTracks[0]);
+
+bool isVoiceTrack(uint16_t i_track) {
+  for(uint8_t i = 0; i < VOICE_TRACK_RANGES; i++) {
+    if(i_track >= pgm_read_word(&voiceTracks[i].i_first) && i_track <= pgm_read_word(&voiceTracks[i].i_last)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+struct BusTrack {
+  uint16_t i_track;
+  uint8_t i_bus;
+};
+
+const struct BusTrack busTracks[] PROGMEM = {
+  { S_BEEP_8, BUS_EFFECTS },
+  { S_WAND_BOOTUP, BUS_EFFECTS },
+  { S_PACK_RIBBON_ALARM_1, BUS_EFFECTS },
+  { S_ALARM_LOOP, BUS_EFFECTS },
+  { S_SMASH_ERROR_LOOP, BUS_EFFECTS },
+  { S_RIBBON_CABLE_START, BUS_EFFECTS },
+  { S_STEAM_LOOP, BUS_EFFECTS },
+  { S_SHUTDOWN, BUS_EFFECTS },
+  { S_GB1_1984_BOOT_UP, BUS_EFFECTS },
+  { S_GB1_1984_PACK_LOOP, BUS_EFFECTS },
+  { S_GB2_PACK_START, BUS_EFFECTS },
+  { S_GB2_PACK_LOOP, BUS_EFFECTS },
+  { S_BOOTUP, BUS_EFFECTS },
+  { S_AFTERLIFE_PACK_STARTUP, BUS_EFFECTS },
+  { S_AFTERLIFE_PACK_IDLE_LOOP, BUS_EFFECTS },
+  { S_FROZEN_EMPIRE_PACK_STARTUP, BUS_EFFECTS },
+  { S_FROZEN_EMPIRE_PACK_IDLE_LOOP, BUS_EFFECTS },
+  { S_PACK_SHUTDOWN_AFTERLIFE_ALT, BUS_EFFECTS },
+  { S_FROZEN_EMPIRE_PACK_SHUTDOWN, BUS_EFFECTS },
+  { S_FROZEN_EMPIRE_SHUTDOWN, BUS_EFFECTS },
+  { S_FROZEN_EMPIRE_BOOT_EFFECT, BUS_EFFECTS },
+  { S_PACK_BEEPS_OVERHEAT, BUS_EFFECTS },
+  { S_PACK_OVERHEAT_HOT, BUS_EFFECTS },
+  { S_GB1_FIRE_HIGH_POWER_LOOP, BUS_EFFECTS },
+  { S_GB1_1984_FIRE_LOOP_PACK, BUS_EFFECTS },
+  { S_GB1_1984_FIRE_HIGH_POWER_LOOP, BUS_EFFECTS },
+  { S_GB2_FIRE_LOOP, BUS_EFFECTS },
+  { S_FIRING_LOOP_GB1, BUS_EFFECTS },
+  { S_PACK_SLIME_TANK_LOOP, BUS_EFFECTS },
+  { S_SLIME_REFILL, BUS_EFFECTS },
+  { S_SLIME_LOOP, BUS_EFFECTS },
+  { S_STASIS_IDLE_LOOP, BUS_EFFECTS },
+  { S_STASIS_LOOP, BUS_EFFECTS },
+  { S_MESON_IDLE_LOOP, BUS_EFFECTS },
+  { S_POWERCELL, BUS_WAND_IDLE },
+  { S_AFTERLIFE_BEEP_WAND_S1, BUS_WAND_IDLE },
+  { S_AFTERLIFE_BEEP_WAND_S2, BUS_WAND_IDLE },
+  { S_AFTERLIFE_BEEP_WAND_S3, BUS_WAND_IDLE },
+  { S_AFTERLIFE_BEEP_WAND_S4, BUS_WAND_IDLE },
+  { S_AFTERLIFE_BEEP_WAND_S5, BUS_WAND_IDLE },
+  { S_AFTERLIFE_WAND_RAMP_1, BUS_WAND_IDLE },
+  { S_AFTERLIFE_WAND_RAMP_2, BUS_WAND_IDLE },
+  { S_AFTERLIFE_WAND_RAMP_2_FADE_IN, BUS_WAND_IDLE },
+  { S_AFTERLIFE_WAND_IDLE_1, BUS_WAND_IDLE },
+  { S_AFTERLIFE_WAND_IDLE_2, BUS_WAND_IDLE },
+  { S_AFTERLIFE_WAND_RAMP_DOWN_2, BUS_WAND_IDLE },
+  { S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT, BUS_WAND_IDLE },
+  { S_AFTERLIFE_WAND_RAMP_DOWN_1, BUS_WAND_IDLE }
+};
+
+const uint8_t BUS_TRACK_COUNT = sizeof(busTracks) / sizeof(busTracks[0]);
+int8_t busTrackOffsets[BUS_TRACK_COUNT]; // Gain of each listed track relative to its bus, as last played or adjusted.
+uint16_t i_bus_voice_track = 0; // The voice line last played.
+int8_t i_bus_voice_offset = 0; // Gain of that voice line relative to the voice bus.
+
+// The current level of a bus in dB.
+int8_t busGain(uint8_t i_bus) {
+  switch(i_bus) {
+    case BUS_MASTER:
+      return i_volume_master;
+    break;
+
+    case BUS_MUSIC:
+      return i_volume_music;
+    break;
+
+    case BUS_WAND_IDLE:
+      return i_volume_effects - i_wand_idle_level;
+    break;
+
+    case BUS_VOICE:
+    case BUS_EFFECTS:
+    default:
+      return i_volume_effects;
+    break;
+  }
+}
+
+// Where the track is in busTracks, or BUS_TRACK_COUNT if it is not listed.
+uint8_t busTrackIndex(uint16_t i_track) {
+  for(uint8_t i = 0; i < BUS_TRACK_COUNT; i++) {
+    if(pgm_read_word(&busTracks[i].i_track) == i_track) {
+      return i;
+    }
+  }
+
+  return BUS_TRACK_COUNT;
+}
+
+// Notes the gain a listed track has been given, relative to its bus.
+void setBusTrackGain(uint16_t i_track, int8_t i_gain) {
+  uint8_t i_index = busTrackIndex(i_track);
+
+  if(i_index < BUS_TRACK_COUNT) {
+    busTrackOffsets[i_index] = i_gain - busGain(pgm_read_byte(&busTracks[i_index].i_bus));
+  }
+  else if(isVoiceTrack(i_track)) {
+    i_bus_voice_track = i_track;
+    i_bus_voice_offset = i_gain - busGain(BUS_VOICE);
+  }
+}
+
+// Sends a track its gain on a bus, kept within what the audio board allows.
+void sendBusTrackGain(uint16_t i_track, int16_t i_gain) {
+  if(i_gain < i_volume_abs_min) {
+    i_gain = i_volume_abs_min;
+  }
+
+  if(i_gain > i_volume_abs_max) {
+    i_gain = i_volume_abs_max;
+  }
+
+  audioTrackGain(i_track, i_gain);
+}
+
+// Sends the new gain of each track on the bus which may still be playing.
+void updateBusTracks(uint8_t i_bus) {
+  int8_t i_bus_gain = busGain(i_bus);
+
+  if(i_bus == BUS_VOICE) {
+    if(i_bus_voice_track > 0 && audioTrackActive(i_bus_voice_track)) {
+      sendBusTrackGain(i_bus_voice_track, i_bus_gain + i_bus_voice_offset);
+    }
+
+    return;
+  }
+
+  for(uint8_t i = 0; i < BUS_TRACK_COUNT; i++) {
+    uint16_t i_track = pgm_read_word(&busTracks[i].i_track);
+
+    if(pgm_read_byte(&busTracks[i].i_bus) == i_bus && audioTrackActive(i_track) && !crossfadeHasTrack(i_track)) {
+      sendBusTrackGain(i_track, i_bus_gain + busTrackOffsets[i]);
+    }
+  }
+
+  // Tracks in a crossfade take the gains for how far it has got instead.
+  updateCrossfadeGains(i_bus);
+}
+
+#include "AudioFades.h"
 
 /*
  * Audio playback functions.
@@ -92,6 +419,9 @@ void updateMasterVolume(bool startup = false);
 
 // Play a sound effect using certain defaults.
 void playEffect(uint16_t i_track_id, bool b_track_loop, int8_t i_track_volume, bool b_fade_in, uint16_t i_fade_time, bool b_lock) {
+  setBusTrackGain(i_track_id, i_track_volume);
+  duckMusicForVoice(i_track_id);
+
   if(AUDIO_DEVICE == A_WAV_TRIGGER) {
     if(i_track_volume < i_volume_abs_min) {
       i_track_volume = i_volume_abs_min;
@@ -106,20 +436,20 @@ void playEffect(uint16_t i_track_id, bool b_track_loop, int8_t i_track_volume, b
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(b_fade_in) {
-        audio.trackGain(i_track_id, i_volume_abs_min);
-        audio.trackPlayPoly(i_track_id, b_lock);
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackGain(i_track_id, i_volume_abs_min);
+        audioTrackPlay(i_track_id, b_lock);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
-        audio.trackPlayPoly(i_track_id, b_lock);
+        audioTrackGain(i_track_id, i_track_volume);
+        audioTrackPlay(i_track_id, b_lock);
       }
 
       if(b_track_loop) {
-        audio.trackLoop(i_track_id, 1);
+        audioTrackLoop(i_track_id, true);
       }
       else {
-        audio.trackLoop(i_track_id, 0);
+        audioTrackLoop(i_track_id, false);
       }
     break;
 
@@ -131,10 +461,12 @@ void playEffect(uint16_t i_track_id, bool b_track_loop, int8_t i_track_volume, b
 }
 
 void stopEffect(uint16_t i_track_id) {
+  cancelCrossfade(i_track_id);
+
   switch(AUDIO_DEVICE) {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
-      audio.trackStop(i_track_id);
+      audioTrackStop(i_track_id);
     break;
 
     case A_NONE:
@@ -144,6 +476,158 @@ void stopEffect(uint16_t i_track_id) {
   }
 }
 
+/*
+ * Music playlist functions.
+ */
+
+// The track after the given one, going back to the first after the last.
+uint16_t musicTrackAfter(uint16_t i_track) {
+  if(i_track + 1 > i_music_track_start + i_music_count - 1) {
+    return i_music_track_start;
+  }
+
+  return i_track + 1;
+}
+
+// The track before the given one, going on to the last before the first.
+uint16_t musicTrackBefore(uint16_t i_track) {
+  if(i_track - 1 < i_music_track_start) {
+    return i_music_track_start + (i_music_count - 1);
+  }
+
+  return i_track - 1;
+}
+
+// Whether the track is playing, queued or was played recently, which shuffling avoids picking again.
+bool musicTrackInPlaylist(uint16_t i_track) {
+  if(i_track == i_current_music_track) {
+    return true;
+  }
+
+  for(uint8_t i = 0; i < i_music_queue_count; i++) {
+    if(musicQueue[i] == i_track) {
+      return true;
+    }
+  }
+
+  for(uint8_t i = 0; i < i_music_history_count; i++) {
+    if(musicHistory[i] == i_track) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Chooses the track to add to the end of the queue.
+uint16_t musicPickTrack() {
+  uint16_t i_last = i_music_queue_count > 0 ? musicQueue[i_music_queue_count - 1] : i_current_music_track;
+
+  if(b_music_shuffle) {
+    uint16_t i_track = i_music_track_start + random(i_music_count);
+
+    // Look on from the random pick for a track not heard recently.
+    for(uint16_t i = 0; i < i_music_count; i++) {
+      if(!musicTrackInPlaylist(i_track)) {
+        return i_track;
+      }
+
+      i_track = musicTrackAfter(i_track);
+    }
+  }
+
+  // In order, or when shuffling with too few tracks for any to be left out.
+  return musicTrackAfter(i_last);
+}
+
+void musicFillQueue() {
+  while(i_music_count > 0 && i_music_queue_count < MUSIC_QUEUE_SIZE) {
+    musicQueue[i_music_queue_count] = musicPickTrack();
+    i_music_queue_count++;
+  }
+}
+
+// Chooses the upcoming tracks again, after the current track or the play order has changed.
+void musicResetQueue() {
+  i_music_queue_count = 0;
+  musicFillQueue();
+}
+
+void musicHistoryAdd(uint16_t i_track) {
+  if(i_music_history_count == MUSIC_QUEUE_SIZE) {
+    // Forget the oldest track.
+    for(uint8_t i = 1; i < MUSIC_QUEUE_SIZE; i++) {
+      musicHistory[i - 1] = musicHistory[i];
+    }
+
+    i_music_history_count--;
+  }
+
+  musicHistory[i_music_history_count] = i_track;
+  i_music_history_count++;
+}
+
+// Makes the first queued track the current one.
+void musicAdvance() {
+  musicFillQueue();
+
+  if(i_music_queue_count == 0) {
+    return;
+  }
+
+  musicHistoryAdd(i_current_music_track);
+  i_current_music_track = musicQueue[0];
+  i_music_queue_count--;
+
+  for(uint8_t i = 0; i < i_music_queue_count; i++) {
+    musicQueue[i] = musicQueue[i + 1];
+  }
+
+  musicFillQueue();
+}
+
+// Makes the previous track the current one: the last one played when shuffling, otherwise the one numbered before it.
+void musicGoBack() {
+  if(b_music_shuffle && i_music_history_count > 0) {
+    // The current track is played next again.
+    if(i_music_queue_count == MUSIC_QUEUE_SIZE) {
+      i_music_queue_count--;
+    }
+
+    for(uint8_t i = i_music_queue_count; i > 0; i--) {
+      musicQueue[i] = musicQueue[i - 1];
+    }
+
+    musicQueue[0] = i_current_music_track;
+    i_music_queue_count++;
+
+    i_music_history_count--;
+    i_current_music_track = musicHistory[i_music_history_count];
+  }
+  else {
+    i_current_music_track = musicTrackBefore(i_current_music_track);
+    musicResetQueue();
+  }
+}
+
+// Makes the given track the current one, with the playlist carrying on from it.
+void musicSelectTrack(uint16_t i_track) {
+  musicHistoryAdd(i_current_music_track);
+  i_current_music_track = i_track;
+  musicResetQueue();
+}
+
+void toggleMusicShuffle() {
+  b_music_shuffle = !b_music_shuffle;
+
+  if(b_music_shuffle) {
+    // When the shuffle is turned on is as good a seed as any.
+    randomSeed(micros());
+  }
+
+  musicResetQueue();
+}
+
 // Play a music track using certain defaults.
 void playMusic() {
   if(i_music_count > 0 && i_current_music_track >= i_music_track_start) {
@@ -154,17 +638,18 @@ void playMusic() {
       case A_GPSTAR_AUDIO:
         // Loop the music track.
         if(b_repeat_track) {
-          audio.trackLoop(i_current_music_track, 1);
+          audioTrackLoop(i_current_music_track, 1);
         }
         else {
-          audio.trackLoop(i_current_music_track, 0);
+          audioTrackLoop(i_current_music_track, 0);
         }
 
-        audio.trackGain(i_current_music_track, i_volume_music);
-        audio.trackPlayPoly(i_current_music_track, true);
+        audioTrackGain(i_current_music_track, musicGain());
+        audioTrackPlay(i_current_music_track, true);
         audio.update();
 
         audio.resetTrackCounter();
+        b_music_track_reported = false;
       break;
 
       case A_NONE:
@@ -186,7 +671,7 @@ void stopMusic() {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(i_music_count > 0 && i_current_music_track >= i_music_track_start) {
-        audio.trackStop(i_current_music_track);
+        audioTrackStop(i_current_music_track);
       }
 
       audio.update();
@@ -214,7 +699,7 @@ void pauseMusic() {
     switch(AUDIO_DEVICE) {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
-        audio.trackPause(i_current_music_track);
+        audioTrackPause(i_current_music_track);
         audio.update();
       break;
 
@@ -241,8 +726,9 @@ void resumeMusic() {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
         audio.resetTrackCounter();
-        audio.trackResume(i_current_music_track);
+        audioTrackResume(i_current_music_track);
         audio.update();
+        b_music_track_reported = false;
       break;
 
       case A_NONE:
@@ -259,60 +745,38 @@ void resumeMusic() {
 }
 
 void musicNextTrack() {
-  uint16_t i_temp_track = i_current_music_track; // Used for music navigation.
-
-  // Determine the next track.
-  if(i_current_music_track + 1 > i_music_track_start + i_music_count - 1) {
-    // Start at the first track if already on the last.
-    i_temp_track = i_music_track_start;
-  }
-  else {
-    i_temp_track++;
-  }
-
   // Switch to the next track.
   if(b_playing_music) {
     // Stops music using the current track number as the identifier.
     stopMusic();
 
-    i_current_music_track = i_temp_track; // Change only AFTER stopping music playback.
+    musicAdvance(); // Change only AFTER stopping music playback.
 
     // Play the appropriate track on pack and wand, and notify the serial1 device.
     playMusic();
   }
   else {
     // Set the new track.
-    i_current_music_track = i_temp_track;
+    musicAdvance();
 
     serial1Send(A_MUSIC_IS_NOT_PLAYING, i_current_music_track); // Updates the music track on the attenuator.
   }
 }
 
 void musicPrevTrack() {
-  uint16_t i_temp_track = i_current_music_track; // Used for music navigation.
-
-  // Determine the previous track.
-  if(i_current_music_track - 1 < i_music_track_start) {
-    // Start at the last track if already on the first.
-    i_temp_track = i_music_track_start + (i_music_count - 1);
-  }
-  else {
-    i_temp_track--;
-  }
-
   // Switch to the previous track.
   if(b_playing_music) {
     // Stops music using the current track number as the identifier.
     stopMusic();
 
-    i_current_music_track = i_temp_track; // Change only AFTER stopping music playback.
+    musicGoBack(); // Change only AFTER stopping music playback.
 
     // Play the appropriate track on pack and wand, and notify the serial1 device.
     playMusic();
   }
   else {
     // Set the new track.
-    i_current_music_track = i_temp_track;
+    musicGoBack();
 
     serial1Send(A_MUSIC_IS_NOT_PLAYING, i_current_music_track); // Updates the music track on the attenuator.
   }
@@ -320,6 +784,8 @@ void musicPrevTrack() {
 
 // Adjust the gain of a single track.
 void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume, bool b_fade, uint16_t i_fade_time) {
+  setBusTrackGain(i_track_id, i_track_volume);
+
   if(i_track_volume < i_volume_abs_min) {
     i_track_volume = i_volume_abs_min;
   }
@@ -332,10 +798,10 @@ void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume, bool b_fade, u
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(b_fade) {
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
+        audioTrackGain(i_track_id, i_track_volume);
       }
     break;
 
@@ -383,7 +849,7 @@ void increaseVolumeEEPROM() {
       i_volume_master_percentage += VOLUME_MULTIPLIER;
     }
 
-    i_volume_master_eeprom = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * i_volume_master_percentage / 100);
+    i_volume_master_eeprom = masterVolumeGain(i_volume_master_percentage);
     i_volume_master = i_volume_master_eeprom;
     i_volume_revert = i_volume_master_eeprom;
 
@@ -403,7 +869,7 @@ void decreaseVolumeEEPROM() {
       i_volume_master_percentage -= VOLUME_MULTIPLIER;
     }
 
-    i_volume_master_eeprom = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * i_volume_master_percentage / 100);
+    i_volume_master_eeprom = masterVolumeGain(i_volume_master_percentage);
     i_volume_master = i_volume_master_eeprom;
     i_volume_revert = i_volume_master_eeprom;
 
@@ -423,7 +889,7 @@ void increaseVolume() {
       i_volume_master_percentage += VOLUME_MULTIPLIER;
     }
 
-    i_volume_master = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * i_volume_master_percentage / 100);
+    i_volume_master = masterVolumeGain(i_volume_master_percentage);
     i_volume_revert = i_volume_master;
 
     updateMasterVolume();
@@ -442,7 +908,7 @@ void decreaseVolume() {
       i_volume_master_percentage -= VOLUME_MULTIPLIER;
     }
 
-    i_volume_master = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * i_volume_master_percentage / 100);
+    i_volume_master = masterVolumeGain(i_volume_master_percentage);
     i_volume_revert = i_volume_master;
 
     updateMasterVolume();
@@ -453,105 +919,10 @@ void updateEffectsVolume() {
   switch(AUDIO_DEVICE) {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
-      // Only effects that are long or looped require adjustment.
-      audio.trackGain(S_BEEP_8, i_volume_effects);
-      audio.trackGain(S_WAND_BOOTUP, i_volume_effects);
-      audio.trackGain(S_PACK_RIBBON_ALARM_1, i_volume_effects);
-      audio.trackGain(S_ALARM_LOOP, i_volume_effects);
-      audio.trackGain(S_SMASH_ERROR_LOOP, i_volume_effects);
-      audio.trackGain(S_RIBBON_CABLE_START, i_volume_effects);
-      audio.trackGain(S_STEAM_LOOP, i_volume_effects);
-      audio.trackGain(S_SHUTDOWN, i_volume_effects);
-
-      switch(SYSTEM_YEAR) {
-        case SYSTEM_1984:
-          audio.trackGain(S_GB1_1984_BOOT_UP, i_volume_effects);
-          audio.trackGain(S_GB1_1984_PACK_LOOP, i_volume_effects);
-        break;
-
-        case SYSTEM_1989:
-          audio.trackGain(S_GB2_PACK_START, i_volume_effects);
-          audio.trackGain(S_GB2_PACK_LOOP, i_volume_effects);
-        break;
-
-        case SYSTEM_AFTERLIFE:
-        case SYSTEM_FROZEN_EMPIRE:
-        default:
-          if(STREAM_MODE == SLIME) {
-            // In slime blower mode these sounds have lower volume than normal.
-            audio.trackGain(S_BOOTUP, i_volume_effects - 30);
-            audio.trackGain(S_AFTERLIFE_PACK_STARTUP, i_volume_effects - 30);
-            audio.trackGain(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - 40);
-            audio.trackGain(S_FROZEN_EMPIRE_PACK_STARTUP, i_volume_effects - 30);
-            audio.trackGain(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, i_volume_effects - 40);
-          }
-          else {
-            audio.trackGain(S_BOOTUP, i_volume_effects);
-            audio.trackGain(S_AFTERLIFE_PACK_STARTUP, i_volume_effects);
-            audio.trackGain(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects);
-            audio.trackGain(S_FROZEN_EMPIRE_PACK_STARTUP, i_volume_effects);
-            audio.trackGain(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, i_volume_effects);
-          }
-
-          audio.trackGain(S_PACK_SHUTDOWN_AFTERLIFE_ALT, i_volume_effects);
-          audio.trackGain(S_FROZEN_EMPIRE_PACK_SHUTDOWN, i_volume_effects);
-          audio.trackGain(S_FROZEN_EMPIRE_SHUTDOWN, i_volume_effects);
-          audio.trackGain(S_POWERCELL, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_BEEP_WAND_S1, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_BEEP_WAND_S2, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_BEEP_WAND_S3, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_BEEP_WAND_S4, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_BEEP_WAND_S5, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_WAND_RAMP_1, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_WAND_RAMP_2, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_WAND_RAMP_2_FADE_IN, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_WAND_IDLE_1, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_WAND_IDLE_2, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_WAND_RAMP_DOWN_2, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_AFTERLIFE_WAND_RAMP_DOWN_1, i_volume_effects - i_wand_idle_level);
-          audio.trackGain(S_PACK_BEEPS_OVERHEAT, i_volume_effects);
-          audio.trackGain(S_PACK_OVERHEAT_HOT, i_volume_effects);
-
-          if(b_brass_pack_sound_loop) {
-            audio.trackGain(S_FROZEN_EMPIRE_BOOT_EFFECT, i_volume_effects);
-          }
-        break;
-      }
-
-      switch(STREAM_MODE) {
-        case PROTON:
-        default:
-          if(b_wand_firing) {
-            audio.trackGain(S_GB1_FIRE_HIGH_POWER_LOOP, i_volume_effects);
-            audio.trackGain(S_GB1_1984_FIRE_LOOP_PACK, i_volume_effects);
-            audio.trackGain(S_GB1_1984_FIRE_HIGH_POWER_LOOP, i_volume_effects);
-            audio.trackGain(S_GB2_FIRE_LOOP, i_volume_effects);
-            audio.trackGain(S_FIRING_LOOP_GB1, i_volume_effects);
-          }
-        break;
-
-        case SLIME:
-          audio.trackGain(S_PACK_SLIME_TANK_LOOP, i_volume_effects);
-          audio.trackGain(S_SLIME_REFILL, i_volume_effects);
-
-          if(b_wand_firing) {
-            audio.trackGain(S_SLIME_LOOP, i_volume_effects);
-          }
-        break;
-
-        case STASIS:
-          audio.trackGain(S_STASIS_IDLE_LOOP, i_volume_effects);
-
-          if(b_wand_firing) {
-            audio.trackGain(S_STASIS_LOOP, i_volume_effects);
-          }
-        break;
-
-        case MESON:
-          audio.trackGain(S_MESON_IDLE_LOOP, i_volume_effects);
-        break;
-      }
+      // The wand idle and voice buses follow the effects bus.
+      updateBusTracks(BUS_EFFECTS);
+      updateBusTracks(BUS_WAND_IDLE);
+      updateBusTracks(BUS_VOICE);
     break;
 
     case A_NONE:
@@ -575,7 +946,7 @@ void increaseVolumeEffects() {
     i_volume_effects_percentage += VOLUME_EFFECTS_MULTIPLIER;
   }
 
-  i_volume_effects = i_volume_abs_min - (i_volume_abs_min * i_volume_effects_percentage / 100);
+  i_volume_effects = volumeGain(i_volume_effects_percentage);
 
   updateEffectsVolume();
 }
@@ -592,7 +963,7 @@ void decreaseVolumeEffects() {
     i_volume_effects_percentage -= VOLUME_EFFECTS_MULTIPLIER;
   }
 
-  i_volume_effects = i_volume_abs_min - (i_volume_abs_min * i_volume_effects_percentage / 100);
+  i_volume_effects = volumeGain(i_volume_effects_percentage);
 
   updateEffectsVolume();
 }
@@ -602,7 +973,7 @@ void updateMusicVolume() {
     switch(AUDIO_DEVICE) {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
-        audio.trackGain(i_current_music_track, i_volume_music);
+        audioTrackGain(i_current_music_track, musicGain());
       break;
 
       case A_NONE:
@@ -627,7 +998,7 @@ void increaseVolumeMusic() {
     i_volume_music_percentage += VOLUME_MUSIC_MULTIPLIER;
   }
 
-  i_volume_music = i_volume_abs_min - (i_volume_abs_min * i_volume_music_percentage / 100);
+  i_volume_music = volumeGain(i_volume_music_percentage);
 
   updateMusicVolume();
 }
@@ -644,7 +1015,7 @@ void decreaseVolumeMusic() {
     i_volume_music_percentage -= VOLUME_MUSIC_MULTIPLIER;
   }
 
-  i_volume_music = i_volume_abs_min - (i_volume_abs_min * i_volume_music_percentage / 100);
+  i_volume_music = volumeGain(i_volume_music_percentage);
 
   updateMusicVolume();
 }
@@ -655,6 +1026,7 @@ void buildMusicCount(uint16_t i_num_tracks) {
 
   if(i_music_count > 0 && i_music_count < 4097) {
     i_current_music_track = i_music_track_start; // Set the first track of music as file 500_
+    musicResetQueue();
   }
   else {
     i_music_count = 0; // If the music count is corrupt, make it 0
@@ -704,56 +1076,61 @@ bool musicTrackStatus() {
   }
 }
 
-void checkMusic() {
-  if(ms_check_music.justFinished() && !ms_music_next_track.isRunning()) {
-    switch(AUDIO_DEVICE) {
-      case A_WAV_TRIGGER:
-      case A_GPSTAR_AUDIO:
-        ms_check_music.start(i_music_check_delay);
-
-        musicTrackPlayingStatus();
-
-        // Loop through all the tracks if the music is not set to repeat a track.
-        if(b_playing_music && !b_repeat_track && !b_music_paused) {
-          if(!musicTrackStatus() && ms_music_status_check.justFinished() && !musicIsTrackCounterReset()) {
-            ms_check_music.stop();
-            ms_music_status_check.stop();
-
-            stopMusic();
-
-            // Switch to the next track.
-            if(i_current_music_track + 1 > i_music_track_start + i_music_count - 1) {
-              i_current_music_track = i_music_track_start;
-            }
-            else {
-              i_current_music_track++;
-            }
-
-            // Start timer to prepare to play music again.
-            ms_music_next_track.start(i_music_next_track_delay);
-          }
-          else {
-            if(ms_music_status_check.justFinished()) {
-              ms_music_status_check.start(i_music_check_delay * 4);
-            }
-          }
-        }
-      break;
+// Moves straight on to the next track in the playlist once the current one has ended.
+void musicTrackFinished() {
+  musicAdvance();
+  playMusic();
+}
 
-      case A_NONE:
-      default:
-        // None
-      break;
+// Asks the board whether the current track is still playing, for boards which have not reported it.
+void musicPollTrack() {
+  if(ms_check_music.justFinished()) {
+    ms_check_music.start(i_music_check_delay);
+
+    musicTrackPlayingStatus();
+
+    if(!musicTrackStatus() && ms_music_status_check.justFinished() && !musicIsTrackCounterReset()) {
+      ms_music_status_check.stop();
+
+      stopMusic();
+      musicTrackFinished();
+    }
+    else {
+      if(ms_music_status_check.justFinished()) {
+        ms_music_status_check.start(i_music_check_delay * 4);
+      }
     }
   }
+}
 
-  // Start playing music again.
-  if(ms_music_next_track.justFinished()) {
-    ms_music_next_track.stop();
-    ms_check_music.start(i_music_check_delay);
+void checkMusic() {
+  // Nothing can end while the music is stopped or paused, or while the board loops the current track.
+  if(!b_playing_music || b_music_paused || b_repeat_track) {
+    return;
+  }
 
-    // Play the appropriate track on the pack and wand, and notify the serial1 device.
-    playMusic();
+  switch(AUDIO_DEVICE) {
+    case A_WAV_TRIGGER:
+      if(audio.isTrackPlaying(i_current_music_track)) {
+        b_music_track_reported = true;
+      }
+      else if(b_music_track_reported) {
+        // The board has reported that the track ended.
+        musicTrackFinished();
+      }
+      else {
+        musicPollTrack();
+      }
+    break;
+
+    case A_GPSTAR_AUDIO:
+      musicPollTrack();
+    break;
+
+    case A_NONE:
+    default:
+      // None
+    break;
   }
 }
 
@@ -766,14 +1143,14 @@ void toggleMusicLoop() {
         b_repeat_track = true;
 
         if(i_music_count > 0) {
-          audio.trackLoop(i_current_music_track, 1);
+          audioTrackLoop(i_current_music_track, 1);
         }
       }
       else {
         b_repeat_track = false;
 
         if(i_music_count > 0) {
-          audio.trackLoop(i_current_music_track, 0);
+          audioTrackLoop(i_current_music_track, 0);
         }
       }
     break;
@@ -812,6 +1189,7 @@ bool setupAudioDevice() {
 
   // Stop all tracks.
   audio.stopAllTracks();
+  memset(audioTracksActive, 0, sizeof(audioTracksActive));
 
   // Reset the sample rate offset. Only for the WAV Trigger.
   audio.samplerateOffset(0);
@@ -851,7 +1229,7 @@ bool setupAudioDevice() {
   if(audio.gpstarAudioHello()) {
     AUDIO_DEVICE = A_GPSTAR_AUDIO;
 
-    i_volume_min_adj = 10; // Moves minimum volume up for GPStar Audio since its minimum is higher.
+    i_volume_min_adj = i_gpstar_volume_min_adj; // Moves minimum volume up for GPStar Audio since its minimum is higher.
 
     debugln(F("Using GPStar Audio"));
 
@@ -873,6 +1251,7 @@ void updateAudio() {
   switch(AUDIO_DEVICE) {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
+      flushAudioQueue();
       audio.update();
     break;
 
@@ -0,0 +1,388 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Crossfades.
+ *
+ * crossfadeTracks() hands one sound effect over to a looping one without holding up the loop. Once the delay has
+ * passed the new track starts and rises to the given gain while the old one falls away from it, and when the time is
+ * up the old track is stopped. Either track may be S_EMPTY to fade a single track in or out. The gains follow a curve:
+ *
+ *   FADE_LINEAR       The audio board fades both tracks itself, linear in dB. Best for fading a single track.
+ *   FADE_EQUAL_POWER  The gains are stepped along an equal-power curve, so the two tracks together keep their
+ *                     loudness through the handoff rather than dipping in the middle.
+ *
+ * The given gain is kept relative to the bus of the new track (or the old one when fading out), and each step is
+ * worked out from the level that bus has at the time, so a volume change part way through carries on into the rest
+ * of the crossfade. The new track is noted on its bus at the gain it ends on, and the steps themselves leave the
+ * offsets kept for the bus alone. While a crossfade is under way, updateBusTracks() leaves its tracks to
+ * updateCrossfadeGains(), which gives them the gains for how far the crossfade has got.
+ *
+ * Each crossfade is timed from when it was asked for and driven by a scheduler timer, so a slow loop pass can hold a
+ * step up but never stretches the crossfade. A new crossfade replaces any pending one which involves either of its
+ * tracks, and stopEffect() on either track drops it. The start callback, if given, is called just before the new
+ * track starts and can return false to drop the crossfade instead. It must not start or stop any sound effects.
+ */
+typedef bool (*CrossfadeCallback)();
+
+enum FADE_CURVES : uint8_t { FADE_LINEAR, FADE_EQUAL_POWER };
+
+struct Crossfade {
+  uint32_t ms_start;
+  uint16_t i_from;
+  uint16_t i_to;
+  uint16_t i_time;
+  int8_t i_offset; // Gain the new track ends on, relative to the bus.
+  uint8_t i_bus;
+  uint8_t i_curve;
+  uint8_t i_step; // Steps of the curve taken so far, or CROSSFADE_WAITING before the new track has started.
+  CrossfadeCallback p_start;
+};
+
+const uint8_t CROSSFADES_MAX = 4;
+const uint8_t CROSSFADE_STEPS = 16;
+const uint8_t CROSSFADE_WAITING = 0xFF;
+
+// Attenuation in dB of a track fading in along the equal-power curve, -20 * log10(sin(step * pi / 32)) at each step.
+// A track fading out takes the same steps in reverse.
+const uint8_t equalPowerFade[CROSSFADE_STEPS + 1] PROGMEM = { 70, 20, 14, 11, 8, 7, 5, 4, 3, 2, 2, 1, 1, 0, 0, 0, 0 };
+
+struct Crossfade crossfades[CROSSFADES_MAX];
+uint8_t i_crossfades = 0;
+
+void runCrossfades();
+
+void removeCrossfade(uint8_t i_index) {
+  i_crossfades--;
+  crossfades[i_index] = crossfades[i_crossfades];
+}
+
+// Drops any crossfade which involves the track, leaving the tracks as they are.
+void cancelCrossfade(uint16_t i_track) {
+  if(i_track == S_EMPTY) {
+    return;
+  }
+
+  for(uint8_t i = i_crossfades; i > 0; i--) {
+    if(crossfades[i - 1].i_from == i_track || crossfades[i - 1].i_to == i_track) {
+      removeCrossfade(i - 1);
+    }
+  }
+
+  if(i_crossfades == 0) {
+    cancelTimer(runCrossfades);
+  }
+}
+
+// Whether the track is in a crossfade which has started.
+bool crossfadeHasTrack(uint16_t i_track) {
+  for(uint8_t i = 0; i < i_crossfades; i++) {
+    if(crossfades[i].i_step != CROSSFADE_WAITING && (crossfades[i].i_from == i_track || crossfades[i].i_to == i_track)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// The gain of the new track at the given step of the equal-power curve, from the current level of the bus.
+int8_t crossfadeGain(const struct Crossfade &fade, uint8_t i_step) {
+  int16_t i_gain = busGain(fade.i_bus) + fade.i_offset - pgm_read_byte(&equalPowerFade[i_step]);
+
+  if(i_gain < i_volume_abs_min) {
+    i_gain = i_volume_abs_min;
+  }
+
+  if(i_gain > i_volume_abs_max) {
+    i_gain = i_volume_abs_max;
+  }
+
+  return i_gain;
+}
+
+// Sends a track the gain for a step without changing its offset from its bus.
+void sendCrossfadeGain(uint16_t i_track, int8_t i_gain) {
+  switch(AUDIO_DEVICE) {
+    case A_WAV_TRIGGER:
+    case A_GPSTAR_AUDIO:
+      audioTrackGain(i_track, i_gain);
+    break;
+
+    case A_NONE:
+    default:
+      // No audio device connected.
+    break;
+  }
+}
+
+// Has the audio board fade a track over the rest of a linear crossfade.
+void sendCrossfadeFade(uint16_t i_track, int8_t i_gain, uint16_t i_time) {
+  switch(AUDIO_DEVICE) {
+    case A_WAV_TRIGGER:
+    case A_GPSTAR_AUDIO:
+      audioTrackFade(i_track, i_gain, i_time);
+    break;
+
+    case A_NONE:
+    default:
+      // No audio device connected.
+    break;
+  }
+}
+
+void startCrossfade(struct Crossfade &fade) {
+  if(fade.i_curve == FADE_EQUAL_POWER) {
+    if(fade.i_to != S_EMPTY) {
+      playEffect(fade.i_to, true, crossfadeGain(fade, 0));
+      setBusTrackGain(fade.i_to, crossfadeGain(fade, CROSSFADE_STEPS));
+    }
+  }
+  else {
+    if(fade.i_from != S_EMPTY) {
+      sendCrossfadeFade(fade.i_from, i_volume_abs_min, fade.i_time);
+    }
+
+    if(fade.i_to != S_EMPTY) {
+      playEffect(fade.i_to, true, crossfadeGain(fade, CROSSFADE_STEPS), true, fade.i_time);
+    }
+  }
+
+  fade.i_step = 0;
+}
+
+// Sets both gains for a later step of the curve, leaving out a track whose gain has not changed since the last one.
+void stepCrossfade(struct Crossfade &fade, uint8_t i_step) {
+  if(fade.i_curve == FADE_EQUAL_POWER) {
+    if(fade.i_to != S_EMPTY && pgm_read_byte(&equalPowerFade[i_step]) != pgm_read_byte(&equalPowerFade[fade.i_step])) {
+      sendCrossfadeGain(fade.i_to, crossfadeGain(fade, i_step));
+    }
+
+    if(fade.i_from != S_EMPTY && pgm_read_byte(&equalPowerFade[CROSSFADE_STEPS - i_step]) != pgm_read_byte(&equalPowerFade[CROSSFADE_STEPS - fade.i_step])) {
+      sendCrossfadeGain(fade.i_from, crossfadeGain(fade, CROSSFADE_STEPS - i_step));
+    }
+  }
+
+  fade.i_step = i_step;
+}
+
+// Gives the tracks of each crossfade under way on the bus the gains for how far it has got, after the bus level changes.
+void updateCrossfadeGains(uint8_t i_bus) {
+  for(uint8_t i = 0; i < i_crossfades; i++) {
+    struct Crossfade &fade = crossfades[i];
+
+    if(fade.i_bus != i_bus || fade.i_step == CROSSFADE_WAITING) {
+      continue;
+    }
+
+    if(fade.i_curve == FADE_EQUAL_POWER) {
+      if(fade.i_to != S_EMPTY) {
+        sendCrossfadeGain(fade.i_to, crossfadeGain(fade, fade.i_step));
+      }
+
+      if(fade.i_from != S_EMPTY) {
+        sendCrossfadeGain(fade.i_from, crossfadeGain(fade, CROSSFADE_STEPS - fade.i_step));
+      }
+    }
+    else if(fade.i_to != S_EMPTY) {
+      // The old track is fading to silence either way, so only the new one needs a new fade.
+      uint32_t i_elapsed = millis() - fade.ms_start;
+
+      if(i_elapsed < fade.i_time) {
+        sendCrossfadeFade(fade.i_to, crossfadeGain(fade, CROSSFADE_STEPS), fade.i_time - i_elapsed);
+      }
+    }
+  }
+}
+
+// Starts, steps and finishes the crossfades which are due, then waits for the next one.
+void runCrossfades() {
+  uint32_t i_now = millis();
+  uint32_t i_wait = 0xFFFFFFFF;
+
+  // Finished crossfades are replaced by the last one, which has already been seen to.
+  for(uint8_t i = i_crossfades; i > 0; i--) {
+    struct Crossfade &fade = crossfades[i - 1];
+
+    if(timerDueBefore(i_now, fade.ms_start)) {
+      if(fade.ms_start - i_now < i_wait) {
+        i_wait = fade.ms_start - i_now;
+      }
+
+      continue;
+    }
+
+    if(fade.i_step == CROSSFADE_WAITING) {
+      if(fade.p_start != NULL && !fade.p_start()) {
+        removeCrossfade(i - 1);
+        continue;
+      }
+
+      startCrossfade(fade);
+    }
+
+    uint32_t i_elapsed = i_now - fade.ms_start;
+    uint8_t i_step = CROSSFADE_STEPS;
+
+    if(i_elapsed < fade.i_time) {
+      i_step = i_elapsed * CROSSFADE_STEPS / fade.i_time;
+    }
+
+    if(i_step > fade.i_step) {
+      stepCrossfade(fade, i_step);
+    }
+
+    if(i_step == CROSSFADE_STEPS) {
+      uint16_t i_from = fade.i_from;
+
+      removeCrossfade(i - 1);
+
+      if(i_from != S_EMPTY) {
+        stopEffect(i_from);
+      }
+
+      continue;
+    }
+
+    uint32_t i_next = fade.i_time - i_elapsed;
+
+    if(fade.i_curve == FADE_EQUAL_POWER) {
+      i_next = ((uint32_t) (i_step + 1) * fade.i_time + CROSSFADE_STEPS - 1) / CROSSFADE_STEPS - i_elapsed;
+    }
+
+    if(i_next < i_wait) {
+      i_wait = i_next;
+    }
+  }
+
+  if(i_crossfades > 0) {
+    scheduleTimer(runCrossfades, i_wait);
+  }
+}
+
+// Hands the from track over to the to track, which loops, over the given time once the delay has passed.
+void crossfadeTracks(uint16_t i_from, uint16_t i_to, uint16_t i_time, uint8_t i_curve = FADE_EQUAL_POWER, int8_t i_gain = i_volume_effects, uint32_t i_delay = 0, CrossfadeCallback p_start = NULL) {
+  uint8_t i_index = busTrackIndex(i_to != S_EMPTY ? i_to : i_from);
+
+  cancelCrossfade(i_from);
+  cancelCrossfade(i_to);
+
+  if(i_crossfades == CROSSFADES_MAX) {
+    // With every crossfade taken, the handoff happens straight away.
+    if(p_start == NULL || p_start()) {
+      if(i_from != S_EMPTY) {
+        stopEffect(i_from);
+      }
+
+      if(i_to != S_EMPTY) {
+        playEffect(i_to, true, i_gain);
+      }
+    }
+
+    return;
+  }
+
+  struct Crossfade &fade = crossfades[i_crossfades];
+
+  fade.ms_start = millis() + i_delay;
+  fade.i_from = i_from;
+  fade.i_to = i_to;
+  fade.i_time = i_time;
+  fade.i_bus = BUS_EFFECTS;
+
+  if(i_index < BUS_TRACK_COUNT) {
+    fade.i_bus = pgm_read_byte(&busTracks[i_index].i_bus);
+  }
+
+  fade.i_offset = i_gain - busGain(fade.i_bus);
+  fade.i_curve = i_curve;
+  fade.i_step = CROSSFADE_WAITING;
+  fade.p_start = p_start;
+  i_crossfades++;
+
+  scheduleTimer(runCrossfades, 0);
+}
+
+/*
+ * Music ducking.
+ *
+ * While the wand fires or a voice line plays, the music track fades down by i_music_duck_level and then back up once
+ * nothing is ducking it. A voice line keeps the music ducked for i_voice_duck_time after it starts.
+ */
+enum MUSIC_DUCKS : uint8_t { DUCK_FIRING = 1, DUCK_VOICE = 2 };
+
+const uint8_t i_music_duck_level = 12; // How many dB the music drops by while ducked.
+const uint16_t i_music_duck_fade = 300; // Time taken to duck the music or bring it back.
+const uint16_t i_voice_duck_time = 2500; // How long a voice line keeps the music ducked.
+uint8_t i_music_ducks = 0; // What is ducking the music, from MUSIC_DUCKS.
+
+// The gain of the music track: the music volume, less the duck level while anything is ducking it.
+int8_t musicGain() {
+  int16_t i_gain = i_volume_music;
+
+  if(i_music_ducks != 0) {
+    i_gain -= i_music_duck_level;
+  }
+
+  if(i_gain < i_volume_abs_min) {
+    i_gain = i_volume_abs_min;
+  }
+
+  return i_gain;
+}
+
+void setMusicDuck(uint8_t i_duck, bool b_duck) {
+  bool b_was_ducked = i_music_ducks != 0;
+
+  if(b_duck) {
+    i_music_ducks |= i_duck;
+  }
+  else {
+    i_music_ducks &= ~i_duck;
+  }
+
+  if((i_music_ducks != 0) == b_was_ducked || i_music_count == 0 || i_current_music_track < i_music_track_start) {
+    return;
+  }
+
+  switch(AUDIO_DEVICE) {
+    case A_WAV_TRIGGER:
+    case A_GPSTAR_AUDIO:
+      audioTrackFade(i_current_music_track, musicGain(), i_music_duck_fade);
+    break;
+
+    case A_NONE:
+    default:
+      // Nothing.
+    break;
+  }
+}
+
+void voiceDuckFinished() {
+  setMusicDuck(DUCK_VOICE, false);
+}
+
+// Ducks the music under a voice line for a while after it starts.
+void duckMusicForVoice(uint16_t i_track) {
+  if(b_playing_music && isVoiceTrack(i_track)) {
+    setMusicDuck(DUCK_VOICE, true);
+    scheduleTimer(voiceDuckFinished, i_voice_duck_time);
+  }
+}
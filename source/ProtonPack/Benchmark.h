@@ -0,0 +1,329 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Loop stage markers, shared by two optional build modes. In a normal build the markers compile to nothing.
+ *
+ * GPSTAR_BENCHMARK: for the simavr cycle benchmark (.github/benchmark.sh). Entering a stage writes its ID
+ * to GPIOR0 and leaving it writes the ID to GPIOR1. These general purpose registers are unused by the
+ * firmware and a write costs a single cycle; the simulator records the cycle count at each write.
+ *
+ * GPSTAR_PROFILING: on-device profiling. Each stage is timed with micros() and accumulated into a small
+ * histogram. Send "p" on the USB console to print the histograms or "r" to reset them. The Attenuator
+ * may also request them with A_REQUEST_PROFILE, which are returned as one PACKET_PROFILE per stage.
+ *
+ * The stage IDs must be kept in sync with source/Benchmark/simavr_bench.c and across devices.
+ */
+enum BENCHMARK_STAGES : uint8_t {
+  BENCH_NONE,
+  BENCH_LOOP,
+  BENCH_MAIN_LOOP,
+  BENCH_SERIAL,
+  BENCH_SWITCHES,
+  BENCH_CYCLOTRON,
+  BENCH_POWERCELL,
+  BENCH_LED_SHOW,
+  BENCH_AUDIO,
+  BENCH_POWER_METER,
+  BENCH_HANDSHAKE,
+  BENCH_SERIAL1,
+  BENCH_MUSIC,
+  BENCH_PACK_STATE,
+  BENCH_TIMERS,
+  BENCH_STAGE_COUNT
+};
+
+#if defined(GPSTAR_PROFILING)
+  #define BENCHMARK_BEGIN(x) profileBegin(x)
+  #define BENCHMARK_END(x) profileEnd(x)
+#elif defined(GPSTAR_BENCHMARK)
+  #define BENCHMARK_BEGIN(x) GPIOR0 = (x)
+  #define BENCHMARK_END(x) GPIOR1 = (x)
+#else
+  #define BENCHMARK_BEGIN(x)
+  #define BENCHMARK_END(x)
+#endif
+
+#ifdef GPSTAR_PROFILING
+/*
+ * Histogram buckets are powers of two, from under 32us up to 4096us and over:
+ * <32, <64, <128, <256, <512, <1024, <2048, <4096, >=4096
+ */
+const uint8_t PROFILE_BUCKETS = 9;
+const uint8_t PROFILE_FIRST_BUCKET_SHIFT = 5; // 32us
+
+struct ProfileStats {
+  unsigned long start;
+  uint32_t samples;
+  uint32_t total;
+  uint16_t minimum;
+  uint16_t maximum;
+  uint16_t buckets[PROFILE_BUCKETS];
+};
+
+struct ProfileStats profileStats[BENCH_STAGE_COUNT];
+
+// Sent to the Attenuator, one packet per stage.
+struct __attribute__((packed)) ProfileData {
+  uint8_t stage;
+  uint32_t samples;
+  uint16_t minimum;
+  uint16_t average;
+  uint16_t maximum;
+  uint16_t buckets[PROFILE_BUCKETS];
+} profileData;
+
+void profileReset() {
+  memset(profileStats, 0, sizeof(profileStats));
+  memset(&wandDrain, 0, sizeof(wandDrain));
+  memset(&serial1Drain, 0, sizeof(serial1Drain));
+  memset(&wandLink, 0, sizeof(wandLink));
+  memset(&serial1Link, 0, sizeof(serial1Link));
+  i_led_frames_sent = 0;
+  i_led_frames_skipped = 0;
+  i_scheduler_dispatched = 0;
+  i_scheduler_late_max = 0;
+  i_audio_stops_skipped = 0;
+}
+
+void profileBegin(uint8_t i_stage) {
+  profileStats[i_stage].start = micros();
+}
+
+void profileEnd(uint8_t i_stage) {
+  struct ProfileStats &stats = profileStats[i_stage];
+  unsigned long i_elapsed = micros() - stats.start;
+  uint16_t i_elapsed_us = i_elapsed > 0xFFFF ? 0xFFFF : i_elapsed;
+  uint8_t i_bucket = 0;
+
+  while(i_bucket < PROFILE_BUCKETS - 1 && (i_elapsed >> (PROFILE_FIRST_BUCKET_SHIFT + i_bucket)) > 0) {
+    i_bucket++;
+  }
+
+  if(stats.samples == 0 || i_elapsed_us < stats.minimum) {
+    stats.minimum = i_elapsed_us;
+  }
+
+  if(i_elapsed_us > stats.maximum) {
+    stats.maximum = i_elapsed_us;
+  }
+
+  // Counters saturate rather than wrap; reset the profile to start a new measurement.
+  if(stats.samples < 0xFFFFFFFF && stats.total < 0xFFFFFFFF - i_elapsed) {
+    stats.samples++;
+    stats.total += i_elapsed;
+  }
+
+  if(stats.buckets[i_bucket] < 0xFFFF) {
+    stats.buckets[i_bucket]++;
+  }
+}
+
+// Copies the stats for one stage into the profileData packet. Returns false if the stage was never measured.
+bool profileFill(uint8_t i_stage) {
+  struct ProfileStats &stats = profileStats[i_stage];
+
+  if(stats.samples == 0) {
+    return false;
+  }
+
+  profileData.stage = i_stage;
+  profileData.samples = stats.samples;
+  profileData.minimum = stats.minimum;
+  profileData.average = stats.total / stats.samples;
+  profileData.maximum = stats.maximum;
+  memcpy(profileData.buckets, stats.buckets, sizeof(profileData.buckets));
+
+  return true;
+}
+
+void profilePrintStageName(uint8_t i_stage) {
+  switch(i_stage) {
+    case BENCH_LOOP:
+      Serial.print(F("loop()"));
+    break;
+    case BENCH_SERIAL:
+      Serial.print(F("checkWand()"));
+    break;
+    case BENCH_SWITCHES:
+      Serial.print(F("checkSwitches()"));
+    break;
+    case BENCH_CYCLOTRON:
+      Serial.print(F("cyclotronControl()"));
+    break;
+    case BENCH_POWERCELL:
+      Serial.print(F("powercellLoop()"));
+    break;
+    case BENCH_LED_SHOW:
+      Serial.print(F("FastLED.show()"));
+    break;
+    case BENCH_AUDIO:
+      Serial.print(F("updateAudio()"));
+    break;
+    case BENCH_POWER_METER:
+      Serial.print(F("checkPowerMeter()"));
+    break;
+    case BENCH_HANDSHAKE:
+      Serial.print(F("serial1HandShake()"));
+    break;
+    case BENCH_SERIAL1:
+      Serial.print(F("checkSerial1()"));
+    break;
+    case BENCH_MUSIC:
+      Serial.print(F("checkMusic()"));
+    break;
+    case BENCH_PACK_STATE:
+      Serial.print(F("PACK_STATE"));
+    break;
+    case BENCH_TIMERS:
+      Serial.print(F("runScheduledTimers()"));
+    break;
+    default:
+      Serial.print(i_stage);
+    break;
+  }
+}
+
+void profilePrintDrain(const struct SerialDrainStats &stats) {
+  Serial.print(',');
+  Serial.print(stats.lastPackets);
+  Serial.print(',');
+  Serial.print(stats.maxPackets);
+  Serial.print(',');
+  Serial.println(stats.deferred);
+}
+
+void profilePrintLink(const struct LinkStats &stats) {
+  uint32_t i_received = 0;
+
+  for(uint8_t i = 0; i < sizeof(stats.framesReceived) / sizeof(stats.framesReceived[0]); i++) {
+    i_received += stats.framesReceived[i];
+  }
+
+  Serial.print(',');
+  Serial.print(stats.framesSent);
+  Serial.print(',');
+  Serial.print(i_received);
+  Serial.print(',');
+  Serial.print(stats.retransmits);
+  Serial.print(',');
+  Serial.print(stats.crcErrors);
+  Serial.print(',');
+  Serial.print(stats.markerErrors);
+  Serial.print(',');
+  Serial.print(stats.handshakeTime);
+  Serial.print(',');
+  Serial.println(stats.maxFrameGap);
+}
+
+// Prints one line per measured stage: stage, samples, min/avg/max in microseconds, then the bucket counts.
+void profilePrint() {
+  Serial.println(F("stage,samples,min,avg,max,<32,<64,<128,<256,<512,<1024,<2048,<4096,>=4096"));
+
+  for(uint8_t i = BENCH_LOOP; i < BENCH_STAGE_COUNT; i++) {
+    if(!profileFill(i)) {
+      continue;
+    }
+
+    profilePrintStageName(i);
+    Serial.print(',');
+    Serial.print(profileData.samples);
+    Serial.print(',');
+    Serial.print(profileData.minimum);
+    Serial.print(',');
+    Serial.print(profileData.average);
+    Serial.print(',');
+    Serial.print(profileData.maximum);
+
+    for(uint8_t j = 0; j < PROFILE_BUCKETS; j++) {
+      Serial.print(',');
+      Serial.print(profileData.buckets[j]);
+    }
+
+    Serial.println();
+  }
+
+  // Serial backlog: packets handled on the last and busiest loop passes, and passes which left data waiting.
+  Serial.println(F("port,last,max,deferred"));
+  Serial.print(F("Wand"));
+  profilePrintDrain(wandDrain);
+  Serial.print(F("Serial1"));
+  profilePrintDrain(serial1Drain);
+
+  // Link quality: frames sent and received, reliable commands sent again, frames dropped, and timings in milliseconds.
+  Serial.println(F("link,sent,received,retransmits,crcErrors,markerErrors,handshakeTime,maxFrameGap"));
+  Serial.print(F("Wand"));
+  profilePrintLink(wandLink);
+  Serial.print(F("Serial1"));
+  profilePrintLink(serial1Link);
+
+  // LED frames: frames which wrote at least one chain, frames where no chain had changed, then the update interval in milliseconds and the percentage of time spent sending.
+  Serial.println(F("leds,sent,skipped,interval,duty"));
+  Serial.print(F("Frames,"));
+  Serial.print(i_led_frames_sent);
+  Serial.print(',');
+  Serial.print(i_led_frames_skipped);
+  Serial.print(',');
+  Serial.print(b_led_adaptive_rate ? i_led_frame_ms : FAST_LED_UPDATE_MS);
+  Serial.print(',');
+  Serial.println(ledDutyCycle());
+
+  // Timer scheduler: timers pending now, callbacks run, and the most milliseconds a callback ran after it was due.
+  Serial.println(F("timers,pending,dispatched,late"));
+  Serial.print(F("Scheduler,"));
+  Serial.print(i_scheduled_timers);
+  Serial.print(',');
+  Serial.print(i_scheduler_dispatched);
+  Serial.print(',');
+  Serial.println(i_scheduler_late_max);
+
+  // Sound effects: commands waiting to be sent to the audio board now, and stops not sent because the track was idle.
+  Serial.println(F("audio,waiting,stopsSkipped"));
+  Serial.print(F("Effects,"));
+  Serial.print(i_audio_queue_count);
+  Serial.print(',');
+  Serial.println(i_audio_stops_skipped);
+}
+
+// Handles profiling requests from the USB console.
+void profileCheckConsole() {
+  while(Serial.available() > 0) {
+    char c_command = Serial.read();
+
+    switch(c_command) {
+      case 'p':
+        profilePrint();
+      break;
+
+      case 'r':
+        profileReset();
+        Serial.println(F("Profile reset"));
+      break;
+
+#ifdef GPSTAR_SERIAL_RECORDER
+      default:
+        recorderConsoleCommand(c_command);
+      break;
+#endif
+    }
+  }
+}
+#endif
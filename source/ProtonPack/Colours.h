@@ -277,6 +277,34 @@ uint8_t getDeviceColour(uint8_t i_device, uint8_t i_firing_mode, bool b_toggle)
   }
 }
 
+/*
+ * Device colours for the current stream mode. They only change with the stream mode, year, Holiday theme or colour
+ * toggles, so updateDeviceColours() works them out again only when one of those has changed, and the draw code reads
+ * them with deviceColour(). The Cyclotron cavity steps through its colours on each call, so it still uses
+ * getDeviceColour(). This must match the number of device ENUM entries, as with i_curr_colour.
+ */
+uint8_t i_device_colour[6];
+uint16_t i_device_colour_settings = 0; // The settings the colours were worked out for; 0 before the first time.
+
+uint8_t deviceColour(uint8_t i_device) {
+  return i_device_colour[i_device];
+}
+
+void updateDeviceColours() {
+  uint16_t i_settings = 0x8000 | STREAM_MODE | (SYSTEM_YEAR << 4) | (b_christmas << 8) | (b_powercell_colour_toggle << 9) | (b_cyclotron_colour_toggle << 10);
+
+  if(i_settings == i_device_colour_settings) {
+    return;
+  }
+
+  i_device_colour[POWERCELL] = getDeviceColour(POWERCELL, STREAM_MODE, b_powercell_colour_toggle);
+  i_device_colour[CYCLOTRON_OUTER] = getDeviceColour(CYCLOTRON_OUTER, STREAM_MODE, b_cyclotron_colour_toggle);
+  i_device_colour[CYCLOTRON_INNER] = getDeviceColour(CYCLOTRON_INNER, STREAM_MODE, b_cyclotron_colour_toggle);
+  i_device_colour[CYCLOTRON_PANEL] = getDeviceColour(CYCLOTRON_PANEL, STREAM_MODE, b_cyclotron_colour_toggle);
+  i_device_colour[VENT_LIGHT] = getDeviceColour(VENT_LIGHT, STREAM_MODE, true);
+  i_device_colour_settings = i_settings;
+}
+
 CHSV getHue(uint8_t i_device, uint8_t i_colour, uint8_t i_brightness = 255, uint8_t i_saturation = 255, bool b_fade = false) {
   // Brightness here is a value from 0-255 as limited by byte (uint8_t) type.
 
@@ -520,15 +548,50 @@ CHSV getHue(uint8_t i_device, uint8_t i_colour, uint8_t i_brightness = 255, uint
   }
 }
 
+/*
+ * Resolved colour for each device. Animations ask for the same device colour LED after LED, with only the brightness
+ * changing, so the hue and saturation last converted to RGB are kept at full value and the HSV conversion is only
+ * redone when they change: on a new stream mode, year, colour toggle or custom colour, or as a colour cycle moves on.
+ * This must match the number of device ENUM entries, as with i_curr_colour.
+ */
+struct DevicePalette {
+  CRGB rgb; // At full value.
+  uint8_t i_hue;
+  uint8_t i_saturation;
+  bool b_valid;
+};
+
+struct DevicePalette devicePalette[6];
+
+CRGB getPaletteRGB(uint8_t i_device, CHSV hsv) {
+  struct DevicePalette &palette = devicePalette[i_device];
+
+  if(!palette.b_valid || palette.i_hue != hsv.hue || palette.i_saturation != hsv.sat) {
+    hsv2rgb_rainbow(CHSV(hsv.hue, hsv.sat, 255), palette.rgb);
+    palette.i_hue = hsv.hue;
+    palette.i_saturation = hsv.sat;
+    palette.b_valid = true;
+  }
+
+  if(hsv.val == 255) {
+    return palette.rgb;
+  }
+
+  // Dim by the value the same way hsv2rgb_rainbow() does, which is after it applies the hue and saturation.
+  uint8_t i_value = scale8_video(hsv.val, hsv.val);
+
+  if(i_value == 0) {
+    return CRGB(0, 0, 0);
+  }
+
+  return CRGB(scale8(palette.rgb.r, i_value), scale8(palette.rgb.g, i_value), scale8(palette.rgb.b, i_value));
+}
+
 CRGB getHueAsRGB(uint8_t i_device, uint8_t i_colour, uint8_t i_brightness = 255, bool b_grb = false, bool b_fade = false) {
   // Brightness here is a value from 0-255 as limited by byte (uint8_t) type.
 
-  // Get the initial colour using the HSV scheme.
-  CHSV hsv = getHue(i_device, i_colour, i_brightness, 255, b_fade);
-
-  // Convert from HSV to RGB.
-  CRGB rgb; // RGB Array as { r, g, b }
-  hsv2rgb_rainbow(hsv, rgb);
+  // Get the initial colour using the HSV scheme, then convert from HSV to RGB.
+  CRGB rgb = getPaletteRGB(i_device, getHue(i_device, i_colour, i_brightness, 255, b_fade)); // RGB Array as { r, g, b }
 
   if(b_grb) {
     // Swap red/green values before returning.
@@ -547,13 +610,121 @@ CRGB getHueAsGRB(uint8_t i_device, uint8_t i_colour, uint8_t i_brightness = 255)
 CRGB getHueAsGBR(uint8_t i_device, uint8_t i_colour, uint8_t i_brightness = 255) {
   // Brightness here is a value from 0-255 as limited by byte (uint8_t) type.
 
-  // Get the initial colour using the HSV scheme.
-  CHSV hsv = getHue(i_device, i_colour, i_brightness);
-
-  // Convert from HSV to RGB.
-  CRGB rgb; // RGB Array as { r, g, b }
-  hsv2rgb_rainbow(hsv, rgb);
+  // Get the initial colour using the HSV scheme, then convert from HSV to RGB.
+  CRGB rgb = getPaletteRGB(i_device, getHue(i_device, i_colour, i_brightness)); // RGB Array as { r, g, b }
 
   // Swap colour values before returning.
   return CRGB(rgb[1], rgb[2], rgb[0]);
-}
\ No newline at end of file
+}
+
+/*
+ * LED Frame Commit
+ *
+ * Writes out only the LED chains whose colours changed since they were last written, as each chain holds
+ * interrupts off for about 30us per LED while it is sent. Each chain keeps a copy of the colours it last sent.
+ */
+const uint8_t i_led_chain_max = 2;
+CRGB pack_leds_sent[sizeof(pack_leds) / sizeof(CRGB)]; // Power Cell and Cyclotron lid colours as last sent.
+CRGB cyclotron_leds_sent[sizeof(cyclotron_leds) / sizeof(CRGB)]; // Inner Cyclotron colours as last sent.
+CRGB * const led_chain_sent[i_led_chain_max] = { pack_leds_sent, cyclotron_leds_sent }; // Indexed by LED chain.
+uint8_t i_led_chains_written = 0; // Bit set for each chain written at least once.
+uint8_t i_led_brightness_written = 0;
+uint32_t i_led_frames_sent = 0; // Frames where at least one chain was written.
+uint32_t i_led_frames_skipped = 0; // Frames where no chain had changed.
+
+// Replaces FastLED.show(), writing only those chains in the given set which changed. Returns true if any was written.
+bool commitLedFrame(uint8_t i_chains = 0xFF) {
+  uint8_t i_brightness = FastLED.getBrightness();
+  bool b_sent = false;
+
+  if(i_brightness != i_led_brightness_written) {
+    // Every chain is scaled by the brightness, so all must be written again.
+    i_led_chains_written = 0;
+    i_led_brightness_written = i_brightness;
+  }
+
+  for(uint8_t i = 0; i < FastLED.count() && i < i_led_chain_max; i++) {
+    if(!(i_chains & (1 << i))) {
+      continue;
+    }
+
+    CLEDController &chain = FastLED[i];
+    size_t i_chain_bytes = chain.size() * sizeof(CRGB);
+
+    if((i_led_chains_written & (1 << i)) && memcmp(chain.leds(), led_chain_sent[i], i_chain_bytes) == 0) {
+      continue;
+    }
+
+    chain.showLeds(i_brightness);
+    memcpy(led_chain_sent[i], chain.leds(), i_chain_bytes);
+    i_led_chains_written |= 1 << i;
+    b_sent = true;
+  }
+
+  if(b_sent) {
+    i_led_frames_sent++;
+  }
+  else {
+    i_led_frames_skipped++;
+  }
+
+  return b_sent;
+}
+
+// Sends only as many LEDs as are in use on a chain, first turning off any which are no longer in use.
+void resizeLedChain(uint8_t i_chain, uint8_t i_num_leds) {
+  CLEDController &chain = FastLED[i_chain];
+
+  if(i_num_leds < chain.size()) {
+    fill_solid(chain.leds() + i_num_leds, chain.size() - i_num_leds, CRGB::Black);
+    chain.showLeds(FastLED.getBrightness());
+  }
+
+  chain.setLeds(chain.leds(), i_num_leds);
+  i_led_chains_written &= ~(1 << i_chain);
+}
+
+// Time in microseconds to send every LED in use.
+uint16_t ledSendTime() {
+  return (FastLED[PACK_LED_CHAIN].size() + FastLED[CYCLOTRON_LED_CHAIN].size()) * i_led_send_us;
+}
+
+// Chooses the shortest LED update interval which keeps the time spent sending to the LEDs within i_led_duty_max percent.
+void updateLedFrameRate() {
+  uint8_t i_duty = i_led_duty_max;
+
+  if(i_duty < 10) {
+    i_duty = 10;
+  }
+  else if(i_duty > 90) {
+    i_duty = 90;
+  }
+
+  uint16_t i_ms = ((uint32_t) ledSendTime() * 100 / i_duty + 999) / 1000;
+
+  if(i_ms < LED_ADAPTIVE_MIN_MS) {
+    i_ms = LED_ADAPTIVE_MIN_MS;
+  }
+  else if(i_ms > LED_ADAPTIVE_MAX_MS) {
+    i_ms = LED_ADAPTIVE_MAX_MS;
+  }
+
+  i_led_frame_ms = i_ms;
+}
+
+// Returns the delay for an LED timer, using the adaptive interval in place of its default when enabled.
+uint8_t ledFrameDelay(uint8_t i_delay, uint8_t i_default) {
+  if(!b_led_adaptive_rate) {
+    return i_delay;
+  }
+
+  // Keep any time an animation adds to the default, such as when skipping frames for a fast Cyclotron.
+  return i_led_frame_ms + (i_delay > i_default ? i_delay - i_default : 0);
+}
+
+// Percentage of the time spent sending to the LEDs at the current update interval.
+uint8_t ledDutyCycle() {
+  uint8_t i_ms = b_led_adaptive_rate ? i_led_frame_ms : FAST_LED_UPDATE_MS;
+
+  return (uint32_t) ledSendTime() * 100 / (i_ms * 1000UL);
+}
@@ -141,7 +141,11 @@ enum pack_messages : uint8_t {
   P_INNER_CYCLOTRON_PANEL_DYNAMIC,
   P_POWERCELL_NOT_INVERTED,
   P_POWERCELL_INVERTED,
-  P_POST_FINISH
+  P_POST_FINISH,
+  P_BAUD_RATE,
+  P_BAUD_RATE_CONFIRM,
+  P_RELIABLE,
+  P_REQUEST_LINK_STATS
 };
 
 enum wand_messages : uint8_t {
@@ -356,7 +360,11 @@ enum wand_messages : uint8_t {
   W_TOGGLE_CYCLOTRON_FADING,
   W_BARGRAPH_28_SEGMENTS,
   W_BARGRAPH_30_SEGMENTS,
-  W_COM_SOUND_NUMBER
+  W_COM_SOUND_NUMBER,
+  W_BAUD_RATE,
+  W_COMMAND_BATCH,
+  W_RELIABLE,
+  W_SEND_LINK_STATS
 };
 
 enum api_messages : uint8_t {
@@ -444,5 +452,15 @@ enum api_messages : uint8_t {
   A_SEND_PREFERENCES_SMOKE,
   A_SAVE_PREFERENCES_PACK,
   A_SAVE_PREFERENCES_WAND,
-  A_SAVE_PREFERENCES_SMOKE
+  A_SAVE_PREFERENCES_SMOKE,
+  A_REQUEST_PROFILE,
+  A_SEND_PROFILE,
+  A_BAUD_RATE,
+  A_BAUD_RATE_CONFIRM,
+  A_SYNC_DELTA_ACK,
+  A_SYNC_DELTA_RESYNC,
+  A_COMMAND_BATCH,
+  A_REQUEST_LINK_STATS,
+  A_SEND_LINK_STATS,
+  A_MUSIC_SHUFFLE_TOGGLE
 };
\ No newline at end of file
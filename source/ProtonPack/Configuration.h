@@ -36,7 +36,12 @@
  *
  * Any settings saved in the EEPROM menu will overwrite these settings.
  */
-uint8_t i_cyclotron_leds = 12;
+#ifdef BENCHMARK_CYCLOTRON_LEDS
+  // Set by the simavr benchmark (.github/benchmark.sh) to measure each supported ring size.
+  uint8_t i_cyclotron_leds = BENCHMARK_CYCLOTRON_LEDS;
+#else
+  uint8_t i_cyclotron_leds = 12;
+#endif
 
 /*
  * Cyclotron Lid LED delays.
@@ -56,22 +61,17 @@ const uint16_t i_1984_delay = 275;
 #define CYCLOTRON_DELAY_2021_40_LED 7 // For 40 LEDs.
 
 /*
- * This is the middle LED aligned in each lens window. (0 is the first LED). Adjust these settings if you use different LED setups and installations.
- * Put the sequence in order from lowest to highest in both directions. (Top right lens as Cyclotron lens #1)
+ * This is the middle LED aligned in each lens window for 1984/1989 mode. (0 is the first LED). Adjust these settings if you use different LED setups and installations.
+ * Put the sequence in clockwise order, starting from the top right lens (Cyclotron lens #1). The counter clockwise order is worked out from it.
  *
- * i_1984_cyclotron_12_leds is for the stock Haslab 12 LED setup.
- * i_1984_cyclotron_20_leds is for the Frutto Technology 20 LED setup.
- * i_1984_cyclotron_36_leds is for the Frutto Technology Max 36 LED setup.
- * i_1984_cyclotron_40_leds is for a 40 LED NeoPixel ring.
+ * Any setup not listed here uses the middle LED of each quarter of the Cyclotron Lid, which suits LEDs spread evenly across the four lenses.
+ * For example the stock HasLab 12 LED setup uses 1, 4, 7, 10, the Frutto Technology 20 LED setup uses 2, 7, 12, 17 and the Frutto Technology Max 36 LED setup uses 4, 13, 22, 31.
+ *
+ * To align one of those differently, add a line such as #define CYCLOTRON_LENSES_12_LED 1, 4, 7, 10 below.
+ *
+ * CYCLOTRON_LENSES_40_LED is for a 40 LED NeoPixel ring, aligned so that the first LED is in the middle of the first lens.
  */
-const uint8_t i_1984_cyclotron_12_leds_cw[4] PROGMEM = { 1, 4, 7, 10 };
-const uint8_t i_1984_cyclotron_12_leds_ccw[4] PROGMEM = { 1, 10, 7, 4 };
-const uint8_t i_1984_cyclotron_20_leds_cw[4] PROGMEM = { 2, 7, 12, 17 };
-const uint8_t i_1984_cyclotron_20_leds_ccw[4] PROGMEM = { 2, 17, 12, 7 };
-const uint8_t i_1984_cyclotron_36_leds_cw[4] PROGMEM = { 4, 13, 22, 31 };
-const uint8_t i_1984_cyclotron_36_leds_ccw[4] PROGMEM = { 4, 31, 22, 13 };
-const uint8_t i_1984_cyclotron_40_leds_cw[4] PROGMEM = { 0, 10, 18, 28 };
-const uint8_t i_1984_cyclotron_40_leds_ccw[4] PROGMEM = { 0, 28, 18, 10 };
+#define CYCLOTRON_LENSES_40_LED 0, 10, 18, 28
 
 /*
  * Cyclotron direction
@@ -173,7 +173,12 @@ bool b_powercell_colour_toggle = true;
  * 35 -> For a 35 LED NeoPixel Ring. (Recommended aftermarket ring size)
  * 36 -> For a 36 LED NeoPixel Ring. (GPStar ring)
  */
-uint8_t i_inner_cyclotron_cake_num_leds = 35;
+#ifdef BENCHMARK_INNER_CYCLOTRON_LEDS
+  // Set by the simavr benchmark (.github/benchmark.sh) to measure each supported ring size.
+  uint8_t i_inner_cyclotron_cake_num_leds = BENCHMARK_INNER_CYCLOTRON_LEDS;
+#else
+  uint8_t i_inner_cyclotron_cake_num_leds = 35;
+#endif
 
 /*
  * (OPTIONAL) Inner Cyclotron (cavity) effects
@@ -210,6 +215,27 @@ uint8_t i_2021_inner_delay = INNER_CYCLOTRON_DELAY_2021_35_LED;
 bool b_grb_cyclotron_cake = false; // Default is false (assumed to be RGB)
 bool b_gbr_cyclotron_cavity = true; // Default is true (set false for RGB)
 
+/*
+ * Inner Cyclotron LED update delay in milliseconds.
+ * The Inner Cyclotron panel, cake and cavity LEDs are updated separately from the Power Cell and Cyclotron Lid LEDs.
+ * The lower the number, the smoother the Inner Cyclotron animations, at the cost of more time spent sending to the LEDs.
+ * If you use a large cake and cavity and notice the Neutrona Wand or Attenuator lagging, raise this a little.
+ * Default is 6. Value range: 4 <--> 15
+ */
+#define CYCLOTRON_LED_UPDATE_MS 6
+
+/*
+ * Adaptive LED frame rate.
+ * When set to true, the time between LED updates is chosen from the number of LEDs in use, so that no more than i_led_duty_max
+ * percent of the time is spent sending to the LEDs (the pack cannot react to anything else while they are sent).
+ * Smaller setups such as the stock HasLab LEDs then update more often than the default, while large Cyclotron rings and cakes
+ * update less often, leaving more time for the switches, serial communication and audio.
+ * When set to false, the LEDs are updated every 6 milliseconds regardless of how many are in use (default).
+ * Value range for i_led_duty_max: 10 <--> 90
+ */
+bool b_led_adaptive_rate = false;
+uint8_t i_led_duty_max = 40;
+
 /*
  * The CHSV colour value for the Spectral Custom mode.
  * This can be adjusted in the EEPROM LED menu. Any EEPROM settings will overwrite these values.
@@ -176,7 +176,30 @@ CRGB cyclotron_leds[INNER_CYCLOTRON_LED_PANEL_MAX + INNER_CYCLOTRON_CAKE_LED_MAX
  */
 #define FAST_LED_UPDATE_MS 6
 uint8_t i_fast_led_delay = FAST_LED_UPDATE_MS;
-millisDelay ms_fast_led;
+bool b_fast_led_due = false; // Set by the timer scheduler when the Power Cell, Cyclotron Lid and N-Filter LEDs are due.
+
+/*
+ * The Inner Cyclotron (panel, cake and cavity) LEDs are on their own data pin, and are written on their own timer
+ * every CYCLOTRON_LED_UPDATE_MS (see Configuration.h). When both chains are due in the same loop pass the Inner
+ * Cyclotron waits for the next pass, so interrupts are only ever held off while one chain is written.
+ */
+uint8_t i_cyclotron_led_delay = CYCLOTRON_LED_UPDATE_MS;
+bool b_cyclotron_led_due = false; // Set by the timer scheduler.
+
+/*
+ * Bounds in milliseconds for the LED update interval when b_led_adaptive_rate is enabled,
+ * and the time in microseconds to send one LED at 800kHz.
+ */
+#define LED_ADAPTIVE_MIN_MS 2
+#define LED_ADAPTIVE_MAX_MS 15
+const uint8_t i_led_send_us = 30;
+uint8_t i_led_frame_ms = FAST_LED_UPDATE_MS; // Interval chosen for the LEDs in use.
+
+// Order in which the LED chains are added to FastLED.
+enum LED_CHAINS : uint8_t {
+  PACK_LED_CHAIN = 0,
+  CYCLOTRON_LED_CHAIN = 1
+};
 
 /*
  * Power Cell LEDs control.
@@ -187,10 +210,6 @@ millisDelay ms_powercell;
 bool b_powercell_updating = false;
 uint8_t i_powercell_multiplier = 1;
 bool b_powercell_sound_loop = false;
-const uint8_t powercell_15_invert[15] PROGMEM = {14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
-const uint8_t powercell_15[15] PROGMEM = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 };
-const uint8_t powercell_13[13] PROGMEM = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
-const uint8_t powercell_13_invert[13] PROGMEM = {12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
 
 /*
  * State of the pack.
@@ -228,20 +247,90 @@ bool b_reset_start_led = true;
 bool b_1984_led_start = true;
 millisDelay ms_cyclotron;
 millisDelay ms_cyclotron_slime_effect;
-rampUnsignedInt r_outer_cyclotron_ramp;
-bool b_cyclotron_led_fading_in[OUTER_CYCLOTRON_LED_MAX] = { false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false, false };
-ramp r_cyclotron_led_fade_out[OUTER_CYCLOTRON_LED_MAX] = {};
-ramp r_cyclotron_led_fade_in[OUTER_CYCLOTRON_LED_MAX] = {};
 uint8_t i_cyclotron_led_value[OUTER_CYCLOTRON_LED_MAX] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
 uint8_t i_cyclotron_fake_ring_counter = 0; // Counter used by the ring simulation code to count how many times we have processed the "0" value in the matrix.
 bool b_cyclotron_lid_on = true;
 bool b_brass_pack_sound_loop = false;
+const uint16_t i_brass_pack_fade_in = 2000; // Time taken to bring in the brass pack sound loop.
+const uint16_t i_brass_pack_fade_out = 1000; // Time taken for the brass pack sound loop to fade away when the lid goes on.
+
+/*
+ * Cyclotron lookup tables, generated at compile time for each number of Cyclotron Lid LEDs.
+ * To support another number of LEDs, add a case for it to bindCyclotronTables().
+ */
+
+// The numbers 0 to N - 1 as a template parameter list, used to fill each table.
+template<uint8_t... I> struct IndexList {};
+template<uint8_t N, uint8_t... I> struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+template<uint8_t... I> struct MakeIndexList<0, I...> { typedef IndexList<I...> type; };
 
 // For the Afterlife and Frozen Empire Cyclotron matrix pattern, map a location on a circle of 40 positions to a target LED (where 0 is the top-right lens).
-const uint8_t i_cyclotron_12led_matrix[OUTER_CYCLOTRON_LED_MAX] PROGMEM = { 1, 2, 3, 0, 0, 0, 0, 0, 0, 0, 4, 5, 6, 0, 0, 0, 0, 0, 0, 0, 7, 8, 9, 0, 0, 0, 0, 0, 0, 0, 10, 11, 12, 0, 0, 0, 0, 0, 0, 0 };
-const uint8_t i_cyclotron_20led_matrix[OUTER_CYCLOTRON_LED_MAX] PROGMEM = { 1, 2, 3, 4, 5, 0, 0, 0, 0, 0, 6, 7, 8, 9, 10, 0, 0, 0, 0, 0, 11, 12, 13, 14, 15, 0, 0, 0, 0, 0, 16, 17, 18, 19, 20, 0, 0, 0, 0, 0 };
-const uint8_t i_cyclotron_36led_matrix[OUTER_CYCLOTRON_LED_MAX] PROGMEM = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 0, 10, 11, 12, 13, 14, 15, 16, 17, 18, 0, 19, 20, 21, 22, 23, 24, 25, 26, 27, 0, 28, 29, 30, 31, 32, 33, 34, 35, 36, 0 };
-const uint8_t i_cyclotron_40led_matrix[OUTER_CYCLOTRON_LED_MAX] PROGMEM = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40 };
+// Each lens covers 10 positions, and the LEDs are shared evenly between the lenses from the start of each; any other position has no LED (0).
+constexpr uint8_t cyclotronMatrixLed(uint8_t i_leds, uint8_t i_position) {
+  return (i_position % 10) < (i_leds / 4) ? (i_position / 10) * (i_leds / 4) + (i_position % 10) + 1 : 0;
+}
+
+template<uint8_t LEDS, typename POSITIONS = typename MakeIndexList<OUTER_CYCLOTRON_LED_MAX>::type> struct CyclotronMatrix;
+
+template<uint8_t LEDS, uint8_t... I> struct CyclotronMatrix<LEDS, IndexList<I...>> {
+  static const uint8_t table[OUTER_CYCLOTRON_LED_MAX];
+};
+
+template<uint8_t LEDS, uint8_t... I> const uint8_t CyclotronMatrix<LEDS, IndexList<I...>>::table[OUTER_CYCLOTRON_LED_MAX] PROGMEM = { cyclotronMatrixLed(LEDS, I)... };
+
+// For 1984/1989 mode, the LED in the middle of each lens in clockwise order. By default this is the middle LED of each quarter of the Cyclotron Lid.
+template<uint8_t LEDS> struct CyclotronLenses {
+  static const uint8_t table[4];
+};
+
+template<uint8_t LEDS> const uint8_t CyclotronLenses<LEDS>::table[4] PROGMEM = { LEDS / 8, LEDS / 4 + LEDS / 8, LEDS / 2 + LEDS / 8, LEDS / 4 * 3 + LEDS / 8 };
+
+// Any setup aligned differently is listed in Configuration.h.
+#ifdef CYCLOTRON_LENSES_12_LED
+template<> const uint8_t CyclotronLenses<HASLAB_CYCLOTRON_LED_COUNT>::table[4] PROGMEM = { CYCLOTRON_LENSES_12_LED };
+#endif
+
+#ifdef CYCLOTRON_LENSES_20_LED
+template<> const uint8_t CyclotronLenses<FRUTTO_CYCLOTRON_LED_COUNT>::table[4] PROGMEM = { CYCLOTRON_LENSES_20_LED };
+#endif
+
+#ifdef CYCLOTRON_LENSES_36_LED
+template<> const uint8_t CyclotronLenses<FRUTTO_MAX_CYCLOTRON_LED_COUNT>::table[4] PROGMEM = { CYCLOTRON_LENSES_36_LED };
+#endif
+
+#ifdef CYCLOTRON_LENSES_40_LED
+template<> const uint8_t CyclotronLenses<OUTER_CYCLOTRON_LED_MAX>::table[4] PROGMEM = { CYCLOTRON_LENSES_40_LED };
+#endif
+
+// Tables for the number of Cyclotron Lid LEDs in use, set by bindCyclotronTables().
+const uint8_t *p_cyclotron_matrix = CyclotronMatrix<HASLAB_CYCLOTRON_LED_COUNT>::table;
+const uint8_t *p_cyclotron_lenses = CyclotronLenses<HASLAB_CYCLOTRON_LED_COUNT>::table;
+
+template<uint8_t LEDS> void useCyclotronTables() {
+  p_cyclotron_matrix = CyclotronMatrix<LEDS>::table;
+  p_cyclotron_lenses = CyclotronLenses<LEDS>::table;
+}
+
+/*
+ * Power Cell frames, generated at compile time for each number of Power Cell LEDs and direction.
+ * Frame i of the sequence (i_powercell_led) has i + 1 LEDs lit, given as a bitmask of LED positions. When the Power
+ * Cell is inverted it fills from the top LED down. The frame with every LED lit is flagged for the pause which
+ * Afterlife and Frozen Empire hold it for.
+ */
+const uint16_t POWERCELL_FRAME_LEDS = 0x7FFF;
+const uint16_t POWERCELL_FRAME_PAUSE = 0x8000;
+
+constexpr uint16_t powercellFrameMask(uint8_t i_leds, bool b_invert, uint8_t i_frame) {
+  return (((1U << (i_frame + 1)) - 1) << (b_invert ? i_leds - 1 - i_frame : 0)) | (i_frame == i_leds - 1 ? POWERCELL_FRAME_PAUSE : 0);
+}
+
+template<uint8_t LEDS, bool INVERT, typename FRAMES = typename MakeIndexList<LEDS>::type> struct PowercellFrames;
+
+template<uint8_t LEDS, bool INVERT, uint8_t... I> struct PowercellFrames<LEDS, INVERT, IndexList<I...>> {
+  static const uint16_t table[LEDS];
+};
+
+template<uint8_t LEDS, bool INVERT, uint8_t... I> const uint16_t PowercellFrames<LEDS, INVERT, IndexList<I...>>::table[LEDS] PROGMEM = { powercellFrameMask(LEDS, INVERT, I)... };
 
 /*
  * Inner Cyclotron LED Panel
@@ -257,7 +346,6 @@ enum INNER_CYC_PANEL_MODES INNER_CYC_PANEL_MODE;
  * Inner Cyclotron NeoPixel ring ramp control.
  */
 millisDelay ms_cyclotron_ring;
-rampUnsignedInt r_inner_cyclotron_ramp;
 const uint16_t i_inner_ramp_delay = 300;
 int8_t i_led_cyclotron_ring = 0; // Current LED for the inner cyclotron ring.
 int8_t i_led_cyclotron_cavity = 0; // Current LED for the cyclotron cavity.
@@ -278,10 +366,9 @@ uint8_t i_ic_cavity_end = i_ic_cavity_start + INNER_CYCLOTRON_CAVITY_LED_MAX - 1
 uint8_t i_cyclotron_sw_led = 0;
 uint8_t i_cyclotron_switch_led_mulitplier = 1;
 const uint8_t i_cyclotron_switch_led_delay_base = 150;
-const uint16_t i_cyclotron_switch_plate_leds_delay = 1000;
+const uint16_t i_cyclotron_switch_plate_leds_delay = 1000; // Blink period of the 2 switch status indicator LEDs.
 uint16_t i_cyclotron_switch_led_delay = i_cyclotron_switch_led_delay_base;
 millisDelay ms_cyclotron_switch_led; // Timer to control the 6 decorative LED patterns.
-millisDelay ms_cyclotron_switch_plate_leds; // Timer to control the 2 switch status indicator LEDs.
 
 /*
  * Alarm
@@ -289,7 +376,6 @@ millisDelay ms_cyclotron_switch_plate_leds; // Timer to control the 2 switch sta
  */
 const uint16_t i_alarm_delay = 500;
 bool b_alarm = false;
-millisDelay ms_alarm;
 
 /*
  * Switches
@@ -314,7 +400,6 @@ uint8_t i_vibration_level_prev = 0;
 const uint8_t i_vibration_idle_level_2021 = 60;
 const uint8_t i_vibration_idle_level_1984 = 35;
 const uint8_t i_vibration_lowest_level = 15;
-millisDelay ms_menu_vibration; // Timer to do non-blocking confirmation buzzing in the vibration menu.
 
 /*
  * Enable or disable vibration control for the Proton Pack.
@@ -342,8 +427,6 @@ const uint16_t i_overheat_delay_max = 60000; // The max length a overheat can be
 /*
  * Vent light timers and delay for overheating.
  */
-millisDelay ms_vent_light_on;
-millisDelay ms_vent_light_off;
 const uint8_t i_vent_light_delay = 50;
 bool b_vent_sounds; // A flag for playing smoke and vent sounds.
 bool b_vent_light_on = false; // To know if the light is on or off.
@@ -404,6 +487,84 @@ const uint16_t i_serial1_disconnect_delay = 8000; // Time until the pack conside
 SerialTransfer serial1Coms;
 SerialTransfer packComs;
 
+/*
+ * Serial Packet Draining
+ * Every complete packet waiting on a port is handled in the same loop pass, up to a packet count and time limit.
+ * The counters for each port record how deep the backlog has been.
+ */
+const uint8_t i_serial_drain_max_packets = 8; // Most packets handled from one port in a single loop pass.
+const uint16_t i_serial_drain_budget_us = 1000; // Stop draining a port once this much time has been spent in a loop pass.
+
+struct SerialDrainStats {
+  uint8_t lastPackets; // Packets handled by the most recent pass which found any.
+  uint8_t maxPackets; // Most packets handled in a single pass.
+  uint16_t deferred; // Passes which reached a limit with more data still waiting.
+};
+
+struct SerialDrainStats serial1Drain;
+struct SerialDrainStats wandDrain;
+
+/*
+ * Reliable Wand Commands
+ * Once the wand says it supports them, commands for critical state changes are numbered and kept until the wand acknowledges them (see Reliable.h).
+ * A lost state change no longer waits for a resync to be put right, so such a wand is expected to handshake more often and is dropped sooner when it stops.
+ * The wand confirms it is numbering commands with its first reliable frame; should it stop acknowledging them, commands go back to being sent plainly.
+ */
+const uint16_t i_wand_reliable_disconnect_delay = 2500; // Time until the pack considers a wand with reliable commands as disconnected.
+bool b_wand_reliable = false; // The wand supports reliable commands.
+bool b_wand_reliable_confirmed = false; // The wand has sent a reliable frame since we sent P_RELIABLE.
+
+/*
+ * Serial Link Telemetry
+ * Counters which show a link degrading before it drops out entirely (see LinkStats.h).
+ */
+struct LinkStats wandLink; // Frames to and from the wand, as seen by the pack.
+struct LinkStats wandReportedLink; // The wand's own counters, as of its last report.
+bool b_wand_link_stats_forward = false; // The Serial1 device is waiting for the wand's own counters.
+struct LinkStats serial1Link; // Frames to and from the Serial1 device, as seen by the pack.
+unsigned long i_wand_link_last_frame = 0; // When the last frame arrived from the wand, or 0 while not connected.
+unsigned long i_wand_link_request_time = 0; // When a handshake or report was requested from the wand, or 0 once answered.
+unsigned long i_serial1_link_last_frame = 0; // When the last frame arrived from the Serial1 device, or 0 while not connected.
+unsigned long i_serial1_link_request_time = 0; // When a handshake was requested from the Serial1 device, or 0 once answered.
+
+/*
+ * Serial Link Speed
+ * Every link starts at the default rate so that devices with older firmware can always connect.
+ * Once a device has synchronized the pack offers it a faster rate, which is only used if the device acknowledges it.
+ * A lost link falls back to the default rate, and one which never worked at the faster rate is not offered it again.
+ */
+const unsigned long i_serial_baud_default = 9600;
+const unsigned long i_wand_baud_fast = 115200; // Pack and wand run from the same 16MHz clock, so their rate errors match.
+const unsigned long i_serial1_baud_fast = 57600; // Lowest error between the Mega 2560 and an ESP32.
+bool b_wand_baud_fast = false; // The wand link is at the faster rate.
+bool b_wand_baud_verified = false; // A packet has been received from the wand at the faster rate.
+bool b_wand_baud_failed = false; // The wand link was lost before it worked at the faster rate.
+bool b_serial1_baud_fast = false; // The Serial1 link is at the faster rate.
+bool b_serial1_baud_verified = false; // A packet has been received from the Serial1 device at the faster rate.
+bool b_serial1_baud_failed = false; // The Serial1 link was lost before it worked at the faster rate.
+
+/*
+ * Serial1 State Mirror
+ * A Serial1 device which mirrors the pack state (the Attenuator) is only sent the bytes of that state which changed since it last acknowledged it.
+ * Commands which only report part of that state are then no longer sent, and the full state is only sent when syncing or if its copy stops matching.
+ */
+millisDelay ms_serial1_mirror; // Runs for the change delay while idle, and for the acknowledgement delay while a change is in flight.
+const uint8_t i_serial1_mirror_delay = 50; // Changes made within this time are sent together.
+const uint16_t i_serial1_mirror_ack_delay = 500; // Changes not acknowledged within this time are sent again.
+bool b_serial1_mirror = false; // The Serial1 device mirrors the pack state.
+bool b_serial1_mirror_pending = false; // A change has been sent but not yet acknowledged.
+uint8_t i_serial1_mirror_version = 0; // Version of the last change sent.
+
+/*
+ * Serial Command Batching
+ * Once a device says it can decode them, commands sent to it during a loop pass are held and sent together in one frame at the end of the pass.
+ * Data packets and rate changes send any held commands first, so everything still arrives in the order it was sent.
+ */
+bool b_wand_batch = false; // The wand decodes batched commands.
+bool b_serial1_batch = false; // The Serial1 device decodes batched commands.
+uint8_t i_wand_batch_count = 0; // Commands held for the wand.
+uint8_t i_serial1_batch_count = 0; // Commands held for the Serial1 device.
+
 /*
  * Firing timers
  */
@@ -486,6 +647,11 @@ void serial1Send(uint8_t i_command);
 void serial1SendData(uint8_t i_message);
 void checkSerial1();
 void checkWand();
+void serial1BaudFallback();
+void wandBaudFallback();
+void sendCommandBatches();
+void packSerialSendReliable(uint8_t i_command, uint16_t i_value);
+void packSerialSendReliable(uint8_t i_command);
 void powercellDraw(uint8_t i_start = 0);
 
 /*
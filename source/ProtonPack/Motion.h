@@ -0,0 +1,432 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Cyclotron speed ramp.
+ *
+ * The outer cyclotron, inner cyclotron and power cell always speed up and slow down together, so they share one
+ * ramp. Its position runs from 0 to 256 (1.0 in Q8.8 fixed point) over the ramp length and is eased with the same
+ * curves as the Ramp library, then scaled onto the outer and inner cyclotron delays. The step per millisecond is
+ * worked out once when the ramp starts, so following the ramp needs no floating point maths or division.
+ */
+const uint16_t CYCLOTRON_RAMP_ONE = 256; // 1.0 in Q8.8.
+
+uint32_t i_cyclotron_ramp_step = 0; // Position gained per millisecond, as a fraction of CYCLOTRON_RAMP_ONE in 16 bits.
+uint32_t i_cyclotron_ramp_time = 0; // When the ramp started.
+uint32_t i_cyclotron_ramp_updated = 0; // When the ramp was last followed.
+uint16_t i_cyclotron_ramp_length = 0;
+uint16_t i_cyclotron_ramp_position = CYCLOTRON_RAMP_ONE; // Eased position in Q8.8, as of the last update.
+uint16_t i_outer_ramp_from = 0;
+uint16_t i_outer_ramp_to = 0;
+uint16_t i_inner_ramp_from = 0;
+uint16_t i_inner_ramp_to = 0;
+uint16_t i_outer_ramp_value = 0;
+uint16_t i_inner_ramp_value = 0;
+ramp_mode CYCLOTRON_RAMP_MODE = NONE;
+bool b_cyclotron_ramp_finished = true;
+
+// Square root of a 32-bit value, rounded down.
+uint16_t rampSqrt(uint32_t i_value) {
+  uint32_t i_root = 0;
+  uint32_t i_bit = 1UL << 30;
+
+  while(i_bit > i_value) {
+    i_bit >>= 2;
+  }
+
+  while(i_bit > 0) {
+    if(i_value >= i_root + i_bit) {
+      i_value -= i_root + i_bit;
+      i_root = (i_root >> 1) + i_bit;
+    }
+    else {
+      i_root >>= 1;
+    }
+
+    i_bit >>= 2;
+  }
+
+  return (uint16_t) i_root;
+}
+
+// Eases a Q8.8 position between 0 and CYCLOTRON_RAMP_ONE. Only the curves used by the cyclotron are eased.
+uint16_t rampEasePosition(ramp_mode mode, uint16_t i_position) {
+  uint16_t i_rest = CYCLOTRON_RAMP_ONE - i_position;
+  uint16_t i_square = 0;
+
+  switch(mode) {
+    case QUADRATIC_OUT:
+      return CYCLOTRON_RAMP_ONE - (uint16_t) (((uint32_t) i_rest * i_rest) >> 8);
+    break;
+
+    case QUARTIC_IN:
+      i_square = (uint16_t) (((uint32_t) i_position * i_position) >> 8);
+      return (uint16_t) (((uint32_t) i_square * i_square) >> 8);
+    break;
+
+    case QUARTIC_OUT:
+      i_square = (uint16_t) (((uint32_t) i_rest * i_rest) >> 8);
+      return CYCLOTRON_RAMP_ONE - (uint16_t) (((uint32_t) i_square * i_square) >> 8);
+    break;
+
+    case CIRCULAR_IN:
+      return CYCLOTRON_RAMP_ONE - rampSqrt(65536UL - (uint32_t) i_position * i_position);
+    break;
+
+    case CIRCULAR_OUT:
+      return rampSqrt((uint32_t) i_position * (2 * CYCLOTRON_RAMP_ONE - i_position));
+    break;
+
+    case LINEAR:
+    default:
+      return i_position;
+    break;
+  }
+}
+
+uint16_t rampBetween(uint16_t i_from, uint16_t i_to, uint16_t i_position) {
+  return (uint16_t) (i_from + (((int32_t) i_to - i_from) * i_position >> 8));
+}
+
+// Moves the outer and inner cyclotron from their current delays to these over i_length milliseconds. With no length they are set at once.
+void startCyclotronRamp(uint16_t i_outer, uint16_t i_inner, uint16_t i_length = 0, ramp_mode mode = LINEAR) {
+  i_outer_ramp_from = i_outer_ramp_value;
+  i_inner_ramp_from = i_inner_ramp_value;
+  i_outer_ramp_to = i_outer;
+  i_inner_ramp_to = i_inner;
+  i_cyclotron_ramp_time = millis();
+  i_cyclotron_ramp_updated = i_cyclotron_ramp_time - 1;
+  i_cyclotron_ramp_length = i_length;
+  CYCLOTRON_RAMP_MODE = mode;
+
+  if(i_length == 0 || mode == NONE) {
+    i_cyclotron_ramp_position = CYCLOTRON_RAMP_ONE;
+    i_outer_ramp_value = i_outer;
+    i_inner_ramp_value = i_inner;
+    b_cyclotron_ramp_finished = true;
+  }
+  else {
+    i_cyclotron_ramp_step = (CYCLOTRON_RAMP_ONE * 65536UL) / i_length;
+    i_cyclotron_ramp_position = 0;
+    b_cyclotron_ramp_finished = false;
+  }
+}
+
+// Follows the ramp to the current time. Repeat calls in the same millisecond do no work.
+void updateCyclotronRamp() {
+  uint32_t i_now = millis();
+  uint32_t i_elapsed = i_now - i_cyclotron_ramp_time;
+
+  if(b_cyclotron_ramp_finished || i_now == i_cyclotron_ramp_updated) {
+    return;
+  }
+
+  i_cyclotron_ramp_updated = i_now;
+
+  if(i_elapsed >= i_cyclotron_ramp_length) {
+    i_cyclotron_ramp_position = CYCLOTRON_RAMP_ONE;
+    i_outer_ramp_value = i_outer_ramp_to;
+    i_inner_ramp_value = i_inner_ramp_to;
+    b_cyclotron_ramp_finished = true;
+  }
+  else {
+    uint16_t i_position = rampEasePosition(CYCLOTRON_RAMP_MODE, (uint16_t) ((i_elapsed * i_cyclotron_ramp_step) >> 16));
+
+    if(i_position != i_cyclotron_ramp_position) {
+      i_cyclotron_ramp_position = i_position;
+      i_outer_ramp_value = rampBetween(i_outer_ramp_from, i_outer_ramp_to, i_position);
+      i_inner_ramp_value = rampBetween(i_inner_ramp_from, i_inner_ramp_to, i_position);
+    }
+  }
+}
+
+uint16_t outerCyclotronRamp() {
+  updateCyclotronRamp();
+  return i_outer_ramp_value;
+}
+
+uint16_t innerCyclotronRamp() {
+  updateCyclotronRamp();
+  return i_inner_ramp_value;
+}
+
+// Whether the ramp had ended when it was last followed.
+bool cyclotronRampFinished() {
+  return b_cyclotron_ramp_finished;
+}
+
+/*
+ * Outer cyclotron LED fades.
+ *
+ * Only LEDs which are fading are kept, so each pass touches just those few. A fade in always follows a circular in
+ * curve and a fade out a circular out curve, as the cyclotron has always used. The brightness reached is kept in
+ * i_cyclotron_led_value, which other effects read and set directly.
+ */
+const uint8_t CYCLOTRON_FADES_MAX = 16; // 1984/1989 fades 12 LEDs in at once when lighting all 4 lenses.
+
+struct CyclotronFade {
+  uint8_t i_led; // Position in the cyclotron, before the lookup table.
+  uint8_t i_from;
+  uint8_t i_target;
+  uint16_t i_step; // Q8.8 position gained per millisecond.
+  uint16_t i_start; // Low 16 bits of millis() when the fade began.
+};
+
+struct CyclotronFade cyclotronFades[CYCLOTRON_FADES_MAX];
+uint8_t i_cyclotron_fades = 0;
+
+// Starts a fade from one brightness to another over i_length milliseconds, replacing any fade the LED already has.
+void startCyclotronFade(uint8_t i_led, uint8_t i_from, uint8_t i_target, uint16_t i_length) {
+  uint8_t i = 0;
+
+  while(i < i_cyclotron_fades && cyclotronFades[i].i_led != i_led) {
+    i++;
+  }
+
+  if(i == CYCLOTRON_FADES_MAX) {
+    // No room; end the first fade to make some.
+    i_cyclotron_led_value[cyclotronFades[0].i_led] = cyclotronFades[0].i_target;
+    i = 0;
+  }
+  else if(i == i_cyclotron_fades) {
+    i_cyclotron_fades++;
+  }
+
+  struct CyclotronFade &fade = cyclotronFades[i];
+
+  fade.i_led = i_led;
+  fade.i_from = i_from;
+  fade.i_target = i_target;
+  fade.i_step = i_length > 1 ? (uint16_t) (65536UL / i_length) : 0xFFFF;
+  fade.i_start = (uint16_t) millis();
+
+  i_cyclotron_led_value[i_led] = i_from;
+}
+
+// Moves a fade on to the given time and returns whether it has reached its target.
+bool advanceCyclotronFade(struct CyclotronFade &fade, uint16_t i_now) {
+  uint32_t i_position = ((uint32_t) (uint16_t) (i_now - fade.i_start) * fade.i_step) >> 8;
+
+  if(i_position >= CYCLOTRON_RAMP_ONE) {
+    i_cyclotron_led_value[fade.i_led] = fade.i_target;
+    return true;
+  }
+
+  uint8_t i_eased = (uint8_t) rampEasePosition(fade.i_target > fade.i_from ? CIRCULAR_IN : CIRCULAR_OUT, (uint16_t) i_position);
+
+  i_cyclotron_led_value[fade.i_led] = lerp8by8(fade.i_from, fade.i_target, i_eased);
+  return false;
+}
+
+void removeCyclotronFade(uint8_t i) {
+  cyclotronFades[i] = cyclotronFades[--i_cyclotron_fades];
+}
+
+void clearCyclotronFades() {
+  for(uint8_t i = 0; i < OUTER_CYCLOTRON_LED_MAX; i++) {
+    i_cyclotron_led_value[i] = 0;
+  }
+
+  i_cyclotron_fades = 0;
+}
+
+/*
+ * Light sequences.
+ *
+ * A light which blinks or fades on a fixed pattern follows a sequence of keyframes kept in flash, rather than its own
+ * set of timers. Each keyframe gives a level from 0 to 255 which is held for the length of the keyframe, or eased to
+ * from the level before it. Every running sequence is moved on once per pass by updateLightSequences(), and the effect
+ * code then reads the level of its track. Keyframes must be at least 1 millisecond long.
+ *
+ * The N-Filter vent light strobe, the ribbon cable and overheat alarm blinks (Cyclotron, vent light and switch panel)
+ * and the blinking switch plate indicators use sequences. A keyframe carries a level but no LED range or colour, so the
+ * effect code still decides which LEDs a level lights and in what colour: the 1984 alarm lights the lenses from the
+ * lookup tables for the installed Cyclotron. Effects which pick random levels or delays, such as the slime Cyclotron,
+ * stay as code.
+ */
+enum LIGHT_EASING : uint8_t {
+  EASE_HOLD,
+  EASE_LINEAR
+};
+
+enum LIGHT_TRACKS : uint8_t {
+  TRACK_VENT_LIGHT, // N-Filter vent light strobe.
+  TRACK_ALARM, // Ribbon cable and overheat alarm blink.
+  TRACK_PANEL_ALARM, // Cyclotron switch panel alarm blink.
+  TRACK_SWITCH_PLATE, // Year and vibration switch indicators.
+  LIGHT_TRACK_COUNT
+};
+
+struct LightKeyframe {
+  uint16_t i_length; // Milliseconds.
+  uint8_t i_level;
+  uint8_t i_easing;
+};
+
+struct LightTrack {
+  const struct LightKeyframe *p_keyframes;
+  uint32_t ms_keyframe; // When the current keyframe began.
+  uint8_t i_keyframes;
+  uint8_t i_keyframe;
+  uint8_t i_from; // Level when the current keyframe began.
+  uint8_t i_level;
+  bool b_loop;
+  bool b_running;
+  bool b_waiting; // Not yet at the first keyframe.
+  bool b_keyframe_started; // Cleared when read with lightKeyframeStarted().
+};
+
+struct LightTrack lightTracks[LIGHT_TRACK_COUNT];
+
+// Expands to the keyframes of a sequence and their count.
+#define LIGHT_SEQUENCE(s) s, sizeof(s) / sizeof(s[0])
+
+// Strobes the N-Filter vent light while venting or smoking.
+const struct LightKeyframe VENT_LIGHT_STROBE[] PROGMEM = {
+  { i_vent_light_delay, 0, EASE_HOLD },
+  { i_vent_light_delay, 255, EASE_HOLD }
+};
+
+// 1984/1989 cyclotron alarm, on for the last quarter of each period.
+const struct LightKeyframe ALARM_1984[] PROGMEM = {
+  { i_1984_delay / 2 - i_1984_delay / 4, 0, EASE_HOLD },
+  { i_1984_delay / 4, 255, EASE_HOLD }
+};
+
+// Afterlife/Frozen Empire vent light alarm, on for the second half of each period.
+const struct LightKeyframe ALARM_2021[] PROGMEM = {
+  { i_1984_delay - i_1984_delay / 2, 0, EASE_HOLD },
+  { i_1984_delay / 2, 255, EASE_HOLD }
+};
+
+// 1984/1989 switch panel alarm, on and off at a quarter of the Afterlife/Frozen Empire rate.
+const struct LightKeyframe PANEL_ALARM_1984[] PROGMEM = {
+  { i_cyclotron_switch_led_delay_base * 8, 255, EASE_HOLD },
+  { i_cyclotron_switch_led_delay_base * 8, 0, EASE_HOLD }
+};
+
+// Afterlife/Frozen Empire switch panel alarm.
+const struct LightKeyframe PANEL_ALARM_2021[] PROGMEM = {
+  { i_cyclotron_switch_led_delay_base * 2, 255, EASE_HOLD },
+  { i_cyclotron_switch_led_delay_base * 2, 0, EASE_HOLD }
+};
+
+// Switch plate indicators, on for the second half of each period.
+const struct LightKeyframe SWITCH_PLATE_BLINK[] PROGMEM = {
+  { i_cyclotron_switch_plate_leds_delay - i_cyclotron_switch_plate_leds_delay / 2, 0, EASE_HOLD },
+  { i_cyclotron_switch_plate_leds_delay / 2, 255, EASE_HOLD }
+};
+
+uint8_t lightSequenceLevel(uint8_t i_track) {
+  return lightTracks[i_track].i_level;
+}
+
+// Whether a new keyframe has begun since this was last asked.
+bool lightKeyframeStarted(uint8_t i_track) {
+  bool b_started = lightTracks[i_track].b_keyframe_started;
+
+  lightTracks[i_track].b_keyframe_started = false;
+  return b_started;
+}
+
+// Moves one track on to the given time.
+void updateLightTrack(struct LightTrack &track, uint32_t ms_now) {
+  // A delayed start has a keyframe time still in the future.
+  if(!track.b_running || (int32_t) (ms_now - track.ms_keyframe) < 0) {
+    return;
+  }
+
+  uint32_t i_elapsed = ms_now - track.ms_keyframe;
+  uint16_t i_length = PROGMEM_READU16(track.p_keyframes[track.i_keyframe].i_length);
+
+  if(track.b_waiting) {
+    track.b_waiting = false;
+    track.b_keyframe_started = true;
+  }
+
+  while(i_elapsed >= i_length) {
+    track.i_from = PROGMEM_READU8(track.p_keyframes[track.i_keyframe].i_level);
+    track.ms_keyframe += i_length;
+    i_elapsed -= i_length;
+
+    if(track.i_keyframe + 1 < track.i_keyframes) {
+      track.i_keyframe++;
+    }
+    else if(track.b_loop) {
+      track.i_keyframe = 0;
+    }
+    else {
+      track.i_level = track.i_from;
+      track.b_running = false;
+      return;
+    }
+
+    track.b_keyframe_started = true;
+    i_length = PROGMEM_READU16(track.p_keyframes[track.i_keyframe].i_length);
+  }
+
+  uint8_t i_target = PROGMEM_READU8(track.p_keyframes[track.i_keyframe].i_level);
+
+  if(PROGMEM_READU8(track.p_keyframes[track.i_keyframe].i_easing) == EASE_LINEAR) {
+    track.i_level = lerp8by8(track.i_from, i_target, (uint8_t) ((i_elapsed << 8) / i_length));
+  }
+  else {
+    track.i_level = i_target;
+  }
+}
+
+void updateLightSequences() {
+  uint32_t ms_now = millis();
+
+  for(uint8_t i = 0; i < LIGHT_TRACK_COUNT; i++) {
+    updateLightTrack(lightTracks[i], ms_now);
+  }
+}
+
+// Starts a sequence from its first keyframe, after an optional delay.
+void startLightSequence(uint8_t i_track, const struct LightKeyframe *p_keyframes, uint8_t i_keyframes, bool b_loop = true, uint16_t i_delay = 0) {
+  struct LightTrack &track = lightTracks[i_track];
+
+  track.p_keyframes = p_keyframes;
+  track.i_keyframes = i_keyframes;
+  track.i_keyframe = 0;
+  track.ms_keyframe = millis() + i_delay;
+
+  if(i_delay > 0) {
+    // Dark until the first keyframe, rather than showing whatever the last sequence on this track left.
+    track.i_level = 0;
+  }
+
+  track.i_from = track.i_level;
+  track.b_loop = b_loop;
+  track.b_running = true;
+  track.b_waiting = true;
+  track.b_keyframe_started = false;
+
+  // Without a delay the first keyframe begins now, as it would for a timer started at 0.
+  updateLightTrack(track, millis());
+}
+
+// Stops a sequence, leaving its level where it was.
+void stopLightSequence(uint8_t i_track) {
+  lightTracks[i_track].b_running = false;
+  lightTracks[i_track].b_keyframe_started = false;
+}
@@ -49,11 +49,17 @@
 #include "Configuration.h"
 #include "MusicSounds.h"
 #include "Communication.h"
+#include "LinkStats.h"
 #include "Header.h"
 #include "Colours.h"
+#include "Motion.h"
+#include "Scheduler.h"
+#include "Reliable.h"
 #include "Audio.h"
 #include "PowerMeter.h"
 #include "Preferences.h"
+#include "Recorder.h"
+#include "Benchmark.h"
 
 void setup() {
   // Setup i2c.
@@ -61,8 +67,8 @@ void setup() {
   Wire.setClock(400000UL); // Sets the i2c bus to 400kHz
 
   Serial.begin(9600); // Standard serial (USB) console.
-  Serial1.begin(9600); // Add-on Serial1 communication.
-  Serial2.begin(9600); // Communication to the Neutrona Wand.
+  Serial1.begin(i_serial_baud_default); // Add-on Serial1 communication.
+  Serial2.begin(i_serial_baud_default); // Communication to the Neutrona Wand.
 
   // Initialize an optional power meter on the i2c bus.
   if(b_use_power_meter) {
@@ -196,10 +202,20 @@ void setup() {
   resetRampSpeeds();
 
   // Start some timers
-  ms_fast_led.start(i_fast_led_delay);
+  scheduleTimer(fastLedDue, i_fast_led_delay);
+  scheduleTimer(cyclotronLedDue, i_cyclotron_led_delay);
   ms_check_music.start(i_music_check_delay);
   ms_serial1_check.start(i_serial1_disconnect_delay);
-  ms_cyclotron_switch_plate_leds.start(i_cyclotron_switch_plate_leds_delay);
+  startLightSequence(TRACK_SWITCH_PLATE, LIGHT_SEQUENCE(SWITCH_PLATE_BLINK));
+
+#ifdef GPSTAR_BENCHMARK
+  // Benchmark builds start lit so that every LED stage is exercised without any switch input.
+  SYSTEM_MODE = MODE_SUPER_HERO;
+  b_demo_light_mode = true;
+#endif
+
+  // Work out the device colours for the year and stream mode set above.
+  updateDeviceColours();
 
   // Perform initial pack reset.
   packOffReset();
@@ -228,33 +244,64 @@ void setup() {
 }
 
 void loop() {
+  BENCHMARK_BEGIN(BENCH_LOOP);
+
   // Update the available audio device.
+  BENCHMARK_BEGIN(BENCH_AUDIO);
   updateAudio();
+  BENCHMARK_END(BENCH_AUDIO);
+
+  // Run anything left on the timer scheduler which is now due.
+  BENCHMARK_BEGIN(BENCH_TIMERS);
+  runScheduledTimers();
+  BENCHMARK_END(BENCH_TIMERS);
 
   // Check current voltage/amperage draw using available methods if enabled.
   if(b_use_power_meter && b_pack_post_finish) {
     // Only check if power meter if present and self-test has completed.
+    BENCHMARK_BEGIN(BENCH_POWER_METER);
     checkPowerMeter();
+    BENCHMARK_END(BENCH_POWER_METER);
   }
 
   // Check for any new serial commands were received from the Neutrona Wand.
+  BENCHMARK_BEGIN(BENCH_SERIAL);
   checkWand();
+  BENCHMARK_END(BENCH_SERIAL);
 
   // Check if the wand is considered to have been disconnected.
   wandDisconnectCheck();
 
   // Check if serial1 device is present.
+  BENCHMARK_BEGIN(BENCH_HANDSHAKE);
   serial1HandShake();
+  BENCHMARK_END(BENCH_HANDSHAKE);
 
   // Check if any new serial commands were received.
+  BENCHMARK_BEGIN(BENCH_SERIAL1);
   checkSerial1();
+  BENCHMARK_END(BENCH_SERIAL1);
 
   if(b_pack_post_finish) {
+    BENCHMARK_BEGIN(BENCH_MUSIC);
     checkMusic();
+    BENCHMARK_END(BENCH_MUSIC);
+
+    // Move the light sequences on before the switch indicators and effects read them.
+    updateLightSequences();
+
+    BENCHMARK_BEGIN(BENCH_SWITCHES);
     checkSwitches();
+    BENCHMARK_END(BENCH_SWITCHES);
+
     checkRotaryEncoder();
     checkMenuVibration();
 
+    // Pick up any change of year, stream mode or colour toggles before the effects are drawn.
+    updateDeviceColours();
+
+    BENCHMARK_BEGIN(BENCH_PACK_STATE);
+
     switch (PACK_STATE) {
       case MODE_OFF:
         // Turn on the status indicator LED.
@@ -273,7 +320,7 @@ void loop() {
           ms_fadeout.start(0);
 
           // Tell the wand the pack is off, so shut down the wand if it happens to still be on.
-          packSerialSend(P_OFF);
+          packSerialSendReliable(P_OFF);
           serial1Send(A_PACK_OFF);
 
           b_pack_on = false;
@@ -286,9 +333,15 @@ void loop() {
             spectralLightsOn();
           }
           else {
+            BENCHMARK_BEGIN(BENCH_CYCLOTRON);
             cyclotronControl();
+            BENCHMARK_END(BENCH_CYCLOTRON);
+
             cyclotronSwitchLEDLoop();
+
+            BENCHMARK_BEGIN(BENCH_POWERCELL);
             powercellLoop();
+            BENCHMARK_END(BENCH_POWERCELL);
           }
         }
         else {
@@ -324,7 +377,7 @@ void loop() {
 
         if(b_pack_on == false) {
           // Tell the wand the pack is on.
-          packSerialSend(P_ON);
+          packSerialSendReliable(P_ON);
           serial1Send(A_PACK_ON);
 
           ms_fadeout.stop();
@@ -360,6 +413,7 @@ void loop() {
             ventLightLEDW(false);
 
             b_alarm = false;
+            stopAlarmSequence();
 
             reset2021RampUp();
 
@@ -474,17 +528,8 @@ void loop() {
             }
 
             // We are strobing the N-Filter jewel.
-            if(ms_vent_light_off.justFinished()) {
-              ms_vent_light_off.stop();
-              ms_vent_light_on.start(i_vent_light_delay);
-
-              ventLight(true);
-            }
-            else if(ms_vent_light_on.justFinished()) {
-              ms_vent_light_on.stop();
-              ms_vent_light_off.start(i_vent_light_delay);
-
-              ventLight(false);
+            if(lightKeyframeStarted(TRACK_VENT_LIGHT)) {
+              ventLight(lightSequenceLevel(TRACK_VENT_LIGHT) > 0);
             }
 
             // The LED-W will not strobe during this venting.
@@ -503,7 +548,9 @@ void loop() {
           packVenting();
         }
 
+        BENCHMARK_BEGIN(BENCH_CYCLOTRON);
         cyclotronControl(); // Set timers for the cyclotron.
+        BENCHMARK_END(BENCH_CYCLOTRON);
 
         if(b_wand_mash_lockout && ms_mash_lockout.isRunning()) {
           if((ms_mash_lockout.delay() / 1.5) > ms_mash_lockout.remaining()) {
@@ -518,11 +565,15 @@ void loop() {
           powercellRampDown();
         }
         else {
+          BENCHMARK_BEGIN(BENCH_POWERCELL);
           powercellLoop();
+          BENCHMARK_END(BENCH_POWERCELL);
         }
       break;
     }
 
+    BENCHMARK_END(BENCH_PACK_STATE);
+
     switch(PACK_ACTION_STATE) {
       case ACTION_IDLE:
         // Do nothing.
@@ -541,16 +592,51 @@ void loop() {
     systemPOST();
   }
 
-  // Update the LEDs
-  if(ms_fast_led.justFinished()) {
-    FastLED.show();
+  // Update the Power Cell, Outer Cyclotron and N-Filter LEDs.
+  bool b_leds_written = false;
+
+  if(b_fast_led_due) {
+    BENCHMARK_BEGIN(BENCH_LED_SHOW);
+    b_leds_written = commitLedFrame(1 << PACK_LED_CHAIN);
+    BENCHMARK_END(BENCH_LED_SHOW);
 
-    ms_fast_led.start(i_fast_led_delay);
+    b_fast_led_due = false;
+    scheduleTimer(fastLedDue, ledFrameDelay(i_fast_led_delay, FAST_LED_UPDATE_MS));
 
     if(b_powercell_updating == true) {
       b_powercell_updating = false;
     }
   }
+
+  // Update the Inner Cyclotron LEDs, unless the other chain was just written.
+  if(b_cyclotron_led_due && !b_leds_written) {
+    BENCHMARK_BEGIN(BENCH_LED_SHOW);
+    commitLedFrame(1 << CYCLOTRON_LED_CHAIN);
+    BENCHMARK_END(BENCH_LED_SHOW);
+
+    b_cyclotron_led_due = false;
+    scheduleTimer(cyclotronLedDue, ledFrameDelay(i_cyclotron_led_delay, CYCLOTRON_LED_UPDATE_MS));
+  }
+
+  // Send the commands held for the wand and Serial1 device during this loop pass.
+  sendCommandBatches();
+
+  BENCHMARK_END(BENCH_LOOP);
+
+#if defined(GPSTAR_PROFILING)
+  profileCheckConsole();
+#elif defined(GPSTAR_SERIAL_RECORDER)
+  recorderCheckConsole();
+#endif
+}
+
+// Timer scheduler callbacks which mark an LED chain as due to be written at the end of the next loop pass.
+void fastLedDue() {
+  b_fast_led_due = true;
+}
+
+void cyclotronLedDue() {
+  b_cyclotron_led_due = true;
 }
 
 void systemPOST() {
@@ -560,26 +646,10 @@ void systemPOST() {
   uint8_t i_tmp_led4 = i_cyclotron_led_start + cyclotron84LookupTable(3);
   uint8_t i_tmp_led5 = i_pack_num_leds - (i_nfilter_jewel_leds / 2);
 
-  uint8_t i_tmp_powercell_led = i_post_powercell_up;
+  uint8_t i_tmp_powercell_led = 0;
 
   if(i_post_powercell_up < i_powercell_leds && ms_delay_post.justFinished()) {
-    if(b_powercell_invert == true) {
-      if(i_powercell_leds == HASLAB_POWERCELL_LED_COUNT) {
-        i_tmp_powercell_led = PROGMEM_READU8(powercell_13_invert[i_post_powercell_up]);
-      }
-      else {
-        i_tmp_powercell_led = PROGMEM_READU8(powercell_15_invert[i_post_powercell_up]);
-
-      }
-    }
-    else {
-      if(i_powercell_leds == HASLAB_POWERCELL_LED_COUNT) {
-        i_tmp_powercell_led = PROGMEM_READU8(powercell_13[i_post_powercell_up]);
-      }
-      else {
-        i_tmp_powercell_led = PROGMEM_READU8(powercell_15[i_post_powercell_up]);
-      }
-    }
+    i_tmp_powercell_led = powercellFrameLed(i_post_powercell_up);
 
     pack_leds[i_tmp_powercell_led] = getHueAsRGB(POWERCELL, C_MID_BLUE);
 
@@ -652,23 +722,7 @@ void systemPOST() {
   }
 
   if(i_post_powercell_down < i_powercell_leds && ms_delay_post_2.justFinished()) {
-    if(b_powercell_invert == true) {
-      if(i_powercell_leds == HASLAB_POWERCELL_LED_COUNT) {
-        i_tmp_powercell_led = PROGMEM_READU8(powercell_13_invert[i_post_powercell_down]);
-      }
-      else {
-        i_tmp_powercell_led = PROGMEM_READU8(powercell_15_invert[i_post_powercell_down]);
-
-      }
-    }
-    else {
-      if(i_powercell_leds == HASLAB_POWERCELL_LED_COUNT) {
-        i_tmp_powercell_led = PROGMEM_READU8(powercell_13[i_post_powercell_down]);
-      }
-      else {
-        i_tmp_powercell_led = PROGMEM_READU8(powercell_15[i_post_powercell_down]);
-      }
-    }
+    i_tmp_powercell_led = powercellFrameLed(i_post_powercell_down);
 
     pack_leds[(i_powercell_leds - 1) - i_tmp_powercell_led] = getHueAsRGB(POWERCELL, C_BLACK); // Ramp up and ramp down.
     //pack_leds[i_post_powercell_down] = getHueAsRGB(POWERCELL, C_BLACK); // Ramp up and ramp away.
@@ -905,7 +959,7 @@ void packStartup(bool firstStart) {
   if(ribbonCableAttached() != true) {
     if(SYSTEM_YEAR == SYSTEM_1984 || SYSTEM_YEAR == SYSTEM_1989) {
       ms_cyclotron.start(0);
-      ms_alarm.start(0);
+      startAlarmSequence();
     }
 
     packAlarm();
@@ -949,8 +1003,8 @@ void packStartup(bool firstStart) {
       default:
         if(firstStart) {
           if(STREAM_MODE == SLIME) {
-            playEffect(S_AFTERLIFE_PACK_STARTUP, false, i_volume_effects - 30);
-            playEffect(S_AFTERLIFE_PACK_IDLE_LOOP, true, i_volume_effects - 40, true, 18000);
+            playEffect(S_AFTERLIFE_PACK_STARTUP, false, i_volume_effects - i_slime_startup_level);
+            playEffect(S_AFTERLIFE_PACK_IDLE_LOOP, true, i_volume_effects - i_slime_idle_level, true, 18000);
           }
           else {
             playEffect(S_AFTERLIFE_PACK_STARTUP);
@@ -961,8 +1015,8 @@ void packStartup(bool firstStart) {
         }
         else {
           if(STREAM_MODE == SLIME) {
-            playEffect(S_BOOTUP, false, i_volume_effects - 30);
-            playEffect(S_AFTERLIFE_PACK_IDLE_LOOP, true, i_volume_effects - 40, true, 500);
+            playEffect(S_BOOTUP, false, i_volume_effects - i_slime_startup_level);
+            playEffect(S_AFTERLIFE_PACK_IDLE_LOOP, true, i_volume_effects - i_slime_idle_level, true, 500);
           }
           else {
             playEffect(S_BOOTUP);
@@ -979,15 +1033,15 @@ void packStartup(bool firstStart) {
         if(b_brass_pack_sound_loop) {
           playEffect(S_BOOTUP);
           playEffect(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, true, i_volume_effects, true, 500);
-          playEffect(S_FROZEN_EMPIRE_BOOT_EFFECT, true, i_volume_effects, true, 2000);
+          crossfadeTracks(S_EMPTY, S_FROZEN_EMPIRE_BOOT_EFFECT, i_brass_pack_fade_in, FADE_LINEAR);
 
           ms_idle_fire_fade.start(0);
         }
         else {
           if(firstStart) {
             if(STREAM_MODE == SLIME) {
-              playEffect(S_FROZEN_EMPIRE_PACK_STARTUP, false, i_volume_effects - 30);
-              playEffect(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, true, i_volume_effects - 40, true, 10000);
+              playEffect(S_FROZEN_EMPIRE_PACK_STARTUP, false, i_volume_effects - i_slime_startup_level);
+              playEffect(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, true, i_volume_effects - i_slime_idle_level, true, 10000);
             }
             else {
               playEffect(S_FROZEN_EMPIRE_PACK_STARTUP);
@@ -998,8 +1052,8 @@ void packStartup(bool firstStart) {
           }
           else {
             if(STREAM_MODE == SLIME) {
-              playEffect(S_BOOTUP, false, i_volume_effects - 30);
-              playEffect(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, true, i_volume_effects - 40, true, 500);
+              playEffect(S_BOOTUP, false, i_volume_effects - i_slime_startup_level);
+              playEffect(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, true, i_volume_effects - i_slime_idle_level, true, 500);
             }
             else {
               playEffect(S_BOOTUP);
@@ -1066,8 +1120,7 @@ void packShutdown() {
     // Turn off the vent lights if they were on.
     ventLight(false);
     ventLightLEDW(false);
-    ms_vent_light_off.stop();
-    ms_vent_light_on.stop();
+    stopLightSequence(TRACK_VENT_LIGHT);
 
     // Turn off any smoke.
     smokeNFilter(false);
@@ -1245,6 +1298,8 @@ void packOffReset() {
   // Tell the wand and any add-on devices that the alarm is off.
   if(b_alarm == true) {
     b_alarm = false;
+    stopAlarmSequence();
+
     // Tell the wand that the alarm is off.
     packSerialSend(P_ALARM_OFF);
 
@@ -1598,7 +1653,7 @@ void cyclotronSwitchLEDUpdate() {
   // When lid is off, updates the switch panel lights using either the stock connectors for individual LEDs,
   // or via the addressable LEDs if the user has installed the custom PCB between the Pack Controller and Cake.
   if(b_cyclotron_lid_on != true) {
-    uint8_t i_colour_scheme = getDeviceColour(CYCLOTRON_PANEL, STREAM_MODE, b_cyclotron_colour_toggle);
+    uint8_t i_colour_scheme = deviceColour(CYCLOTRON_PANEL);
     uint8_t i_brightness = getBrightness(i_cyclotron_panel_brightness);
 
     if(b_alarm == true) {
@@ -1811,41 +1866,42 @@ void cyclotronSwitchLEDUpdate() {
   }
 }
 
+// Whether the Frozen Empire brass pack effect has the switch panel LEDs turned off.
+bool brassPackEffectActive() {
+  return b_brass_pack_sound_loop || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (b_2021_ramp_down || b_alarm || b_wand_mash_lockout) && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM));
+}
+
 void cyclotronSwitchLEDLoop() {
+  if(b_alarm == true && lightKeyframeStarted(TRACK_PANEL_ALARM) && b_cyclotron_lid_on != true && !brassPackEffectActive()) {
+    // The alarm blinks the switch panel on its own sequence, rather than stepping the chase below.
+    i_cyclotron_sw_led = lightSequenceLevel(TRACK_PANEL_ALARM) > 0 ? 1 : 0;
+    cyclotronSwitchLEDUpdate();
+  }
+
   if(ms_cyclotron_switch_led.justFinished()) {
     if(b_cyclotron_lid_on != true) {
       // Frozen Empire brass pack sound is handled here.
       if(SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM) && !b_alarm && !b_overheating && !b_2021_ramp_down && !b_wand_mash_lockout) {
         if(!b_brass_pack_sound_loop) {
-          playEffect(S_FROZEN_EMPIRE_BOOT_EFFECT, true, i_volume_effects, true, 2000);
+          crossfadeTracks(S_EMPTY, S_FROZEN_EMPIRE_BOOT_EFFECT, i_brass_pack_fade_in, FADE_LINEAR);
           b_brass_pack_sound_loop = true;
         }
       }
       else if(b_brass_pack_sound_loop) {
-        stopEffect(S_FROZEN_EMPIRE_BOOT_EFFECT);
+        crossfadeTracks(S_FROZEN_EMPIRE_BOOT_EFFECT, S_EMPTY, i_brass_pack_fade_out, FADE_LINEAR);
         b_brass_pack_sound_loop = false;
       }
 
-      if(b_brass_pack_sound_loop || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (b_2021_ramp_down || b_alarm || b_wand_mash_lockout) && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM))) {
+      if(brassPackEffectActive()) {
         // Per user request, turn off the switch panel LEDs if brass pack is running.
         cyclotronSwitchLEDOff();
       }
-      else {
-        if(b_alarm == true) {
-          if(i_cyclotron_sw_led > 0) {
-            i_cyclotron_sw_led = 0;
-          }
-          else {
-            i_cyclotron_sw_led++;
-          }
+      else if(b_alarm != true) {
+        if(i_cyclotron_sw_led >= 7) {
+          i_cyclotron_sw_led = 0;
         }
         else {
-          if(i_cyclotron_sw_led >= 7) {
-            i_cyclotron_sw_led = 0;
-          }
-          else {
-            i_cyclotron_sw_led++;
-          }
+          i_cyclotron_sw_led++;
         }
 
         // Update the LEDs.
@@ -1856,9 +1912,9 @@ void cyclotronSwitchLEDLoop() {
       // No need to have the Inner Cyclotron switch plate LEDs on when the lid is on.
       cyclotronSwitchLEDOff();
 
-      // Stop the brass pack sound if it is playing.
+      // Fade out the brass pack sound if it is playing.
       if(b_brass_pack_sound_loop) {
-        stopEffect(S_FROZEN_EMPIRE_BOOT_EFFECT);
+        crossfadeTracks(S_FROZEN_EMPIRE_BOOT_EFFECT, S_EMPTY, i_brass_pack_fade_out, FADE_LINEAR);
         b_brass_pack_sound_loop = false;
       }
     }
@@ -1872,18 +1928,18 @@ void cyclotronSwitchLEDLoop() {
       default:
         if(ms_idle_fire_fade.remaining() > 0) {
           if(b_2021_ramp_up == true) {
-            i_cyc_led_delay = i_cyclotron_switch_led_delay + (i_2021_ramp_delay - r_outer_cyclotron_ramp.update());
+            i_cyc_led_delay = i_cyclotron_switch_led_delay + (i_2021_ramp_delay - outerCyclotronRamp());
           }
           else if(b_2021_ramp_down == true) {
-            i_cyc_led_delay = i_cyclotron_switch_led_delay + r_outer_cyclotron_ramp.update();
+            i_cyc_led_delay = i_cyclotron_switch_led_delay + outerCyclotronRamp();
           }
         }
         else {
           if(b_2021_ramp_up == true) {
-            i_cyc_led_delay = i_cyclotron_switch_led_delay + ((i_2021_ramp_delay / 2) - r_outer_cyclotron_ramp.update());
+            i_cyc_led_delay = i_cyclotron_switch_led_delay + ((i_2021_ramp_delay / 2) - outerCyclotronRamp());
           }
           else if(b_2021_ramp_down == true) {
-            i_cyc_led_delay = i_cyclotron_switch_led_delay + r_outer_cyclotron_ramp.update();
+            i_cyc_led_delay = i_cyclotron_switch_led_delay + outerCyclotronRamp();
           }
         }
       break;
@@ -1891,10 +1947,10 @@ void cyclotronSwitchLEDLoop() {
       case SYSTEM_1984:
       case SYSTEM_1989:
         if(b_2021_ramp_up == true) {
-          i_cyc_led_delay = i_cyclotron_switch_led_delay + (r_outer_cyclotron_ramp.update() - i_1984_delay);
+          i_cyc_led_delay = i_cyclotron_switch_led_delay + (outerCyclotronRamp() - i_1984_delay);
         }
         else if(b_2021_ramp_down == true) {
-          i_cyc_led_delay = i_cyclotron_switch_led_delay / 6 + r_outer_cyclotron_ramp.update();
+          i_cyc_led_delay = i_cyclotron_switch_led_delay / 6 + outerCyclotronRamp();
         }
       break;
     }
@@ -1919,7 +1975,7 @@ void powercellRampDown() {
     }
 
     if(b_powercell_sound_loop) {
-      audio.trackLoop(S_POWERCELL, 0); // Turn off looping which stops the track.
+      audioTrackLoop(S_POWERCELL, false); // Turn off looping which stops the track.
       b_powercell_sound_loop = false;
     }
 
@@ -1930,7 +1986,7 @@ void powercellRampDown() {
       case SYSTEM_1984:
       case SYSTEM_1989:
         if(b_2021_ramp_up == true || b_2021_ramp_down == true) {
-          i_pc_delay = i_powercell_delay + (r_outer_cyclotron_ramp.update() - i_1984_delay);
+          i_pc_delay = i_powercell_delay + (outerCyclotronRamp() - i_1984_delay);
         }
       break;
 
@@ -1938,7 +1994,7 @@ void powercellRampDown() {
       case SYSTEM_FROZEN_EMPIRE:
       default:
         if(b_2021_ramp_up == true || b_2021_ramp_down == true) {
-          i_pc_delay = i_powercell_delay + r_outer_cyclotron_ramp.update();
+          i_pc_delay = i_powercell_delay + outerCyclotronRamp();
         }
       break;
     }
@@ -1965,7 +2021,7 @@ void powercellLoop() {
       if(b_powercell_updating != true) {
         if(((SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && b_cyclotron_lid_on && !b_wand_mash_lockout) || SYSTEM_YEAR == SYSTEM_AFTERLIFE) && i_powercell_led == 0 && !b_2021_ramp_up && !b_2021_ramp_down && !b_wand_firing && !b_alarm && !b_overheating) {
           if(b_powercell_sound_loop != true) {
-            playEffect(S_POWERCELL, true, i_volume_effects - i_wand_idle_level, true, 1400);
+            crossfadeTracks(S_EMPTY, S_POWERCELL, 1400, FADE_LINEAR, busGain(BUS_WAND_IDLE));
             b_powercell_sound_loop = true;
           }
         }
@@ -1973,7 +2029,7 @@ void powercellLoop() {
         powercellDraw(i_powercell_led); // Update starting at a specific LED.
 
         // Add a small delay to pause the Power Cell when all Power Cell LEDs are lit up, to match Afterlife and Frozen Empire.
-        if((SYSTEM_YEAR == SYSTEM_AFTERLIFE || SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE) && !b_alarm && i_powercell_led == i_powercell_leds - 1) {
+        if((SYSTEM_YEAR == SYSTEM_AFTERLIFE || SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE) && !b_alarm && (powercellFrame(i_powercell_led) & POWERCELL_FRAME_PAUSE)) {
           i_extra_delay = 350;
         }
 
@@ -1982,7 +2038,7 @@ void powercellLoop() {
     }
 
     if((b_overheating || b_2021_ramp_down || b_2021_ramp_up || b_alarm || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (!b_cyclotron_lid_on || b_wand_mash_lockout))) && b_powercell_sound_loop) {
-      audio.trackLoop(S_POWERCELL, 0); // Turn off looping which stops the track.
+      audioTrackLoop(S_POWERCELL, false); // Turn off looping which stops the track.
       b_powercell_sound_loop = false;
     }
 
@@ -1993,7 +2049,7 @@ void powercellLoop() {
       case SYSTEM_1984:
       case SYSTEM_1989:
         if(b_2021_ramp_up == true || b_2021_ramp_down == true) {
-          i_pc_delay = i_powercell_delay + (r_outer_cyclotron_ramp.update() - i_1984_delay);
+          i_pc_delay = i_powercell_delay + (outerCyclotronRamp() - i_1984_delay);
         }
       break;
 
@@ -2001,7 +2057,7 @@ void powercellLoop() {
       case SYSTEM_FROZEN_EMPIRE:
       default:
         if(b_2021_ramp_up == true || b_2021_ramp_down == true) {
-          i_pc_delay = i_powercell_delay + r_outer_cyclotron_ramp.update();
+          i_pc_delay = i_powercell_delay + outerCyclotronRamp();
         }
       break;
     }
@@ -2123,9 +2179,7 @@ void powercellOn() {
 }
 
 void powercellOff() {
-  for(uint8_t i = 0; i < i_powercell_leds; i++) {
-    pack_leds[i] = getHueAsRGB(POWERCELL, C_BLACK);
-  }
+  fill_solid(pack_leds, i_powercell_leds, CRGB::Black);
 
   i_powercell_led = 0;
 }
@@ -2169,125 +2223,95 @@ void spectralLightsOn() {
   serial1Send(A_SPECTRAL_COLOUR_DATA);
 }
 
-void powercellDraw(uint8_t i_start) {
-  uint8_t i_brightness = getBrightness(i_powercell_brightness); // Calculate desired brightness.
-  uint8_t i_colour_scheme = getDeviceColour(POWERCELL, STREAM_MODE, b_powercell_colour_toggle);
-
-  // Sets the colour for each Power Cell LED, subject to colour toggle setting.
-  for(uint8_t i = i_start; i <= i_powercell_led; i++) {
-    if(i_powercell_led < i_powercell_leds) {
-      uint8_t i_tmp_powercell_led = 0;
+// The LEDs lit in one frame of the Power Cell sequence, for the number of LEDs and direction in use.
+uint16_t powercellFrame(uint8_t i_frame) {
+  const uint16_t *p_frames = nullptr;
 
-      if(b_powercell_invert == true) {
-        if(i_powercell_leds == HASLAB_POWERCELL_LED_COUNT) {
-          i_tmp_powercell_led = PROGMEM_READU8(powercell_13_invert[i]);
-        }
-        else {
-          i_tmp_powercell_led = PROGMEM_READU8(powercell_15_invert[i]);
+  if(i_powercell_leds == HASLAB_POWERCELL_LED_COUNT) {
+    p_frames = b_powercell_invert ? PowercellFrames<HASLAB_POWERCELL_LED_COUNT, true>::table : PowercellFrames<HASLAB_POWERCELL_LED_COUNT, false>::table;
+  }
+  else {
+    p_frames = b_powercell_invert ? PowercellFrames<FRUTTO_POWERCELL_LED_COUNT, true>::table : PowercellFrames<FRUTTO_POWERCELL_LED_COUNT, false>::table;
+  }
 
-        }
-      }
-      else {
-        if(i_powercell_leds == HASLAB_POWERCELL_LED_COUNT) {
-          i_tmp_powercell_led = PROGMEM_READU8(powercell_13[i]);
-        }
-        else {
-          i_tmp_powercell_led = PROGMEM_READU8(powercell_15[i]);
-        }
-      }
+  return PROGMEM_READU16(p_frames[i_frame]);
+}
 
-      // Note: Always assumed to be RGB for built-in.
-      pack_leds[i_tmp_powercell_led] = getHueAsRGB(POWERCELL, i_colour_scheme, i_brightness);
-    }
-  }
+// The LED which a frame of the Power Cell sequence lights in addition to the frame before it.
+uint8_t powercellFrameLed(uint8_t i_frame) {
+  return b_powercell_invert ? i_powercell_leds - 1 - i_frame : i_frame;
 }
 
-// This function handles returning 1984 Cyclotron lookup table values.
-uint8_t cyclotron84LookupTable(uint8_t index) {
-  // First include a sanity check that will reject indexes above 3.
-  if(index > 3) {
-    index = 0;
+// Lights the LEDs of the current Power Cell frame, leaving out those already lit by the frames before i_start.
+void powercellDraw(uint8_t i_start) {
+  if(i_powercell_led < 0 || i_powercell_led >= i_powercell_leds) {
+    return;
   }
 
-  if(b_clockwise) {
-    switch(i_cyclotron_leds) {
-      case HASLAB_CYCLOTRON_LED_COUNT:
-      default:
-        // 1984 CW 12 LED array.
-        return PROGMEM_READU8(i_1984_cyclotron_12_leds_cw[index]);
-      break;
+  uint16_t i_leds = powercellFrame(i_powercell_led) & POWERCELL_FRAME_LEDS;
 
-      case FRUTTO_CYCLOTRON_LED_COUNT:
-        // 1984 CW 20 LED array.
-        return PROGMEM_READU8(i_1984_cyclotron_20_leds_cw[index]);
-      break;
-
-      case FRUTTO_MAX_CYCLOTRON_LED_COUNT:
-        // 1984 CW 36 LED array.
-        return PROGMEM_READU8(i_1984_cyclotron_36_leds_cw[index]);
-      break;
-
-      case OUTER_CYCLOTRON_LED_MAX:
-        // 1984 CW 40 LED array.
-        return PROGMEM_READU8(i_1984_cyclotron_40_leds_cw[index]);
-      break;
-    }
+  if(i_start > 0) {
+    i_leds &= ~powercellFrame(i_start - 1);
   }
-  else {
-    switch(i_cyclotron_leds) {
-      case HASLAB_CYCLOTRON_LED_COUNT:
-      default:
-        // 1984 CCW 12 LED array.
-        return PROGMEM_READU8(i_1984_cyclotron_12_leds_ccw[index]);
-      break;
-
-      case FRUTTO_CYCLOTRON_LED_COUNT:
-        // 1984 CCW 20 LED array.
-        return PROGMEM_READU8(i_1984_cyclotron_20_leds_ccw[index]);
-      break;
 
-      case FRUTTO_MAX_CYCLOTRON_LED_COUNT:
-        // 1984 CCW 36 LED array.
-        return PROGMEM_READU8(i_1984_cyclotron_36_leds_ccw[index]);
-      break;
+  // Sets the colour for the Power Cell LEDs, subject to colour toggle setting.
+  // Note: Always assumed to be RGB for built-in.
+  CRGB colour = getHueAsRGB(POWERCELL, deviceColour(POWERCELL), getBrightness(i_powercell_brightness));
 
-      case OUTER_CYCLOTRON_LED_MAX:
-        // 1984 CCW 40 LED array.
-        return PROGMEM_READU8(i_1984_cyclotron_40_leds_ccw[index]);
-      break;
+  for(uint8_t i = 0; i_leds != 0; i++) {
+    if(i_leds & 1) {
+      pack_leds[i] = colour;
     }
+
+    i_leds >>= 1;
   }
 }
 
-// This function handles returning ring-simulated Cyclotron lookup table values.
-uint8_t cyclotronLookupTable(uint8_t index) {
+// Points the Cyclotron lookups at the tables for the number of Cyclotron Lid LEDs in use.
+void bindCyclotronTables() {
   switch(i_cyclotron_leds) {
     case HASLAB_CYCLOTRON_LED_COUNT:
     default:
-      // Hasbro 12 LED array.
-      return PROGMEM_READU8(i_cyclotron_12led_matrix[index]);
+      useCyclotronTables<HASLAB_CYCLOTRON_LED_COUNT>();
     break;
 
     case FRUTTO_CYCLOTRON_LED_COUNT:
-      // Frutto 20 LED array.
-      return PROGMEM_READU8(i_cyclotron_20led_matrix[index]);
+      useCyclotronTables<FRUTTO_CYCLOTRON_LED_COUNT>();
     break;
 
     case FRUTTO_MAX_CYCLOTRON_LED_COUNT:
-      // Frutto Max 36 LED array.
-      return PROGMEM_READU8(i_cyclotron_36led_matrix[index]);
+      useCyclotronTables<FRUTTO_MAX_CYCLOTRON_LED_COUNT>();
     break;
 
     case OUTER_CYCLOTRON_LED_MAX:
-      // NeoPixel Ring 40 LED array.
-      return PROGMEM_READU8(i_cyclotron_40led_matrix[index]);
+      useCyclotronTables<OUTER_CYCLOTRON_LED_MAX>();
     break;
   }
 }
 
+// This function handles returning 1984 Cyclotron lookup table values.
+uint8_t cyclotron84LookupTable(uint8_t index) {
+  // First include a sanity check that will reject indexes above 3.
+  if(index > 3) {
+    index = 0;
+  }
+
+  // Counter clockwise visits the same lenses in reverse, still starting from the first.
+  if(!b_clockwise) {
+    index = (4 - index) % 4;
+  }
+
+  return PROGMEM_READU8(p_cyclotron_lenses[index]);
+}
+
+// This function handles returning ring-simulated Cyclotron lookup table values.
+uint8_t cyclotronLookupTable(uint8_t index) {
+  return PROGMEM_READU8(p_cyclotron_matrix[index]);
+}
+
 // Reset the Cyclotron LED colours.
 void cyclotronColourReset() {
-  uint8_t i_colour_scheme = getDeviceColour(CYCLOTRON_OUTER, STREAM_MODE, b_cyclotron_colour_toggle);
+  uint8_t i_colour_scheme = deviceColour(CYCLOTRON_OUTER);
 
   // We override the colour changes when using stock HasLab Cyclotron LEDs, returning full white.
   // Changing the colour space with a CHSV Object affects the brightness slightly for non RGB pixels.
@@ -2341,12 +2365,10 @@ void cyclotronControl() {
         }
 
         ms_cyclotron.start(0);
-        ms_alarm.start(0);
-      }
-      else {
-        ms_alarm.start(i_alarm_delay);
       }
 
+      startAlarmSequence();
+
       packAlarm();
 
       // Tell the wand the pack alarm is on.
@@ -2373,12 +2395,10 @@ void cyclotronControl() {
         }
 
         ms_cyclotron.start(0);
-        ms_alarm.start(0);
-      }
-      else {
-        ms_alarm.start(i_alarm_delay);
       }
 
+      startAlarmSequence();
+
       if(b_overheat_lights_off == true) {
         powercellOn();
       }
@@ -2394,14 +2414,12 @@ void cyclotronControl() {
     if(b_2021_ramp_up_start == true) {
       b_2021_ramp_up_start = false;
 
-      r_outer_cyclotron_ramp.go(i_outer_current_ramp_speed); // Reset the ramp.
-      r_inner_cyclotron_ramp.go(i_inner_current_ramp_speed); // Reset the Inner Cyclotron ramp.
+      startCyclotronRamp(i_outer_current_ramp_speed, i_inner_current_ramp_speed); // Reset the ramp.
 
       switch(SYSTEM_YEAR) {
         case SYSTEM_1984:
         case SYSTEM_1989:
-          r_outer_cyclotron_ramp.go(i_1984_delay, i_1984_ramp_length, CIRCULAR_OUT);
-          r_inner_cyclotron_ramp.go(i_1984_inner_delay, i_1984_ramp_length, CIRCULAR_OUT);
+          startCyclotronRamp(i_1984_delay, i_1984_inner_delay, i_1984_ramp_length, CIRCULAR_OUT);
         break;
 
         case SYSTEM_AFTERLIFE:
@@ -2409,14 +2427,12 @@ void cyclotronControl() {
         default:
           if(ms_idle_fire_fade.remaining() > 0) {
             // Full Afterlife startup sequence ramps.
-            r_outer_cyclotron_ramp.go(i_2021_delay, i_2021_ramp_length, QUARTIC_OUT);
-            r_inner_cyclotron_ramp.go(i_2021_inner_delay, i_2021_ramp_length, QUARTIC_OUT);
+            startCyclotronRamp(i_2021_delay, i_2021_inner_delay, i_2021_ramp_length, QUARTIC_OUT);
           }
           else {
             if(b_brass_pack_sound_loop) {
               // Faster startup for brass pack.
-              r_outer_cyclotron_ramp.go(i_2021_delay, (uint16_t)(i_2021_ramp_length / 4), QUADRATIC_OUT);
-              r_inner_cyclotron_ramp.go(i_2021_inner_delay, (uint16_t)(i_2021_ramp_length / 4), QUADRATIC_OUT);
+              startCyclotronRamp(i_2021_delay, i_2021_inner_delay, (uint16_t)(i_2021_ramp_length / 4), QUADRATIC_OUT);
             }
             else {
               // Abbreviated Afterlife/Frozen Empire startup.
@@ -2430,25 +2446,20 @@ void cyclotronControl() {
     else if(b_2021_ramp_down_start == true) {
       b_2021_ramp_down_start = false;
 
-      r_outer_cyclotron_ramp.go(i_outer_current_ramp_speed); // Reset the ramp.
-      r_inner_cyclotron_ramp.go(i_inner_current_ramp_speed); // Reset the Inner Cyclotron ramp.
+      startCyclotronRamp(i_outer_current_ramp_speed, i_inner_current_ramp_speed); // Reset the ramp.
 
       if(SYSTEM_YEAR == SYSTEM_1984 || SYSTEM_YEAR == SYSTEM_1989) {
-        r_outer_cyclotron_ramp.go((uint16_t)(i_1984_delay * 1.3), i_1984_ramp_down_length, CIRCULAR_IN);
-        r_inner_cyclotron_ramp.go(i_inner_ramp_delay, i_1984_ramp_down_length, CIRCULAR_IN);
+        startCyclotronRamp((uint16_t)(i_1984_delay * 1.3), i_inner_ramp_delay, i_1984_ramp_down_length, CIRCULAR_IN);
       }
       else {
         if(ms_mash_lockout.isRunning()) {
-          r_outer_cyclotron_ramp.go(i_2021_ramp_delay, ms_mash_lockout.delay() / 3, QUARTIC_IN);
-          r_inner_cyclotron_ramp.go(i_inner_ramp_delay, ms_mash_lockout.delay() / 3, QUARTIC_IN);
+          startCyclotronRamp(i_2021_ramp_delay, i_inner_ramp_delay, ms_mash_lockout.delay() / 3, QUARTIC_IN);
         }
         else if(SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE) {
-          r_outer_cyclotron_ramp.go(i_2021_ramp_delay, i_2021_ramp_down_length / 4, QUARTIC_IN);
-          r_inner_cyclotron_ramp.go(i_inner_ramp_delay, i_2021_ramp_down_length / 4, QUARTIC_IN);
+          startCyclotronRamp(i_2021_ramp_delay, i_inner_ramp_delay, i_2021_ramp_down_length / 4, QUARTIC_IN);
         }
         else {
-          r_outer_cyclotron_ramp.go(i_2021_ramp_delay, i_2021_ramp_down_length, QUARTIC_IN);
-          r_inner_cyclotron_ramp.go(i_inner_ramp_delay, i_2021_ramp_down_length, QUARTIC_IN);
+          startCyclotronRamp(i_2021_ramp_delay, i_inner_ramp_delay, i_2021_ramp_down_length, QUARTIC_IN);
         }
       }
     }
@@ -2480,8 +2491,9 @@ void cyclotronControl() {
 }
 
 void cyclotronFade() {
-  uint8_t i_colour_scheme = getDeviceColour(CYCLOTRON_OUTER, STREAM_MODE, b_cyclotron_colour_toggle);
-  uint8_t i_cyclotron_leds_total = i_pack_num_leds - i_nfilter_jewel_leds - i_cyclotron_led_start;
+  uint8_t i_colour_scheme = deviceColour(CYCLOTRON_OUTER);
+  uint16_t i_now = millis();
+  uint8_t i = 0;
 
   // We override the colour changes when using stock HasLab Cyclotron LEDs.
   // Changing the colour space with a CHSV Object affects the brightness slightly for non RGB pixels.
@@ -2493,61 +2505,42 @@ void cyclotronFade() {
     case SYSTEM_AFTERLIFE:
     case SYSTEM_FROZEN_EMPIRE:
     default:
-      i_cyclotron_leds_total = OUTER_CYCLOTRON_LED_MAX;
-
-      for(uint8_t i = 0; i < i_cyclotron_leds_total; i++) {
-        if(r_cyclotron_led_fade_in[i].isRunning()) {
-          b_cyclotron_led_fading_in[i] = true;
-
-          uint8_t i_curr_brightness = r_cyclotron_led_fade_in[i].update();
-          i_cyclotron_led_value[i] = i_curr_brightness;
-
-          if(cyclotronLookupTable(i) > 0) {
-            pack_leds[cyclotronLookupTable(i) + i_cyclotron_led_start - 1] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_curr_brightness);
+      while(i < i_cyclotron_fades) {
+        struct CyclotronFade &fade = cyclotronFades[i];
+        bool b_finished = advanceCyclotronFade(fade, i_now);
+        uint8_t i_cyclotron_matrix_led = cyclotronLookupTable(fade.i_led);
+
+        if(i_cyclotron_matrix_led > 0) {
+          if(b_finished && fade.i_target == 0) {
+            pack_leds[i_cyclotron_matrix_led + i_cyclotron_led_start - 1] = getHueAsRGB(CYCLOTRON_OUTER, C_BLACK);
+          }
+          else {
+            pack_leds[i_cyclotron_matrix_led + i_cyclotron_led_start - 1] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_cyclotron_led_value[fade.i_led]);
           }
         }
 
-        uint8_t i_new_brightness = getBrightness(i_cyclotron_brightness);
-        if(r_cyclotron_led_fade_in[i].isFinished() && i_cyclotron_led_value[i] > (i_new_brightness - 1) && b_cyclotron_led_fading_in[i] == true) {
-          i_cyclotron_led_value[i] = i_new_brightness;
-          b_cyclotron_led_fading_in[i] = false;
-
-          r_cyclotron_led_fade_out[i].go(i_new_brightness);
-
+        if(!b_finished) {
+          i++;
+        }
+        else if(fade.i_target > 0) {
+          // Once lit, each LED fades back out behind the spinning light.
           switch(i_cyclotron_leds) {
             case OUTER_CYCLOTRON_LED_MAX:
             case FRUTTO_CYCLOTRON_LED_COUNT:
             case FRUTTO_MAX_CYCLOTRON_LED_COUNT:
-              r_cyclotron_led_fade_out[i].go(0, i_outer_current_ramp_speed * 3, CIRCULAR_OUT);
+              startCyclotronFade(fade.i_led, fade.i_target, 0, i_outer_current_ramp_speed * 3);
             break;
 
             case HASLAB_CYCLOTRON_LED_COUNT:
             default:
-              r_cyclotron_led_fade_out[i].go(0, i_outer_current_ramp_speed * 2, CIRCULAR_OUT);
+              startCyclotronFade(fade.i_led, fade.i_target, 0, i_outer_current_ramp_speed * 2);
             break;
           }
 
-          if(cyclotronLookupTable(i) > 0) {
-            pack_leds[cyclotronLookupTable(i) + i_cyclotron_led_start - 1] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_new_brightness);
-          }
+          i++;
         }
-
-        if(r_cyclotron_led_fade_out[i].isRunning()) {
-          uint8_t i_curr_brightness = r_cyclotron_led_fade_out[i].update();
-          i_cyclotron_led_value[i] = i_curr_brightness;
-
-          if(cyclotronLookupTable(i) > 0) {
-            pack_leds[cyclotronLookupTable(i) + i_cyclotron_led_start - 1] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_curr_brightness);
-          }
-        }
-
-        if(r_cyclotron_led_fade_out[i].isFinished() && b_cyclotron_led_fading_in[i] == false) {
-          i_cyclotron_led_value[i] = 0;
-          b_cyclotron_led_fading_in[i] = true;
-
-          if(cyclotronLookupTable(i) > 0) {
-            pack_leds[cyclotronLookupTable(i) + i_cyclotron_led_start - 1] = getHueAsRGB(CYCLOTRON_OUTER, C_BLACK);
-          }
+        else {
+          removeCyclotronFade(i);
         }
       }
     break;
@@ -2560,34 +2553,22 @@ void cyclotronFade() {
           i_colour_scheme = C_RED;
         }
 
-        for(uint8_t i = 0; i < i_cyclotron_leds_total; i++) {
-          if(r_cyclotron_led_fade_in[i].isRunning()) {
-            b_cyclotron_led_fading_in[i] = true;
-            uint8_t i_curr_brightness = r_cyclotron_led_fade_in[i].update();
+        while(i < i_cyclotron_fades) {
+          struct CyclotronFade &fade = cyclotronFades[i];
+          bool b_finished = advanceCyclotronFade(fade, i_now);
 
-            pack_leds[i + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_curr_brightness, false, !b_overheating);
-            i_cyclotron_led_value[i] = i_curr_brightness;
+          if(b_finished && fade.i_target == 0) {
+            pack_leds[fade.i_led + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, C_BLACK);
           }
-
-          uint8_t i_new_brightness = getBrightness(i_cyclotron_brightness);
-
-          if(r_cyclotron_led_fade_in[i].isFinished() && i_cyclotron_led_value[i] > (i_new_brightness - 1) && b_cyclotron_led_fading_in[i] == true) {
-            pack_leds[i + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_new_brightness, false, !b_overheating);
-            i_cyclotron_led_value[i] = i_new_brightness;
+          else {
+            pack_leds[fade.i_led + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_cyclotron_led_value[fade.i_led], false, !b_overheating);
           }
 
-          if(r_cyclotron_led_fade_out[i].isRunning()) {
-            uint8_t i_curr_brightness = r_cyclotron_led_fade_out[i].update();
-
-            pack_leds[i + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, i_colour_scheme, i_curr_brightness, false, !b_overheating);
-            i_cyclotron_led_value[i] = i_curr_brightness;
-            b_cyclotron_led_fading_in[i] = false;
+          if(b_finished) {
+            removeCyclotronFade(i);
           }
-
-          if(r_cyclotron_led_fade_out[i].isFinished() && b_cyclotron_led_fading_in[i] == false) {
-            pack_leds[i + i_cyclotron_led_start] = getHueAsRGB(CYCLOTRON_OUTER, C_BLACK);
-            i_cyclotron_led_value[i] = 0;
-            b_cyclotron_led_fading_in[i] = true;
+          else {
+            i++;
           }
         }
       }
@@ -2605,7 +2586,7 @@ void cyclotron2021(uint16_t iRampDelay) {
     if(b_2021_ramp_up) {
       i_fast_led_delay = FAST_LED_UPDATE_MS;
 
-      if(r_outer_cyclotron_ramp.isFinished()) {
+      if(cyclotronRampFinished()) {
         b_2021_ramp_up = false;
         i_outer_current_ramp_speed = iRampDelay;
 
@@ -2614,7 +2595,7 @@ void cyclotron2021(uint16_t iRampDelay) {
         i_vibration_level = i_vibration_idle_level_2021;
       }
       else {
-        i_outer_current_ramp_speed = r_outer_cyclotron_ramp.update();
+        i_outer_current_ramp_speed = outerCyclotronRamp();
 
         ms_cyclotron.start(i_outer_current_ramp_speed);
 
@@ -2632,11 +2613,11 @@ void cyclotron2021(uint16_t iRampDelay) {
     else if(b_2021_ramp_down) {
       i_fast_led_delay = FAST_LED_UPDATE_MS;
 
-      if(r_outer_cyclotron_ramp.isFinished()) {
+      if(cyclotronRampFinished()) {
         b_2021_ramp_down = false;
       }
       else {
-        i_outer_current_ramp_speed = r_outer_cyclotron_ramp.update();
+        i_outer_current_ramp_speed = outerCyclotronRamp();
 
         ms_cyclotron.start(i_outer_current_ramp_speed);
 
@@ -2777,8 +2758,7 @@ void cyclotron2021(uint16_t iRampDelay) {
     }
 
     if(i_cyclotron_led_value[i_curr_cyclotron_position] == 0 && i_cyclotron_matrix_led > 0) {
-      r_cyclotron_led_fade_in[i_curr_cyclotron_position].go(0);
-      r_cyclotron_led_fade_in[i_curr_cyclotron_position].go(i_brightness, iRampDelay, CIRCULAR_IN);
+      startCyclotronFade(i_curr_cyclotron_position, 0, i_brightness, iRampDelay);
     }
 
     uint8_t i_cyclotron_lens_gap = 0;
@@ -2918,7 +2898,7 @@ void cyclotron1984(uint16_t iRampDelay) {
     iRampDelay = iRampDelay / i_cyclotron_multiplier;
 
     if(b_2021_ramp_up == true) {
-      if(r_outer_cyclotron_ramp.isFinished()) {
+      if(cyclotronRampFinished()) {
         b_2021_ramp_up = false;
 
         ms_cyclotron.start(iRampDelay);
@@ -2928,19 +2908,19 @@ void cyclotron1984(uint16_t iRampDelay) {
         i_vibration_level = i_vibration_idle_level_1984;
       }
       else {
-        ms_cyclotron.start(r_outer_cyclotron_ramp.update());
-        i_outer_current_ramp_speed = r_outer_cyclotron_ramp.update();
+        ms_cyclotron.start(outerCyclotronRamp());
+        i_outer_current_ramp_speed = outerCyclotronRamp();
 
         i_vibration_level = i_vibration_idle_level_1984;
       }
     }
     else if(b_2021_ramp_down == true) {
-      if(r_outer_cyclotron_ramp.isFinished()) {
+      if(cyclotronRampFinished()) {
         b_2021_ramp_down = false;
       }
       else {
-        ms_cyclotron.start(r_outer_cyclotron_ramp.update());
-        i_outer_current_ramp_speed = r_outer_cyclotron_ramp.update();
+        ms_cyclotron.start(outerCyclotronRamp());
+        i_outer_current_ramp_speed = outerCyclotronRamp();
 
         i_vibration_level = i_vibration_level - 1;
 
@@ -2982,7 +2962,7 @@ void cyclotron1984(uint16_t iRampDelay) {
 
 void cyclotron1984Alarm() {
   uint8_t i_brightness = getBrightness(i_cyclotron_brightness);
-  uint8_t i_colour_scheme = getDeviceColour(CYCLOTRON_OUTER, STREAM_MODE, b_cyclotron_colour_toggle);
+  uint8_t i_colour_scheme = deviceColour(CYCLOTRON_OUTER);
   uint8_t led1 = i_cyclotron_led_start + cyclotron84LookupTable(0);
   uint8_t led2 = i_cyclotron_led_start + cyclotron84LookupTable(1);
   uint8_t led3 = i_cyclotron_led_start + cyclotron84LookupTable(2);
@@ -3061,17 +3041,17 @@ void cyclotron1984Alarm() {
 
     if(b_fade_in_now) {
       clearCyclotronFades();
-      r_cyclotron_led_fade_in[led1 - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
-      r_cyclotron_led_fade_in[led2 - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
-      r_cyclotron_led_fade_in[led3 - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
-      r_cyclotron_led_fade_in[led4 - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+      startCyclotronFade(led1 - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
+      startCyclotronFade(led2 - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
+      startCyclotronFade(led3 - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
+      startCyclotronFade(led4 - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
     }
 
     // Turn on all the other cyclotron LEDs if required.
     if(b_cyclotron_single_led != true) {
       for(uint8_t i = 1; i <= i_led_array_width; i++) {
         if(b_fade_in_now) {
-          r_cyclotron_led_fade_in[led1 + i - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+          startCyclotronFade(led1 + i - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
         }
 
         if(led1 - i < i_cyclotron_led_start) {
@@ -3082,11 +3062,11 @@ void cyclotron1984Alarm() {
         }
 
         if(b_fade_in_now) {
-          r_cyclotron_led_fade_in[led1 - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+          startCyclotronFade(led1 - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
         }
 
         if(b_fade_in_now) {
-          r_cyclotron_led_fade_in[led2 + i - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+          startCyclotronFade(led2 + i - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
         }
 
         if(led2 - i < i_cyclotron_led_start) {
@@ -3097,11 +3077,11 @@ void cyclotron1984Alarm() {
         }
 
         if(b_fade_in_now) {
-          r_cyclotron_led_fade_in[led2 - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+          startCyclotronFade(led2 - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
         }
 
         if(b_fade_in_now) {
-          r_cyclotron_led_fade_in[led3 + i - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+          startCyclotronFade(led3 + i - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
         }
 
         if(led3 - i < i_cyclotron_led_start) {
@@ -3112,11 +3092,11 @@ void cyclotron1984Alarm() {
         }
 
         if(b_fade_in_now) {
-          r_cyclotron_led_fade_in[led3 - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+          startCyclotronFade(led3 - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
         }
 
         if(b_fade_in_now) {
-          r_cyclotron_led_fade_in[led4 + i - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+          startCyclotronFade(led4 + i - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
         }
 
         if(led4 - i < i_cyclotron_led_start) {
@@ -3127,7 +3107,7 @@ void cyclotron1984Alarm() {
         }
 
         if(b_fade_in_now) {
-          r_cyclotron_led_fade_in[led4 - i_cyclotron_led_start].go(i_brightness, i_1984_delay * 2, CIRCULAR_IN);
+          startCyclotronFade(led4 - i_cyclotron_led_start, 0, i_brightness, i_1984_delay * 2);
         }
       }
     }
@@ -3136,7 +3116,7 @@ void cyclotron1984Alarm() {
 
 void cyclotron84LightOn(uint8_t cLed) {
   uint8_t i_brightness = getBrightness(i_cyclotron_brightness);
-  uint8_t i_colour_scheme = getDeviceColour(CYCLOTRON_OUTER, STREAM_MODE, b_cyclotron_colour_toggle);
+  uint8_t i_colour_scheme = deviceColour(CYCLOTRON_OUTER);
   uint8_t i_led_array_width = 1; // Variable to store the number of LEDs to either side of the center LED.
 
   /*
@@ -3216,16 +3196,14 @@ void cyclotron84LightOff(uint8_t cLed) {
     uint8_t i_brightness_tmp = 0;
 
     if(i_cyclotron_led_value[cLed - i_cyclotron_led_start] == i_brightness) {
-      r_cyclotron_led_fade_out[cLed - i_cyclotron_led_start].go(i_brightness);
-      r_cyclotron_led_fade_out[cLed - i_cyclotron_led_start].go(i_brightness_tmp, (i_1984_delay * 2) / i_cyclotron_multiplier, CIRCULAR_OUT);
+      startCyclotronFade(cLed - i_cyclotron_led_start, i_brightness, i_brightness_tmp, (i_1984_delay * 2) / i_cyclotron_multiplier);
     }
 
     // Turn off the other 2 LEDs if we are allowing 3 to light up.
     if(b_cyclotron_single_led != true) {
       for(uint8_t i = 1; i <= i_led_array_width; i++) {
         if(i_cyclotron_led_value[cLed + i - i_cyclotron_led_start] == i_brightness) {
-          r_cyclotron_led_fade_out[cLed + i - i_cyclotron_led_start].go(i_brightness);
-          r_cyclotron_led_fade_out[cLed + i - i_cyclotron_led_start].go(i_brightness_tmp, (i_1984_delay * 2) / i_cyclotron_multiplier, CIRCULAR_OUT);
+          startCyclotronFade(cLed + i - i_cyclotron_led_start, i_brightness, i_brightness_tmp, (i_1984_delay * 2) / i_cyclotron_multiplier);
         }
 
         uint8_t cLedTemp = cLed; // Create new temporary variable for the negative side.
@@ -3238,8 +3216,7 @@ void cyclotron84LightOff(uint8_t cLed) {
         }
 
         if(i_cyclotron_led_value[cLedTemp - i_cyclotron_led_start] == i_brightness) {
-          r_cyclotron_led_fade_out[cLedTemp - i_cyclotron_led_start].go(i_brightness);
-          r_cyclotron_led_fade_out[cLedTemp - i_cyclotron_led_start].go(i_brightness_tmp, (i_1984_delay * 2) / i_cyclotron_multiplier, CIRCULAR_OUT);
+          startCyclotronFade(cLedTemp - i_cyclotron_led_start, i_brightness, i_brightness_tmp, (i_1984_delay * 2) / i_cyclotron_multiplier);
         }
       }
     }
@@ -3270,7 +3247,7 @@ void slimeCyclotronEffect() {
     }
 
     uint8_t i_cyclotron_leds_total = i_pack_num_leds - i_nfilter_jewel_leds - i_cyclotron_led_start;
-    uint8_t i_colour_scheme = getDeviceColour(CYCLOTRON_OUTER, STREAM_MODE, b_cyclotron_colour_toggle);
+    uint8_t i_colour_scheme = deviceColour(CYCLOTRON_OUTER);
     uint8_t i_random_lower = 50;
     uint8_t i_random_upper = 121;
 
@@ -3472,21 +3449,8 @@ void packVenting() {
     fanBooster(true);
 
     // For strobing the vent light.
-    if(ms_vent_light_off.justFinished()) {
-      ms_vent_light_off.stop();
-      ms_vent_light_on.start(i_vent_light_delay);
-
-      if(b_overheat_strobe == true) {
-        ventLight(true);
-      }
-    }
-    else if(ms_vent_light_on.justFinished()) {
-      ms_vent_light_on.stop();
-      ms_vent_light_off.start(i_vent_light_delay);
-
-      if(b_overheat_strobe == true) {
-        ventLight(false);
-      }
+    if(lightKeyframeStarted(TRACK_VENT_LIGHT) && b_overheat_strobe == true) {
+      ventLight(lightSequenceLevel(TRACK_VENT_LIGHT) > 0);
     }
 
     // For non-strobing vent light option.
@@ -3604,8 +3568,7 @@ void cyclotronOverheating() {
     case SYSTEM_1989:
       innerCyclotronRingUpdate(i_2021_inner_delay * 16);
 
-      if(ms_alarm.justFinished()) {
-        ms_alarm.start(i_1984_delay / 2);
+      if(lightKeyframeStarted(TRACK_ALARM) && lightSequenceLevel(TRACK_ALARM) == 0) {
 
         if(!usingSlimeCyclotron()) {
           if(b_fade_cyclotron_led != true) {
@@ -3618,7 +3581,7 @@ void cyclotronOverheating() {
           }
         }
       }
-      else if(ms_alarm.remaining() < i_1984_delay / 4) {
+      else if(lightSequenceLevel(TRACK_ALARM) > 0) {
         if(b_overheat_lights_off != true) {
           vibrationPack(i_vibration_lowest_level);
 
@@ -3650,21 +3613,8 @@ void cyclotronOverheating() {
     fanBooster(true);
 
     // For strobing the vent light.
-    if(ms_vent_light_off.justFinished()) {
-      ms_vent_light_off.stop();
-      ms_vent_light_on.start(i_vent_light_delay);
-
-      if(b_overheat_strobe == true) {
-        ventLight(true);
-      }
-    }
-    else if(ms_vent_light_on.justFinished()) {
-      ms_vent_light_on.stop();
-      ms_vent_light_off.start(i_vent_light_delay);
-
-      if(b_overheat_strobe == true) {
-        ventLight(false);
-      }
+    if(lightKeyframeStarted(TRACK_VENT_LIGHT) && b_overheat_strobe == true) {
+      ventLight(lightSequenceLevel(TRACK_VENT_LIGHT) > 0);
     }
 
     // For non-strobing vent light option.
@@ -3708,10 +3658,7 @@ void packOverheatingStart() {
     ms_overheating.start(i_overheating_delay);
 
     // Reset some vent light timers.
-    ms_vent_light_off.stop();
-    ms_vent_light_on.stop();
-    //ms_fan_stop_timer.stop();
-    ms_vent_light_off.start(i_vent_light_delay);
+    startLightSequence(TRACK_VENT_LIGHT, LIGHT_SEQUENCE(VENT_LIGHT_STROBE));
     //ms_fan_stop_timer.start(i_fan_stop_timer);
   }
 
@@ -3736,10 +3683,7 @@ void packVentingStart() {
   }
   else {
     // Reset some vent light timers.
-    ms_vent_light_off.stop();
-    ms_vent_light_on.stop();
-    //ms_fan_stop_timer.stop();
-    ms_vent_light_off.start(i_vent_light_delay);
+    startLightSequence(TRACK_VENT_LIGHT, LIGHT_SEQUENCE(VENT_LIGHT_STROBE));
     //ms_fan_stop_timer.start(i_fan_stop_timer);
   }
 
@@ -3756,7 +3700,7 @@ void packVentingStart() {
 
 void packOverheatingFinished() {
   if(b_wand_syncing != true) {
-    packSerialSend(P_OVERHEATING_FINISHED);
+    packSerialSendReliable(P_OVERHEATING_FINISHED);
   }
 
   serial1Send(A_OVERHEATING_FINISHED);
@@ -3802,6 +3746,7 @@ void packOverheatingFinished() {
   }
 
   b_alarm = false;
+  stopAlarmSequence();
 
   if(b_overheat_lights_off == true) {
     cyclotronSpeedRevert();
@@ -3817,8 +3762,7 @@ void packOverheatingFinished() {
   // Turn off the vent lights
   ventLight(false);
   ventLightLEDW(false);
-  ms_vent_light_off.stop();
-  ms_vent_light_on.stop();
+  stopLightSequence(TRACK_VENT_LIGHT);
 
   ms_cyclotron.start(i_2021_delay);
 }
@@ -3854,8 +3798,25 @@ void packVentingFinished() {
   // Turn off the vent lights
   ventLight(false);
   ventLightLEDW(false);
-  ms_vent_light_off.stop();
-  ms_vent_light_on.stop();
+  stopLightSequence(TRACK_VENT_LIGHT);
+}
+
+// Starts the alarm blinks for the current year.
+void startAlarmSequence() {
+  if(SYSTEM_YEAR == SYSTEM_1984 || SYSTEM_YEAR == SYSTEM_1989) {
+    startLightSequence(TRACK_ALARM, LIGHT_SEQUENCE(ALARM_1984));
+    startLightSequence(TRACK_PANEL_ALARM, LIGHT_SEQUENCE(PANEL_ALARM_1984));
+  }
+  else {
+    // The first Afterlife/Frozen Empire blink ends i_alarm_delay after the alarm starts.
+    startLightSequence(TRACK_ALARM, LIGHT_SEQUENCE(ALARM_2021), true, i_alarm_delay > i_1984_delay ? i_alarm_delay - i_1984_delay : 0);
+    startLightSequence(TRACK_PANEL_ALARM, LIGHT_SEQUENCE(PANEL_ALARM_2021));
+  }
+}
+
+void stopAlarmSequence() {
+  stopLightSequence(TRACK_ALARM);
+  stopLightSequence(TRACK_PANEL_ALARM);
 }
 
 void cyclotronNoCable() {
@@ -3867,13 +3828,12 @@ void cyclotronNoCable() {
 
       innerCyclotronRingUpdate(i_2021_inner_delay * 16);
 
-      if(ms_alarm.justFinished()) {
+      if(lightKeyframeStarted(TRACK_ALARM) && lightSequenceLevel(TRACK_ALARM) == 0) {
         ventLight(false);
         ventLightLEDW(false);
-        ms_alarm.start(i_1984_delay);
       }
       else {
-        if(ms_alarm.remaining() < i_1984_delay / 2) {
+        if(lightSequenceLevel(TRACK_ALARM) > 0) {
           ventLight(true);
           ventLightLEDW(true);
         }
@@ -3888,8 +3848,7 @@ void cyclotronNoCable() {
 
       innerCyclotronRingUpdate(i_2021_inner_delay * 16);
 
-      if(ms_alarm.justFinished()) {
-        ms_alarm.start(i_1984_delay / 2);
+      if(lightKeyframeStarted(TRACK_ALARM) && lightSequenceLevel(TRACK_ALARM) == 0) {
 
         // Turn off the N-Filter lights.
         ventLight(false);
@@ -3898,7 +3857,7 @@ void cyclotronNoCable() {
         vibrationPack(i_vibration_lowest_level);
       }
       else {
-        if(ms_alarm.remaining() < i_1984_delay / 4) {
+        if(lightSequenceLevel(TRACK_ALARM) > 0) {
           vibrationPack(i_vibration_idle_level_1984);
 
           // Turn on the N-Filter lights.
@@ -3958,15 +3917,6 @@ void resetCyclotronState() {
   cyclotronSpeedRevert();
 }
 
-void clearCyclotronFades() {
-  for(uint8_t i = 0; i < OUTER_CYCLOTRON_LED_MAX; i++) {
-    i_cyclotron_led_value[i] = 0;
-    r_cyclotron_led_fade_out[i].go(0);
-    r_cyclotron_led_fade_in[i].go(0);
-    b_cyclotron_led_fading_in[i] = true;
-  }
-}
-
 void innerCyclotronLEDPanelOff() {
   if(INNER_CYC_PANEL_MODE != PANEL_INDIVIDUAL) {
     if(b_cyclotron_lid_on == true) {
@@ -4076,27 +4026,27 @@ void innerCyclotronCavityUpdate(uint16_t iRampDelay) {
 void innerCyclotronRingUpdate(uint16_t iRampDelay) {
   if(ms_cyclotron_ring.justFinished()) {
     if(b_inner_ramp_up == true) {
-      if(r_inner_cyclotron_ramp.isFinished()) {
+      if(cyclotronRampFinished()) {
         b_inner_ramp_up = false;
         ms_cyclotron_ring.start(iRampDelay);
 
         i_inner_current_ramp_speed = iRampDelay;
       }
       else {
-        ms_cyclotron_ring.start(r_inner_cyclotron_ramp.update());
-        i_inner_current_ramp_speed = r_inner_cyclotron_ramp.update();
+        ms_cyclotron_ring.start(innerCyclotronRamp());
+        i_inner_current_ramp_speed = innerCyclotronRamp();
       }
     }
     else if(b_inner_ramp_down == true) {
       innerCyclotronCavityOff(); // Turn off (sparking) cavity lights.
 
-      if(r_inner_cyclotron_ramp.isFinished()) {
+      if(cyclotronRampFinished()) {
         b_inner_ramp_down = false;
       }
       else {
-        ms_cyclotron_ring.start(r_inner_cyclotron_ramp.update());
+        ms_cyclotron_ring.start(innerCyclotronRamp());
 
-        i_inner_current_ramp_speed = r_inner_cyclotron_ramp.update();
+        i_inner_current_ramp_speed = innerCyclotronRamp();
       }
     }
     else {
@@ -4175,7 +4125,7 @@ void innerCyclotronRingUpdate(uint16_t iRampDelay) {
 
     // Colour control for the Inner Cyclotron LEDs.
     uint8_t i_brightness = getBrightness(i_cyclotron_inner_brightness);
-    uint8_t i_colour_scheme = getDeviceColour(CYCLOTRON_INNER, STREAM_MODE, b_cyclotron_colour_toggle);
+    uint8_t i_colour_scheme = deviceColour(CYCLOTRON_INNER);
 
     if(SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && STREAM_MODE == PROTON) {
       // As a "sparking" effect is predominant in GB:FE during the Proton stream,
@@ -4266,7 +4216,7 @@ void ventLightLEDW(bool b_on) {
 }
 
 void ventLight(bool b_on) {
-  uint8_t i_colour_scheme = getDeviceColour(VENT_LIGHT, STREAM_MODE, true);
+  uint8_t i_colour_scheme = deviceColour(VENT_LIGHT);
   b_vent_light_on = b_on;
 
   if(b_on == true) {
@@ -4468,18 +4418,18 @@ void modeFireStartSounds() {
   if((SYSTEM_YEAR == SYSTEM_AFTERLIFE || SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE) && i_wand_power_level < 5) {
     if(ms_idle_fire_fade.remaining() < 3000) {
       if(STREAM_MODE == SLIME) {
-        adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - 40, true, 100);
+        adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - i_slime_idle_level, true, 100);
       }
       else {
-        adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - 2, true, 100);
+        adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - i_idle_fire_level, true, 100);
       }
     }
     else {
       if(STREAM_MODE == SLIME) {
-        adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - 40, true, ms_idle_fire_fade.remaining());
+        adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - i_slime_idle_level, true, ms_idle_fire_fade.remaining());
       }
       else {
-        adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - 2, true, ms_idle_fire_fade.remaining());
+        adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - i_idle_fire_level, true, ms_idle_fire_fade.remaining());
       }
     }
   }
@@ -4492,6 +4442,7 @@ void wandFiring() {
   }
 
   modeFireStartSounds();
+  setMusicDuck(DUCK_FIRING, true);
 
   b_wand_firing = true;
   serial1Send(A_FIRING);
@@ -4515,14 +4466,12 @@ void wandFiring() {
   }
 
   // Just in case a semi-auto was fired before we started firing a stream, stop its vibration timer.
-  ms_menu_vibration.stop();
+  cancelTimer(menuVibrationFinished);
 
   vibrationPack(255);
 
   // Reset some vent light timers.
-  ms_vent_light_off.stop();
-  ms_vent_light_on.stop();
-  ms_vent_light_off.start(i_vent_light_delay);
+  startLightSequence(TRACK_VENT_LIGHT, LIGHT_SEQUENCE(VENT_LIGHT_STROBE));
 
   // Reset vent sounds flag.
   b_vent_sounds = true;
@@ -4630,7 +4579,7 @@ void modeFireStopSounds() {
     if((SYSTEM_YEAR == SYSTEM_AFTERLIFE || SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE) && i_wand_power_level < 5) {
       if(ms_idle_fire_fade.remaining() < 1000) {
         if(STREAM_MODE == SLIME) {
-          adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - 40, true, 30);
+          adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - i_slime_idle_level, true, 30);
         }
         else {
           adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects, true, 30);
@@ -4638,7 +4587,7 @@ void modeFireStopSounds() {
       }
       else {
         if(STREAM_MODE == SLIME) {
-          adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - 40, true, ms_idle_fire_fade.remaining());
+          adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - i_slime_idle_level, true, ms_idle_fire_fade.remaining());
         }
         else {
           adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects, true, ms_idle_fire_fade.remaining());
@@ -4650,6 +4599,7 @@ void modeFireStopSounds() {
 
 void wandStoppedFiring() {
   modeFireStopSounds();
+  setMusicDuck(DUCK_FIRING, false);
 
   ms_firing_sound_mix.stop();
 
@@ -4663,8 +4613,7 @@ void wandStoppedFiring() {
   b_firing_intensify = false;
 
   // Reset some vent light timers.
-  ms_vent_light_off.stop();
-  ms_vent_light_on.stop();
+  stopLightSequence(TRACK_VENT_LIGHT);
   ventLight(false);
   ventLightLEDW(false);
 
@@ -5003,14 +4952,12 @@ void cyclotronSwitchPlateLEDs() {
     }
   }
 
-  bool b_brass_pack_effect_active = b_brass_pack_sound_loop || (SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE && (b_2021_ramp_down || b_alarm || b_wand_mash_lockout) && (STREAM_MODE == PROTON || STREAM_MODE == SPECTRAL_CUSTOM));
-
-  if(b_cyclotron_lid_on != true && !b_brass_pack_effect_active) {
+  if(b_cyclotron_lid_on != true && !brassPackEffectActive()) {
     uint8_t i_brightness = getBrightness(i_cyclotron_panel_brightness);
 
     // Change colors for year theme switch indicator.
     if(SYSTEM_YEAR == SYSTEM_1984 || SYSTEM_YEAR == SYSTEM_1989) {
-      if(ms_cyclotron_switch_plate_leds.remaining() < i_cyclotron_switch_plate_leds_delay / 2) {
+      if(lightSequenceLevel(TRACK_SWITCH_PLATE) > 0) {
         digitalWriteFast(YEAR_TOGGLE_LED_PIN, HIGH);
 
         if(INNER_CYC_PANEL_MODE != PANEL_INDIVIDUAL) {
@@ -5055,7 +5002,7 @@ void cyclotronSwitchPlateLEDs() {
 
     // Change colors for vibration switch indicator.
     if(b_vibration_switch_on) {
-      if(ms_cyclotron_switch_plate_leds.remaining() < i_cyclotron_switch_plate_leds_delay / 2) {
+      if(lightSequenceLevel(TRACK_SWITCH_PLATE) > 0) {
         digitalWriteFast(VIBRATION_TOGGLE_LED_PIN, HIGH);
 
         if(INNER_CYC_PANEL_MODE != PANEL_INDIVIDUAL) {
@@ -5088,10 +5035,6 @@ void cyclotronSwitchPlateLEDs() {
       cyclotron_leds[i_ic_panel_end] = getHueAsRGB(CYCLOTRON_PANEL, C_BLACK);
     }
   }
-
-  if(ms_cyclotron_switch_plate_leds.justFinished()) {
-    ms_cyclotron_switch_plate_leds.repeat();
-  }
 }
 
 void vibrationPack(uint8_t i_level) {
@@ -5120,25 +5063,31 @@ void vibrationPack(uint8_t i_level) {
 }
 
 void checkMenuVibration() {
-  if(VIBRATION_MODE != CYCLOTRON_MOTOR) {
-    if(ms_menu_vibration.justFinished()) {
-      vibrationOff();
+  if(VIBRATION_MODE != CYCLOTRON_MOTOR && timerScheduled(menuVibrationFinished)) {
+    if(PACK_STATE == MODE_OFF) {
+      // If we're off we must be in the EEPROM Config Menu; vibrate at 59%.
+      analogWrite(VIBRATION_PIN, 150);
     }
-    else if(ms_menu_vibration.isRunning()) {
-      if(PACK_STATE == MODE_OFF) {
-        // If we're off we must be in the EEPROM Config Menu; vibrate at 59%.
-        analogWrite(VIBRATION_PIN, 150);
-      }
-      else {
-        // If we're on we must be firing a semi-auto blast; vibrate at 71%.
-        analogWrite(VIBRATION_PIN, 180);
-      }
+    else {
+      // If we're on we must be firing a semi-auto blast; vibrate at 71%.
+      analogWrite(VIBRATION_PIN, 180);
     }
   }
 }
 
+// Non-blocking buzz for confirmations and semi-auto blasts, ended by the timer scheduler.
+void startMenuVibration(uint16_t i_length) {
+  scheduleTimer(menuVibrationFinished, i_length);
+}
+
+void menuVibrationFinished() {
+  if(VIBRATION_MODE != CYCLOTRON_MOTOR) {
+    vibrationOff();
+  }
+}
+
 void vibrationOff() {
-  ms_menu_vibration.stop();
+  cancelTimer(menuVibrationFinished);
   i_vibration_level_prev = 0;
   digitalWrite(VIBRATION_PIN, LOW);
 }
@@ -5338,10 +5287,22 @@ void serial1HandShake() {
       // Attenuator has abandoned us.
       b_serial1_syncing = false;
       b_serial1_connected = false;
+
+      // Listen at the default rate for the next sync.
+      serial1BaudFallback();
+
+      // Send every command on its own until the next device says what it supports.
+      b_serial1_mirror = false;
+      b_serial1_batch = false;
+
+      // The time until the next device appears is not a gap in the link.
+      i_serial1_link_last_frame = 0;
+      i_serial1_link_request_time = 0;
     }
     else if(ms_serial1_check.remaining() < (ms_serial1_check.delay() / 2) && !b_serial1_syncing) {
       // Haven't heard from the Attenuator recently; let's check in.
       b_serial1_syncing = true;
+      i_serial1_link_request_time = millis();
       serial1Send(A_HANDSHAKE);
     }
   }
@@ -5362,6 +5323,16 @@ void wandDisconnectCheck() {
       b_wand_syncing = false; // If there is no wand we cannot be syncing with one.
       b_wand_on = false; // No wand means the device is no longer powered on.
 
+      // Listen at the default rate for the next sync, and send commands singly until a wand says what it supports.
+      wandBaudFallback();
+      b_wand_batch = false;
+      b_wand_reliable = false;
+      b_wand_reliable_confirmed = false;
+
+      // The time until the next wand appears is not a gap in the link.
+      i_wand_link_last_frame = 0;
+      i_wand_link_request_time = 0;
+
       // Tell the serial1 device the wand was disconnected.
       serial1Send(A_WAND_DISCONNECTED);
 
@@ -5389,10 +5360,11 @@ void wandDisconnectCheck() {
     }
     else {
       if(ms_wand_check.remaining() < (ms_wand_check.delay() / 5) && !b_wand_syncing) {
-        // If we haven't received a handshake from the wand in over 6.5 seconds, force a handshake with the wand.
-        // This is because the wand is supposed to handshake every 3.25 seconds and we haven't heard back in two pings.
+        // If we haven't received a handshake from the wand in over 6.5 seconds (2 seconds with reliable commands), force a handshake with the wand.
+        // This is because the wand is supposed to handshake every 3.25 seconds (1 second) and we haven't heard back in two pings.
         // This should be a last-resort check to make sure it's available and responding.
         b_wand_syncing = true;
+        i_wand_link_request_time = millis();
         packSerialSend(P_HANDSHAKE);
       }
     }
@@ -5403,23 +5375,23 @@ void wandExtraSoundsBeepLoop() {
   if(b_overheating != true) {
     switch(i_wand_power_level) {
       case 1:
-        playEffect(S_AFTERLIFE_BEEP_WAND_S1, true, i_volume_effects - i_wand_idle_level);
+        playEffect(S_AFTERLIFE_BEEP_WAND_S1, true, busGain(BUS_WAND_IDLE));
       break;
 
       case 2:
-        playEffect(S_AFTERLIFE_BEEP_WAND_S2, true, i_volume_effects - i_wand_idle_level);
+        playEffect(S_AFTERLIFE_BEEP_WAND_S2, true, busGain(BUS_WAND_IDLE));
       break;
 
       case 3:
-        playEffect(S_AFTERLIFE_BEEP_WAND_S3, true, i_volume_effects - i_wand_idle_level);
+        playEffect(S_AFTERLIFE_BEEP_WAND_S3, true, busGain(BUS_WAND_IDLE));
       break;
 
       case 4:
-        playEffect(S_AFTERLIFE_BEEP_WAND_S4, true, i_volume_effects - i_wand_idle_level);
+        playEffect(S_AFTERLIFE_BEEP_WAND_S4, true, busGain(BUS_WAND_IDLE));
       break;
 
       case 5:
-        playEffect(S_AFTERLIFE_BEEP_WAND_S5, true, i_volume_effects - i_wand_idle_level);
+        playEffect(S_AFTERLIFE_BEEP_WAND_S5, true, busGain(BUS_WAND_IDLE));
       break;
     }
   }
@@ -5428,11 +5400,11 @@ void wandExtraSoundsBeepLoop() {
 void wandExtraSoundsBeepLoopStop(bool stopNaturally) {
   if(stopNaturally) {
     // Set all beep looping to false so they stop naturally.
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S1, false);
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S2, false);
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S3, false);
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S4, false);
-    audio.trackLoop(S_AFTERLIFE_BEEP_WAND_S5, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S1, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S2, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S3, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S4, false);
+    audioTrackLoop(S_AFTERLIFE_BEEP_WAND_S5, false);
   }
   else {
     // Stop all beeps explicitly to prevent rapid switching from taking up all available channels.
@@ -5573,6 +5545,9 @@ void updateProtonPackLEDCounts() {
   i_cyclotron_led_start = i_powercell_leds;
   i_vent_light_start = i_powercell_leds + i_cyclotron_leds;
 
+  // Use the Cyclotron lookup tables for this number of LEDs.
+  bindCyclotronTables();
+
   // Calculate the inner cyclotron which may consist of the optional components:
   // [in order...] Switch Panel + Cake Lights + Cavity Lights
   if(INNER_CYC_PANEL_MODE != PANEL_INDIVIDUAL) {
@@ -5589,6 +5564,11 @@ void updateProtonPackLEDCounts() {
     i_ic_cavity_start = i_ic_cake_end + 1;
     i_ic_cavity_end = i_ic_cavity_start + i_inner_cyclotron_cavity_num_leds - 1;
   }
+
+  // Only send to the LEDs in use, and pick the update interval to suit.
+  resizeLedChain(PACK_LED_CHAIN, i_pack_num_leds);
+  resizeLedChain(CYCLOTRON_LED_CHAIN, i_inner_cyclotron_panel_num_leds + i_inner_cyclotron_cake_num_leds + i_inner_cyclotron_cavity_num_leds);
+  updateLedFrameRate();
 }
 
 // Update the LED counts for the inner cyclotron, if we are using the addon LED panel or not.
@@ -5723,13 +5703,13 @@ void restartFromWandMash() {
         // Play pack restart sound depending on lid on/off.
         playEffect(S_PACK_RECOVERY);
         if(STREAM_MODE == SLIME) {
-          playEffect(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, true, i_volume_effects - 40, true, 500);
+          playEffect(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, true, i_volume_effects - i_slime_idle_level, true, 500);
         }
         else {
           playEffect(S_FROZEN_EMPIRE_PACK_IDLE_LOOP, true, i_volume_effects, true, 2000);
         }
         if(b_brass_pack_sound_loop) {
-          playEffect(S_FROZEN_EMPIRE_BOOT_EFFECT, true, i_volume_effects, true, 2000);
+          crossfadeTracks(S_EMPTY, S_FROZEN_EMPIRE_BOOT_EFFECT, i_brass_pack_fade_in, FADE_LINEAR);
         }
 
         // Trigger timer for restart sequence.
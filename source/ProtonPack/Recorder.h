@@ -0,0 +1,195 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Serial traffic recorder, for builds with GPSTAR_SERIAL_RECORDER defined. In a normal build the markers compile to nothing.
+ *
+ * Every SerialTransfer frame to and from the wand and the Serial1 device is kept with its time in milliseconds in a
+ * RAM ring buffer, which holds the most recent frames. Send "c" on the USB console to print the capture and clear
+ * the buffer, or "l" to also print each frame as it happens. Each frame is printed as one line:
+ *
+ *   rec,<ms>,<port>,<direction>,<packet id>,<payload hex>
+ *
+ * The port is "wand" or "serial1", and the direction is "in" or "out" as seen by the pack. Any other console
+ * output is ignored when the capture is replayed with ProtonPackNative/serial_replay.py. A replay starts from power
+ * on, so for one use "l" from power on, or a RECORDER_BUFFER_SIZE large enough to hold the whole session.
+ */
+enum RECORDER_FRAMES : uint8_t {
+  RECORD_WAND_IN,
+  RECORD_WAND_OUT,
+  RECORD_SERIAL1_IN,
+  RECORD_SERIAL1_OUT
+};
+
+#ifdef GPSTAR_SERIAL_RECORDER
+  #define RECORD_FRAME(t, id, p, n) recordFrame(t, id, p, n)
+#else
+  #define RECORD_FRAME(t, id, p, n)
+#endif
+
+#ifdef GPSTAR_SERIAL_RECORDER
+#ifndef RECORDER_BUFFER_SIZE
+  #define RECORDER_BUFFER_SIZE 1024
+#endif
+
+// Each frame is kept as its time (4 bytes), type, packet ID and payload length, then the payload.
+const uint8_t RECORDER_HEADER_SIZE = 7;
+
+uint8_t recorderBuffer[RECORDER_BUFFER_SIZE];
+uint16_t i_recorder_start = 0; // Oldest byte kept.
+uint16_t i_recorder_used = 0;
+uint16_t i_recorder_dropped = 0; // Older frames discarded to make room since the last capture was printed.
+bool b_recorder_live = false; // Print each frame as it happens.
+
+uint8_t recorderPeek(uint16_t i_offset) {
+  return recorderBuffer[(i_recorder_start + i_offset) % RECORDER_BUFFER_SIZE];
+}
+
+void recorderPrintFrame(uint32_t i_ms, uint8_t i_type, uint8_t i_packet_id) {
+  Serial.print(F("rec,"));
+  Serial.print(i_ms);
+  Serial.print(i_type < RECORD_SERIAL1_IN ? F(",wand,") : F(",serial1,"));
+  Serial.print(i_type == RECORD_WAND_IN || i_type == RECORD_SERIAL1_IN ? F("in,") : F("out,"));
+  Serial.print(i_packet_id);
+  Serial.print(',');
+}
+
+void recorderPrintByte(uint8_t i_byte) {
+  if(i_byte < 0x10) {
+    Serial.print('0');
+  }
+
+  Serial.print(i_byte, HEX);
+}
+
+void recordFrame(uint8_t i_type, uint8_t i_packet_id, const uint8_t *p_payload, uint8_t i_length) {
+  uint32_t i_ms = millis();
+  uint16_t i_size = RECORDER_HEADER_SIZE + i_length;
+  uint16_t i_end = 0;
+
+  if(b_recorder_live) {
+    recorderPrintFrame(i_ms, i_type, i_packet_id);
+
+    for(uint8_t i = 0; i < i_length; i++) {
+      recorderPrintByte(p_payload[i]);
+    }
+
+    Serial.println();
+  }
+
+  if(i_size > RECORDER_BUFFER_SIZE) {
+    i_recorder_dropped++;
+    return;
+  }
+
+  // Discard the oldest frames until this one fits.
+  while(RECORDER_BUFFER_SIZE - i_recorder_used < i_size) {
+    uint16_t i_oldest = RECORDER_HEADER_SIZE + recorderPeek(RECORDER_HEADER_SIZE - 1);
+
+    i_recorder_start = (i_recorder_start + i_oldest) % RECORDER_BUFFER_SIZE;
+    i_recorder_used -= i_oldest;
+    i_recorder_dropped++;
+  }
+
+  i_end = (i_recorder_start + i_recorder_used) % RECORDER_BUFFER_SIZE;
+
+  for(uint16_t i = 0; i < i_size; i++) {
+    uint8_t i_byte = 0;
+
+    if(i < 4) {
+      i_byte = (uint8_t) (i_ms >> (8 * i));
+    }
+    else if(i == 4) {
+      i_byte = i_type;
+    }
+    else if(i == 5) {
+      i_byte = i_packet_id;
+    }
+    else if(i == 6) {
+      i_byte = i_length;
+    }
+    else {
+      i_byte = p_payload[i - RECORDER_HEADER_SIZE];
+    }
+
+    recorderBuffer[(i_end + i) % RECORDER_BUFFER_SIZE] = i_byte;
+  }
+
+  i_recorder_used += i_size;
+}
+
+// Prints every frame kept, oldest first, then clears the buffer.
+void recorderPrint() {
+  if(i_recorder_dropped > 0) {
+    Serial.print(F("Frames dropped: "));
+    Serial.println(i_recorder_dropped);
+  }
+
+  while(i_recorder_used > 0) {
+    uint32_t i_ms = 0;
+    uint8_t i_length = recorderPeek(RECORDER_HEADER_SIZE - 1);
+
+    for(uint8_t i = 0; i < 4; i++) {
+      i_ms |= (uint32_t) recorderPeek(i) << (8 * i);
+    }
+
+    recorderPrintFrame(i_ms, recorderPeek(4), recorderPeek(5));
+
+    for(uint8_t i = 0; i < i_length; i++) {
+      recorderPrintByte(recorderPeek(RECORDER_HEADER_SIZE + i));
+    }
+
+    Serial.println();
+
+    i_recorder_start = (i_recorder_start + RECORDER_HEADER_SIZE + i_length) % RECORDER_BUFFER_SIZE;
+    i_recorder_used -= RECORDER_HEADER_SIZE + i_length;
+  }
+
+  i_recorder_start = 0;
+  i_recorder_dropped = 0;
+}
+
+// Handles a recorder request from the USB console, returning false for anything else.
+bool recorderConsoleCommand(char c_command) {
+  switch(c_command) {
+    case 'c':
+      recorderPrint();
+      return true;
+    break;
+
+    case 'l':
+      b_recorder_live = !b_recorder_live;
+      Serial.println(b_recorder_live ? F("Live capture on") : F("Live capture off"));
+      return true;
+    break;
+
+    default:
+      return false;
+    break;
+  }
+}
+
+void recorderCheckConsole() {
+  while(Serial.available() > 0) {
+    recorderConsoleCommand(Serial.read());
+  }
+}
+#endif
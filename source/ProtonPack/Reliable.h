@@ -0,0 +1,197 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Reliable commands.
+ *
+ * Once both ends of the pack and wand link say they support them, commands for critical state changes are numbered
+ * and kept until the other end acknowledges them. Any which go unacknowledged are sent again individually, and the
+ * receiving end acts on each one once and in the order sent. Acknowledgements ride along with reliable commands going
+ * the other way, or are sent alone if none is sent soon enough. A command sent i_reliable_retry_max times without being
+ * acknowledged means the other end has stopped numbering commands, so the link gives up: reliableFailed() turns true
+ * and reliableAbandon() hands back every command still waiting to be sent as a plain command.
+ *
+ * The framing of each link lives in Serial.h.
+ */
+const uint8_t i_reliable_window = 4; // Commands which may be awaiting acknowledgement at once.
+const uint8_t i_reliable_retry_delay = 100; // Time before an unacknowledged command is sent again.
+const uint8_t i_reliable_ack_delay = 20; // Time an acknowledgement waits for a reliable command to ride along with.
+const uint8_t i_reliable_retry_max = 10; // Times a command is sent again before the link gives up on reliable commands.
+
+// For numbered commands which are sent again until acknowledged (1 byte ID, 2 byte optional data).
+struct __attribute__((packed)) ReliablePacket {
+  uint8_t s;
+  uint8_t seq; // Sequence number of this command.
+  uint8_t ack; // Sequence number of the last command received in order.
+  uint8_t c; // 0 for an acknowledgement on its own.
+  uint16_t d1;
+  uint8_t e;
+};
+
+// A reliable command kept until acknowledged, or received ahead of one still missing.
+struct ReliableSlot {
+  uint8_t c;
+  uint16_t d1;
+  bool used;
+  uint8_t retries;
+  unsigned long sentTime;
+};
+
+// Both directions of the reliable command channel over one link.
+struct ReliableLink {
+  uint8_t nextSeq; // Sequence number for the next command sent.
+  uint8_t baseSeq; // Oldest command sent which is not yet acknowledged.
+  uint8_t expectedSeq; // Next command expected in order.
+  bool ackDue; // A command was received which has not been acknowledged.
+  bool failed; // A command went unacknowledged after every retry.
+  unsigned long ackDueTime;
+  struct ReliableSlot sent[i_reliable_window];
+  struct ReliableSlot held[i_reliable_window];
+};
+
+// Sends one reliable frame over the link: a command with its sequence number, or a bare acknowledgement (0, 0, 0).
+typedef void (*ReliableSender)(uint8_t i_seq, uint8_t i_command, uint16_t i_value);
+
+// Acts on one command received in order, or sends one as a plain command once the link has given up.
+typedef void (*ReliableHandler)(uint8_t i_command, uint16_t i_value);
+
+// Starts the reliable command channel afresh, as when the other end has just synchronized.
+void resetReliableLink(struct ReliableLink &link) {
+  memset(&link, 0, sizeof(link));
+}
+
+// Returns the sequence number to acknowledge in a frame about to be sent, which settles any acknowledgement due.
+uint8_t reliableAck(struct ReliableLink &link) {
+  link.ackDue = false;
+
+  return link.expectedSeq - 1;
+}
+
+// Keeps a command until it is acknowledged and returns its sequence number, or false if too many are unacknowledged.
+bool reliableKeep(struct ReliableLink &link, uint8_t i_command, uint16_t i_value, uint8_t &i_seq) {
+  struct ReliableSlot &slot = link.sent[link.nextSeq % i_reliable_window];
+
+  if((uint8_t) (link.nextSeq - link.baseSeq) >= i_reliable_window) {
+    return false;
+  }
+
+  slot.c = i_command;
+  slot.d1 = i_value;
+  slot.used = true;
+  slot.retries = 0;
+  slot.sentTime = millis();
+
+  i_seq = link.nextSeq++;
+
+  return true;
+}
+
+// Takes in a reliable frame, releasing what it acknowledges and handling each command now in order.
+void reliableReceive(struct ReliableLink &link, const struct ReliablePacket &packet, ReliableHandler handler) {
+  uint8_t i_ahead = 0;
+
+  // Everything up to and including the acknowledged command has arrived.
+  while(link.baseSeq != link.nextSeq && (uint8_t) (packet.ack - link.baseSeq) < (uint8_t) (link.nextSeq - link.baseSeq)) {
+    link.sent[link.baseSeq % i_reliable_window].used = false;
+    link.baseSeq++;
+  }
+
+  if(packet.c == 0) {
+    // Only an acknowledgement.
+    return;
+  }
+
+  // Anything received is acknowledged, including repeats whose acknowledgement was lost.
+  if(!link.ackDue) {
+    link.ackDue = true;
+    link.ackDueTime = millis();
+  }
+
+  i_ahead = packet.seq - link.expectedSeq;
+
+  if(i_ahead >= i_reliable_window) {
+    // A repeat of a command already handled.
+    return;
+  }
+
+  link.held[packet.seq % i_reliable_window].c = packet.c;
+  link.held[packet.seq % i_reliable_window].d1 = packet.d1;
+  link.held[packet.seq % i_reliable_window].used = true;
+
+  // Act on every command now in order, including any which arrived ahead of this one.
+  while(link.held[link.expectedSeq % i_reliable_window].used) {
+    struct ReliableSlot &slot = link.held[link.expectedSeq % i_reliable_window];
+
+    slot.used = false;
+    link.expectedSeq++;
+
+    handler(slot.c, slot.d1);
+  }
+}
+
+// Sends again any commands which have gone unacknowledged and any acknowledgement which is due, returning the resends.
+uint8_t reliableCheck(struct ReliableLink &link, ReliableSender sender) {
+  uint8_t i_resent = 0;
+
+  for(uint8_t i_seq = link.baseSeq; i_seq != link.nextSeq; i_seq++) {
+    struct ReliableSlot &slot = link.sent[i_seq % i_reliable_window];
+
+    if(slot.used && millis() - slot.sentTime >= i_reliable_retry_delay) {
+      if(slot.retries >= i_reliable_retry_max) {
+        link.failed = true;
+        return i_resent;
+      }
+
+      // Only this command is sent again; any after it may well have arrived.
+      slot.retries++;
+      slot.sentTime = millis();
+      i_resent++;
+      sender(i_seq, slot.c, slot.d1);
+    }
+  }
+
+  if(link.ackDue && millis() - link.ackDueTime >= i_reliable_ack_delay) {
+    // No reliable command was sent for the acknowledgement to ride along with.
+    sender(0, 0, 0);
+  }
+
+  return i_resent;
+}
+
+// Whether the other end has stopped acknowledging reliable commands.
+bool reliableFailed(const struct ReliableLink &link) {
+  return link.failed;
+}
+
+// Gives up on sending reliable commands, passing each one not yet acknowledged to the sender in order to be sent as a
+// plain command. Commands received keep their numbering.
+void reliableAbandon(struct ReliableLink &link, ReliableHandler sender) {
+  for(; link.baseSeq != link.nextSeq; link.baseSeq++) {
+    struct ReliableSlot &slot = link.sent[link.baseSeq % i_reliable_window];
+
+    if(slot.used) {
+      slot.used = false;
+      sender(slot.c, slot.d1);
+    }
+  }
+
+  link.failed = false;
+}
@@ -0,0 +1,216 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Timer scheduler.
+ *
+ * A millisDelay has to be polled on every loop pass to find out that it has finished, even while it is not running.
+ * A timer given to the scheduler instead names the function to call when it is due, and runScheduledTimers() calls
+ * it once that time has passed. Pending timers are kept in a binary min-heap ordered by due time, so finding out that
+ * nothing is due is a single comparison however many timers are pending, and scheduledTimerWait() tells the loop how
+ * long it may go before anything is.
+ *
+ * Each callback has at most one pending timer: scheduling it again moves the timer rather than adding another. This
+ * means a timer is started, stopped and checked by its callback alone, much as a millisDelay is by its name, and the
+ * two can be used side by side while timers are moved over one at a time.
+ */
+typedef void (*TimerCallback)();
+
+const uint8_t SCHEDULER_TIMERS_MAX = 16;
+
+struct ScheduledTimer {
+  uint32_t ms_due;
+  TimerCallback p_callback;
+};
+
+struct ScheduledTimer scheduledTimers[SCHEDULER_TIMERS_MAX]; // Min-heap: each timer is due no later than its two children.
+uint8_t i_scheduled_timers = 0;
+uint32_t i_scheduler_dispatched = 0; // Callbacks run, for the profiling report.
+uint16_t i_scheduler_late_max = 0; // Most milliseconds a callback has run after it was due.
+bool b_scheduler_running_early = false; // Set while a timer which found no room is run straight away.
+
+// Whether time a comes before time b, allowing for millis() wrapping around.
+bool timerDueBefore(uint32_t a, uint32_t b) {
+  return (int32_t) (a - b) < 0;
+}
+
+void swapScheduledTimers(uint8_t i_first, uint8_t i_second) {
+  struct ScheduledTimer timer = scheduledTimers[i_first];
+
+  scheduledTimers[i_first] = scheduledTimers[i_second];
+  scheduledTimers[i_second] = timer;
+}
+
+// Moves a timer towards the top of the heap until its parent is due no later than it.
+uint8_t scheduledTimerSiftUp(uint8_t i_index) {
+  while(i_index > 0) {
+    uint8_t i_parent = (i_index - 1) / 2;
+
+    if(!timerDueBefore(scheduledTimers[i_index].ms_due, scheduledTimers[i_parent].ms_due)) {
+      break;
+    }
+
+    swapScheduledTimers(i_index, i_parent);
+    i_index = i_parent;
+  }
+
+  return i_index;
+}
+
+// Moves a timer towards the bottom of the heap until neither of its children is due before it.
+void scheduledTimerSiftDown(uint8_t i_index) {
+  while(true) {
+    uint8_t i_earliest = i_index;
+    uint8_t i_child = i_index * 2 + 1;
+
+    for(uint8_t i = i_child; i < i_child + 2 && i < i_scheduled_timers; i++) {
+      if(timerDueBefore(scheduledTimers[i].ms_due, scheduledTimers[i_earliest].ms_due)) {
+        i_earliest = i;
+      }
+    }
+
+    if(i_earliest == i_index) {
+      break;
+    }
+
+    swapScheduledTimers(i_index, i_earliest);
+    i_index = i_earliest;
+  }
+}
+
+// Returns where the callback's pending timer is kept, or SCHEDULER_TIMERS_MAX if it has none.
+uint8_t scheduledTimerIndex(TimerCallback p_callback) {
+  for(uint8_t i = 0; i < i_scheduled_timers; i++) {
+    if(scheduledTimers[i].p_callback == p_callback) {
+      return i;
+    }
+  }
+
+  return SCHEDULER_TIMERS_MAX;
+}
+
+void removeScheduledTimer(uint8_t i_index) {
+  i_scheduled_timers--;
+
+  if(i_index < i_scheduled_timers) {
+    // Fill the gap with the last timer, then move it up or down to where it belongs.
+    scheduledTimers[i_index] = scheduledTimers[i_scheduled_timers];
+    scheduledTimerSiftDown(scheduledTimerSiftUp(i_index));
+  }
+}
+
+// Calls the earliest timer's callback now, to make room when every slot is taken.
+void runEarliestTimer() {
+  TimerCallback p_callback = scheduledTimers[0].p_callback;
+
+  removeScheduledTimer(0);
+  i_scheduler_dispatched++;
+  p_callback();
+}
+
+// Calls the function after the given number of milliseconds, replacing any timer already pending for it.
+void scheduleTimer(TimerCallback p_callback, uint32_t i_delay) {
+  uint8_t i_index = scheduledTimerIndex(p_callback);
+
+  if(i_index < SCHEDULER_TIMERS_MAX) {
+    removeScheduledTimer(i_index);
+  }
+  else {
+    // Make room by calling the earliest timers now. Each may schedule a timer of its own, so keep going until one is free.
+    for(uint8_t i = 0; i < SCHEDULER_TIMERS_MAX && i_scheduled_timers == SCHEDULER_TIMERS_MAX; i++) {
+      runEarliestTimer();
+    }
+
+    if(i_scheduled_timers == SCHEDULER_TIMERS_MAX) {
+      // Every callback run put itself straight back, so run this one early too rather than lose it.
+      // Should it then try to put itself back as well, there is still no room and that timer is dropped.
+      if(!b_scheduler_running_early) {
+        b_scheduler_running_early = true;
+        i_scheduler_dispatched++;
+        p_callback();
+        b_scheduler_running_early = false;
+      }
+
+      return;
+    }
+
+    // One of the callbacks run may have scheduled this one.
+    i_index = scheduledTimerIndex(p_callback);
+
+    if(i_index < SCHEDULER_TIMERS_MAX) {
+      removeScheduledTimer(i_index);
+    }
+  }
+
+  i_index = i_scheduled_timers;
+  scheduledTimers[i_index].ms_due = millis() + i_delay;
+  scheduledTimers[i_index].p_callback = p_callback;
+  i_scheduled_timers++;
+
+  scheduledTimerSiftUp(i_index);
+}
+
+void cancelTimer(TimerCallback p_callback) {
+  uint8_t i_index = scheduledTimerIndex(p_callback);
+
+  if(i_index < SCHEDULER_TIMERS_MAX) {
+    removeScheduledTimer(i_index);
+  }
+}
+
+bool timerScheduled(TimerCallback p_callback) {
+  return scheduledTimerIndex(p_callback) < SCHEDULER_TIMERS_MAX;
+}
+
+// Milliseconds until the next timer is due: 0 if one is due now, or 0xFFFFFFFF if none are pending.
+uint32_t scheduledTimerWait() {
+  if(i_scheduled_timers == 0) {
+    return 0xFFFFFFFF;
+  }
+
+  uint32_t i_now = millis();
+
+  if(!timerDueBefore(i_now, scheduledTimers[0].ms_due)) {
+    return 0;
+  }
+
+  return scheduledTimers[0].ms_due - i_now;
+}
+
+// Calls the callback of every timer which is due, earliest first.
+void runScheduledTimers() {
+  uint32_t i_now = millis();
+
+  // A callback may schedule itself again, so only run as many as were pending to begin with.
+  for(uint8_t i = i_scheduled_timers; i > 0 && !timerDueBefore(i_now, scheduledTimers[0].ms_due); i--) {
+    uint32_t i_late = i_now - scheduledTimers[0].ms_due;
+
+    if(i_late > i_scheduler_late_max) {
+      i_scheduler_late_max = i_late > 0xFFFF ? 0xFFFF : i_late;
+    }
+
+    runEarliestTimer();
+
+    if(i_scheduled_timers == 0) {
+      break;
+    }
+  }
+}
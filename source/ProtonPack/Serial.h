@@ -28,7 +28,12 @@ enum PACKET_TYPE : uint8_t {
   PACKET_PACK = 3,
   PACKET_WAND = 4,
   PACKET_SMOKE = 5,
-  PACKET_SYNC = 6
+  PACKET_SYNC = 6,
+  PACKET_PROFILE = 7,
+  PACKET_SYNC_DELTA = 8,
+  PACKET_COMMAND_BATCH = 9,
+  PACKET_RELIABLE = 10,
+  PACKET_LINK_STATS = 11
 };
 
 // For command signals (1 byte ID, 2 byte optional data).
@@ -44,6 +49,44 @@ struct CommandPacket recvCmdW;
 struct CommandPacket sendCmdS;
 struct CommandPacket recvCmdS;
 
+// For several commands sent in one frame (1 byte ID, 2 byte optional data each).
+// The pack, wand and Attenuator must all agree on i_command_batch_max, the most commands one frame can hold.
+const uint8_t i_command_batch_max = 16;
+
+struct __attribute__((packed)) BatchedCommand {
+  uint8_t c;
+  uint16_t d1;
+};
+
+struct __attribute__((packed)) CommandBatchPacket {
+  uint8_t s;
+  uint8_t e;
+  struct BatchedCommand cmd[i_command_batch_max]; // Only the commands held are sent.
+};
+
+struct CommandBatchPacket sendBatchW;
+struct CommandBatchPacket sendBatchS;
+
+// Identifies which end of which link the counters in a PACKET_LINK_STATS were kept by.
+enum LINK_ID : uint8_t {
+  LINK_PACK_WAND = 0,
+  LINK_WAND_PACK = 1,
+  LINK_PACK_SERIAL1 = 2
+};
+
+// For link telemetry (1 byte link ID, counters).
+struct __attribute__((packed)) LinkStatsPacket {
+  uint8_t link;
+  struct LinkStats stats;
+};
+
+struct LinkStatsPacket sendLinkStats;
+struct LinkStatsPacket recvLinkStats;
+
+struct ReliablePacket sendReliableW;
+struct ReliablePacket recvReliableW;
+struct ReliableLink wandReliable;
+
 // For generic data communication (1 byte ID, 4 byte array).
 struct __attribute__((packed)) MessagePacket {
   uint8_t s;
@@ -178,8 +221,22 @@ struct __attribute__((packed)) AttenuatorSyncData {
   uint16_t currentTrack;
   uint16_t musicCount;
   uint16_t packVoltage;
+  uint8_t musicShuffle;
 } attenuatorSyncData;
 
+struct AttenuatorSyncData attenuatorSyncShadow; // Pack state last acknowledged by the Serial1 device.
+struct AttenuatorSyncData attenuatorSyncSent; // Pack state sent to the Serial1 device and not yet acknowledged.
+
+// Changed bytes of AttenuatorSyncData, with one bit in the mask for each byte of the struct.
+struct __attribute__((packed)) SyncDeltaPacket {
+  uint8_t version;
+  uint8_t crc; // Checksum of the complete state once the change is applied.
+  uint32_t changed;
+  uint8_t d[sizeof(AttenuatorSyncData)]; // Only the changed bytes are sent, in order.
+} syncDelta;
+
+static_assert(sizeof(AttenuatorSyncData) <= 32, "AttenuatorSyncData no longer fits the SyncDeltaPacket mask");
+
 // Adjusts which year mode the Proton Pack and Neutrona Wand are in, as switched by the Neutrona Wand.
 void toggleYearModes() {
   // Toggle between the year modes.
@@ -260,20 +317,130 @@ void toggleYearModes() {
  * Serial API Communication Handlers
  */
 
+// Sends the frame built in the Serial1 transmit buffer.
+void serial1SendFrame(uint16_t i_send_size, uint8_t i_packet_id) {
+  // Record before sending, as the library encodes the transmit buffer in place.
+  RECORD_FRAME(RECORD_SERIAL1_OUT, i_packet_id, serial1Coms.packet.txBuff, i_send_size);
+  serial1Coms.sendData(i_send_size, i_packet_id);
+  serial1Link.framesSent++;
+}
+
+// Sends the frame built in the wand transmit buffer.
+void wandSendFrame(uint16_t i_send_size, uint8_t i_packet_id) {
+  RECORD_FRAME(RECORD_WAND_OUT, i_packet_id, packComs.packet.txBuff, i_send_size);
+  packComs.sendData(i_send_size, i_packet_id);
+  wandLink.framesSent++;
+}
+
+// Sends any commands held for the Serial1 device in one frame.
+void serial1SendBatch() {
+  uint16_t i_send_size = 0;
+
+  if(i_serial1_batch_count == 0) {
+    return;
+  }
+
+  sendBatchS.s = P_COM_START;
+  sendBatchS.e = P_COM_END;
+
+  i_send_size = serial1Coms.txObj(sendBatchS, 0, offsetof(struct CommandBatchPacket, cmd) + i_serial1_batch_count * sizeof(struct BatchedCommand));
+  serial1SendFrame(i_send_size, PACKET_COMMAND_BATCH);
+
+  i_serial1_batch_count = 0;
+}
+
+// Sends any commands held for the wand in one frame.
+void packSerialSendBatch() {
+  uint16_t i_send_size = 0;
+
+  if(i_wand_batch_count == 0) {
+    return;
+  }
+
+  sendBatchW.s = P_COM_START;
+  sendBatchW.e = P_COM_END;
+
+  i_send_size = packComs.txObj(sendBatchW, 0, offsetof(struct CommandBatchPacket, cmd) + i_wand_batch_count * sizeof(struct BatchedCommand));
+  wandSendFrame(i_send_size, PACKET_COMMAND_BATCH);
+
+  i_wand_batch_count = 0;
+}
+
+// Sends the commands held during this loop pass.
+void sendCommandBatches() {
+  packSerialSendBatch();
+  serial1SendBatch();
+}
+
+// Commands which only report state that a mirroring Serial1 device already receives through AttenuatorSyncData.
+bool serial1Mirrored(uint8_t i_command) {
+  switch(i_command) {
+    case A_WAND_CONNECTED:
+    case A_WAND_DISCONNECTED:
+    case A_BARREL_EXTENDED:
+    case A_BARREL_RETRACTED:
+    case A_MODE_SUPER_HERO:
+    case A_MODE_ORIGINAL:
+    case A_YEAR_1984:
+    case A_YEAR_1989:
+    case A_YEAR_AFTERLIFE:
+    case A_YEAR_FROZEN_EMPIRE:
+    case A_PROTON_MODE:
+    case A_SLIME_MODE:
+    case A_STASIS_MODE:
+    case A_MESON_MODE:
+    case A_SPECTRAL_MODE:
+    case A_HOLIDAY_MODE:
+    case A_POWER_LEVEL_1:
+    case A_POWER_LEVEL_2:
+    case A_POWER_LEVEL_3:
+    case A_POWER_LEVEL_4:
+    case A_POWER_LEVEL_5:
+    case A_CYCLOTRON_LID_ON:
+    case A_CYCLOTRON_LID_OFF:
+    case A_TOGGLE_MUTE:
+    case A_MUSIC_TRACK_LOOP_TOGGLE:
+    case A_MUSIC_SHUFFLE_TOGGLE:
+    case A_BATTERY_VOLTAGE_PACK:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
 // Outgoing commands to the Serial1 device
 void serial1Send(uint8_t i_command, uint16_t i_value) {
   uint16_t i_send_size = 0;
 
+  if(b_serial1_mirror && serial1Mirrored(i_command)) {
+    // The change reaches the device with the next update of the mirrored state.
+    return;
+  }
+
   // debug(F("Command to Serial1: "));
   // debugln(i_command);
 
+  if(b_serial1_batch) {
+    // Held until the end of this loop pass.
+    sendBatchS.cmd[i_serial1_batch_count].c = i_command;
+    sendBatchS.cmd[i_serial1_batch_count].d1 = i_value;
+    i_serial1_batch_count++;
+
+    if(i_serial1_batch_count >= i_command_batch_max) {
+      serial1SendBatch();
+    }
+
+    return;
+  }
+
   sendCmdS.s = P_COM_START;
   sendCmdS.c = i_command;
   sendCmdS.d1 = i_value;
   sendCmdS.e = P_COM_END;
 
   i_send_size = serial1Coms.txObj(sendCmdS);
-  serial1Coms.sendData(i_send_size, (uint8_t) PACKET_COMMAND);
+  serial1SendFrame(i_send_size, PACKET_COMMAND);
 }
 // Override function to handle calls with a single parameter.
 void serial1Send(uint8_t i_command) {
@@ -288,6 +455,9 @@ void serial1SendData(uint8_t i_message) {
   // debug(F("Data to Serial1: "))
   // debugln(i_message);
 
+  // Held commands go out ahead of this payload.
+  serial1SendBatch();
+
   sendDataS.s = P_COM_START;
   sendDataS.m = i_message;
   sendDataS.e = P_COM_END;
@@ -303,22 +473,27 @@ void serial1SendData(uint8_t i_message) {
       sendDataS.d[1] = i_spectral_cyclotron_custom_saturation;
 
       i_send_size = serial1Coms.txObj(sendDataS);
-      serial1Coms.sendData(i_send_size, (uint8_t) PACKET_DATA);
+      serial1SendFrame(i_send_size, PACKET_DATA);
     break;
 
     case A_SYNC_DATA:
       i_send_size = serial1Coms.txObj(attenuatorSyncData);
-      serial1Coms.sendData(i_send_size, (uint8_t) PACKET_SYNC);
+      serial1SendFrame(i_send_size, PACKET_SYNC);
     break;
 
     case A_VOLUME_SYNC:
+      if(b_serial1_mirror) {
+        // The volume levels are part of the mirrored state.
+        break;
+      }
+
       // Send the current volume levels.
       sendDataS.d[0] = i_volume_master_percentage;
       sendDataS.d[1] = i_volume_effects_percentage;
       sendDataS.d[2] = i_volume_music_percentage;
 
       i_send_size = serial1Coms.txObj(sendDataS);
-      serial1Coms.sendData(i_send_size, (uint8_t) PACKET_DATA);
+      serial1SendFrame(i_send_size, PACKET_DATA);
     break;
 
     case A_SEND_PREFERENCES_PACK:
@@ -389,13 +564,13 @@ void serial1SendData(uint8_t i_message) {
       packConfig.ledVGPowercell = b_powercell_colour_toggle ? 1 : 0;
 
       i_send_size = serial1Coms.txObj(packConfig);
-      serial1Coms.sendData(i_send_size, (uint8_t) PACKET_PACK);
+      serial1SendFrame(i_send_size, PACKET_PACK);
     break;
 
     case A_SEND_PREFERENCES_WAND:
       // Any ENUM or boolean types will simply translate as numeric values.
       i_send_size = serial1Coms.txObj(wandConfig);
-      serial1Coms.sendData(i_send_size, (uint8_t) PACKET_WAND);
+      serial1SendFrame(i_send_size, PACKET_WAND);
     break;
 
     case A_SEND_PREFERENCES_SMOKE:
@@ -432,8 +607,38 @@ void serial1SendData(uint8_t i_message) {
       }
 
       i_send_size = serial1Coms.txObj(smokeConfig);
-      serial1Coms.sendData(i_send_size, (uint8_t) PACKET_SMOKE);
+      serial1SendFrame(i_send_size, PACKET_SMOKE);
+    break;
+
+    case A_SEND_LINK_STATS:
+      // One packet per link end. This blocks while the UART drains, so only send on request.
+      sendLinkStats.link = LINK_PACK_WAND;
+      sendLinkStats.stats = wandLink;
+      i_send_size = serial1Coms.txObj(sendLinkStats);
+      serial1SendFrame(i_send_size, PACKET_LINK_STATS);
+
+      sendLinkStats.link = LINK_WAND_PACK;
+      sendLinkStats.stats = wandReportedLink;
+      i_send_size = serial1Coms.txObj(sendLinkStats);
+      serial1SendFrame(i_send_size, PACKET_LINK_STATS);
+
+      sendLinkStats.link = LINK_PACK_SERIAL1;
+      sendLinkStats.stats = serial1Link;
+      i_send_size = serial1Coms.txObj(sendLinkStats);
+      serial1SendFrame(i_send_size, PACKET_LINK_STATS);
+    break;
+
+#ifdef GPSTAR_PROFILING
+    case A_SEND_PROFILE:
+      // One packet per measured loop stage. This blocks while the UART drains, so only send on request.
+      for(uint8_t i = BENCH_LOOP; i < BENCH_STAGE_COUNT; i++) {
+        if(profileFill(i)) {
+          i_send_size = serial1Coms.txObj(profileData);
+          serial1SendFrame(i_send_size, PACKET_PROFILE);
+        }
+      }
     break;
+#endif
 
     default:
       // No-op for all other communications.
@@ -448,13 +653,26 @@ void packSerialSend(uint8_t i_command, uint16_t i_value) {
   debug(F("Command to Wand: "));
   debugln(i_command);
 
+  if(b_wand_batch) {
+    // Held until the end of this loop pass.
+    sendBatchW.cmd[i_wand_batch_count].c = i_command;
+    sendBatchW.cmd[i_wand_batch_count].d1 = i_value;
+    i_wand_batch_count++;
+
+    if(i_wand_batch_count >= i_command_batch_max) {
+      packSerialSendBatch();
+    }
+
+    return;
+  }
+
   sendCmdW.s = P_COM_START;
   sendCmdW.c = i_command;
   sendCmdW.d1 = i_value;
   sendCmdW.e = P_COM_END;
 
   i_send_size = packComs.txObj(sendCmdW);
-  packComs.sendData(i_send_size, (uint8_t) PACKET_COMMAND);
+  wandSendFrame(i_send_size, PACKET_COMMAND);
 }
 // Override function to handle calls with a single parameter.
 void packSerialSend(uint8_t i_command) {
@@ -468,6 +686,9 @@ void packSerialSendData(uint8_t i_message) {
   // debug(F("Data to Wand: "));
   // debugln(i_message);
 
+  // Held commands go out ahead of this payload.
+  packSerialSendBatch();
+
   sendDataW.s = P_COM_START;
   sendDataW.m = i_message;
   sendDataW.s = P_COM_END;
@@ -479,17 +700,17 @@ void packSerialSendData(uint8_t i_message) {
   switch(i_message) {
     case P_SAVE_PREFERENCES_WAND:
       i_send_size = packComs.txObj(wandConfig);
-      packComs.sendData(i_send_size, (uint8_t) PACKET_WAND);
+      wandSendFrame(i_send_size, PACKET_WAND);
     break;
 
     case P_SAVE_PREFERENCES_SMOKE:
       i_send_size = packComs.txObj(smokeConfig);
-      packComs.sendData(i_send_size, (uint8_t) PACKET_SMOKE);
+      wandSendFrame(i_send_size, PACKET_SMOKE);
     break;
 
     case P_SYNC_DATA:
       i_send_size = packComs.txObj(wandSyncData);
-      packComs.sendData(i_send_size, (uint8_t) PACKET_SYNC);
+      wandSendFrame(i_send_size, PACKET_SYNC);
     break;
 
     default:
@@ -502,317 +723,455 @@ void packSerialSendData(uint8_t i_message) {
 void handleSerialCommand(uint8_t i_command, uint16_t i_value);
 void handleWandCommand(uint8_t i_command, uint16_t i_value);
 
-// Incoming messages from the extra Serial1 port.
-void checkSerial1() {
-  if(serial1Coms.available() > 0) {
-    uint8_t i_packet_id = serial1Coms.currentPacketID();
-    // debug(F("Serial PacketID: "));
-    // debugln(i_packet_id);
-
-    if(i_packet_id > 0) {
-      if(ms_serial1_check.isRunning() && b_serial1_connected) {
-        // If the timer is still running and Attenuator is connected, consider any request as proof of life.
-        ms_serial1_check.restart();
-      }
-
-      // Determine the type of packet which was sent by the serial1 device.
-      switch(i_packet_id) {
-        case PACKET_COMMAND:
-          serial1Coms.rxObj(recvCmdS);
-          if(recvCmdS.c > 0 && recvCmdS.s == A_COM_START && recvCmdS.e == A_COM_END) {
-            debug(F("Recv. Serial1 Command: "));
-            debugln(recvCmdS.c);
-            handleSerialCommand(recvCmdS.c, recvCmdS.d1);
-          }
-        break;
+// Sends a reliable command frame to the wand, along with an acknowledgement of what we have received.
+void packSerialSendReliableFrame(uint8_t i_seq, uint8_t i_command, uint16_t i_value) {
+  uint16_t i_send_size = 0;
 
-        case PACKET_DATA:
-          if(!b_serial1_connected) {
-            // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
-            return;
-          }
+  // Held commands go out ahead of this one.
+  packSerialSendBatch();
 
-          serial1Coms.rxObj(recvDataS);
-          if(recvDataS.m > 0 && recvDataS.s == A_COM_START && recvDataS.e == A_COM_END) {
-            debug(F("Recv. Serial1 Message: "));
-            debugln(recvDataS.m);
-            // No handlers at this time.
-          }
-        break;
+  sendReliableW.s = P_COM_START;
+  sendReliableW.seq = i_seq;
+  sendReliableW.ack = reliableAck(wandReliable);
+  sendReliableW.c = i_command;
+  sendReliableW.d1 = i_value;
+  sendReliableW.e = P_COM_END;
 
-        case PACKET_PACK:
-          if(!b_serial1_connected) {
-            // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
-            return;
-          }
+  i_send_size = packComs.txObj(sendReliableW);
+  wandSendFrame(i_send_size, PACKET_RELIABLE);
+}
 
-          serial1Coms.rxObj(packConfig);
-          debugln(F("Recv. Pack Config"));
-
-          // Writes new preferences back to runtime variables.
-          // This action does not save changes to the EEPROM!
-
-          switch(packConfig.defaultSystemModePack) {
-            case 0:
-            default:
-              SYSTEM_MODE = MODE_SUPER_HERO;
-              packSerialSend(P_MODE_SUPER_HERO);
-              serial1Send(A_MODE_SUPER_HERO);
-            break;
-
-            case 1:
-              SYSTEM_MODE = MODE_ORIGINAL;
-              packSerialSend(P_MODE_ORIGINAL);
-              serial1Send(A_MODE_ORIGINAL);
-
-              if(!b_wand_connected && STREAM_MODE != PROTON) {
-                // If no wand is connected we need to make sure we're in Proton Stream.
-                STREAM_MODE = PROTON;
-                serial1Send(A_PROTON_MODE);
-              }
-            break;
-          }
+// Outgoing commands to the wand which must not be lost.
+void packSerialSendReliable(uint8_t i_command, uint16_t i_value) {
+  uint8_t i_seq = 0;
 
-          switch(packConfig.defaultYearThemePack) {
-            case 1:
-            default:
-              // Will allow the pack to boot up to whatever state the mode switch is in.
-              SYSTEM_EEPROM_YEAR = SYSTEM_TOGGLE_SWITCH;
-            break;
-            case 2:
-              SYSTEM_EEPROM_YEAR = SYSTEM_1984;
-            break;
-            case 3:
-              SYSTEM_EEPROM_YEAR = SYSTEM_1989;
-            break;
-            case 4:
-              SYSTEM_EEPROM_YEAR = SYSTEM_AFTERLIFE;
-            break;
-            case 5:
-              SYSTEM_EEPROM_YEAR = SYSTEM_FROZEN_EMPIRE;
-            break;
-          }
+  if(!b_wand_reliable || !reliableKeep(wandReliable, i_command, i_value, i_seq)) {
+    // Older wand firmware, or so many commands unacknowledged that the link is failing anyway.
+    packSerialSend(i_command, i_value);
+    return;
+  }
 
-          switch(packConfig.currentYearThemePack) {
-            case 2:
-              SYSTEM_YEAR = SYSTEM_1984;
-              SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
-              b_switch_mode_override = true; // Explicit mode set, override mode toggle.
-              packSerialSend(P_YEAR_1984);
-              serial1Send(A_YEAR_1984);
-            break;
-            case 3:
-              SYSTEM_YEAR = SYSTEM_1989;
-              SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
-              b_switch_mode_override = true; // Explicit mode set, override mode toggle.
-              packSerialSend(P_YEAR_1989);
-              serial1Send(A_YEAR_1989);
-            break;
-            case 4:
-              SYSTEM_YEAR = SYSTEM_AFTERLIFE;
-              SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
-              b_switch_mode_override = true; // Explicit mode set, override mode toggle.
-              packSerialSend(P_YEAR_AFTERLIFE);
-              serial1Send(A_YEAR_AFTERLIFE);
-            break;
-            case 5:
-              SYSTEM_YEAR = SYSTEM_FROZEN_EMPIRE;
-              SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
-              b_switch_mode_override = true; // Explicit mode set, override mode toggle.
-              packSerialSend(P_YEAR_FROZEN_EMPIRE);
-              serial1Send(A_YEAR_FROZEN_EMPIRE);
-            break;
-          }
+  debug(F("Reliable Command to Wand: "));
+  debugln(i_command);
 
-          switch(packConfig.packVibration) {
-            case 1:
-              b_vibration_switch_on = true; // Override the vibration toggle switch.
-              VIBRATION_MODE_EEPROM = VIBRATION_ALWAYS;
-              VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-            break;
-
-            case 2:
-              b_vibration_switch_on = true; // Override the vibration toggle switch.
-              VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
-              VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-            break;
-
-            case 3:
-              VIBRATION_MODE_EEPROM = VIBRATION_NONE;
-              VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-            break;
-
-            case 4:
-            default:
-              VIBRATION_MODE_EEPROM = VIBRATION_DEFAULT;
-              VIBRATION_MODE = VIBRATION_FIRING_ONLY;
-
-              // Reset the vibration switch state.
-              if(switch_vibration.getState() == LOW) {
-                b_vibration_switch_on = true;
-              }
-              else {
-                b_vibration_switch_on = false;
-              }
-            break;
-
-            case 5:
-              VIBRATION_MODE_EEPROM = CYCLOTRON_MOTOR;
-              VIBRATION_MODE = VIBRATION_MODE_EEPROM;
-
-              // Reset the vibration switch state.
-              if(switch_vibration.getState() == LOW) {
-                b_vibration_switch_on = true;
-              }
-              else {
-                b_vibration_switch_on = false;
-              }
-            break;
-          }
+  packSerialSendReliableFrame(i_seq, i_command, i_value);
+}
+// Override function to handle calls with a single parameter.
+void packSerialSendReliable(uint8_t i_command) {
+  packSerialSendReliable(i_command, 0);
+}
 
-          i_volume_master_eeprom = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * packConfig.defaultSystemVolume / 100);
-          b_stream_effects = (packConfig.protonStreamEffects == 1);
-          b_overheat_strobe = (packConfig.overheatStrobeNF == 1);
-          b_overheat_lights_off = (packConfig.overheatLightsOff == 1);
-          b_overheat_sync_to_fan = (packConfig.overheatSyncToFan == 1);
-          b_demo_light_mode = (packConfig.demoLightMode == 1);
-          b_use_ribbon_cable = (packConfig.ribbonCableAlarm == 1);
-
-          // Cyclotron Lid
-          switch(packConfig.ledCycLidCount) {
-            // For a 40 LED Neopixel ring.
-            case 40:
-              i_cyclotron_leds = OUTER_CYCLOTRON_LED_MAX;
-            break;
-
-            // For Frutto Technology Max Cyclotron (36) LEDs.
-            case 36:
-              i_cyclotron_leds = FRUTTO_MAX_CYCLOTRON_LED_COUNT;
-            break;
-
-            // For Frutto Technology Cyclotron (20) LEDs.
-            case 20:
-              i_cyclotron_leds = FRUTTO_CYCLOTRON_LED_COUNT;
-            break;
-
-            // Default HasLab (12) LEDs.
-            case 12:
-            default:
-              i_cyclotron_leds = HASLAB_CYCLOTRON_LED_COUNT;
-            break;
-          }
-          i_spectral_cyclotron_custom_colour = packConfig.ledCycLidHue;
-          i_spectral_cyclotron_custom_saturation = packConfig.ledCycLidSat;
-          b_clockwise = (packConfig.cyclotronDirection == 1);
-          b_cyclotron_single_led = (packConfig.ledCycLidCenter == 1);
-          b_fade_cyclotron_led = (packConfig.ledCycLidFade == 1);
-          b_cyclotron_colour_toggle = (packConfig.ledVGCyclotron == 1);
-          b_cyclotron_simulate_ring = (packConfig.ledCycLidSimRing == 1);
-
-          // Inner Cyclotron
-          switch(packConfig.ledCycInnerPanel) {
-            case 1:
-            default:
-              INNER_CYC_PANEL_MODE = PANEL_INDIVIDUAL;
-            break;
-            case 2:
-              INNER_CYC_PANEL_MODE = PANEL_RGB_STATIC;
-            break;
-            case 3:
-              INNER_CYC_PANEL_MODE = PANEL_RGB_DYNAMIC;
-            break;
-          }
-          i_inner_cyclotron_cake_num_leds = packConfig.ledCycCakeCount;
-          i_spectral_cyclotron_inner_custom_colour = packConfig.ledCycCakeHue;
-          i_spectral_cyclotron_inner_custom_saturation = packConfig.ledCycCakeSat;
-          b_grb_cyclotron_cake = (packConfig.ledCycCakeGRB == 1);
-          i_inner_cyclotron_cavity_num_leds = packConfig.ledCycCavCount;
-
-          // Power Cell
-          i_powercell_leds = packConfig.ledPowercellCount;
-          b_powercell_invert = (packConfig.ledInvertPowercell == 1);
-          i_spectral_powercell_custom_colour = packConfig.ledPowercellHue;
-          i_spectral_powercell_custom_saturation = packConfig.ledPowercellSat;
-          b_powercell_colour_toggle = (packConfig.ledVGPowercell == 1);
-
-          // Offer some feedback to the user
-          stopEffect(S_VENT_DRY);
-          playEffect(S_VENT_DRY);
-
-          // Update system values and reset as needed.
-          resetInnerCyclotronLEDs(); // Must call this first, prior to updating counts
-          updateProtonPackLEDCounts(); // Must call this after resetting # of LEDs
-          resetCyclotronLEDs(); // Update delays based on LED count
-          resetRampSpeeds(); // Update delays based on LED count
-        break;
+// Handles a reliable command frame from the wand.
+void handleWandReliable() {
+  packComs.rxObj(recvReliableW);
 
-        case PACKET_WAND:
-          if(!b_serial1_connected) {
-            // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
-            return;
-          }
+  if(recvReliableW.s != W_COM_START || recvReliableW.e != W_COM_END) {
+    wandLink.markerErrors++;
+    return;
+  }
 
-          serial1Coms.rxObj(wandConfig);
-          debugln(F("Recv. Wand Config"));
+  if(!b_wand_reliable) {
+    return;
+  }
 
-          // This will pass values from the wandConfig object
-          packSerialSendData(P_SAVE_PREFERENCES_WAND);
+  if(!b_wand_reliable_confirmed) {
+    // The wand got our P_RELIABLE and is numbering commands too, so it handshakes more often and can be dropped sooner.
+    b_wand_reliable_confirmed = true;
+    ms_wand_check.start(i_wand_reliable_disconnect_delay);
+  }
 
-          // Offer some feedback to the user
-          stopEffect(S_VENT_DRY);
-          playEffect(S_VENT_DRY);
-        break;
+  reliableReceive(wandReliable, recvReliableW, handleWandCommand);
+}
 
-        case PACKET_SMOKE:
-          if(!b_serial1_connected) {
-            // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
-            return;
-          }
+// Sends again any reliable commands the wand has not acknowledged, and acknowledges any the wand sent.
+void checkWandReliable() {
+  if(!b_wand_reliable) {
+    return;
+  }
 
-          serial1Coms.rxObj(smokeConfig);
-          debugln(F("Recv. Smoke Config"));
-
-          // Save local and remote (wand) smoke timing settings
-          i_ms_overheating_length_5 = smokeConfig.overheatDuration5 * 1000;
-          i_ms_overheating_length_4 = smokeConfig.overheatDuration4 * 1000;
-          i_ms_overheating_length_3 = smokeConfig.overheatDuration3 * 1000;
-          i_ms_overheating_length_2 = smokeConfig.overheatDuration2 * 1000;
-          i_ms_overheating_length_1 = smokeConfig.overheatDuration1 * 1000;
-
-          b_smoke_continuous_level_5 = (smokeConfig.overheatContinuous5 == 1);
-          b_smoke_continuous_level_4 = (smokeConfig.overheatContinuous4 == 1);
-          b_smoke_continuous_level_3 = (smokeConfig.overheatContinuous3 == 1);
-          b_smoke_continuous_level_2 = (smokeConfig.overheatContinuous2 == 1);
-          b_smoke_continuous_level_1 = (smokeConfig.overheatContinuous1 == 1);
-          b_smoke_enabled = (smokeConfig.smokeEnabled == 1);
-          resetContinuousSmoke(); // Set other variables as necessary
-
-          // This will pass values from the smokeConfig object
-          packSerialSendData(P_SAVE_PREFERENCES_SMOKE);
-
-          // Offer some feedback to the user
-          stopEffect(S_VENT_SMOKE);
-          playEffect(S_VENT_SMOKE);
-        break;
-      }
+  wandLink.retransmits += reliableCheck(wandReliable, packSerialSendReliableFrame);
+
+  if(reliableFailed(wandReliable)) {
+    // The wand has stopped acknowledging, so send it what it missed as plain commands and stop numbering them.
+    debugln(F("Wand Reliable Commands Failed"));
+    b_wand_reliable = false;
+    b_wand_reliable_confirmed = false;
+    reliableAbandon(wandReliable, packSerialSend);
+    ms_wand_check.start(i_wand_disconnect_delay);
+  }
+}
+
+// Moves the Serial1 link to a new rate once any queued bytes have been sent.
+void setSerial1BaudRate(unsigned long i_baud) {
+  serial1SendBatch();
+  Serial1.flush();
+  Serial1.begin(i_baud);
+
+  b_serial1_baud_fast = (i_baud != i_serial_baud_default);
+  b_serial1_baud_verified = false;
+}
+
+// Returns a lost Serial1 link to the default rate.
+void serial1BaudFallback() {
+  if(b_serial1_baud_fast) {
+    if(!b_serial1_baud_verified) {
+      // Nothing was ever received at the faster rate, so do not offer it again.
+      b_serial1_baud_failed = true;
     }
+
+    setSerial1BaudRate(i_serial_baud_default);
   }
 }
 
-void doSerial1Sync() {
-  // Denote sync in progress, don't run this code again if we get another handshake.
-  // This will be cleared once the Attenuator responds back that it has been synchronized.
-  b_serial1_syncing = true;
-  b_serial1_connected = false;
-  ms_serial1_check.stop();
+// Moves the wand link to a new rate once any queued bytes have been sent.
+void setWandBaudRate(unsigned long i_baud) {
+  packSerialSendBatch();
+  Serial2.flush();
+  Serial2.begin(i_baud);
 
-  if(b_diagnostic) {
-    playEffect(S_BEEPS_ALT);
+  b_wand_baud_fast = (i_baud != i_serial_baud_default);
+  b_wand_baud_verified = false;
+}
+
+// Returns a lost wand link to the default rate.
+void wandBaudFallback() {
+  if(b_wand_baud_fast) {
+    if(!b_wand_baud_verified) {
+      // Nothing was ever received at the faster rate, so do not offer it again.
+      b_wand_baud_failed = true;
+    }
+
+    setWandBaudRate(i_serial_baud_default);
   }
+}
 
-  debugln(F("Serial1 Sync Start"));
-  serial1Send(A_SYNC_START);
+// Records how many packets one pass of a drain loop handled.
+void updateSerialDrainStats(struct SerialDrainStats &stats, uint8_t i_packets, bool b_deferred) {
+  if(i_packets == 0) {
+    return;
+  }
+
+  stats.lastPackets = i_packets;
+
+  if(i_packets > stats.maxPackets) {
+    stats.maxPackets = i_packets;
+    debug(F("New Serial Backlog Max: "));
+    debugln(i_packets);
+  }
+
+  if(b_deferred && stats.deferred < 0xFFFF) {
+    stats.deferred++;
+  }
+}
+
+// Handles a single packet from the extra Serial1 port.
+void handleSerial1Packet(uint8_t i_packet_id) {
+  // debug(F("Serial PacketID: "));
+  // debugln(i_packet_id);
+
+  if(i_packet_id > 0) {
+    if(ms_serial1_check.isRunning() && b_serial1_connected) {
+      // If the timer is still running and Attenuator is connected, consider any request as proof of life.
+      ms_serial1_check.restart();
+    }
+
+    if(b_serial1_baud_fast) {
+      // Any valid packet proves the link works at the faster rate.
+      b_serial1_baud_verified = true;
+    }
+
+    // Determine the type of packet which was sent by the serial1 device.
+    switch(i_packet_id) {
+      case PACKET_COMMAND:
+        serial1Coms.rxObj(recvCmdS);
+        if(recvCmdS.c > 0 && recvCmdS.s == A_COM_START && recvCmdS.e == A_COM_END) {
+          debug(F("Recv. Serial1 Command: "));
+          debugln(recvCmdS.c);
+          handleSerialCommand(recvCmdS.c, recvCmdS.d1);
+        }
+        else {
+          serial1Link.markerErrors++;
+        }
+      break;
+
+      case PACKET_DATA:
+        if(!b_serial1_connected) {
+          // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
+          return;
+        }
+
+        serial1Coms.rxObj(recvDataS);
+        if(recvDataS.m > 0 && recvDataS.s == A_COM_START && recvDataS.e == A_COM_END) {
+          debug(F("Recv. Serial1 Message: "));
+          debugln(recvDataS.m);
+          // No handlers at this time.
+        }
+        else {
+          serial1Link.markerErrors++;
+        }
+      break;
+
+      case PACKET_PACK:
+        if(!b_serial1_connected) {
+          // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
+          return;
+        }
+
+        serial1Coms.rxObj(packConfig);
+        debugln(F("Recv. Pack Config"));
+
+        // Writes new preferences back to runtime variables.
+        // This action does not save changes to the EEPROM!
+
+        switch(packConfig.defaultSystemModePack) {
+          case 0:
+          default:
+            SYSTEM_MODE = MODE_SUPER_HERO;
+            packSerialSend(P_MODE_SUPER_HERO);
+            serial1Send(A_MODE_SUPER_HERO);
+          break;
+
+          case 1:
+            SYSTEM_MODE = MODE_ORIGINAL;
+            packSerialSend(P_MODE_ORIGINAL);
+            serial1Send(A_MODE_ORIGINAL);
+
+            if(!b_wand_connected && STREAM_MODE != PROTON) {
+              // If no wand is connected we need to make sure we're in Proton Stream.
+              STREAM_MODE = PROTON;
+              serial1Send(A_PROTON_MODE);
+            }
+          break;
+        }
+
+        switch(packConfig.defaultYearThemePack) {
+          case 1:
+          default:
+            // Will allow the pack to boot up to whatever state the mode switch is in.
+            SYSTEM_EEPROM_YEAR = SYSTEM_TOGGLE_SWITCH;
+          break;
+          case 2:
+            SYSTEM_EEPROM_YEAR = SYSTEM_1984;
+          break;
+          case 3:
+            SYSTEM_EEPROM_YEAR = SYSTEM_1989;
+          break;
+          case 4:
+            SYSTEM_EEPROM_YEAR = SYSTEM_AFTERLIFE;
+          break;
+          case 5:
+            SYSTEM_EEPROM_YEAR = SYSTEM_FROZEN_EMPIRE;
+          break;
+        }
+
+        switch(packConfig.currentYearThemePack) {
+          case 2:
+            SYSTEM_YEAR = SYSTEM_1984;
+            SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
+            b_switch_mode_override = true; // Explicit mode set, override mode toggle.
+            packSerialSend(P_YEAR_1984);
+            serial1Send(A_YEAR_1984);
+          break;
+          case 3:
+            SYSTEM_YEAR = SYSTEM_1989;
+            SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
+            b_switch_mode_override = true; // Explicit mode set, override mode toggle.
+            packSerialSend(P_YEAR_1989);
+            serial1Send(A_YEAR_1989);
+          break;
+          case 4:
+            SYSTEM_YEAR = SYSTEM_AFTERLIFE;
+            SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
+            b_switch_mode_override = true; // Explicit mode set, override mode toggle.
+            packSerialSend(P_YEAR_AFTERLIFE);
+            serial1Send(A_YEAR_AFTERLIFE);
+          break;
+          case 5:
+            SYSTEM_YEAR = SYSTEM_FROZEN_EMPIRE;
+            SYSTEM_YEAR_TEMP = SYSTEM_YEAR;
+            b_switch_mode_override = true; // Explicit mode set, override mode toggle.
+            packSerialSend(P_YEAR_FROZEN_EMPIRE);
+            serial1Send(A_YEAR_FROZEN_EMPIRE);
+          break;
+        }
+
+        switch(packConfig.packVibration) {
+          case 1:
+            b_vibration_switch_on = true; // Override the vibration toggle switch.
+            VIBRATION_MODE_EEPROM = VIBRATION_ALWAYS;
+            VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+          break;
+
+          case 2:
+            b_vibration_switch_on = true; // Override the vibration toggle switch.
+            VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
+            VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+          break;
+
+          case 3:
+            VIBRATION_MODE_EEPROM = VIBRATION_NONE;
+            VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+          break;
+
+          case 4:
+          default:
+            VIBRATION_MODE_EEPROM = VIBRATION_DEFAULT;
+            VIBRATION_MODE = VIBRATION_FIRING_ONLY;
+
+            // Reset the vibration switch state.
+            if(switch_vibration.getState() == LOW) {
+              b_vibration_switch_on = true;
+            }
+            else {
+              b_vibration_switch_on = false;
+            }
+          break;
+
+          case 5:
+            VIBRATION_MODE_EEPROM = CYCLOTRON_MOTOR;
+            VIBRATION_MODE = VIBRATION_MODE_EEPROM;
+
+            // Reset the vibration switch state.
+            if(switch_vibration.getState() == LOW) {
+              b_vibration_switch_on = true;
+            }
+            else {
+              b_vibration_switch_on = false;
+            }
+          break;
+        }
+
+        i_volume_master_eeprom = (MINIMUM_VOLUME + i_volume_min_adj) - ((MINIMUM_VOLUME + i_volume_min_adj) * packConfig.defaultSystemVolume / 100);
+        b_stream_effects = (packConfig.protonStreamEffects == 1);
+        b_overheat_strobe = (packConfig.overheatStrobeNF == 1);
+        b_overheat_lights_off = (packConfig.overheatLightsOff == 1);
+        b_overheat_sync_to_fan = (packConfig.overheatSyncToFan == 1);
+        b_demo_light_mode = (packConfig.demoLightMode == 1);
+        b_use_ribbon_cable = (packConfig.ribbonCableAlarm == 1);
+
+        // Cyclotron Lid
+        switch(packConfig.ledCycLidCount) {
+          // For a 40 LED Neopixel ring.
+          case 40:
+            i_cyclotron_leds = OUTER_CYCLOTRON_LED_MAX;
+          break;
+
+          // For Frutto Technology Max Cyclotron (36) LEDs.
+          case 36:
+            i_cyclotron_leds = FRUTTO_MAX_CYCLOTRON_LED_COUNT;
+          break;
+
+          // For Frutto Technology Cyclotron (20) LEDs.
+          case 20:
+            i_cyclotron_leds = FRUTTO_CYCLOTRON_LED_COUNT;
+          break;
+
+          // Default HasLab (12) LEDs.
+          case 12:
+          default:
+            i_cyclotron_leds = HASLAB_CYCLOTRON_LED_COUNT;
+          break;
+        }
+        i_spectral_cyclotron_custom_colour = packConfig.ledCycLidHue;
+        i_spectral_cyclotron_custom_saturation = packConfig.ledCycLidSat;
+        b_clockwise = (packConfig.cyclotronDirection == 1);
+        b_cyclotron_single_led = (packConfig.ledCycLidCenter == 1);
+        b_fade_cyclotron_led = (packConfig.ledCycLidFade == 1);
+        b_cyclotron_colour_toggle = (packConfig.ledVGCyclotron == 1);
+        b_cyclotron_simulate_ring = (packConfig.ledCycLidSimRing == 1);
+
+        // Inner Cyclotron
+        switch(packConfig.ledCycInnerPanel) {
+          case 1:
+          default:
+            INNER_CYC_PANEL_MODE = PANEL_INDIVIDUAL;
+          break;
+          case 2:
+            INNER_CYC_PANEL_MODE = PANEL_RGB_STATIC;
+          break;
+          case 3:
+            INNER_CYC_PANEL_MODE = PANEL_RGB_DYNAMIC;
+          break;
+        }
+        i_inner_cyclotron_cake_num_leds = packConfig.ledCycCakeCount;
+        i_spectral_cyclotron_inner_custom_colour = packConfig.ledCycCakeHue;
+        i_spectral_cyclotron_inner_custom_saturation = packConfig.ledCycCakeSat;
+        b_grb_cyclotron_cake = (packConfig.ledCycCakeGRB == 1);
+        i_inner_cyclotron_cavity_num_leds = packConfig.ledCycCavCount;
+
+        // Power Cell
+        i_powercell_leds = packConfig.ledPowercellCount;
+        b_powercell_invert = (packConfig.ledInvertPowercell == 1);
+        i_spectral_powercell_custom_colour = packConfig.ledPowercellHue;
+        i_spectral_powercell_custom_saturation = packConfig.ledPowercellSat;
+        b_powercell_colour_toggle = (packConfig.ledVGPowercell == 1);
+
+        // Offer some feedback to the user
+        stopEffect(S_VENT_DRY);
+        playEffect(S_VENT_DRY);
+
+        // Update system values and reset as needed.
+        resetInnerCyclotronLEDs(); // Must call this first, prior to updating counts
+        updateProtonPackLEDCounts(); // Must call this after resetting # of LEDs
+        resetCyclotronLEDs(); // Update delays based on LED count
+        resetRampSpeeds(); // Update delays based on LED count
+      break;
+
+      case PACKET_WAND:
+        if(!b_serial1_connected) {
+          // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
+          return;
+        }
+
+        serial1Coms.rxObj(wandConfig);
+        debugln(F("Recv. Wand Config"));
+
+        // This will pass values from the wandConfig object
+        packSerialSendData(P_SAVE_PREFERENCES_WAND);
+
+        // Offer some feedback to the user
+        stopEffect(S_VENT_DRY);
+        playEffect(S_VENT_DRY);
+      break;
+
+      case PACKET_SMOKE:
+        if(!b_serial1_connected) {
+          // Can't proceed if the Attenuator isn't connected; prevents phantom actions from occurring.
+          return;
+        }
+
+        serial1Coms.rxObj(smokeConfig);
+        debugln(F("Recv. Smoke Config"));
+
+        // Save local and remote (wand) smoke timing settings
+        i_ms_overheating_length_5 = smokeConfig.overheatDuration5 * 1000;
+        i_ms_overheating_length_4 = smokeConfig.overheatDuration4 * 1000;
+        i_ms_overheating_length_3 = smokeConfig.overheatDuration3 * 1000;
+        i_ms_overheating_length_2 = smokeConfig.overheatDuration2 * 1000;
+        i_ms_overheating_length_1 = smokeConfig.overheatDuration1 * 1000;
+
+        b_smoke_continuous_level_5 = (smokeConfig.overheatContinuous5 == 1);
+        b_smoke_continuous_level_4 = (smokeConfig.overheatContinuous4 == 1);
+        b_smoke_continuous_level_3 = (smokeConfig.overheatContinuous3 == 1);
+        b_smoke_continuous_level_2 = (smokeConfig.overheatContinuous2 == 1);
+        b_smoke_continuous_level_1 = (smokeConfig.overheatContinuous1 == 1);
+        b_smoke_enabled = (smokeConfig.smokeEnabled == 1);
+        resetContinuousSmoke(); // Set other variables as necessary
+
+        // This will pass values from the smokeConfig object
+        packSerialSendData(P_SAVE_PREFERENCES_SMOKE);
 
+        // Offer some feedback to the user
+        stopEffect(S_VENT_SMOKE);
+        playEffect(S_VENT_SMOKE);
+      break;
+    }
+  }
+}
+
+// Incoming messages from the extra Serial1 port.
+// Captures the current pack state reported to the Serial1 device.
+void fillSerial1SyncData() {
   // Tell the serial1 device about the wand status.
   attenuatorSyncData.wandPresent = b_wand_connected ? 1 : 0;
   attenuatorSyncData.barrelExtended = b_neutrona_wand_barrel_extended ? 1 : 0;
@@ -886,6 +1245,7 @@ void doSerial1Sync() {
   attenuatorSyncData.musicPlaying = b_playing_music ? 1 : 0;
   attenuatorSyncData.musicPaused = b_music_paused ? 1 : 0;
   attenuatorSyncData.trackLooped = b_repeat_track ? 2 : 1;
+  attenuatorSyncData.musicShuffle = b_music_shuffle ? 2 : 1;
   attenuatorSyncData.currentTrack = i_current_music_track;
   attenuatorSyncData.musicCount = i_music_count;
   attenuatorSyncData.masterMuted = (i_volume_master == i_volume_abs_min) ? 2 : 1;
@@ -893,8 +1253,131 @@ void doSerial1Sync() {
   attenuatorSyncData.effectsVolume = i_volume_effects_percentage;
   attenuatorSyncData.musicVolume = i_volume_music_percentage;
 
+  if(b_pack_started_by_meter) {
+    // Matches the full power proton stream reported when the power meter started the pack.
+    attenuatorSyncData.powerLevel = 5;
+    attenuatorSyncData.streamMode = 1;
+  }
+}
+
+// CRC-8 of a block of state, used by the Serial1 device to confirm that its mirror matches.
+uint8_t syncChecksum(const uint8_t *p_data, uint8_t i_length) {
+  uint8_t i_crc = 0;
+
+  for(uint8_t i = 0; i < i_length; i++) {
+    i_crc ^= p_data[i];
+
+    for(uint8_t j = 0; j < 8; j++) {
+      i_crc = (i_crc & 0x80) ? (i_crc << 1) ^ 0x9B : (i_crc << 1);
+    }
+  }
+
+  return i_crc;
+}
+
+// Sends the bytes of the pack state which differ from the state last acknowledged by the Serial1 device.
+void serial1SendMirror() {
+  uint16_t i_send_size = 0;
+  uint8_t i_changed = 0;
+  const uint8_t *p_state = (const uint8_t *) &attenuatorSyncData;
+  const uint8_t *p_shadow = (const uint8_t *) &attenuatorSyncShadow;
+
+  fillSerial1SyncData();
+
+  syncDelta.changed = 0;
+
+  for(uint8_t i = 0; i < sizeof(AttenuatorSyncData); i++) {
+    if(p_state[i] != p_shadow[i]) {
+      syncDelta.changed |= (uint32_t) 1 << i;
+      syncDelta.d[i_changed++] = p_state[i];
+    }
+  }
+
+  if(i_changed == 0 && !b_serial1_mirror_pending) {
+    // Nothing has changed, so check again later.
+    ms_serial1_mirror.start(i_serial1_mirror_delay);
+    return;
+  }
+
+  // Changes are relative to the acknowledged state, so the next change also covers one which was lost.
+  // An unacknowledged change is followed up even if nothing differs, as the device may have applied it.
+  // Held commands go out ahead of this change.
+  serial1SendBatch();
+
+  syncDelta.version = ++i_serial1_mirror_version;
+  syncDelta.crc = syncChecksum(p_state, sizeof(AttenuatorSyncData));
+  attenuatorSyncSent = attenuatorSyncData;
+  b_serial1_mirror_pending = true;
+
+  i_send_size = serial1Coms.txObj(syncDelta, 0, offsetof(struct SyncDeltaPacket, d) + i_changed);
+  serial1SendFrame(i_send_size, PACKET_SYNC_DELTA);
+
+  ms_serial1_mirror.start(i_serial1_mirror_ack_delay);
+}
+
+// Sends changes in the pack state to a mirroring Serial1 device, at most once per change delay.
+void checkSerial1Mirror() {
+  if(b_serial1_mirror && ms_serial1_mirror.justFinished()) {
+    serial1SendMirror();
+  }
+}
+
+void checkSerial1() {
+  uint8_t i_packets = 0;
+  bool b_deferred = false;
+  unsigned long i_start = micros();
+
+  // Handle every complete packet already waiting, within the per-loop limits.
+  while(serial1Coms.available() > 0) {
+    RECORD_FRAME(RECORD_SERIAL1_IN, serial1Coms.currentPacketID(), serial1Coms.packet.rxBuff, serial1Coms.bytesRead);
+    linkFrameReceived(serial1Link, i_serial1_link_last_frame, serial1Coms.currentPacketID());
+    handleSerial1Packet(serial1Coms.currentPacketID());
+    i_packets++;
+
+    if(i_packets >= i_serial_drain_max_packets || micros() - i_start >= i_serial_drain_budget_us) {
+      // Leave anything else for the next loop pass.
+      b_deferred = Serial1.available() > 0;
+      break;
+    }
+  }
+
+  if(serial1Coms.status <= CRC_ERROR) {
+    // The last frame read was corrupted.
+    serial1Link.crcErrors++;
+  }
+
+  updateSerialDrainStats(serial1Drain, i_packets, b_deferred);
+
+  checkSerial1Mirror();
+}
+
+void doSerial1Sync() {
+  // Denote sync in progress, don't run this code again if we get another handshake.
+  // This will be cleared once the Attenuator responds back that it has been synchronized.
+  b_serial1_syncing = true;
+  b_serial1_connected = false;
+  ms_serial1_check.stop();
+
+  if(b_diagnostic) {
+    playEffect(S_BEEPS_ALT);
+  }
+
+  // Anything held goes out as before, then commands are sent singly until the device says it decodes batches.
+  serial1SendBatch();
+  b_serial1_batch = false;
+
+  debugln(F("Serial1 Sync Start"));
+  serial1Send(A_SYNC_START);
+
+  fillSerial1SyncData();
   serial1SendData(A_SYNC_DATA);
 
+  // The device starts from this state, and says whether it mirrors it once the sync has ended.
+  attenuatorSyncShadow = attenuatorSyncData;
+  b_serial1_mirror = false;
+  b_serial1_mirror_pending = false;
+  i_serial1_mirror_version = 0;
+
   // Send the ribbon cable alarm status if the ribbon cable is detached.
   if(b_alarm && ribbonCableAttached() != true) {
     serial1Send(A_ALARM_ON);
@@ -920,6 +1403,7 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
     break;
 
     case A_HANDSHAKE:
+      linkRequestAnswered(serial1Link, i_serial1_link_request_time);
       b_serial1_syncing = false; // No longer attempting to force a sync w/ Attenuator.
       b_serial1_connected = true; // If we're receiving handshake instead of SYNC_NOW we must be connected.
 
@@ -934,6 +1418,52 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
       b_serial1_syncing = false;
       b_serial1_connected = true;
       ms_serial1_check.start(i_serial1_disconnect_delay);
+
+      if(!b_serial1_baud_fast && !b_serial1_baud_failed) {
+        // Offer a faster link rate. Older firmware ignores this and stays at the default rate.
+        serial1Send(A_BAUD_RATE, i_serial1_baud_fast / 100);
+      }
+    break;
+
+    case A_BAUD_RATE:
+      // The Attenuator accepted the faster rate and has already switched, so follow it and confirm.
+      if(!b_serial1_baud_fast && i_value == i_serial1_baud_fast / 100) {
+        debugln(F("Serial1 Baud Rate Increased"));
+        setSerial1BaudRate(i_serial1_baud_fast);
+        serial1Send(A_BAUD_RATE_CONFIRM, i_value);
+      }
+    break;
+
+    case A_SYNC_DELTA_ACK:
+      if(!b_serial1_mirror) {
+        // The device has taken the full state from the sync and will mirror it from now on.
+        debugln(F("Serial1 Mirroring State"));
+        b_serial1_mirror = true;
+        ms_serial1_mirror.start(i_serial1_mirror_delay);
+      }
+      else if(b_serial1_mirror_pending && i_value == i_serial1_mirror_version) {
+        // The last change was applied, so further changes are relative to it.
+        attenuatorSyncShadow = attenuatorSyncSent;
+        b_serial1_mirror_pending = false;
+        ms_serial1_mirror.start(i_serial1_mirror_delay);
+      }
+    break;
+
+    case A_COMMAND_BATCH:
+      // The device decodes batched commands, so hold commands until the end of each loop pass.
+      debugln(F("Serial1 Batching Commands"));
+      b_serial1_batch = true;
+    break;
+
+    case A_SYNC_DELTA_RESYNC:
+      // The device's copy of the state no longer matches, so send all of it again.
+      debugln(F("Serial1 Mirror Resync"));
+      fillSerial1SyncData();
+      serial1SendData(A_SYNC_DATA);
+
+      attenuatorSyncShadow = attenuatorSyncData;
+      b_serial1_mirror_pending = false;
+      ms_serial1_mirror.start(i_serial1_mirror_delay);
     break;
 
     case A_TURN_PACK_ON:
@@ -1103,6 +1633,11 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
       serial1Send(A_MUSIC_TRACK_LOOP_TOGGLE, b_repeat_track ? 2 : 1);
     break;
 
+    case A_MUSIC_SHUFFLE_TOGGLE:
+      toggleMusicShuffle();
+      serial1Send(A_MUSIC_SHUFFLE_TOGGLE, b_music_shuffle ? 2 : 1);
+    break;
+
     case A_REQUEST_PREFERENCES_PACK:
       // If requested by the serial device, send back all pack EEPROM preferences.
       // This will send a data payload directly from the pack as all data is local.
@@ -1136,13 +1671,13 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
           stopMusic(); // Stops current track before change.
 
           // Only update after the music is stopped.
-          i_current_music_track = i_value;
+          musicSelectTrack(i_value);
 
           // Play the appropriate track on pack and wand, and notify the serial1 device.
           playMusic();
         }
         else {
-          i_current_music_track = i_value;
+          musicSelectTrack(i_value);
         }
       }
     break;
@@ -1166,81 +1701,156 @@ void handleSerialCommand(uint8_t i_command, uint16_t i_value) {
       playEffect(S_VOICE_EEPROM_SAVE);
     break;
 
+    case A_REQUEST_LINK_STATS:
+      // Send what we have now, then pass on the wand's own counters as soon as it answers.
+      serial1SendData(A_SEND_LINK_STATS);
+
+      if(b_wand_connected) {
+        b_wand_link_stats_forward = true;
+        packSerialSend(P_REQUEST_LINK_STATS);
+      }
+    break;
+
+    case A_REQUEST_PROFILE:
+      // Loop stage timings are only available when built with GPSTAR_PROFILING.
+#ifdef GPSTAR_PROFILING
+      serial1SendData(A_SEND_PROFILE);
+#endif
+    break;
+
     default:
       // No-op for anything else.
     break;
   }
 }
 
-// Incoming messages from the wand.
-void checkWand() {
-  if(packComs.available() > 0) {
-    uint8_t i_packet_id = packComs.currentPacketID();
-    // debug(F("Wand PacketID: "));
-    // debugln(i_packet_id);
-
-    if(i_packet_id > 0) {
-      if(ms_wand_check.isRunning() && b_wand_connected) {
-        // If the timer is still running and wand is connected, consider any request as proof of life.
-        ms_wand_check.restart();
-      }
-
-      // Determine the type of packet which was sent by the wand device.
-      switch(i_packet_id) {
-        case PACKET_COMMAND:
-          packComs.rxObj(recvCmdW);
-          if(recvCmdW.c > 0 && recvCmdW.s == W_COM_START && recvCmdW.e == W_COM_END) {
-            debug(F("Recv. Wand Command: "));
-            debugln(recvCmdW.c);
-            handleWandCommand(recvCmdW.c, recvCmdW.d1);
-          }
-        break;
+// Handles a single packet from the wand.
+void handleWandPacket(uint8_t i_packet_id) {
+  // debug(F("Wand PacketID: "));
+  // debugln(i_packet_id);
 
-        case PACKET_DATA:
-          if(!b_wand_connected) {
-            // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
-            return;
-          }
+  if(i_packet_id > 0) {
+    if(ms_wand_check.isRunning() && b_wand_connected) {
+      // If the timer is still running and wand is connected, consider any request as proof of life.
+      ms_wand_check.restart();
+    }
 
-          packComs.rxObj(recvDataW);
-          if(recvDataW.m > 0 && recvDataW.s == W_COM_START && recvDataW.e == W_COM_END) {
-            debug(F("Recv. Wand Data: "));
-            debugln(recvDataW.m);
-            // No handlers at this time.
-          }
-        break;
+    if(b_wand_baud_fast) {
+      // Any valid packet proves the link works at the faster rate.
+      b_wand_baud_verified = true;
+    }
 
-        case PACKET_WAND:
-          if(!b_wand_connected) {
-            // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
-            return;
-          }
+    // Determine the type of packet which was sent by the wand device.
+    switch(i_packet_id) {
+      case PACKET_COMMAND:
+        packComs.rxObj(recvCmdW);
+        if(recvCmdW.c > 0 && recvCmdW.s == W_COM_START && recvCmdW.e == W_COM_END) {
+          debug(F("Recv. Wand Command: "));
+          debugln(recvCmdW.c);
+          handleWandCommand(recvCmdW.c, recvCmdW.d1);
+        }
+        else {
+          wandLink.markerErrors++;
+        }
+      break;
 
-          packComs.rxObj(wandConfig);
-          debugln(F("Recv. Wand Config Prefs"));
+      case PACKET_RELIABLE:
+        handleWandReliable();
+      break;
 
-          // Send the EEPROM preferences just returned by the wand.
-          serial1SendData(A_SEND_PREFERENCES_WAND);
-        break;
+      case PACKET_LINK_STATS:
+        packComs.rxObj(recvLinkStats);
 
-        case PACKET_SMOKE:
-          if(!b_wand_connected) {
-            // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
-            return;
+        if(recvLinkStats.link == LINK_WAND_PACK) {
+          // Kept in case the Serial1 device asks again while the wand is away.
+          wandReportedLink = recvLinkStats.stats;
+
+          if(b_wand_link_stats_forward) {
+            // Replaces the older copy sent when the Serial1 device asked.
+            b_wand_link_stats_forward = false;
+            sendLinkStats = recvLinkStats;
+            serial1SendFrame(serial1Coms.txObj(sendLinkStats), PACKET_LINK_STATS);
           }
+        }
+      break;
 
-          packComs.rxObj(smokeConfig);
-          debugln(F("Recv. Wand Smoke Prefs"));
+      case PACKET_DATA:
+        if(!b_wand_connected) {
+          // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
+          return;
+        }
 
-          // Send the EEPROM preferences just returned by the wand.
-          // This data will combine with the pack's smoke settings.
-          serial1SendData(A_SEND_PREFERENCES_SMOKE);
-        break;
-      }
+        packComs.rxObj(recvDataW);
+        if(recvDataW.m > 0 && recvDataW.s == W_COM_START && recvDataW.e == W_COM_END) {
+          debug(F("Recv. Wand Data: "));
+          debugln(recvDataW.m);
+          // No handlers at this time.
+        }
+        else {
+          wandLink.markerErrors++;
+        }
+      break;
+
+      case PACKET_WAND:
+        if(!b_wand_connected) {
+          // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
+          return;
+        }
+
+        packComs.rxObj(wandConfig);
+        debugln(F("Recv. Wand Config Prefs"));
+
+        // Send the EEPROM preferences just returned by the wand.
+        serial1SendData(A_SEND_PREFERENCES_WAND);
+      break;
+
+      case PACKET_SMOKE:
+        if(!b_wand_connected) {
+          // Can't proceed if the wand isn't connected; prevents phantom actions from occurring.
+          return;
+        }
+
+        packComs.rxObj(smokeConfig);
+        debugln(F("Recv. Wand Smoke Prefs"));
+
+        // Send the EEPROM preferences just returned by the wand.
+        // This data will combine with the pack's smoke settings.
+        serial1SendData(A_SEND_PREFERENCES_SMOKE);
+      break;
     }
   }
 }
 
+// Incoming messages from the wand.
+void checkWand() {
+  uint8_t i_packets = 0;
+  bool b_deferred = false;
+  unsigned long i_start = micros();
+
+  // Handle every complete packet already waiting, within the per-loop limits.
+  while(packComs.available() > 0) {
+    RECORD_FRAME(RECORD_WAND_IN, packComs.currentPacketID(), packComs.packet.rxBuff, packComs.bytesRead);
+    linkFrameReceived(wandLink, i_wand_link_last_frame, packComs.currentPacketID());
+    handleWandPacket(packComs.currentPacketID());
+    i_packets++;
+
+    if(i_packets >= i_serial_drain_max_packets || micros() - i_start >= i_serial_drain_budget_us) {
+      // Leave anything else for the next loop pass.
+      b_deferred = Serial2.available() > 0;
+      break;
+    }
+  }
+
+  if(packComs.status <= CRC_ERROR) {
+    // The last frame read was corrupted.
+    wandLink.crcErrors++;
+  }
+
+  updateSerialDrainStats(wandDrain, i_packets, b_deferred);
+
+  checkWandReliable();
+}
+
 // Performs the synchronization of pack settings to a connected wand.
 void doWandSync() {
   // Denote sync in progress, don't run this code again if we get another handshake.
@@ -1258,6 +1868,12 @@ void doWandSync() {
   stopEffect(S_WAND_SYNC);
   playEffect(S_WAND_SYNC);
 
+  // Anything held goes out as before, then commands are sent singly until the wand says it decodes batches.
+  packSerialSendBatch();
+  b_wand_batch = false;
+  b_wand_reliable = false;
+  b_wand_reliable_confirmed = false;
+
   // Begin the synchronization process which tells the wand the pack got the handshake.
   debugln(F("Wand Sync Start"));
   packSerialSend(P_SYNC_START, b_pack_post_finish ? 0 : 1);
@@ -1407,12 +2023,18 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
     break;
 
     case W_HANDSHAKE:
+      linkRequestAnswered(wandLink, i_wand_link_request_time);
       b_wand_syncing = false; // No longer attempting to force a sync w/ wand.
       b_wand_connected = true; // If we're receiving handshake instead of SYNC_NOW we must be connected
 
       // Tell the serial1 device the wand is still connected.
       serial1Send(A_WAND_CONNECTED);
 
+      if(b_wand_baud_fast) {
+        // The wand has no other way to tell that the pack is still listening at the faster rate.
+        packSerialSend(P_BAUD_RATE_CONFIRM, i_wand_baud_fast / 100);
+      }
+
       if(b_diagnostic == true) {
         // While in diagnostic mode, play a sound to indicate the wand is connected.
         playEffect(S_BEEPS);
@@ -1425,6 +2047,36 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       b_wand_connected = true; // Wand sent sync confirmation, so it must be connected.
       ms_wand_check.start(i_wand_disconnect_delay); // Wand is synchronized, so start the keep-alive timer.
       serial1Send(A_WAND_CONNECTED); // Tell the serial1 device the wand is (re-)connected.
+
+      if(!b_wand_baud_fast && !b_wand_baud_failed) {
+        // Offer a faster link rate. Older firmware ignores this and stays at the default rate.
+        packSerialSend(P_BAUD_RATE, i_wand_baud_fast / 100);
+      }
+    break;
+
+    case W_BAUD_RATE:
+      // The wand accepted the faster rate and has already switched, so follow it and confirm.
+      if(!b_wand_baud_fast && i_value == i_wand_baud_fast / 100) {
+        debugln(F("Wand Baud Rate Increased"));
+        setWandBaudRate(i_wand_baud_fast);
+        packSerialSend(P_BAUD_RATE_CONFIRM, i_value);
+      }
+    break;
+
+    case W_COMMAND_BATCH:
+      // The wand decodes batched commands, so hold commands until the end of each loop pass.
+      debugln(F("Wand Batching Commands"));
+      b_wand_batch = true;
+    break;
+
+    case W_RELIABLE:
+      // The wand supports reliable commands, so start numbering them and tell the wand we do too.
+      debugln(F("Wand Reliable Commands"));
+      // Until the wand answers with a reliable frame, it may have missed P_RELIABLE and keeps its usual heartbeat.
+      resetReliableLink(wandReliable);
+      b_wand_reliable = true;
+      b_wand_reliable_confirmed = false;
+      packSerialSend(P_RELIABLE);
     break;
 
     case W_ON:
@@ -1533,7 +2185,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_WAND_BEEP:
       if(b_overheating != true) {
-        playEffect(S_AFTERLIFE_BEEP_WAND_S5, false, i_volume_effects - i_wand_idle_level);
+        playEffect(S_AFTERLIFE_BEEP_WAND_S5, false, busGain(BUS_WAND_IDLE));
       }
     break;
 
@@ -1629,42 +2281,42 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
     case W_AFTERLIFE_GUN_RAMP_1:
       stopEffect(S_AFTERLIFE_WAND_RAMP_1);
-      playEffect(S_AFTERLIFE_WAND_RAMP_1, false, i_volume_effects - i_wand_idle_level);
+      playEffect(S_AFTERLIFE_WAND_RAMP_1, false, busGain(BUS_WAND_IDLE));
     break;
 
     case W_AFTERLIFE_GUN_RAMP_2:
       stopEffect(S_AFTERLIFE_WAND_RAMP_2);
-      playEffect(S_AFTERLIFE_WAND_RAMP_2, false, i_volume_effects - i_wand_idle_level);
+      playEffect(S_AFTERLIFE_WAND_RAMP_2, false, busGain(BUS_WAND_IDLE));
     break;
 
     case W_AFTERLIFE_GUN_RAMP_2_FADE_IN:
       stopEffect(S_AFTERLIFE_WAND_RAMP_2_FADE_IN);
-      playEffect(S_AFTERLIFE_WAND_RAMP_2_FADE_IN, false, i_volume_effects - i_wand_idle_level);
+      playEffect(S_AFTERLIFE_WAND_RAMP_2_FADE_IN, false, busGain(BUS_WAND_IDLE));
     break;
 
     case W_AFTERLIFE_GUN_LOOP_1:
       stopEffect(S_AFTERLIFE_WAND_IDLE_1);
-      playEffect(S_AFTERLIFE_WAND_IDLE_1, true, i_volume_effects - i_wand_idle_level);
+      playEffect(S_AFTERLIFE_WAND_IDLE_1, true, busGain(BUS_WAND_IDLE));
     break;
 
     case W_AFTERLIFE_GUN_LOOP_2:
       stopEffect(S_AFTERLIFE_WAND_IDLE_2);
-      playEffect(S_AFTERLIFE_WAND_IDLE_2, true, i_volume_effects - i_wand_idle_level);
+      playEffect(S_AFTERLIFE_WAND_IDLE_2, true, busGain(BUS_WAND_IDLE));
     break;
 
     case W_AFTERLIFE_GUN_RAMP_DOWN_2:
       stopEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2);
-      playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2, false, i_volume_effects - i_wand_idle_level);
+      playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2, false, busGain(BUS_WAND_IDLE));
     break;
 
     case W_AFTERLIFE_GUN_RAMP_DOWN_2_FADE_OUT:
       stopEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT);
-      playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT, false, i_volume_effects - i_wand_idle_level);
+      playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_2_FADE_OUT, false, busGain(BUS_WAND_IDLE));
     break;
 
     case W_AFTERLIFE_GUN_RAMP_DOWN_1:
       stopEffect(S_AFTERLIFE_WAND_RAMP_DOWN_1);
-      playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_1, false, i_volume_effects - i_wand_idle_level);
+      playEffect(S_AFTERLIFE_WAND_RAMP_DOWN_1, false, busGain(BUS_WAND_IDLE));
     break;
 
     case W_EXTRA_WAND_SOUNDS_STOP:
@@ -1680,7 +2332,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       }
 
       if(VIBRATION_MODE == VIBRATION_FIRING_ONLY && b_vibration_switch_on) {
-        ms_menu_vibration.start(350); // If vibrate while firing is enabled and vibration switch is on, vibrate the pack.
+        startMenuVibration(350); // If vibrate while firing is enabled and vibration switch is on, vibrate the pack.
       }
     break;
 
@@ -1688,7 +2340,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       playEffect(S_SHOCK_BLAST_FIRE, false, i_volume_effects, false, 0, false);
 
       if(VIBRATION_MODE == VIBRATION_FIRING_ONLY && b_vibration_switch_on) {
-        ms_menu_vibration.start(300); // If vibrate while firing is enabled and vibration switch is on, vibrate the pack.
+        startMenuVibration(300); // If vibrate while firing is enabled and vibration switch is on, vibrate the pack.
       }
     break;
 
@@ -1700,7 +2352,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       playEffect(S_MESON_COLLIDER_FIRE, false, i_volume_effects, false, 0, false);
 
       if(VIBRATION_MODE == VIBRATION_FIRING_ONLY && b_vibration_switch_on) {
-        ms_menu_vibration.start(200); // If vibrate while firing is enabled and vibration switch is on, vibrate the pack.
+        startMenuVibration(200); // If vibrate while firing is enabled and vibration switch is on, vibrate the pack.
       }
     break;
 
@@ -1790,6 +2442,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
       // Proton mode.
       STREAM_MODE = PROTON;
+      updateDeviceColours();
 
       if(b_settings) {
         playEffect(S_CLICK);
@@ -1828,13 +2481,14 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
         playEffect(S_PACK_SLIME_TANK_LOOP, true, i_volume_effects, true, 700);
 
         if((SYSTEM_YEAR == SYSTEM_AFTERLIFE || SYSTEM_YEAR == SYSTEM_FROZEN_EMPIRE)) {
-          adjustGainEffect(S_AFTERLIFE_PACK_STARTUP, i_volume_effects - 30, true, 100);
-          adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - 40, true, 100);
+          adjustGainEffect(S_AFTERLIFE_PACK_STARTUP, i_volume_effects - i_slime_startup_level, true, 100);
+          adjustGainEffect(S_AFTERLIFE_PACK_IDLE_LOOP, i_volume_effects - i_slime_idle_level, true, 100);
         }
       }
 
       // Slime mode.
       STREAM_MODE = SLIME;
+      updateDeviceColours();
 
       if(b_settings) {
         playEffect(S_CLICK);
@@ -1890,6 +2544,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
       // Stasis mode.
       STREAM_MODE = STASIS;
+      updateDeviceColours();
 
       if(b_settings) {
         playEffect(S_CLICK);
@@ -1936,6 +2591,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
       // Meson mode.
       STREAM_MODE = MESON;
+      updateDeviceColours();
 
       if(b_settings) {
         playEffect(S_CLICK);
@@ -1991,6 +2647,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
       // Proton mode.
       STREAM_MODE = SPECTRAL;
+      updateDeviceColours();
 
       if(b_settings) {
         playEffect(S_CLICK);
@@ -2042,6 +2699,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
       // Proton mode.
       STREAM_MODE = HOLIDAY;
       b_christmas = (i_value == 2);
+      updateDeviceColours();
 
       if(b_settings) {
         playEffect(S_CLICK);
@@ -2095,6 +2753,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
       // Proton mode.
       STREAM_MODE = SPECTRAL_CUSTOM;
+      updateDeviceColours();
 
       if(b_settings) {
         playEffect(S_CLICK);
@@ -2677,7 +3336,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
           packSerialSend(P_PACK_VIBRATION_FIRING_ENABLED);
 
-          ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+          startMenuVibration(250); // Confirmation buzz for 250ms.
         break;
 
         case VIBRATION_FIRING_ONLY:
@@ -2731,7 +3390,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
           packSerialSend(P_PACK_VIBRATION_ENABLED);
 
-          ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+          startMenuVibration(250); // Confirmation buzz for 250ms.
         break;
       }
     break;
@@ -2759,7 +3418,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
           packSerialSend(P_PACK_VIBRATION_ENABLED);
 
-          ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+          startMenuVibration(250); // Confirmation buzz for 250ms.
         break;
         case VIBRATION_ALWAYS:
           VIBRATION_MODE_EEPROM = VIBRATION_FIRING_ONLY;
@@ -2777,7 +3436,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
           packSerialSend(P_PACK_VIBRATION_FIRING_ENABLED);
 
-          ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+          startMenuVibration(250); // Confirmation buzz for 250ms.
         break;
         case VIBRATION_FIRING_ONLY:
           VIBRATION_MODE_EEPROM = VIBRATION_NONE;
@@ -2840,7 +3499,7 @@ void handleWandCommand(uint8_t i_command, uint16_t i_value) {
 
           packSerialSend(P_PACK_VIBRATION_DEFAULT);
 
-          ms_menu_vibration.start(250); // Confirmation buzz for 250ms.
+          startMenuVibration(250); // Confirmation buzz for 250ms.
         break;
       }
     break;
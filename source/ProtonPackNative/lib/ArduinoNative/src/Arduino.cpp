@@ -0,0 +1,417 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdio.h>
+
+#include "Arduino.h"
+
+// termios.h names its baud rates B0, B110 and so on, which clash with the binary constants from binary.h.
+// Nothing in this file uses the binary constants, so drop them and let termios.h define its own.
+#undef B0
+#undef B110
+#undef B1000000
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+volatile uint8_t TCCR1B = 0;
+volatile uint8_t TCCR2B = 0;
+volatile uint8_t TCCR3B = 0;
+volatile uint8_t TCCR4B = 0;
+volatile uint8_t TCCR5B = 0;
+volatile uint8_t ADMUX = 0;
+NativeADCSRA ADCSRA = {0};
+volatile uint16_t ADC = 228;
+
+/*
+ * Virtual clock.
+ */
+static uint64_t i_clock_us = 0;
+static uint64_t i_delayed_us = 0;
+
+unsigned long millis() {
+  return (unsigned long) (i_clock_us / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long) i_clock_us;
+}
+
+void delay(unsigned long ms) {
+  i_clock_us += (uint64_t) ms * 1000;
+  i_delayed_us += (uint64_t) ms * 1000;
+}
+
+void delayMicroseconds(unsigned int us) {
+  i_clock_us += us;
+  i_delayed_us += us;
+}
+
+/*
+ * Virtual pins. Zero-initialised storage means "not driven low", so every pin reads HIGH
+ * until the sketch or harness says otherwise. This must hold before any static
+ * constructor (eg. ezButton) samples a pin.
+ */
+static bool b_pin_low[NATIVE_NUM_PINS];
+static int i_pin_analog_out[NATIVE_NUM_PINS];
+static int i_pin_analog_in[NATIVE_NUM_PINS];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void) pin;
+  (void) mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  if(pin < NATIVE_NUM_PINS) {
+    b_pin_low[pin] = (val == LOW);
+    i_pin_analog_out[pin] = (val == LOW) ? 0 : 255;
+  }
+}
+
+int digitalRead(uint8_t pin) {
+  if(pin < NATIVE_NUM_PINS) {
+    return b_pin_low[pin] ? LOW : HIGH;
+  }
+
+  return LOW;
+}
+
+void analogWrite(uint8_t pin, int val) {
+  if(pin < NATIVE_NUM_PINS) {
+    i_pin_analog_out[pin] = val;
+    b_pin_low[pin] = (val == 0);
+  }
+}
+
+int analogRead(uint8_t pin) {
+  if(pin < NATIVE_NUM_PINS) {
+    return i_pin_analog_in[pin];
+  }
+
+  return 0;
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/*
+ * Deterministic pseudo-random generator (xorshift32).
+ */
+static uint32_t i_random_state = 2463534242UL;
+
+void randomSeed(unsigned long seed) {
+  if(seed != 0) {
+    i_random_state = (uint32_t) seed;
+  }
+}
+
+long random(long howbig) {
+  if(howbig <= 0) {
+    return 0;
+  }
+
+  i_random_state ^= i_random_state << 13;
+  i_random_state ^= i_random_state >> 17;
+  i_random_state ^= i_random_state << 5;
+
+  return (long) (i_random_state % (uint32_t) howbig);
+}
+
+long random(long howsmall, long howbig) {
+  if(howsmall >= howbig) {
+    return howsmall;
+  }
+
+  return random(howbig - howsmall) + howsmall;
+}
+
+namespace native {
+  void advanceMicros(uint64_t i_us) {
+    i_clock_us += i_us;
+  }
+
+  uint64_t elapsedMicros() {
+    return i_clock_us;
+  }
+
+  uint64_t delayedMicros() {
+    return i_delayed_us;
+  }
+
+  void setPin(uint8_t pin, uint8_t val) {
+    if(pin < NATIVE_NUM_PINS) {
+      b_pin_low[pin] = (val == LOW);
+    }
+  }
+
+  int getPin(uint8_t pin) {
+    if(pin < NATIVE_NUM_PINS) {
+      return i_pin_analog_out[pin];
+    }
+
+    return 0;
+  }
+
+  void setAnalog(uint8_t pin, int val) {
+    if(pin < NATIVE_NUM_PINS) {
+      i_pin_analog_in[pin] = val;
+    }
+  }
+}
+
+/*
+ * Print.
+ */
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+
+  while(size--) {
+    n += write(*buffer++);
+  }
+
+  return n;
+}
+
+size_t Print::write(const char *str) {
+  if(str == NULL) {
+    return 0;
+  }
+
+  return write((const uint8_t *) str, strlen(str));
+}
+
+size_t Print::printNumber(unsigned long n, uint8_t base) {
+  char buf[8 * sizeof(long) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+
+  *str = '\0';
+
+  if(base < 2) {
+    base = 10;
+  }
+
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while(n);
+
+  return write(str);
+}
+
+size_t Print::print(const char *str) { return write(str); }
+size_t Print::print(char c) { return write((uint8_t) c); }
+size_t Print::print(unsigned char n, int base) { return print((unsigned long) n, base); }
+size_t Print::print(int n, int base) { return print((long) n, base); }
+size_t Print::print(unsigned int n, int base) { return print((unsigned long) n, base); }
+size_t Print::print(unsigned long n, int base) { return printNumber(n, base); }
+
+size_t Print::print(long n, int base) {
+  if(base == 10 && n < 0) {
+    return write((uint8_t) '-') + printNumber((unsigned long) -n, 10);
+  }
+
+  return printNumber((unsigned long) n, base);
+}
+
+size_t Print::print(double n, int digits) {
+  char buf[32];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return write(buf);
+}
+
+size_t Print::println() { return write("\r\n"); }
+size_t Print::println(const char *str) { return print(str) + println(); }
+size_t Print::println(char c) { return print(c) + println(); }
+size_t Print::println(unsigned char n, int base) { return print(n, base) + println(); }
+size_t Print::println(int n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned int n, int base) { return print(n, base) + println(); }
+size_t Print::println(long n, int base) { return print(n, base) + println(); }
+size_t Print::println(unsigned long n, int base) { return print(n, base) + println(); }
+size_t Print::println(double n, int digits) { return print(n, digits) + println(); }
+
+/*
+ * HardwareSerial.
+ */
+HardwareSerial::HardwareSerial(const char *name) : s_name(name) {}
+
+void HardwareSerial::begin(unsigned long baud) {
+  i_baud = baud;
+
+  if(attached()) {
+    // Anything still queued was written at the previous rate.
+    pump();
+    applyBaud();
+    printf("%s: %lu baud at %.3f s\n", s_name, baud, (double) native::elapsedMicros() / 1000000.0);
+    fflush(stdout);
+  }
+}
+
+void HardwareSerial::end() {
+  i_baud = 0;
+}
+
+int HardwareSerial::available() {
+  return (int) i_rx_count;
+}
+
+int HardwareSerial::read() {
+  if(i_rx_count == 0) {
+    return -1;
+  }
+
+  uint8_t c = rx_buffer[i_rx_head];
+  i_rx_head = (i_rx_head + 1) % BUFFER_SIZE;
+  i_rx_count--;
+  i_rx_total++;
+
+  return c;
+}
+
+int HardwareSerial::peek() {
+  if(i_rx_count == 0) {
+    return -1;
+  }
+
+  return rx_buffer[i_rx_head];
+}
+
+int HardwareSerial::availableForWrite() {
+  return (int) (BUFFER_SIZE - i_tx_count);
+}
+
+void HardwareSerial::flush() {
+  // Transmission is instant on the host, so only an attached device has anything to wait for.
+  if(attached()) {
+    pump();
+    tcdrain(i_fd);
+  }
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+  i_tx_total++;
+
+  if(b_echo_stdout) {
+    fputc(c, stdout);
+    return 1;
+  }
+
+  if(i_tx_count == BUFFER_SIZE) {
+    // Nobody is draining this port; drop the oldest byte as a real UART would overrun.
+    i_tx_head = (i_tx_head + 1) % BUFFER_SIZE;
+    i_tx_count--;
+  }
+
+  tx_buffer[(i_tx_head + i_tx_count) % BUFFER_SIZE] = c;
+  i_tx_count++;
+
+  return 1;
+}
+
+void HardwareSerial::inject(const uint8_t *data, size_t len) {
+  for(size_t i = 0; i < len && i_rx_count < BUFFER_SIZE; i++) {
+    rx_buffer[(i_rx_head + i_rx_count) % BUFFER_SIZE] = data[i];
+    i_rx_count++;
+  }
+}
+
+size_t HardwareSerial::drain(uint8_t *data, size_t i_max) {
+  size_t n = 0;
+
+  while(n < i_max && i_tx_count > 0) {
+    data[n++] = tx_buffer[i_tx_head];
+    i_tx_head = (i_tx_head + 1) % BUFFER_SIZE;
+    i_tx_count--;
+  }
+
+  return n;
+}
+
+size_t HardwareSerial::pending() const {
+  return i_tx_count;
+}
+
+bool HardwareSerial::attach(const char *path) {
+  i_fd = open(path, O_RDWR | O_NOCTTY | O_NONBLOCK);
+
+  if(i_fd < 0) {
+    return false;
+  }
+
+  struct termios tio;
+
+  if(tcgetattr(i_fd, &tio) == 0) {
+    cfmakeraw(&tio);
+    tcsetattr(i_fd, TCSANOW, &tio);
+  }
+
+  applyBaud();
+
+  return true;
+}
+
+void HardwareSerial::applyBaud() {
+  struct termios tio;
+  speed_t speed;
+
+  switch(i_baud) {
+    case 19200: speed = B19200; break;
+    case 38400: speed = B38400; break;
+    case 57600: speed = B57600; break;
+    case 115200: speed = B115200; break;
+    case 230400: speed = B230400; break;
+    default: speed = B9600; break;
+  }
+
+  if(tcgetattr(i_fd, &tio) == 0) {
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    tcsetattr(i_fd, TCSANOW, &tio);
+  }
+}
+
+void HardwareSerial::pump() {
+  uint8_t buffer[256];
+  ssize_t n;
+
+  while(i_tx_count > 0) {
+    size_t len = drain(buffer, sizeof(buffer));
+    size_t sent = 0;
+
+    while(sent < len && (n = ::write(i_fd, buffer + sent, len - sent)) > 0) {
+      sent += (size_t) n;
+    }
+
+    if(sent < len) {
+      // The peer is not reading; discard the rest as a disconnected line would.
+      break;
+    }
+  }
+
+  while((n = ::read(i_fd, buffer, sizeof(buffer))) > 0) {
+    inject(buffer, (size_t) n);
+  }
+}
+
+HardwareSerial Serial("Serial");
+HardwareSerial Serial1("Serial1");
+HardwareSerial Serial2("Serial2");
+HardwareSerial Serial3("Serial3");
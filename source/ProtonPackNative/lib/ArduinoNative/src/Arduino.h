@@ -0,0 +1,182 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+/*
+ * Host-native replacement for the Arduino AVR core.
+ * Only the parts of the core used by the GPStar firmware are provided. All time-keeping
+ * is driven by a virtual clock which only moves when the harness (or a blocking call
+ * such as delay()) advances it, so a sketch can run many times faster than real time.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#include "binary.h"
+
+typedef uint8_t byte;
+typedef bool boolean;
+typedef uint16_t word;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+
+#define PI 3.1415926535897932384626433832795
+
+// Flash memory does not exist on the host, so PROGMEM data is ordinary read-only data.
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+#define pgm_read_byte_near(addr) pgm_read_byte(addr)
+#define pgm_read_word_near(addr) pgm_read_word(addr)
+#define pgm_read_dword_near(addr) pgm_read_dword(addr)
+#define memcpy_P memcpy
+#define strcpy_P strcpy
+
+#define lowByte(w) ((uint8_t) ((w) & 0xff))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+#define bitWrite(value, bit, bitvalue) ((bitvalue) ? bitSet(value, bit) : bitClear(value, bit))
+#define bit(b) (1UL << (b))
+
+#define interrupts()
+#define noInterrupts()
+#define cli()
+#define sei()
+
+template<class T, class L>
+auto min(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+  return (b < a) ? b : a;
+}
+
+template<class T, class L>
+auto max(const T& a, const L& b) -> decltype((b < a) ? b : a) {
+  return (a < b) ? b : a;
+}
+
+template<class T, class L, class H>
+T constrain(const T& x, const L& low, const H& high) {
+  return (x < low) ? low : ((x > high) ? high : x);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max);
+
+/*
+ * Timer and port registers written directly by the firmware (eg. PWM prescalers).
+ * These are plain bytes on the host and have no effect.
+ */
+extern volatile uint8_t TCCR1B;
+extern volatile uint8_t TCCR2B;
+extern volatile uint8_t TCCR3B;
+extern volatile uint8_t TCCR4B;
+extern volatile uint8_t TCCR5B;
+
+/*
+ * ADC registers, used by the pack to measure its own Vcc against the internal bandgap.
+ * A conversion completes instantly and ADC reads back as a 5.0V supply unless changed.
+ */
+#define _BV(b) (1 << (b))
+#define MUX0 0
+#define MUX1 1
+#define MUX2 2
+#define MUX3 3
+#define MUX4 4
+#define ADLAR 5
+#define REFS0 6
+#define REFS1 7
+#define MUX5 3
+#define ADSC 6
+
+struct NativeADCSRA {
+  uint8_t value;
+
+  NativeADCSRA &operator|=(uint8_t v) { value |= (v & ~_BV(ADSC)); return *this; }
+  NativeADCSRA &operator&=(uint8_t v) { value &= v; return *this; }
+  NativeADCSRA &operator=(uint8_t v) { value = (v & ~_BV(ADSC)); return *this; }
+  operator uint8_t() const { return value; }
+};
+
+extern volatile uint8_t ADMUX;
+extern NativeADCSRA ADCSRA;
+extern volatile uint16_t ADC;
+
+/*
+ * Time functions, all backed by the virtual clock.
+ */
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+/*
+ * Digital and analog I/O, backed by a virtual pin table.
+ * Unwritten pins read as HIGH, which matches an input with the pull-up enabled.
+ */
+#define NATIVE_NUM_PINS 100
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+int analogRead(uint8_t pin);
+
+/*
+ * Pseudo-random numbers. The generator is deterministic for a given seed so that
+ * two native runs with the same inputs produce the same output.
+ */
+void randomSeed(unsigned long seed);
+long random(long howbig);
+long random(long howsmall, long howbig);
+
+#include "HardwareSerial.h"
+
+/*
+ * Native-only controls used by the harness to drive the virtual hardware.
+ */
+namespace native {
+  // Advance the virtual clock by the given number of microseconds.
+  void advanceMicros(uint64_t i_us);
+
+  // Total virtual time elapsed since the start of the run.
+  uint64_t elapsedMicros();
+
+  // Total virtual time spent inside blocking delay() and delayMicroseconds() calls.
+  uint64_t delayedMicros();
+
+  // Force the level seen by digitalRead() on an input pin, eg. a toggle switch.
+  void setPin(uint8_t pin, uint8_t val);
+
+  // Last value written by digitalWrite() or analogWrite().
+  int getPin(uint8_t pin);
+
+  // Set the value returned by analogRead() for a pin.
+  void setAnalog(uint8_t pin, int val);
+}
@@ -0,0 +1,71 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * CRC32 (bakercp/CRC32) replacement with the same API and the same polynomial.
+ */
+#include "Arduino.h"
+
+class CRC32 {
+  public:
+    CRC32() { reset(); }
+
+    void reset() { _state = 0xFFFFFFFF; }
+
+    void update(uint8_t data) {
+      uint8_t tbl_idx = _state ^ (data >> (0 * 4));
+      _state = pgm_read_dword(crc32_table + (tbl_idx & 0x0f)) ^ (_state >> 4);
+      tbl_idx = _state ^ (data >> (1 * 4));
+      _state = pgm_read_dword(crc32_table + (tbl_idx & 0x0f)) ^ (_state >> 4);
+    }
+
+    template <typename Type> void update(const Type& data) {
+      update(&data, 1);
+    }
+
+    template <typename Type> void update(const Type* data, size_t size) {
+      size_t nBytes = size * sizeof(Type);
+      const uint8_t* pData = (const uint8_t*) data;
+
+      for(size_t i = 0; i < nBytes; i++) {
+        update(pData[i]);
+      }
+    }
+
+    uint32_t finalize() const { return ~_state; }
+
+    template <typename Type> static uint32_t calculate(const Type* data, size_t size) {
+      CRC32 crc;
+      crc.update(data, size);
+      return crc.finalize();
+    }
+
+  private:
+    uint32_t _state = 0xFFFFFFFF;
+
+    static constexpr uint32_t crc32_table[16] = {
+      0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+      0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+      0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+      0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c
+    };
+};
@@ -0,0 +1,82 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * EEPROM replacement sized to match the ATmega2560 (4KB).
+ * The contents start erased (0xFF) and can be loaded from or saved to a host file by the harness.
+ */
+#include "Arduino.h"
+
+#define NATIVE_EEPROM_SIZE 4096
+
+struct EERef {
+  EERef(const int index) : index(index) {}
+
+  uint8_t operator*() const;
+  operator uint8_t() const { return **this; }
+  EERef &operator=(uint8_t in);
+  EERef &operator=(const EERef &ref) { return *this = *ref; }
+  EERef &update(uint8_t in) { return in != *this ? *this = in : *this; }
+
+  int index;
+};
+
+class EEPROMClass {
+  public:
+    uint8_t read(int idx) { return EERef(idx); }
+    void write(int idx, uint8_t val) { (EERef(idx)) = val; }
+    void update(int idx, uint8_t val) { EERef(idx).update(val); }
+    EERef operator[](const int idx) { return idx; }
+    uint16_t length() { return NATIVE_EEPROM_SIZE; }
+
+    template<typename T> T &get(int idx, T &t) {
+      uint8_t *ptr = (uint8_t*) &t;
+
+      for(int count = sizeof(T); count; --count, ++idx) {
+        *ptr++ = read(idx);
+      }
+
+      return t;
+    }
+
+    template<typename T> const T &put(int idx, const T &t) {
+      const uint8_t *ptr = (const uint8_t*) &t;
+
+      for(int count = sizeof(T); count; --count, ++idx) {
+        update(idx, *ptr++);
+      }
+
+      return t;
+    }
+
+    // Native-only: direct access to the backing store and its write counter.
+    uint8_t *data();
+    unsigned long writes() const;
+};
+
+extern EEPROMClass EEPROM;
+
+namespace native {
+  // Load or save the virtual EEPROM from/to a host file. Returns false on I/O errors.
+  bool loadEEPROM(const char *s_path);
+  bool saveEEPROM(const char *s_path);
+}
@@ -0,0 +1,228 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "FastLED.h"
+
+CFastLED FastLED;
+
+// Same algorithm as FastLED's hsv2rgb_rainbow() with the default yellow boost.
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb) {
+  uint8_t hue = hsv.hue;
+  uint8_t sat = hsv.sat;
+  uint8_t val = hsv.val;
+
+  uint8_t offset = hue & 0x1F;
+  uint8_t offset8 = offset << 3;
+  uint8_t third = scale8(offset8, (256 / 3));
+  uint8_t twothirds = scale8(offset8, ((256 * 2) / 3));
+  uint8_t r, g, b;
+
+  if(!(hue & 0x80)) {
+    if(!(hue & 0x40)) {
+      if(!(hue & 0x20)) {
+        // Red to orange.
+        r = 255 - third;
+        g = third;
+        b = 0;
+      }
+      else {
+        // Orange to yellow.
+        r = 171;
+        g = 85 + third;
+        b = 0;
+      }
+    }
+    else {
+      if(!(hue & 0x20)) {
+        // Yellow to green.
+        r = 171 - twothirds;
+        g = 170 + third;
+        b = 0;
+      }
+      else {
+        // Green to aqua.
+        r = 0;
+        g = 255 - third;
+        b = third;
+      }
+    }
+  }
+  else {
+    if(!(hue & 0x40)) {
+      if(!(hue & 0x20)) {
+        // Aqua to blue.
+        r = 0;
+        g = 171 - twothirds;
+        b = 85 + twothirds;
+      }
+      else {
+        // Blue to purple.
+        r = third;
+        g = 0;
+        b = 255 - third;
+      }
+    }
+    else {
+      if(!(hue & 0x20)) {
+        // Purple to pink.
+        r = 85 + third;
+        g = 0;
+        b = 171 - third;
+      }
+      else {
+        // Pink to red.
+        r = 170 + third;
+        g = 0;
+        b = 85 - third;
+      }
+    }
+  }
+
+  if(sat != 255) {
+    if(sat == 0) {
+      r = 255;
+      g = 255;
+      b = 255;
+    }
+    else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+
+      r = scale8(r, satscale) + desat;
+      g = scale8(g, satscale) + desat;
+      b = scale8(b, satscale) + desat;
+    }
+  }
+
+  if(val != 255) {
+    val = scale8_video(val, val);
+
+    if(val == 0) {
+      r = 0;
+      g = 0;
+      b = 0;
+    }
+    else {
+      r = scale8(r, val);
+      g = scale8(g, val);
+      b = scale8(b, val);
+    }
+  }
+
+  rgb.r = r;
+  rgb.g = g;
+  rgb.b = b;
+}
+
+CRGB &nblend(CRGB &existing, const CRGB &overlay, fract8 amountOfOverlay) {
+  if(amountOfOverlay == 0) {
+    return existing;
+  }
+
+  if(amountOfOverlay == 255) {
+    existing = overlay;
+    return existing;
+  }
+
+  fract8 amountOfKeep = 255 - amountOfOverlay;
+
+  existing.r = scale8(existing.r, amountOfKeep) + scale8(overlay.r, amountOfOverlay);
+  existing.g = scale8(existing.g, amountOfKeep) + scale8(overlay.g, amountOfOverlay);
+  existing.b = scale8(existing.b, amountOfKeep) + scale8(overlay.b, amountOfOverlay);
+
+  return existing;
+}
+
+CRGB blend(const CRGB &p1, const CRGB &p2, fract8 amountOfP2) {
+  CRGB nu(p1);
+  nblend(nu, p2, amountOfP2);
+  return nu;
+}
+
+void fill_solid(CRGB *leds, int numToFill, const CRGB &color) {
+  for(int i = 0; i < numToFill; i++) {
+    leds[i] = color;
+  }
+}
+
+void fill_rainbow(CRGB *leds, int numToFill, uint8_t initialhue, uint8_t deltahue) {
+  CHSV hsv(initialhue, 240, 255);
+
+  for(int i = 0; i < numToFill; i++) {
+    leds[i] = hsv;
+    hsv.hue += deltahue;
+  }
+}
+
+void fadeToBlackBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy) {
+  nscale8(leds, num_leds, 255 - fadeBy);
+}
+
+void nscale8(CRGB *leds, uint16_t num_leds, uint8_t scale) {
+  for(uint16_t i = 0; i < num_leds; i++) {
+    leds[i].nscale8(scale);
+  }
+}
+
+void CLEDController::init(CRGB *data, int nLeds, uint8_t i_pin) {
+  m_Data = data;
+  m_nLeds = nLeds;
+  i_data_pin = i_pin;
+}
+
+void CLEDController::showLeds(uint8_t brightness) {
+  (void) brightness;
+
+  // Interrupts are off for the whole transmission, so the sketch loses this time outright.
+  uint64_t i_cost = (uint64_t) m_nLeds * FastLED.microsPerLed();
+
+  native::advanceMicros(i_cost);
+  i_busy_us += i_cost;
+  i_frames++;
+}
+
+CLEDController &CFastLED::addController(CRGB *data, int nLeds, uint8_t i_pin) {
+  if(i_controllers >= MAX_CONTROLLERS) {
+    return controllers[MAX_CONTROLLERS - 1];
+  }
+
+  controllers[i_controllers].init(data, nLeds, i_pin);
+
+  return controllers[i_controllers++];
+}
+
+void CFastLED::show(uint8_t scale) {
+  i_shows++;
+
+  for(int i = 0; i < i_controllers; i++) {
+    controllers[i].showLeds(scale);
+  }
+}
+
+void CFastLED::clear(bool writeData) {
+  for(int i = 0; i < i_controllers; i++) {
+    fill_solid(controllers[i].leds(), controllers[i].size(), CRGB(0, 0, 0));
+  }
+
+  if(writeData) {
+    show(0);
+  }
+}
@@ -0,0 +1,246 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * FastLED replacement. Pixel buffers, colour conversion and the lib8tion helpers behave as
+ * on the device; show() does not drive any pins but charges the virtual clock for the
+ * time the WS281x transmission would have kept interrupts disabled (~30us per LED).
+ */
+#include "Arduino.h"
+
+typedef uint8_t fract8;
+
+inline uint8_t scale8(uint8_t i, fract8 scale) {
+  return (uint8_t) (((uint16_t) i * (1 + (uint16_t) scale)) >> 8);
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {
+  return (uint8_t) ((((int) i * (int) scale) >> 8) + ((i && scale) ? 1 : 0));
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+  unsigned int t = i + j;
+  return t > 255 ? 255 : (uint8_t) t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j) {
+  int t = i - j;
+  return t < 0 ? 0 : (uint8_t) t;
+}
+
+inline uint8_t lerp8by8(uint8_t a, uint8_t b, fract8 frac) {
+  if(b > a) {
+    return a + scale8(b - a, frac);
+  }
+
+  return a - scale8(a - b, frac);
+}
+
+inline uint8_t random8() { return (uint8_t) random(256); }
+inline uint8_t random8(uint8_t lim) { return (uint8_t) random(lim); }
+inline uint8_t random8(uint8_t min, uint8_t lim) { return (uint8_t) random(min, lim); }
+inline uint16_t random16() { return (uint16_t) random(65536); }
+inline uint16_t random16(uint16_t lim) { return (uint16_t) random(lim); }
+
+struct CHSV {
+  union {
+    struct {
+      union { uint8_t hue; uint8_t h; };
+      union { uint8_t saturation; uint8_t sat; uint8_t s; };
+      union { uint8_t value; uint8_t val; uint8_t v; };
+    };
+    uint8_t raw[3];
+  };
+
+  CHSV() = default;
+  constexpr CHSV(uint8_t ih, uint8_t is, uint8_t iv) : h(ih), s(is), v(iv) {}
+  uint8_t &operator[](uint8_t x) { return raw[x]; }
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV &hsv, CRGB &rgb);
+
+struct CRGB {
+  union {
+    struct {
+      union { uint8_t r; uint8_t red; };
+      union { uint8_t g; uint8_t green; };
+      union { uint8_t b; uint8_t blue; };
+    };
+    uint8_t raw[3];
+  };
+
+  CRGB() = default;
+  constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  constexpr CRGB(uint32_t colorcode) : r((colorcode >> 16) & 0xFF), g((colorcode >> 8) & 0xFF), b(colorcode & 0xFF) {}
+  CRGB(const CHSV &rhs) { hsv2rgb_rainbow(rhs, *this); }
+
+  CRGB &operator=(const CHSV &rhs) { hsv2rgb_rainbow(rhs, *this); return *this; }
+  CRGB &operator=(uint32_t colorcode) { r = (colorcode >> 16) & 0xFF; g = (colorcode >> 8) & 0xFF; b = colorcode & 0xFF; return *this; }
+  uint8_t &operator[](uint8_t x) { return raw[x]; }
+  const uint8_t &operator[](uint8_t x) const { return raw[x]; }
+
+  CRGB &setRGB(uint8_t nr, uint8_t ng, uint8_t nb) { r = nr; g = ng; b = nb; return *this; }
+  CRGB &setHSV(uint8_t hue, uint8_t sat, uint8_t val) { hsv2rgb_rainbow(CHSV(hue, sat, val), *this); return *this; }
+  CRGB &setHue(uint8_t hue) { return setHSV(hue, 255, 255); }
+
+  CRGB &nscale8(uint8_t scaledown) {
+    r = scale8(r, scaledown);
+    g = scale8(g, scaledown);
+    b = scale8(b, scaledown);
+    return *this;
+  }
+
+  CRGB &nscale8_video(uint8_t scaledown) {
+    r = scale8_video(r, scaledown);
+    g = scale8_video(g, scaledown);
+    b = scale8_video(b, scaledown);
+    return *this;
+  }
+
+  CRGB &fadeToBlackBy(uint8_t fadefactor) { return nscale8(255 - fadefactor); }
+  CRGB &fadeLightBy(uint8_t fadefactor) { return nscale8_video(255 - fadefactor); }
+
+  CRGB &maximizeBrightness(uint8_t limit = 255) {
+    uint8_t max = r;
+    if(g > max) max = g;
+    if(b > max) max = b;
+
+    if(max == 0) {
+      return *this;
+    }
+
+    uint16_t factor = ((uint16_t) (limit) * 256) / max;
+    r = (r * factor) / 256;
+    g = (g * factor) / 256;
+    b = (b * factor) / 256;
+    return *this;
+  }
+
+  CRGB &operator+=(const CRGB &rhs) { r = qadd8(r, rhs.r); g = qadd8(g, rhs.g); b = qadd8(b, rhs.b); return *this; }
+  CRGB &operator-=(const CRGB &rhs) { r = qsub8(r, rhs.r); g = qsub8(g, rhs.g); b = qsub8(b, rhs.b); return *this; }
+  CRGB &operator%=(uint8_t scaledown) { return nscale8_video(scaledown); }
+  explicit operator bool() const { return r || g || b; }
+
+  enum HTMLColorCode {
+    Black = 0x000000,
+    White = 0xFFFFFF,
+    Red = 0xFF0000,
+    Green = 0x008000,
+    Blue = 0x0000FF,
+    Yellow = 0xFFFF00,
+    Orange = 0xFFA500,
+    Purple = 0x800080,
+    Pink = 0xFFC0CB
+  };
+};
+
+inline bool operator==(const CRGB &lhs, const CRGB &rhs) { return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b; }
+inline bool operator!=(const CRGB &lhs, const CRGB &rhs) { return !(lhs == rhs); }
+
+CRGB &nblend(CRGB &existing, const CRGB &overlay, fract8 amountOfOverlay);
+CRGB blend(const CRGB &p1, const CRGB &p2, fract8 amountOfP2);
+void fill_solid(CRGB *leds, int numToFill, const CRGB &color);
+void fill_rainbow(CRGB *leds, int numToFill, uint8_t initialhue, uint8_t deltahue = 5);
+void fadeToBlackBy(CRGB *leds, uint16_t num_leds, uint8_t fadeBy);
+void nscale8(CRGB *leds, uint16_t num_leds, uint8_t scale);
+
+/*
+ * Colour orders and chipsets. Only the type names matter on the host.
+ */
+enum EOrder { RGB = 0012, RBG = 0021, GRB = 0102, GBR = 0120, BRG = 0201, BGR = 0210 };
+
+template<uint8_t DATA_PIN> class NEOPIXEL {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class WS2811 {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class WS2812 {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class WS2812B {};
+template<uint8_t DATA_PIN, EOrder RGB_ORDER = GRB> class SK6812 {};
+
+/*
+ * One chain of LEDs attached to a data pin.
+ */
+class CLEDController {
+  public:
+    void init(CRGB *data, int nLeds, uint8_t i_pin);
+
+    CLEDController &setLeds(CRGB *data, int nLeds) { m_Data = data; m_nLeds = nLeds; return *this; }
+    CRGB *leds() { return m_Data; }
+    int size() const { return m_nLeds; }
+    uint8_t pin() const { return i_data_pin; }
+
+    // Push this controller's buffer out to the LEDs.
+    void showLeds(uint8_t brightness = 255);
+
+    // Native-only: number of times this chain has been written and the virtual time spent doing so.
+    unsigned long frames() const { return i_frames; }
+    uint64_t busyMicros() const { return i_busy_us; }
+
+  private:
+    CRGB *m_Data = NULL;
+    int m_nLeds = 0;
+    uint8_t i_data_pin = 0;
+    unsigned long i_frames = 0;
+    uint64_t i_busy_us = 0;
+};
+
+class CFastLED {
+  public:
+    static const uint8_t MAX_CONTROLLERS = 8;
+
+    template<template<uint8_t DATA_PIN> class CHIPSET, uint8_t DATA_PIN>
+    CLEDController &addLeds(CRGB *data, int nLeds) {
+      return addController(data, nLeds, DATA_PIN);
+    }
+
+    template<template<uint8_t DATA_PIN, EOrder RGB_ORDER> class CHIPSET, uint8_t DATA_PIN, EOrder RGB_ORDER = GRB>
+    CLEDController &addLeds(CRGB *data, int nLeds) {
+      return addController(data, nLeds, DATA_PIN);
+    }
+
+    void show() { show(m_Scale); }
+    void show(uint8_t scale);
+    void clear(bool writeData = false);
+    void setBrightness(uint8_t scale) { m_Scale = scale; }
+    uint8_t getBrightness() const { return m_Scale; }
+    void setDither(uint8_t ditherMode = 1) { (void) ditherMode; }
+    void setMaxPowerInVoltsAndMilliamps(uint8_t volts, uint32_t milliamps) { (void) volts; (void) milliamps; }
+    int count() const { return i_controllers; }
+    CLEDController &operator[](int x) { return controllers[x < i_controllers ? x : 0]; }
+
+    // Native-only: cost charged to the virtual clock per LED written by show().
+    void setMicrosPerLed(uint16_t i_us) { i_us_per_led = i_us; }
+    uint16_t microsPerLed() const { return i_us_per_led; }
+
+    // Native-only: number of show() calls.
+    unsigned long shows() const { return i_shows; }
+
+  private:
+    CLEDController &addController(CRGB *data, int nLeds, uint8_t i_pin);
+
+    CLEDController controllers[MAX_CONTROLLERS];
+    int i_controllers = 0;
+    uint8_t m_Scale = 255;
+    uint16_t i_us_per_led = 30;
+    unsigned long i_shows = 0;
+};
+
+extern CFastLED FastLED;
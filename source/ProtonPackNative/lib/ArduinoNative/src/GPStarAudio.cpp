@@ -0,0 +1,301 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "GPStarAudio.h"
+
+// Command codes from the WAV Trigger/GPStar Audio serial protocol.
+#define CMD_GET_VERSION 0x01
+#define CMD_GET_SYS_INFO 0x02
+#define CMD_TRACK_CONTROL 0x03
+#define CMD_STOP_ALL 0x04
+#define CMD_MASTER_VOLUME 0x05
+#define CMD_TRACK_VOLUME 0x08
+#define CMD_AMP_POWER 0x09
+#define CMD_TRACK_FADE 0x0A
+#define CMD_RESUME_ALL_SYNC 0x0B
+#define CMD_SAMPLERATE_OFFSET 0x0C
+#define CMD_SET_REPORTING 0x0D
+#define CMD_TRACK_CONTROL_EX 0x0E
+#define CMD_GPSTAR_HELLO 0x73
+
+#define TRK_PLAY_SOLO 0x00
+#define TRK_PLAY_POLY 0x01
+#define TRK_PAUSE 0x02
+#define TRK_RESUME 0x03
+#define TRK_STOP 0x04
+#define TRK_LOOP_ON 0x05
+#define TRK_LOOP_OFF 0x06
+#define TRK_LOAD 0x07
+
+#define SOM1 0xF0
+#define SOM2 0xAA
+#define EOM 0x55
+
+void gpstarAudio::start(Stream &_port) {
+  port = &_port;
+}
+
+void gpstarAudio::send(uint8_t i_cmd, const uint8_t *data, uint8_t len) {
+  uint8_t frame[16];
+  uint8_t n = 0;
+
+  frame[n++] = SOM1;
+  frame[n++] = SOM2;
+  frame[n++] = len + 5;
+  frame[n++] = i_cmd;
+
+  for(uint8_t i = 0; i < len && n < sizeof(frame) - 1; i++) {
+    frame[n++] = data[i];
+  }
+
+  frame[n++] = EOM;
+
+  if(port != NULL) {
+    port->write(frame, n);
+  }
+
+  stats.commands++;
+  stats.bytes += n;
+}
+
+void gpstarAudio::update() {
+  // Replies would be parsed here; the modelled board answers immediately instead.
+}
+
+void gpstarAudio::hello() {
+  b_hello_requested = true;
+  send(CMD_GPSTAR_HELLO, NULL, 0);
+}
+
+bool gpstarAudio::gpstarAudioHello() {
+  return b_hello_requested && native_board == BOARD_GPSTAR_AUDIO;
+}
+
+void gpstarAudio::requestVersionString() {
+  b_version_requested = true;
+  send(CMD_GET_VERSION, NULL, 0);
+}
+
+void gpstarAudio::requestSystemInfo() {
+  b_sysinfo_requested = true;
+  send(CMD_GET_SYS_INFO, NULL, 0);
+}
+
+bool gpstarAudio::getVersion(char *pDst) {
+  if(b_version_requested && native_board == BOARD_WAV_TRIGGER) {
+    strncpy(pDst, "WAV Trigger native", VERSION_STRING_LEN);
+    pDst[VERSION_STRING_LEN - 1] = '\0';
+    return true;
+  }
+
+  return false;
+}
+
+bool gpstarAudio::wasSysInfoRcvd() {
+  return b_sysinfo_requested && native_board != BOARD_NONE;
+}
+
+int gpstarAudio::getNumTracks() {
+  return i_num_tracks;
+}
+
+void gpstarAudio::setReporting(bool b_enable) {
+  uint8_t data[1] = { (uint8_t) b_enable };
+  send(CMD_SET_REPORTING, data, 1);
+}
+
+void gpstarAudio::setAmpPwr(bool b_enable) {
+  uint8_t data[1] = { (uint8_t) b_enable };
+  send(CMD_AMP_POWER, data, 1);
+}
+
+void gpstarAudio::samplerateOffset(int offset) {
+  uint8_t data[2] = { (uint8_t) offset, (uint8_t) (offset >> 8) };
+  send(CMD_SAMPLERATE_OFFSET, data, 2);
+}
+
+void gpstarAudio::masterGain(int gain) {
+  uint8_t data[2] = { (uint8_t) gain, (uint8_t) (gain >> 8) };
+  send(CMD_MASTER_VOLUME, data, 2);
+}
+
+void gpstarAudio::stopAllTracks() {
+  send(CMD_STOP_ALL, NULL, 0);
+
+  for(int i = 0; i < NATIVE_AUDIO_MAX_TRACKS; i++) {
+    tracks[i].playing = false;
+  }
+}
+
+void gpstarAudio::resumeAllInSync() {
+  send(CMD_RESUME_ALL_SYNC, NULL, 0);
+}
+
+void gpstarAudio::trackControl(int trk, uint8_t code, bool lock) {
+  if(lock) {
+    uint8_t data[4] = { code, (uint8_t) trk, (uint8_t) (trk >> 8), 1 };
+    send(CMD_TRACK_CONTROL_EX, data, 4);
+  }
+  else {
+    uint8_t data[3] = { code, (uint8_t) trk, (uint8_t) (trk >> 8) };
+    send(CMD_TRACK_CONTROL, data, 3);
+  }
+}
+
+void gpstarAudio::trackPlaySolo(int trk, bool lock) {
+  for(int i = 0; i < NATIVE_AUDIO_MAX_TRACKS; i++) {
+    tracks[i].playing = false;
+  }
+
+  trackPlayPoly(trk, lock);
+}
+
+void gpstarAudio::trackPlayPoly(int trk, bool lock) {
+  trackControl(trk, TRK_PLAY_POLY, lock);
+  stats.plays++;
+
+  if(valid(trk)) {
+    tracks[trk].playing = true;
+    tracks[trk].paused = false;
+    tracks[trk].started = millis();
+    tracks[trk].length = track_lengths[trk] > 0 ? track_lengths[trk] : i_default_length_ms;
+  }
+}
+
+void gpstarAudio::trackLoad(int trk, bool lock) {
+  trackControl(trk, TRK_LOAD, lock);
+}
+
+void gpstarAudio::trackStop(int trk) {
+  trackControl(trk, TRK_STOP);
+  stats.stops++;
+
+  if(valid(trk)) {
+    expire(trk);
+
+    if(!tracks[trk].playing) {
+      stats.stopsIdle++;
+    }
+
+    tracks[trk].playing = false;
+  }
+}
+
+void gpstarAudio::trackPause(int trk) {
+  trackControl(trk, TRK_PAUSE);
+
+  if(valid(trk)) {
+    tracks[trk].paused = true;
+  }
+}
+
+void gpstarAudio::trackResume(int trk) {
+  trackControl(trk, TRK_RESUME);
+
+  if(valid(trk)) {
+    tracks[trk].paused = false;
+  }
+}
+
+void gpstarAudio::trackLoop(int trk, bool enable) {
+  trackControl(trk, enable ? TRK_LOOP_ON : TRK_LOOP_OFF);
+  stats.loops++;
+
+  if(valid(trk)) {
+    tracks[trk].looping = enable;
+  }
+}
+
+void gpstarAudio::trackGain(int trk, int gain) {
+  uint8_t data[4] = { (uint8_t) trk, (uint8_t) (trk >> 8), (uint8_t) gain, (uint8_t) (gain >> 8) };
+  send(CMD_TRACK_VOLUME, data, 4);
+  stats.gains++;
+}
+
+void gpstarAudio::trackFade(int trk, int gain, int time, bool stopFlag) {
+  uint8_t data[7] = { (uint8_t) trk, (uint8_t) (trk >> 8), (uint8_t) gain, (uint8_t) (gain >> 8), (uint8_t) time, (uint8_t) (time >> 8), (uint8_t) stopFlag };
+  send(CMD_TRACK_FADE, data, 7);
+  stats.fades++;
+
+  if(stopFlag && valid(trk) && tracks[trk].playing) {
+    // The board stops the track when the fade completes.
+    unsigned long i_elapsed = millis() - tracks[trk].started;
+    tracks[trk].looping = false;
+    tracks[trk].length = i_elapsed + (unsigned long) time;
+  }
+}
+
+void gpstarAudio::expire(int trk) {
+  TrackState &t = tracks[trk];
+
+  if(t.playing && !t.looping && !t.paused && (millis() - t.started) >= t.length) {
+    t.playing = false;
+  }
+}
+
+bool gpstarAudio::isTrackPlaying(int trk) {
+  if(!valid(trk)) {
+    return false;
+  }
+
+  expire(trk);
+
+  return tracks[trk].playing;
+}
+
+bool gpstarAudio::currentTrackStatus(int trk) {
+  return isTrackPlaying(trk);
+}
+
+void gpstarAudio::trackPlayingStatus(int trk) {
+  uint8_t data[2] = { (uint8_t) trk, (uint8_t) (trk >> 8) };
+  send(CMD_GET_SYS_INFO, data, 2);
+  stats.statusRequests++;
+
+  // The board answers with a fresh report, which clears the reset state.
+  b_counter_reset = false;
+}
+
+bool gpstarAudio::isTrackCounterReset() {
+  return b_counter_reset;
+}
+
+void gpstarAudio::resetTrackCounter(bool bReset) {
+  (void) bReset;
+  b_counter_reset = true;
+}
+
+void gpstarAudio::setNativeTrackLength(int trk, unsigned long i_ms) {
+  if(valid(trk)) {
+    track_lengths[trk] = i_ms;
+  }
+}
+
+int gpstarAudio::nativePlayingCount() {
+  int i_count = 0;
+
+  for(int i = 1; i < NATIVE_AUDIO_MAX_TRACKS; i++) {
+    if(isTrackPlaying(i)) {
+      i_count++;
+    }
+  }
+
+  return i_count;
+}
@@ -0,0 +1,124 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * GPStar Audio / WAV Trigger serial library replacement.
+ * Every command is encoded with the real wire format and written to the port passed to
+ * start(), so the UART load on the audio link can be measured. Track playback is modelled
+ * in software (per-track length, looping, stop) against the virtual clock so that status
+ * queries such as currentTrackStatus() answer like a real board would.
+ */
+#include "Arduino.h"
+
+#define VERSION_STRING_LEN 21
+#define NATIVE_AUDIO_MAX_TRACKS 4096
+
+class gpstarAudio {
+  public:
+    // Which board the harness pretends is attached.
+    enum NativeBoard { BOARD_NONE, BOARD_GPSTAR_AUDIO, BOARD_WAV_TRIGGER };
+
+    void start(Stream &port);
+    void update();
+    void flush() {}
+
+    void hello();
+    bool gpstarAudioHello();
+    void gpstarShortTrackOverload(bool b_enable) { (void) b_enable; }
+    void gpstarTrackForce(bool b_enable) { (void) b_enable; }
+    void requestVersionString();
+    void requestSystemInfo();
+    bool getVersion(char *pDst);
+    bool wasSysInfoRcvd();
+    int getNumTracks();
+    void setReporting(bool b_enable);
+    void setAmpPwr(bool b_enable);
+    void samplerateOffset(int offset);
+    void setTriggerBank(int bank) { (void) bank; }
+
+    void masterGain(int gain);
+    void stopAllTracks();
+    void resumeAllInSync();
+    void trackPlaySolo(int trk, bool lock = false);
+    void trackPlayPoly(int trk, bool lock = false);
+    void trackLoad(int trk, bool lock = false);
+    void trackStop(int trk);
+    void trackPause(int trk);
+    void trackResume(int trk);
+    void trackLoop(int trk, bool enable);
+    void trackGain(int trk, int gain);
+    void trackFade(int trk, int gain, int time, bool stopFlag);
+
+    bool isTrackPlaying(int trk);
+    bool currentTrackStatus(int trk);
+    void trackPlayingStatus(int trk);
+    bool isTrackCounterReset();
+    void resetTrackCounter(bool bReset = false);
+
+    // Native-only configuration.
+    void setNativeBoard(NativeBoard board) { native_board = board; }
+    void setNativeTrackCount(int i_tracks) { i_num_tracks = i_tracks; }
+    void setNativeDefaultLength(unsigned long i_ms) { i_default_length_ms = i_ms; }
+    void setNativeTrackLength(int trk, unsigned long i_ms);
+
+    // Native-only statistics.
+    struct NativeStats {
+      unsigned long commands;
+      unsigned long bytes;
+      unsigned long plays;
+      unsigned long stops;
+      unsigned long stopsIdle; // Stop commands for tracks that were not playing.
+      unsigned long gains;
+      unsigned long fades;
+      unsigned long loops;
+      unsigned long statusRequests;
+    };
+
+    const NativeStats &nativeStats() const { return stats; }
+    int nativePlayingCount();
+
+  private:
+    struct TrackState {
+      bool playing;
+      bool paused;
+      bool looping;
+      unsigned long started;
+      unsigned long length;
+    };
+
+    void send(uint8_t i_cmd, const uint8_t *data, uint8_t len);
+    void trackControl(int trk, uint8_t code, bool lock = false);
+    bool valid(int trk) const { return trk > 0 && trk < NATIVE_AUDIO_MAX_TRACKS; }
+    void expire(int trk);
+
+    Stream *port = NULL;
+    NativeBoard native_board = BOARD_GPSTAR_AUDIO;
+    int i_num_tracks = 0;
+    unsigned long i_default_length_ms = 2000;
+    bool b_version_requested = false;
+    bool b_sysinfo_requested = false;
+    bool b_hello_requested = false;
+    bool b_counter_reset = false;
+    TrackState tracks[NATIVE_AUDIO_MAX_TRACKS];
+    unsigned long track_lengths[NATIVE_AUDIO_MAX_TRACKS];
+    NativeStats stats = {};
+};
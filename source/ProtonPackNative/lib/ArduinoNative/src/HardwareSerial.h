@@ -0,0 +1,141 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+/*
+ * Minimal Print/Stream hierarchy matching the Arduino core.
+ */
+class Print {
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *str);
+
+    size_t print(const char *str);
+    size_t print(char c);
+    size_t print(unsigned char n, int base = DEC);
+    size_t print(int n, int base = DEC);
+    size_t print(unsigned int n, int base = DEC);
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println();
+    size_t println(const char *str);
+    size_t println(char c);
+    size_t println(unsigned char n, int base = DEC);
+    size_t println(int n, int base = DEC);
+    size_t println(unsigned int n, int base = DEC);
+    size_t println(long n, int base = DEC);
+    size_t println(unsigned long n, int base = DEC);
+    size_t println(double n, int digits = 2);
+
+  private:
+    size_t printNumber(unsigned long n, uint8_t base);
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    virtual void flush() {}
+};
+
+/*
+ * A virtual UART. Bytes written by the sketch are held in a transmit queue until the
+ * harness drains them; bytes injected by the harness are returned by read().
+ * Ports may optionally be echoed to the host stdout (used for the USB console), or attached
+ * to a host serial device such as one end of a pseudo-terminal pair.
+ */
+class HardwareSerial : public Stream {
+  public:
+    explicit HardwareSerial(const char *name);
+
+    void begin(unsigned long baud);
+    void end();
+    unsigned long baud() const { return i_baud; }
+    const char *name() const { return s_name; }
+
+    int available() override;
+    int read() override;
+    int peek() override;
+    int availableForWrite();
+    void flush() override;
+    size_t write(uint8_t c) override;
+    using Print::write;
+    operator bool() const { return true; }
+
+    // Native-only: queue bytes as if they were received on the RX pin.
+    void inject(const uint8_t *data, size_t len);
+
+    // Native-only: remove up to i_max bytes from the transmit queue, returning the count.
+    size_t drain(uint8_t *data, size_t i_max);
+
+    // Native-only: bytes waiting in the transmit queue.
+    size_t pending() const;
+
+    // Native-only: total bytes ever written and read by the sketch on this port.
+    unsigned long bytesWritten() const { return i_tx_total; }
+    unsigned long bytesRead() const { return i_rx_total; }
+
+    // Native-only: copy everything written to stdout instead of queueing it.
+    void setEcho(bool b_echo) { b_echo_stdout = b_echo; }
+
+    // Native-only: exchange bytes with a host serial device. begin() then also sets the
+    // device's line speed, so the peer on the other end can see the rate the sketch chose.
+    bool attach(const char *path);
+    bool attached() const { return i_fd >= 0; }
+
+    // Native-only: send queued bytes to the attached device and queue any bytes it received.
+    void pump();
+
+  private:
+    static const size_t BUFFER_SIZE = 4096;
+
+    const char *s_name;
+    unsigned long i_baud = 0;
+    bool b_echo_stdout = false;
+    uint8_t rx_buffer[BUFFER_SIZE];
+    uint8_t tx_buffer[BUFFER_SIZE];
+    size_t i_rx_head = 0;
+    size_t i_rx_count = 0;
+    size_t i_tx_head = 0;
+    size_t i_tx_count = 0;
+    unsigned long i_tx_total = 0;
+    unsigned long i_rx_total = 0;
+    int i_fd = -1;
+
+    void applyBaud();
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+extern HardwareSerial Serial3;
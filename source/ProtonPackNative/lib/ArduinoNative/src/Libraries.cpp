@@ -0,0 +1,168 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*
+ * Out-of-line pieces of the 3rd-party library replacements.
+ */
+#include <stdio.h>
+
+#include "EEPROM.h"
+#include "Ramp.h"
+#include "Wire.h"
+
+TwoWire Wire;
+
+/*
+ * EEPROM.
+ */
+static uint8_t eeprom_data[NATIVE_EEPROM_SIZE];
+static bool b_eeprom_init = false;
+static unsigned long i_eeprom_writes = 0;
+
+static uint8_t *eepromStore() {
+  if(!b_eeprom_init) {
+    memset(eeprom_data, 0xFF, sizeof(eeprom_data));
+    b_eeprom_init = true;
+  }
+
+  return eeprom_data;
+}
+
+uint8_t EERef::operator*() const {
+  return eepromStore()[index % NATIVE_EEPROM_SIZE];
+}
+
+EERef &EERef::operator=(uint8_t in) {
+  eepromStore()[index % NATIVE_EEPROM_SIZE] = in;
+  i_eeprom_writes++;
+  return *this;
+}
+
+EEPROMClass EEPROM;
+
+uint8_t *EEPROMClass::data() {
+  return eepromStore();
+}
+
+unsigned long EEPROMClass::writes() const {
+  return i_eeprom_writes;
+}
+
+namespace native {
+  bool loadEEPROM(const char *s_path) {
+    FILE *f = fopen(s_path, "rb");
+
+    if(f == NULL) {
+      return false;
+    }
+
+    size_t n = fread(eepromStore(), 1, NATIVE_EEPROM_SIZE, f);
+    fclose(f);
+
+    return n == NATIVE_EEPROM_SIZE;
+  }
+
+  bool saveEEPROM(const char *s_path) {
+    FILE *f = fopen(s_path, "wb");
+
+    if(f == NULL) {
+      return false;
+    }
+
+    size_t n = fwrite(eepromStore(), 1, NATIVE_EEPROM_SIZE, f);
+    fclose(f);
+
+    return n == NATIVE_EEPROM_SIZE;
+  }
+}
+
+/*
+ * Ramp easing curves (Robert Penner's equations, as used by the RAMP library).
+ */
+float rampEase(ramp_mode mode, float k) {
+  switch(mode) {
+    case NONE:
+      return 1.0f;
+    case LINEAR:
+    default:
+      return k;
+    case QUADRATIC_IN:
+      return k * k;
+    case QUADRATIC_OUT:
+      return k * (2.0f - k);
+    case QUADRATIC_INOUT:
+      return (k < 0.5f) ? 2.0f * k * k : -1.0f + (4.0f - 2.0f * k) * k;
+    case CUBIC_IN:
+      return k * k * k;
+    case CUBIC_OUT:
+      k -= 1.0f;
+      return k * k * k + 1.0f;
+    case CUBIC_INOUT:
+      return (k < 0.5f) ? 4.0f * k * k * k : (k - 1.0f) * (2.0f * k - 2.0f) * (2.0f * k - 2.0f) + 1.0f;
+    case QUARTIC_IN:
+      return k * k * k * k;
+    case QUARTIC_OUT:
+      k -= 1.0f;
+      return 1.0f - k * k * k * k;
+    case QUARTIC_INOUT:
+      if(k < 0.5f) {
+        return 8.0f * k * k * k * k;
+      }
+      k -= 1.0f;
+      return 1.0f - 8.0f * k * k * k * k;
+    case QUINTIC_IN:
+      return k * k * k * k * k;
+    case QUINTIC_OUT:
+      k -= 1.0f;
+      return 1.0f + k * k * k * k * k;
+    case QUINTIC_INOUT:
+      if(k < 0.5f) {
+        return 16.0f * k * k * k * k * k;
+      }
+      k -= 1.0f;
+      return 1.0f + 16.0f * k * k * k * k * k;
+    case SINUSOIDAL_IN:
+      return 1.0f - cosf(k * (float) PI / 2.0f);
+    case SINUSOIDAL_OUT:
+      return sinf(k * (float) PI / 2.0f);
+    case SINUSOIDAL_INOUT:
+      return 0.5f * (1.0f - cosf((float) PI * k));
+    case EXPONENTIAL_IN:
+      return (k == 0.0f) ? 0.0f : powf(1024.0f, k - 1.0f);
+    case EXPONENTIAL_OUT:
+      return (k == 1.0f) ? 1.0f : 1.0f - powf(2.0f, -10.0f * k);
+    case EXPONENTIAL_INOUT:
+      if(k == 0.0f || k == 1.0f) {
+        return k;
+      }
+      return (k < 0.5f) ? 0.5f * powf(1024.0f, 2.0f * k - 1.0f) : 0.5f * (2.0f - powf(2.0f, -10.0f * (2.0f * k - 1.0f)));
+    case CIRCULAR_IN:
+      return 1.0f - sqrtf(1.0f - k * k);
+    case CIRCULAR_OUT:
+      k -= 1.0f;
+      return sqrtf(1.0f - k * k);
+    case CIRCULAR_INOUT:
+      if(k < 0.5f) {
+        return 0.5f * (1.0f - sqrtf(1.0f - 4.0f * k * k));
+      }
+      k = 2.0f * k - 2.0f;
+      return 0.5f * (sqrtf(1.0f - k * k) + 1.0f);
+  }
+}
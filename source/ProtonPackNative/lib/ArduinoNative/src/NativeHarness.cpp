@@ -0,0 +1,448 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*
+ * Entry point for host-native builds. Runs the sketch's setup() once and then loop()
+ * repeatedly against the virtual clock, and reports loop throughput and LED frame timing.
+ *
+ * The time a loop() pass takes on the Mega 2560 cannot be known on the host, so each pass
+ * is charged a fixed cost (--loop-us). Blocking calls (delay(), FastLED.show()) charge their
+ * own cost on top of that, which is what makes timing questions answerable here.
+ */
+#include <stdio.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Arduino.h"
+#include "EEPROM.h"
+#include "FastLED.h"
+#include "GPStarAudio.h"
+#include "SerialTransfer.h"
+
+void setup();
+void loop();
+
+// Provided by SchedulerTest.cpp.
+bool runSchedulerTest(unsigned long i_steps);
+
+// Provided by the sketch (Audio.h).
+extern gpstarAudio audio;
+
+struct HarnessOptions {
+  unsigned long i_run_ms = 60000;
+  unsigned long i_loop_us = 100;
+  unsigned int i_led_us = 30;
+  int i_tracks = 0;
+  unsigned long i_seed = 0;
+  unsigned long i_scheduler_steps = 0;
+  gpstarAudio::NativeBoard board = gpstarAudio::BOARD_GPSTAR_AUDIO;
+  const char *s_eeprom = NULL;
+  const char *s_replay = NULL;
+  const char *s_record = NULL;
+  bool b_console = false;
+  bool b_realtime = false;
+};
+
+static void usage(const char *s_name) {
+  printf("Usage: %s [options]\n", s_name);
+  printf("  --ms N          Virtual time to run, in milliseconds (default 60000)\n");
+  printf("  --loop-us N     Virtual cost charged per loop() pass, in microseconds (default 100)\n");
+  printf("  --led-us N      Virtual cost per LED for each FastLED.show() (default 30)\n");
+  printf("  --board B       Audio board to model: gpstar, wav or none (default gpstar)\n");
+  printf("  --tracks N      Number of tracks reported by the audio board (default 0)\n");
+  printf("  --pin P=V       Hold input pin P at level V (0 or 1); may be repeated\n");
+  printf("  --eeprom FILE   Load the EEPROM image from FILE and save it back on exit\n");
+  printf("  --seed N        Seed for random()\n");
+  printf("  --console       Echo the USB console (Serial) to stdout\n");
+  printf("  --tty N=PATH    Attach SerialN (1-3) to a serial device such as a pseudo-terminal\n");
+  printf("  --realtime      Keep the virtual clock from running ahead of the wall clock\n");
+  printf("  --replay FILE   Feed the frames received in a serial capture to the pack at their recorded times\n");
+  printf("  --record FILE   Write every frame the pack sends or receives to FILE as a serial capture\n");
+  printf("  --scheduler-test N  Instead of running the sketch, check its timer scheduler against a model for N random steps\n");
+}
+
+/*
+ * Serial captures use the same lines as the pack's GPSTAR_SERIAL_RECORDER build:
+ *   rec,<ms>,<port>,<direction>,<packet id>,<payload hex>
+ * The port is "wand" (Serial2) or "serial1", and the direction is "in" or "out" as seen by the pack.
+ * Any other lines, such as debug output in a console log, are ignored.
+ */
+struct CaptureFrame {
+  unsigned long i_ms;
+  HardwareSerial *port;
+  uint8_t i_packet_id;
+  uint8_t i_len;
+  uint8_t payload[MAX_PACKET_SIZE];
+};
+
+static std::vector<CaptureFrame> replayFrames;
+static size_t i_replay_next = 0;
+static FILE *recordFile = NULL;
+static unsigned long i_recorded = 0;
+
+static HardwareSerial *capturePort(const char *s_port) {
+  if(strcmp(s_port, "wand") == 0) {
+    return &Serial2;
+  }
+  else if(strcmp(s_port, "serial1") == 0) {
+    return &Serial1;
+  }
+
+  return NULL;
+}
+
+// Loads the frames the pack received from a capture, which are all that a replay needs.
+static bool loadReplay(const char *s_path) {
+  FILE *file = fopen(s_path, "r");
+  char s_line[1024];
+
+  if(file == NULL) {
+    return false;
+  }
+
+  while(fgets(s_line, sizeof(s_line), file) != NULL) {
+    CaptureFrame frame;
+    char s_port[16];
+    char s_dir[8];
+    char s_hex[2 * MAX_PACKET_SIZE + 1] = "";
+    unsigned int i_packet_id = 0;
+
+    if(sscanf(s_line, "rec,%lu,%15[^,],%7[^,],%u,%508[0-9A-Fa-f]", &frame.i_ms, s_port, s_dir, &i_packet_id, s_hex) < 4) {
+      continue;
+    }
+
+    frame.port = capturePort(s_port);
+    frame.i_packet_id = (uint8_t) i_packet_id;
+    frame.i_len = 0;
+
+    if(frame.port == NULL || strcmp(s_dir, "in") != 0) {
+      continue;
+    }
+
+    for(size_t i = 0; s_hex[i] != '\0' && s_hex[i + 1] != '\0' && frame.i_len < MAX_PACKET_SIZE; i += 2) {
+      unsigned int i_byte = 0;
+      sscanf(&s_hex[i], "%2x", &i_byte);
+      frame.payload[frame.i_len++] = (uint8_t) i_byte;
+    }
+
+    replayFrames.push_back(frame);
+  }
+
+  fclose(file);
+  return true;
+}
+
+// Number of times any LED chain has been written, which changes on each frame the sketch sends.
+static unsigned long ledWrites() {
+  unsigned long i_writes = 0;
+
+  for(int i = 0; i < FastLED.count(); i++) {
+    i_writes += FastLED[i].frames();
+  }
+
+  return i_writes;
+}
+
+// Delivers every captured frame which is due by the current virtual time.
+static void replayDue() {
+  uint8_t buffer[PREAMBLE_SIZE + MAX_PACKET_SIZE + POSTAMBLE_SIZE];
+
+  while(i_replay_next < replayFrames.size() && replayFrames[i_replay_next].i_ms <= millis()) {
+    const CaptureFrame &frame = replayFrames[i_replay_next++];
+    uint16_t i_frame_len = SerialTransfer::encodeFrame(buffer, frame.payload, frame.i_len, frame.i_packet_id);
+
+    frame.port->inject(buffer, i_frame_len);
+  }
+}
+
+static void recordFrame(const Stream *port, bool b_sent, uint8_t i_packet_id, const uint8_t *payload, uint8_t i_len) {
+  const char *s_port = (port == &Serial2) ? "wand" : (port == &Serial1) ? "serial1" : "other";
+
+  fprintf(recordFile, "rec,%lu,%s,%s,%u,", millis(), s_port, b_sent ? "out" : "in", i_packet_id);
+
+  for(uint8_t i = 0; i < i_len; i++) {
+    fprintf(recordFile, "%02X", payload[i]);
+  }
+
+  fprintf(recordFile, "\n");
+  i_recorded++;
+}
+
+static bool parseOptions(int argc, char **argv, HarnessOptions &opts) {
+  for(int i = 1; i < argc; i++) {
+    const char *s_arg = argv[i];
+    const char *s_val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+    if(strcmp(s_arg, "--console") == 0) {
+      opts.b_console = true;
+      continue;
+    }
+
+    if(strcmp(s_arg, "--realtime") == 0) {
+      opts.b_realtime = true;
+      continue;
+    }
+
+    if(s_val == NULL) {
+      return false;
+    }
+
+    if(strcmp(s_arg, "--ms") == 0) {
+      opts.i_run_ms = strtoul(s_val, NULL, 10);
+    }
+    else if(strcmp(s_arg, "--loop-us") == 0) {
+      opts.i_loop_us = strtoul(s_val, NULL, 10);
+    }
+    else if(strcmp(s_arg, "--led-us") == 0) {
+      opts.i_led_us = (unsigned int) strtoul(s_val, NULL, 10);
+    }
+    else if(strcmp(s_arg, "--tracks") == 0) {
+      opts.i_tracks = atoi(s_val);
+    }
+    else if(strcmp(s_arg, "--seed") == 0) {
+      opts.i_seed = strtoul(s_val, NULL, 10);
+    }
+    else if(strcmp(s_arg, "--scheduler-test") == 0) {
+      opts.i_scheduler_steps = strtoul(s_val, NULL, 10);
+    }
+    else if(strcmp(s_arg, "--eeprom") == 0) {
+      opts.s_eeprom = s_val;
+    }
+    else if(strcmp(s_arg, "--replay") == 0) {
+      opts.s_replay = s_val;
+    }
+    else if(strcmp(s_arg, "--record") == 0) {
+      opts.s_record = s_val;
+    }
+    else if(strcmp(s_arg, "--board") == 0) {
+      if(strcmp(s_val, "wav") == 0) {
+        opts.board = gpstarAudio::BOARD_WAV_TRIGGER;
+      }
+      else if(strcmp(s_val, "none") == 0) {
+        opts.board = gpstarAudio::BOARD_NONE;
+      }
+      else {
+        opts.board = gpstarAudio::BOARD_GPSTAR_AUDIO;
+      }
+    }
+    else if(strcmp(s_arg, "--pin") == 0) {
+      unsigned int i_pin = 0;
+      unsigned int i_level = 0;
+
+      if(sscanf(s_val, "%u=%u", &i_pin, &i_level) != 2) {
+        return false;
+      }
+
+      native::setPin((uint8_t) i_pin, i_level ? HIGH : LOW);
+    }
+    else if(strcmp(s_arg, "--tty") == 0) {
+      HardwareSerial *ports[] = { &Serial1, &Serial2, &Serial3 };
+      unsigned int i_port = 0;
+      char s_path[256];
+
+      if(sscanf(s_val, "%u=%255s", &i_port, s_path) != 2 || i_port < 1 || i_port > 3) {
+        return false;
+      }
+
+      if(!ports[i_port - 1]->attach(s_path)) {
+        printf("Unable to open %s\n", s_path);
+        return false;
+      }
+    }
+    else {
+      return false;
+    }
+
+    i++;
+  }
+
+  return true;
+}
+
+// Discard everything the sketch wrote to a port, as if a peer consumed it.
+// Attached ports exchange bytes with their device instead.
+static void drainPort(HardwareSerial &port) {
+  uint8_t buffer[256];
+
+  if(port.attached()) {
+    port.pump();
+    return;
+  }
+
+  while(port.drain(buffer, sizeof(buffer)) > 0) {
+  }
+}
+
+int main(int argc, char **argv) {
+  HarnessOptions opts;
+
+  if(!parseOptions(argc, argv, opts)) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  Serial.setEcho(opts.b_console);
+  FastLED.setMicrosPerLed(opts.i_led_us);
+  audio.setNativeBoard(opts.board);
+  audio.setNativeTrackCount(opts.i_tracks);
+  randomSeed(opts.i_seed);
+
+  if(opts.i_scheduler_steps > 0) {
+    return runSchedulerTest(opts.i_scheduler_steps) ? 0 : 1;
+  }
+
+  if(opts.s_eeprom != NULL && !native::loadEEPROM(opts.s_eeprom)) {
+    printf("EEPROM image %s not loaded; starting erased.\n", opts.s_eeprom);
+  }
+
+  if(opts.s_replay != NULL && !loadReplay(opts.s_replay)) {
+    printf("Unable to read the serial capture %s\n", opts.s_replay);
+    return 1;
+  }
+
+  if(opts.s_record != NULL) {
+    recordFile = fopen(opts.s_record, "w");
+
+    if(recordFile == NULL) {
+      printf("Unable to write the serial capture %s\n", opts.s_record);
+      return 1;
+    }
+
+    // Write each frame as it happens, so a run which is stopped still leaves its capture.
+    setvbuf(recordFile, NULL, _IOLBF, 0);
+    SerialTransfer::observer = recordFrame;
+  }
+
+  auto wall_start = std::chrono::steady_clock::now();
+
+  setup();
+
+  uint64_t i_setup_us = native::elapsedMicros();
+  uint64_t i_end_us = i_setup_us + (uint64_t) opts.i_run_ms * 1000;
+  unsigned long i_passes = 0;
+  unsigned long i_passes_since_frame = 0;
+  unsigned long i_frame_min = 0;
+  unsigned long i_frame_max = 0;
+  unsigned long i_frame_intervals = 0;
+  unsigned long i_frame_passes = 0;
+  unsigned long i_led_frames = 0;
+  unsigned long i_last_writes = ledWrites();
+  uint64_t i_last_frame_us = native::elapsedMicros();
+  uint64_t i_frame_gap_max = 0;
+  uint64_t i_pass_max_us = 0;
+
+  while(native::elapsedMicros() < i_end_us) {
+    uint64_t i_pass_start = native::elapsedMicros();
+
+    replayDue();
+    loop();
+    native::advanceMicros(opts.i_loop_us);
+
+    uint64_t i_pass_us = native::elapsedMicros() - i_pass_start;
+
+    if(i_pass_us > i_pass_max_us) {
+      i_pass_max_us = i_pass_us;
+    }
+
+    i_passes++;
+    i_passes_since_frame++;
+
+    if(ledWrites() != i_last_writes) {
+      // Skip the first frame as it is measured from the end of setup().
+      if(i_led_frames > 0) {
+        if(i_frame_intervals == 0 || i_passes_since_frame < i_frame_min) {
+          i_frame_min = i_passes_since_frame;
+        }
+
+        if(i_passes_since_frame > i_frame_max) {
+          i_frame_max = i_passes_since_frame;
+        }
+
+        if(native::elapsedMicros() - i_last_frame_us > i_frame_gap_max) {
+          i_frame_gap_max = native::elapsedMicros() - i_last_frame_us;
+        }
+
+        i_frame_intervals++;
+        i_frame_passes += i_passes_since_frame;
+      }
+
+      i_led_frames++;
+      i_last_writes = ledWrites();
+      i_last_frame_us = native::elapsedMicros();
+      i_passes_since_frame = 0;
+    }
+
+    drainPort(Serial1);
+    drainPort(Serial2);
+    drainPort(Serial3);
+
+    if(opts.b_realtime) {
+      // A peer on an attached device runs on the wall clock, so wait for it to catch up.
+      auto virtual_now = wall_start + std::chrono::microseconds(native::elapsedMicros() - i_setup_us);
+
+      if(virtual_now > std::chrono::steady_clock::now()) {
+        std::this_thread::sleep_until(virtual_now);
+      }
+    }
+  }
+
+  double f_wall_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+  double f_virtual_s = (double) native::elapsedMicros() / 1000000.0;
+  double f_loop_s = (double) (native::elapsedMicros() - i_setup_us) / 1000000.0;
+  const gpstarAudio::NativeStats &audio_stats = audio.nativeStats();
+
+  printf("Virtual time:        %.3f s (setup %.3f s), wall time %.3f s, speedup %.1fx\n", f_virtual_s, (double) i_setup_us / 1000000.0, f_wall_s, f_wall_s > 0 ? f_virtual_s / f_wall_s : 0.0);
+  printf("loop() passes:       %lu (%.1f per second, slowest %.3f ms)\n", i_passes, f_loop_s > 0 ? i_passes / f_loop_s : 0.0, (double) i_pass_max_us / 1000.0);
+  printf("LED frames:          %lu written", i_led_frames);
+
+  for(int i = 0; i < FastLED.count(); i++) {
+    printf(", pin %u: %d LEDs %lu writes %.1f ms busy", FastLED[i].pin(), FastLED[i].size(), FastLED[i].frames(), (double) FastLED[i].busyMicros() / 1000.0);
+  }
+
+  printf("\n");
+
+  if(i_frame_intervals > 0) {
+    printf("Passes per frame:    min %lu, avg %.1f, max %lu (longest frame gap %.3f ms)\n", i_frame_min, (double) i_frame_passes / i_frame_intervals, i_frame_max, (double) i_frame_gap_max / 1000.0);
+  }
+
+  printf("Blocking delay():    %.3f s\n", (double) native::delayedMicros() / 1000000.0);
+  printf("Serial bytes out:    Serial1 %lu, Serial2 %lu, Serial3 %lu\n", Serial1.bytesWritten(), Serial2.bytesWritten(), Serial3.bytesWritten());
+  printf("Audio commands:      %lu (%lu bytes): %lu play, %lu stop (%lu idle), %lu gain, %lu fade, %lu loop, %lu status\n",
+    audio_stats.commands, audio_stats.bytes, audio_stats.plays, audio_stats.stops, audio_stats.stopsIdle,
+    audio_stats.gains, audio_stats.fades, audio_stats.loops, audio_stats.statusRequests);
+  printf("EEPROM writes:       %lu\n", EEPROM.writes());
+
+  if(opts.s_replay != NULL) {
+    printf("Serial replay:       %lu of %lu frames delivered\n", (unsigned long) i_replay_next, (unsigned long) replayFrames.size());
+  }
+
+  if(recordFile != NULL) {
+    printf("Serial capture:      %lu frames recorded\n", i_recorded);
+    fclose(recordFile);
+  }
+
+  if(opts.s_eeprom != NULL && !native::saveEEPROM(opts.s_eeprom)) {
+    printf("Unable to save EEPROM image to %s\n", opts.s_eeprom);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,112 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * RAMP (siteswapjuggler/RAMP) replacement covering the interpolation API used by the firmware.
+ * Only forward, single-shot ramps are modelled; the loop modes are accepted and treated as ONCEFORWARD.
+ */
+#include "Arduino.h"
+
+enum ramp_mode {
+  NONE, LINEAR,
+  QUADRATIC_IN, QUADRATIC_OUT, QUADRATIC_INOUT,
+  CUBIC_IN, CUBIC_OUT, CUBIC_INOUT,
+  QUARTIC_IN, QUARTIC_OUT, QUARTIC_INOUT,
+  QUINTIC_IN, QUINTIC_OUT, QUINTIC_INOUT,
+  SINUSOIDAL_IN, SINUSOIDAL_OUT, SINUSOIDAL_INOUT,
+  EXPONENTIAL_IN, EXPONENTIAL_OUT, EXPONENTIAL_INOUT,
+  CIRCULAR_IN, CIRCULAR_OUT, CIRCULAR_INOUT
+};
+
+enum loop_mode { ONCEFORWARD, LOOPFORWARD, FORTHANDBACK, ONCEBACKWARD, LOOPBACKWARD, BACKANDFORTH };
+
+float rampEase(ramp_mode mode, float k);
+
+template <class T>
+class _ramp {
+  public:
+    T go(T _val, unsigned long _dur = 0, ramp_mode _mode = LINEAR, loop_mode _loop = ONCEFORWARD) {
+      (void) _loop;
+      A = val;
+      B = _val;
+      mode = _mode;
+      dur = _dur;
+      t = millis();
+      pos = 0;
+      paused = false;
+
+      if(dur == 0 || mode == NONE) {
+        val = B;
+        pos = dur;
+        mode = NONE;
+      }
+
+      return val;
+    }
+
+    T update() {
+      if(mode != NONE && !paused && pos < dur) {
+        pos = millis() - t;
+
+        if(pos >= dur) {
+          pos = dur;
+          val = B;
+        }
+        else {
+          float k = rampEase(mode, (float) pos / (float) dur);
+          val = (T) (A + (((float) B - (float) A) * k));
+        }
+      }
+
+      return val;
+    }
+
+    void pause() { paused = true; }
+    void resume() { if(paused) { paused = false; t = millis() - pos; } }
+    bool isFinished() const { return pos >= dur; }
+    bool isRunning() const { return mode != NONE && !paused && pos < dur; }
+    bool isPaused() const { return paused; }
+    T getValue() const { return val; }
+    T getOrigin() const { return A; }
+    T getTarget() const { return B; }
+    unsigned long getDuration() const { return dur; }
+    unsigned long getPosition() const { return pos; }
+    float getCompletion() const { return dur == 0 ? 100.0f : (100.0f * pos) / dur; }
+
+  private:
+    T A = 0;
+    T B = 0;
+    T val = 0;
+    ramp_mode mode = NONE;
+    unsigned long t = 0;
+    unsigned long dur = 0;
+    unsigned long pos = 0;
+    bool paused = false;
+};
+
+typedef _ramp<unsigned char> ramp;
+typedef _ramp<int> rampInt;
+typedef _ramp<unsigned int> rampUnsignedInt;
+typedef _ramp<long> rampLong;
+typedef _ramp<unsigned long> rampUnsignedLong;
+typedef _ramp<float> rampFloat;
+typedef _ramp<double> rampDouble;
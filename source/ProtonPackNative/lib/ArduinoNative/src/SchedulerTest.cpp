@@ -0,0 +1,291 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/*
+ * Check of the sketch's timer scheduler (Scheduler.h) against a reference model, run with --scheduler-test in
+ * place of setup() and loop().
+ *
+ * Each step schedules, moves or cancels one of more timers than the scheduler can hold, or moves the virtual
+ * clock on and runs whatever is due. Some callbacks schedule themselves again when they run. The model is a plain
+ * list of due times, and after every step the scheduler must agree with it:
+ *   - every timer due runs exactly once and none runs early, earliest first;
+ *   - a timer scheduled again moves rather than being added twice;
+ *   - a full scheduler makes room by running its earliest timers;
+ *   - the heap order holds, and scheduledTimerWait() gives the time until the earliest timer.
+ * The clock starts shortly before millis() wraps around in 32 bits, so the wrap is crossed during the run.
+ */
+#include <stdio.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Arduino.h"
+
+// Provided by the sketch (Scheduler.h). This must match struct ScheduledTimer there.
+typedef void (*TimerCallback)();
+
+struct ScheduledTimer {
+  uint32_t ms_due;
+  TimerCallback p_callback;
+};
+
+extern struct ScheduledTimer scheduledTimers[];
+extern uint8_t i_scheduled_timers;
+void scheduleTimer(TimerCallback p_callback, uint32_t i_delay);
+void cancelTimer(TimerCallback p_callback);
+bool timerScheduled(TimerCallback p_callback);
+uint32_t scheduledTimerWait();
+void runScheduledTimers();
+
+namespace {
+  const uint8_t i_capacity = 16; // SCHEDULER_TIMERS_MAX in Scheduler.h.
+  const uint8_t i_callbacks = i_capacity + 8;
+
+  struct ModelTimer {
+    bool b_pending;
+    uint32_t ms_due;
+  };
+
+  ModelTimer model[i_callbacks];
+  std::vector<uint8_t> ran; // Callbacks run by the scheduler during the current step.
+  TimerCallback callbacks[i_callbacks];
+  unsigned long i_failures = 0;
+  unsigned long i_step = 0;
+
+  uint32_t now() {
+    return (uint32_t) millis();
+  }
+
+  bool dueBefore(uint32_t a, uint32_t b) {
+    return (int32_t) (a - b) < 0;
+  }
+
+  // Every third callback puts itself back a few milliseconds later, as runCrossfades() does.
+  uint32_t rescheduleDelay(uint8_t i_id) {
+    return (i_id % 3 == 0) ? 1 + i_id % 7 : 0;
+  }
+
+  template<uint8_t N> void testCallback() {
+    ran.push_back(N);
+
+    if(rescheduleDelay(N) > 0) {
+      scheduleTimer(testCallback<N>, rescheduleDelay(N));
+    }
+  }
+
+  template<uint8_t... N> void fillCallbacks(std::integer_sequence<uint8_t, N...>) {
+    TimerCallback list[] = { testCallback<N>... };
+
+    for(uint8_t i = 0; i < sizeof...(N); i++) {
+      callbacks[i] = list[i];
+    }
+  }
+
+  void fail(const char *s_what, int i_id) {
+    if(i_failures < 10) {
+      printf("Scheduler test step %lu, %lu ms: %s (timer %d)\n", i_step, (unsigned long) now(), s_what, i_id);
+    }
+
+    i_failures++;
+  }
+
+  uint8_t modelPending() {
+    uint8_t i_count = 0;
+
+    for(uint8_t i = 0; i < i_callbacks; i++) {
+      i_count += model[i].b_pending;
+    }
+
+    return i_count;
+  }
+
+  // Whether a timer is due no later than every other pending timer.
+  bool modelEarliest(uint8_t i_id) {
+    for(uint8_t i = 0; i < i_callbacks; i++) {
+      if(model[i].b_pending && dueBefore(model[i].ms_due, model[i_id].ms_due)) {
+        return false;
+      }
+    }
+
+    return model[i_id].b_pending;
+  }
+
+  // Has the model follow a callback the scheduler ran: it is no longer pending, unless it put itself back.
+  void modelRan(uint8_t i_id) {
+    model[i_id].b_pending = rescheduleDelay(i_id) > 0;
+    model[i_id].ms_due = now() + rescheduleDelay(i_id);
+  }
+
+  void stepSchedule(uint8_t i_id, uint32_t i_delay) {
+    ran.clear();
+    scheduleTimer(callbacks[i_id], i_delay);
+
+    // Any callbacks run were to make room, and each must have been the earliest pending at the time.
+    bool b_ran_early = false;
+
+    for(uint8_t i_ran : ran) {
+      if(i_ran == i_id && !model[i_id].b_pending) {
+        // Run at once because every timer run to make room put itself straight back. Should it try to put itself
+        // back too there is still no room, so it is left unscheduled.
+        if(b_ran_early) {
+          fail("ran a timer at once more than once", i_id);
+        }
+
+        b_ran_early = true;
+        continue;
+      }
+
+      if(modelPending() < i_capacity || model[i_id].b_pending) {
+        fail("ran a timer early with room to spare", i_ran);
+      }
+      else if(!modelEarliest(i_ran)) {
+        fail("made room with a timer which was not the earliest", i_ran);
+      }
+
+      modelRan(i_ran);
+    }
+
+    if(b_ran_early) {
+      if(modelPending() < i_capacity) {
+        fail("ran a timer at once with room to spare", i_id);
+      }
+    }
+    else {
+      model[i_id].b_pending = true;
+      model[i_id].ms_due = now() + i_delay;
+    }
+  }
+
+  void stepCancel(uint8_t i_id) {
+    ran.clear();
+    cancelTimer(callbacks[i_id]);
+    model[i_id].b_pending = false;
+
+    if(!ran.empty()) {
+      fail("ran a timer on cancelling one", ran[0]);
+    }
+  }
+
+  void stepRun(uint32_t i_advance) {
+    native::advanceMicros((uint64_t) i_advance * 1000);
+
+    ModelTimer before[i_callbacks];
+    std::copy(model, model + i_callbacks, before);
+
+    ran.clear();
+    runScheduledTimers();
+
+    uint32_t ms_last = 0;
+
+    for(size_t i = 0; i < ran.size(); i++) {
+      uint8_t i_id = ran[i];
+
+      if(!before[i_id].b_pending || dueBefore(now(), before[i_id].ms_due)) {
+        fail("ran a timer which was not due", i_id);
+      }
+      else if(i > 0 && dueBefore(before[i_id].ms_due, ms_last)) {
+        fail("ran a timer after one due later", i_id);
+      }
+
+      ms_last = before[i_id].ms_due;
+      before[i_id].b_pending = false; // Catches a timer run twice.
+      modelRan(i_id);
+    }
+
+    for(uint8_t i = 0; i < i_callbacks; i++) {
+      if(before[i].b_pending && !dueBefore(now(), before[i].ms_due)) {
+        fail("left a due timer waiting", i);
+      }
+    }
+  }
+
+  void checkState() {
+    if(i_scheduled_timers != modelPending()) {
+      fail("holds a different number of timers", i_scheduled_timers);
+    }
+
+    for(uint8_t i = 0; i < i_callbacks; i++) {
+      if(timerScheduled(callbacks[i]) != model[i].b_pending) {
+        fail(model[i].b_pending ? "lost a timer" : "kept a timer which should be gone", i);
+      }
+    }
+
+    for(uint8_t i = 0; i < i_scheduled_timers; i++) {
+      uint8_t i_parent = (i - 1) / 2;
+
+      if(i > 0 && dueBefore(scheduledTimers[i].ms_due, scheduledTimers[i_parent].ms_due)) {
+        fail("broke the heap order", i);
+      }
+
+      for(uint8_t j = 0; j < i_callbacks; j++) {
+        if(scheduledTimers[i].p_callback == callbacks[j] && scheduledTimers[i].ms_due != model[j].ms_due) {
+          fail("holds a timer at the wrong time", j);
+        }
+      }
+    }
+
+    uint32_t i_wait = 0xFFFFFFFF;
+
+    for(uint8_t i = 0; i < i_callbacks; i++) {
+      if(model[i].b_pending) {
+        uint32_t i_left = dueBefore(now(), model[i].ms_due) ? model[i].ms_due - now() : 0;
+
+        if(i_left < i_wait) {
+          i_wait = i_left;
+        }
+      }
+    }
+
+    if(scheduledTimerWait() != i_wait) {
+      fail("gave the wrong wait until the next timer", (int) scheduledTimerWait());
+    }
+  }
+}
+
+bool runSchedulerTest(unsigned long i_steps) {
+  fillCallbacks(std::make_integer_sequence<uint8_t, i_callbacks>());
+
+  // Start 20 seconds before millis() wraps around in 32 bits.
+  native::advanceMicros((0x100000000ULL - 20000) * 1000 - native::elapsedMicros());
+
+  unsigned long i_runs = 0;
+  uint32_t ms_start = now();
+
+  for(i_step = 0; i_step < i_steps; i_step++) {
+    long i_choice = random(10);
+    uint8_t i_id = (uint8_t) random(i_callbacks);
+
+    if(i_choice < 5) {
+      stepSchedule(i_id, (uint32_t) random(50));
+    }
+    else if(i_choice < 7) {
+      stepCancel(i_id);
+    }
+    else {
+      stepRun((uint32_t) random(25));
+    }
+
+    i_runs += ran.size();
+    checkState();
+  }
+
+  printf("Scheduler test:      %lu steps over %lu ms, %lu callbacks run, %lu failures\n", i_steps, (unsigned long) (now() - ms_start), i_runs, i_failures);
+  return i_failures == 0;
+}
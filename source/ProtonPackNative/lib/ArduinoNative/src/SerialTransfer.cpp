@@ -0,0 +1,260 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "SerialTransfer.h"
+
+SerialTransfer::FrameObserver SerialTransfer::observer = NULL;
+
+static uint8_t crc8Table[256];
+static bool b_crc8_init = false;
+
+static uint8_t crc8(const uint8_t *arr, uint8_t len) {
+  if(!b_crc8_init) {
+    const uint8_t poly = 0x9B;
+
+    for(int i = 0; i < 256; i++) {
+      uint8_t curr = i;
+
+      for(int j = 0; j < 8; j++) {
+        if((curr & 0x80) != 0) {
+          curr = (curr << 1) ^ poly;
+        }
+        else {
+          curr <<= 1;
+        }
+      }
+
+      crc8Table[i] = curr;
+    }
+
+    b_crc8_init = true;
+  }
+
+  uint8_t crc = 0;
+
+  for(uint8_t i = 0; i < len; i++) {
+    crc = crc8Table[crc ^ arr[i]];
+  }
+
+  return crc;
+}
+
+// Index of the first START_BYTE in the payload, or 0xFF if there is none.
+static uint8_t calcOverhead(const uint8_t *arr, uint8_t len) {
+  for(uint8_t i = 0; i < len; i++) {
+    if(arr[i] == START_BYTE) {
+      return i;
+    }
+  }
+
+  return 0xFF;
+}
+
+// Replace each START_BYTE with the distance to the next one (0 for the last).
+static void stuffPacket(uint8_t *arr, uint8_t len) {
+  int16_t refByte = -1;
+
+  for(int16_t i = len - 1; i >= 0; i--) {
+    if(arr[i] == START_BYTE) {
+      arr[i] = (refByte == -1) ? 0 : (uint8_t) (refByte - i);
+      refByte = i;
+    }
+  }
+}
+
+static void unpackPacket(uint8_t *arr, uint8_t overhead) {
+  uint8_t testIndex = overhead;
+
+  if(testIndex < MAX_PACKET_SIZE) {
+    while(arr[testIndex]) {
+      uint8_t delta = arr[testIndex];
+      arr[testIndex] = START_BYTE;
+      testIndex += delta;
+    }
+
+    arr[testIndex] = START_BYTE;
+  }
+}
+
+uint16_t SerialTransfer::encodeFrame(uint8_t *out, const uint8_t *payload, uint8_t len, uint8_t packetID) {
+  if(len > MAX_PACKET_SIZE) {
+    len = MAX_PACKET_SIZE;
+  }
+
+  uint8_t *body = out + PREAMBLE_SIZE;
+  memcpy(body, payload, len);
+
+  uint8_t overhead = calcOverhead(body, len);
+  stuffPacket(body, len);
+
+  out[0] = START_BYTE;
+  out[1] = packetID;
+  out[2] = overhead;
+  out[3] = len;
+  out[PREAMBLE_SIZE + len] = crc8(body, len);
+  out[PREAMBLE_SIZE + len + 1] = STOP_BYTE;
+
+  return PREAMBLE_SIZE + len + POSTAMBLE_SIZE;
+}
+
+void SerialTransfer::begin(Stream &_port, bool _debug, Stream &_debugPort, uint32_t _timeout) {
+  (void) _debug;
+  (void) _debugPort;
+  (void) _timeout;
+
+  port = &_port;
+  reset();
+}
+
+uint8_t SerialTransfer::sendData(const uint16_t &messageLen, const uint8_t packetID) {
+  uint8_t frame[PREAMBLE_SIZE + MAX_PACKET_SIZE + POSTAMBLE_SIZE];
+  uint8_t len = (messageLen > MAX_PACKET_SIZE) ? MAX_PACKET_SIZE : (uint8_t) messageLen;
+  uint16_t i_frame_len = encodeFrame(frame, packet.txBuff, len, packetID);
+
+  if(observer != NULL) {
+    observer(port, true, packetID, packet.txBuff, len);
+  }
+
+  if(port != NULL) {
+    port->write(frame, i_frame_len);
+  }
+
+  return len;
+}
+
+uint8_t SerialTransfer::parse(uint8_t recChar, bool valid) {
+  if(!valid) {
+    status = NO_DATA;
+    return 0;
+  }
+
+  switch(state) {
+    case find_start_byte:
+      if(recChar == START_BYTE) {
+        state = find_id_byte;
+      }
+    break;
+
+    case find_id_byte:
+      idByte = recChar;
+      state = find_overhead_byte;
+    break;
+
+    case find_overhead_byte:
+      recOverheadByte = recChar;
+      state = find_payload_len;
+    break;
+
+    case find_payload_len:
+      if(recChar > 0 && recChar <= MAX_PACKET_SIZE) {
+        bytesToRec = recChar;
+        payIndex = 0;
+        state = find_payload;
+      }
+      else {
+        bytesRead = 0;
+        state = find_start_byte;
+        status = PAYLOAD_ERROR;
+        return 0;
+      }
+    break;
+
+    case find_payload:
+      if(payIndex < bytesToRec) {
+        packet.rxBuff[payIndex++] = recChar;
+
+        if(payIndex == bytesToRec) {
+          state = find_crc;
+        }
+      }
+    break;
+
+    case find_crc:
+      if(recChar == crc8(packet.rxBuff, bytesToRec)) {
+        state = find_end_byte;
+      }
+      else {
+        bytesRead = 0;
+        state = find_start_byte;
+        status = CRC_ERROR;
+        return 0;
+      }
+    break;
+
+    case find_end_byte:
+      state = find_start_byte;
+
+      if(recChar == STOP_BYTE) {
+        unpackPacket(packet.rxBuff, recOverheadByte);
+        bytesRead = bytesToRec;
+        status = NEW_DATA;
+        return bytesToRec;
+      }
+
+      bytesRead = 0;
+      status = STOP_BYTE_ERROR;
+      return 0;
+    break;
+  }
+
+  status = CONTINUE;
+  return 0;
+}
+
+// Consumes bytes until one complete packet has been parsed (or the port runs dry).
+uint8_t SerialTransfer::available() {
+  if(port == NULL) {
+    return 0;
+  }
+
+  if(port->available()) {
+    while(port->available()) {
+      bytesRead = parse((uint8_t) port->read(), true);
+
+      if(status != CONTINUE) {
+        if(status < 0) {
+          reset();
+        }
+
+        break;
+      }
+    }
+  }
+  else {
+    bytesRead = parse(0xFF, false);
+
+    if(status < 0) {
+      reset();
+    }
+  }
+
+  if(status == NEW_DATA && observer != NULL) {
+    observer(port, false, idByte, packet.rxBuff, bytesRead);
+  }
+
+  return bytesRead;
+}
+
+void SerialTransfer::reset() {
+  memset(packet.txBuff, 0, sizeof(packet.txBuff));
+  memset(packet.rxBuff, 0, sizeof(packet.rxBuff));
+  bytesRead = 0;
+  state = find_start_byte;
+}
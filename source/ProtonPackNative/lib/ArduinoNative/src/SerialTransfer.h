@@ -0,0 +1,119 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * SerialTransfer (PowerBroker2/SerialTransfer) replacement.
+ * The framing is byte-compatible with the real library: start byte, packet ID, COBS overhead
+ * byte, payload length, COBS-stuffed payload, CRC-8 (poly 0x9B) and stop byte. This keeps the
+ * traffic seen on the virtual UARTs identical to what a real wand or Attenuator would see.
+ */
+#include "Arduino.h"
+
+const int8_t CONTINUE = 3;
+const int8_t NEW_DATA = 2;
+const int8_t NO_DATA = 1;
+const int8_t CRC_ERROR = 0;
+const int8_t PAYLOAD_ERROR = -1;
+const int8_t STOP_BYTE_ERROR = -2;
+const int8_t STALE_PACKET_ERROR = -3;
+
+const uint8_t START_BYTE = 0x7E;
+const uint8_t STOP_BYTE = 0x81;
+
+const uint8_t PREAMBLE_SIZE = 4;
+const uint8_t POSTAMBLE_SIZE = 2;
+const uint8_t MAX_PACKET_SIZE = 0xFE;
+
+class SerialTransfer {
+  public:
+    // The payload buffers live in a Packet member, as in the real library.
+    struct Packet {
+      uint8_t txBuff[MAX_PACKET_SIZE];
+      uint8_t rxBuff[MAX_PACKET_SIZE];
+    } packet;
+
+    uint8_t bytesRead = 0;
+    int8_t status = NO_DATA;
+
+    void begin(Stream &_port, bool _debug = true, Stream &_debugPort = Serial, uint32_t _timeout = 50);
+    uint8_t sendData(const uint16_t &messageLen, const uint8_t packetID = 0);
+    uint8_t available();
+    bool tick() { return available() > 0; }
+    uint8_t currentPacketID() const { return idByte; }
+    void reset();
+
+    template <typename T>
+    uint16_t txObj(const T &val, const uint16_t &index = 0, const uint16_t &len = sizeof(T)) {
+      const uint8_t *ptr = (const uint8_t *) &val;
+      uint16_t maxIndex = ((len + index) > MAX_PACKET_SIZE) ? MAX_PACKET_SIZE : (len + index);
+
+      for(uint16_t i = index; i < maxIndex; i++) {
+        packet.txBuff[i] = *ptr++;
+      }
+
+      return maxIndex;
+    }
+
+    template <typename T>
+    uint16_t rxObj(const T &val, const uint16_t &index = 0, const uint16_t &len = sizeof(T)) {
+      uint8_t *ptr = (uint8_t *) &val;
+      uint16_t maxIndex = ((len + index) > MAX_PACKET_SIZE) ? MAX_PACKET_SIZE : (len + index);
+
+      for(uint16_t i = index; i < maxIndex; i++) {
+        *ptr++ = packet.rxBuff[i];
+      }
+
+      return maxIndex;
+    }
+
+    template <typename T>
+    uint8_t sendDatum(const T &val, const uint8_t packetID = 0, const uint16_t &len = sizeof(T)) {
+      return sendData(txObj(val, 0, len), packetID);
+    }
+
+    // Native-only: frame a payload exactly as sendData() would, without a port.
+    static uint16_t encodeFrame(uint8_t *out, const uint8_t *payload, uint8_t len, uint8_t packetID);
+
+    // Native-only: called with the payload of every frame sent or received by any instance.
+    typedef void (*FrameObserver)(const Stream *port, bool b_sent, uint8_t packetID, const uint8_t *payload, uint8_t len);
+    static FrameObserver observer;
+
+  private:
+    enum fsm {
+      find_start_byte,
+      find_id_byte,
+      find_overhead_byte,
+      find_payload_len,
+      find_payload,
+      find_crc,
+      find_end_byte
+    };
+
+    uint8_t parse(uint8_t recChar, bool valid);
+
+    Stream *port = NULL;
+    fsm state = find_start_byte;
+    uint8_t idByte = 0;
+    uint8_t recOverheadByte = 0;
+    uint8_t bytesToRec = 0;
+    uint8_t payIndex = 0;
+};
@@ -0,0 +1,42 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * i2c replacement. No devices are present on the virtual bus, so every transmission NACKs.
+ */
+#include "Arduino.h"
+
+class TwoWire : public Stream {
+  public:
+    void begin() {}
+    void setClock(uint32_t i_clock) { (void) i_clock; }
+    void beginTransmission(uint8_t i_address) { (void) i_address; }
+    uint8_t endTransmission(bool b_stop = true) { (void) b_stop; return 2; }
+    uint8_t requestFrom(uint8_t i_address, uint8_t i_quantity, bool b_stop = true) { (void) i_address; (void) i_quantity; (void) b_stop; return 0; }
+    size_t write(uint8_t c) override { (void) c; return 1; }
+    using Print::write;
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+};
+
+extern TwoWire Wire;
@@ -0,0 +1,31 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * digitalWriteFast replacement; the fast variants simply forward to the core functions.
+ */
+#include "Arduino.h"
+
+#define pinModeFast(pin, mode) pinMode(pin, mode)
+#define digitalWriteFast(pin, val) digitalWrite(pin, val)
+#define digitalReadFast(pin) digitalRead(pin)
+#define digitalToggleFast(pin) digitalWrite(pin, !digitalRead(pin))
@@ -0,0 +1,89 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * ezButton replacement with identical debounce semantics, reading from the virtual pins.
+ */
+#include "Arduino.h"
+
+#define COUNT_FALLING 0
+#define COUNT_RISING  1
+#define COUNT_BOTH    2
+
+class ezButton {
+  public:
+    ezButton(int pin) : ezButton(pin, INPUT_PULLUP) {}
+
+    ezButton(int pin, int mode) {
+      btnPin = pin;
+      pinMode(btnPin, mode);
+      previousSteadyState = digitalRead(btnPin);
+      lastSteadyState = previousSteadyState;
+      lastFlickerableState = previousSteadyState;
+    }
+
+    void setDebounceTime(unsigned long time) { debounceTime = time; }
+    int getState() const { return lastSteadyState; }
+    int getStateRaw() const { return digitalRead(btnPin); }
+    bool isPressed() const { return previousSteadyState == HIGH && lastSteadyState == LOW; }
+    bool isReleased() const { return previousSteadyState == LOW && lastSteadyState == HIGH; }
+    void setCountMode(int mode) { countMode = mode; }
+    unsigned long getCount() const { return count; }
+    void resetCount() { count = 0; }
+
+    void loop() {
+      int currentState = digitalRead(btnPin);
+      unsigned long currentTime = millis();
+
+      if(currentState != lastFlickerableState) {
+        lastDebounceTime = currentTime;
+        lastFlickerableState = currentState;
+      }
+
+      if((currentTime - lastDebounceTime) >= debounceTime) {
+        previousSteadyState = lastSteadyState;
+        lastSteadyState = currentState;
+      }
+
+      if(previousSteadyState != lastSteadyState) {
+        if(countMode == COUNT_BOTH) {
+          count++;
+        }
+        else if(countMode == COUNT_FALLING && previousSteadyState == HIGH && lastSteadyState == LOW) {
+          count++;
+        }
+        else if(countMode == COUNT_RISING && previousSteadyState == LOW && lastSteadyState == HIGH) {
+          count++;
+        }
+      }
+    }
+
+  private:
+    int btnPin;
+    unsigned long debounceTime = 0;
+    unsigned long count = 0;
+    int countMode = COUNT_FALLING;
+    int previousSteadyState;
+    int lastSteadyState;
+    int lastFlickerableState;
+    unsigned long lastDebounceTime = 0;
+};
@@ -0,0 +1,100 @@
+/**
+ *   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+ *   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#pragma once
+
+/*
+ * millisDelay (SafeString) replacement with identical semantics, driven by the virtual clock.
+ */
+#include "Arduino.h"
+
+class millisDelay {
+  public:
+    void start(unsigned long delay) {
+      mS_delay = delay;
+      startTime = millis();
+      running = true;
+      finishNow = false;
+    }
+
+    void stop() {
+      running = false;
+      finishNow = false;
+    }
+
+    void restart() {
+      start(mS_delay);
+    }
+
+    void repeat() {
+      startTime += mS_delay;
+      running = true;
+      finishNow = false;
+    }
+
+    void finish() {
+      finishNow = true;
+    }
+
+    bool justFinished() {
+      if(running && (finishNow || ((millis() - startTime) >= mS_delay))) {
+        stop();
+        return true;
+      }
+
+      return false;
+    }
+
+    bool isRunning() const {
+      return running;
+    }
+
+    bool isFinished() const {
+      return !running;
+    }
+
+    unsigned long remaining() const {
+      if(running) {
+        unsigned long ms = millis();
+
+        if(finishNow || (ms - startTime) >= mS_delay) {
+          return 0;
+        }
+
+        return mS_delay - (ms - startTime);
+      }
+
+      return 0;
+    }
+
+    unsigned long delay() const {
+      return mS_delay;
+    }
+
+    unsigned long getStartTime() const {
+      return startTime;
+    }
+
+  private:
+    unsigned long mS_delay = 0;
+    unsigned long startTime = 0;
+    bool running = false;
+    bool finishNow = false;
+};
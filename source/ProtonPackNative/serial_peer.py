@@ -0,0 +1,544 @@
+#!/usr/bin/env python3
+#
+#   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+#   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+#
+#   This program is free software; you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation; either version 3 of the License, or
+#   (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program; if not, see <https://www.gnu.org/licenses/>.
+#
+
+"""
+Serial link peer for the host-native Proton Pack build.
+
+Runs the native program with one of its serial ports attached to a pseudo-terminal and plays
+the part of a Neutrona Wand (Serial2) or Attenuator (Serial1) on the other end, to check the
+link speed negotiation. Both ends of a pseudo-terminal share one set of line settings, so the
+rate the pack selects is read back from the terminal rather than reported by the pack.
+
+  fast    Accept the faster rate; the link must stay up at that rate.
+  legacy  Ignore the offer, as older firmware would; the link must stay at 9600 baud.
+  deaf    Accept the offer, then never be heard at the new rate; the pack must fall back
+          to 9600 baud and must not offer the faster rate again.
+  mirror  Attenuator only: mirror the pack state, change the volume in bursts and check that
+          the changes arrive coalesced, that commands reporting that state stop, and that a
+          corrupted copy is repaired by a full resync.
+
+With --batch the peer also says that it decodes batched commands, so the pack sends the
+commands of each loop pass together in one frame.
+
+With --reliable the wand also says that it supports reliable commands, then sends the pack
+two numbered handshakes out of order and a repeat of the first; the pack must hold the early
+one, acknowledge both once they are in order, and ignore the repeat. Its heartbeat then comes
+every second, as the pack expects of a wand with reliable commands. With --lose-reliable the
+wand never hears the pack agree and keeps its usual heartbeat; the pack must not start to
+expect the faster heartbeat, so it must never need to send a handshake of its own.
+
+With --links the Attenuator asks the pack for its link counters once synchronized; the pack
+must answer with one report per link, and its own count of frames from the Attenuator must
+include every frame the peer sent once synchronized.
+
+Usage: serial_peer.py [--role wand|attenuator] [--mode fast|legacy|deaf|mirror] [--batch] [--reliable [--lose-reliable]] [--links] PROGRAM
+"""
+
+import argparse
+import struct
+import os
+import re
+import subprocess
+import sys
+import termios
+import time
+
+START_BYTE = 0x7E
+STOP_BYTE = 0x81
+PACKET_COMMAND = 1
+PACKET_DATA = 2
+PACKET_SYNC = 6
+PACKET_SYNC_DELTA = 8
+PACKET_COMMAND_BATCH = 9
+PACKET_RELIABLE = 10
+PACKET_LINK_STATS = 11
+
+# Link ID, frames sent, frames received by packet type, retransmits, CRC errors, marker errors,
+# handshake time and longest frame gap.
+LINK_STATS = struct.Struct('<BI12H5H')
+LINK_NAMES = ['pack-wand', 'wand-pack', 'pack-serial1']
+
+# Commands which the pack stops sending once the Attenuator mirrors its state.
+MIRRORED_COMMANDS = {
+  'A_WAND_CONNECTED', 'A_WAND_DISCONNECTED', 'A_BARREL_EXTENDED', 'A_BARREL_RETRACTED',
+  'A_MODE_SUPER_HERO', 'A_MODE_ORIGINAL', 'A_YEAR_1984', 'A_YEAR_1989', 'A_YEAR_AFTERLIFE',
+  'A_YEAR_FROZEN_EMPIRE', 'A_PROTON_MODE', 'A_SLIME_MODE', 'A_STASIS_MODE', 'A_MESON_MODE',
+  'A_SPECTRAL_MODE', 'A_HOLIDAY_MODE', 'A_POWER_LEVEL_1', 'A_POWER_LEVEL_2', 'A_POWER_LEVEL_3',
+  'A_POWER_LEVEL_4', 'A_POWER_LEVEL_5', 'A_CYCLOTRON_LID_ON', 'A_CYCLOTRON_LID_OFF',
+  'A_TOGGLE_MUTE', 'A_MUSIC_TRACK_LOOP_TOGGLE', 'A_BATTERY_VOLTAGE_PACK', 'A_VOLUME_SYNC',
+  'A_MUSIC_SHUFFLE_TOGGLE',
+}
+
+# Offsets of systemMode and masterVolume within AttenuatorSyncData.
+SYNC_SYSTEM_MODE = 0
+SYNC_MASTER_VOLUME = 15
+
+BAUD_RATES = {
+  termios.B9600: 9600,
+  termios.B19200: 19200,
+  termios.B38400: 38400,
+  termios.B57600: 57600,
+  termios.B115200: 115200,
+}
+
+
+def load_enums(path):
+  """Returns the enumerator names of each enum in Communication.h, in order."""
+  enums = {}
+
+  with open(path) as f:
+    source = f.read()
+
+  for enum, body in re.findall(r'enum\s+(\w+)\s*:\s*uint8_t\s*\{(.*?)\};', source, re.S):
+    names = [re.sub(r'//.*', '', n).strip() for n in body.split(',')]
+    enums[enum] = [n for n in names if n]
+
+  return enums
+
+
+def crc8(data):
+  crc = 0
+
+  for b in data:
+    crc ^= b
+
+    for _ in range(8):
+      crc = ((crc << 1) ^ 0x9B) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+
+  return crc
+
+
+def encode_frame(payload, packet_id):
+  body = bytearray(payload)
+  overhead = 0xFF
+  ref = -1
+
+  for i in range(len(body) - 1, -1, -1):
+    if body[i] == START_BYTE:
+      body[i] = 0 if ref == -1 else ref - i
+      ref = i
+
+  if ref != -1:
+    overhead = ref
+
+  return bytes([START_BYTE, packet_id, overhead, len(body)]) + bytes(body) + bytes([crc8(body), STOP_BYTE])
+
+
+class FrameParser:
+  """Byte-at-a-time SerialTransfer decoder, yielding (packet_id, payload)."""
+
+  def __init__(self):
+    self.buffer = bytearray()
+
+  def feed(self, data):
+    self.buffer += data
+    frames = []
+
+    while True:
+      start = self.buffer.find(bytes([START_BYTE]))
+
+      if start < 0:
+        self.buffer.clear()
+        break
+
+      del self.buffer[:start]
+
+      if len(self.buffer) < 4:
+        break
+
+      length = self.buffer[3]
+
+      if len(self.buffer) < 4 + length + 2:
+        break
+
+      body = bytearray(self.buffer[4:4 + length])
+
+      if length == 0 or self.buffer[4 + length] != crc8(body) or self.buffer[5 + length] != STOP_BYTE:
+        del self.buffer[:1]
+        continue
+
+      index = self.buffer[2]
+
+      while index < length:
+        delta = body[index]
+        body[index] = START_BYTE
+
+        if delta == 0:
+          break
+
+        index += delta
+
+      frames.append((self.buffer[1], bytes(body)))
+      del self.buffer[:6 + length]
+
+    return frames
+
+
+class Peer:
+  def __init__(self, args, enums):
+    self.role = args.role
+    self.mode = args.mode
+    self.batch = args.batch
+    self.reliable = args.reliable and args.role == 'wand'
+    self.lose_reliable = self.reliable and args.lose_reliable
+    self.acks = []
+    self.links = args.links and args.role == 'attenuator'
+    self.link_reports = {}
+    self.sent = 0
+    self.parser = FrameParser()
+    self.frames = 0
+    self.commands = 0
+    self.mirror = None
+    self.full_syncs = 0
+    self.deltas = 0
+    self.resyncs = 0
+    self.master, slave = os.openpty()
+    self.slave_name = os.ttyname(slave)
+    os.set_blocking(self.master, False)
+
+    port = 2 if self.role == 'wand' else 1
+    self.program = subprocess.Popen([args.program, '--tty', '%d=%s' % (port, self.slave_name), '--realtime', '--ms', str(args.seconds * 1000)], stdout=subprocess.DEVNULL)
+    os.close(slave)
+
+    ids = enums['device_ids']
+
+    if self.role == 'wand':
+      self.outgoing, self.incoming = enums['wand_messages'], enums['pack_messages']
+      self.start, self.end = ids.index('W_COM_START'), ids.index('W_COM_END')
+      self.remote_start, self.remote_end = ids.index('P_COM_START'), ids.index('P_COM_END')
+      self.sync_now, self.sync_end_in, self.sync_ack = 'W_SYNC_NOW', 'P_SYNC_END', 'W_SYNCHRONIZED'
+      self.handshake_in, self.handshake = 'P_HANDSHAKE', 'W_HANDSHAKE'
+      self.baud_offer, self.baud_ack, self.baud_confirm = 'P_BAUD_RATE', 'W_BAUD_RATE', 'P_BAUD_RATE_CONFIRM'
+      self.batch_ack = 'W_COMMAND_BATCH'
+    else:
+      self.outgoing, self.incoming = enums['api_messages'], enums['api_messages']
+      self.start, self.end = ids.index('A_COM_START'), ids.index('A_COM_END')
+      self.remote_start, self.remote_end = ids.index('P_COM_START'), ids.index('P_COM_END')
+      self.sync_now, self.sync_end_in, self.sync_ack = 'A_SYNC_START', 'A_SYNC_END', 'A_SYNC_END'
+      self.handshake_in, self.handshake = 'A_HANDSHAKE', 'A_HANDSHAKE'
+      self.baud_offer, self.baud_ack, self.baud_confirm = 'A_BAUD_RATE', 'A_BAUD_RATE', 'A_BAUD_RATE_CONFIRM'
+      self.batch_ack = 'A_COMMAND_BATCH'
+
+  def line_rate(self):
+    return BAUD_RATES.get(termios.tcgetattr(self.master)[4], 0)
+
+  def send(self, name, value=0):
+    payload = bytes([self.start, self.outgoing.index(name), value & 0xFF, value >> 8, self.end])
+    os.write(self.master, encode_frame(payload, PACKET_COMMAND))
+    self.sent += 1
+
+  def receive(self):
+    """Returns the (command name, value) pairs received since the last call."""
+    try:
+      data = os.read(self.master, 4096)
+    except (BlockingIOError, OSError):
+      data = b''
+
+    commands = []
+
+    for packet_id, payload in self.parser.feed(data):
+      self.frames += 1
+
+      if packet_id == PACKET_COMMAND and len(payload) == 5 and payload[0] == self.remote_start and payload[4] == self.remote_end:
+        commands.append(self.command(payload[1], payload[2] | (payload[3] << 8)))
+      elif packet_id == PACKET_COMMAND_BATCH and len(payload) % 3 == 2 and payload[0] == self.remote_start and payload[1] == self.remote_end:
+        for i in range(2, len(payload), 3):
+          commands.append(self.command(payload[i], payload[i + 1] | (payload[i + 2] << 8)))
+      elif packet_id == PACKET_RELIABLE and len(payload) == 7 and payload[0] == self.remote_start and payload[6] == self.remote_end:
+        self.acks.append(payload[2])
+
+        if payload[3] != 0:
+          commands.append(self.command(payload[3], payload[4] | (payload[5] << 8)))
+          self.send_reliable(0, payload[1])
+      elif packet_id == PACKET_LINK_STATS and len(payload) == LINK_STATS.size:
+        fields = LINK_STATS.unpack(payload)
+        self.link_reports[fields[0]] = fields
+      elif packet_id == PACKET_DATA and len(payload) == 6 and payload[1] < len(self.incoming):
+        commands.append((self.incoming[payload[1]], 0))
+      elif packet_id == PACKET_SYNC and self.role == 'attenuator':
+        self.mirror = bytearray(payload)
+        self.full_syncs += 1
+      elif packet_id == PACKET_SYNC_DELTA and self.mode == 'mirror' and self.mirror is not None:
+        self.apply_delta(payload)
+
+    self.commands += len(commands)
+    return commands
+
+  def send_reliable(self, seq, ack, name=None, value=0):
+    command = self.outgoing.index(name) if name else 0
+    payload = bytes([self.start, seq, ack, command, value & 0xFF, value >> 8, self.end])
+    os.write(self.master, encode_frame(payload, PACKET_RELIABLE))
+    self.sent += 1
+
+  def check_reliable(self):
+    """Sends numbered handshakes out of order and returns whether the pack acknowledged them correctly."""
+    self.acks = []
+    self.send_reliable(1, 0xFF, self.handshake)
+    self.wait(0.3)
+    early = list(self.acks)
+
+    self.send_reliable(0, 0xFF, self.handshake)
+    self.wait(0.3)
+    in_order = list(self.acks[len(early):])
+
+    self.send_reliable(0, 0xFF, self.handshake)
+    self.wait(0.3)
+    repeat = list(self.acks[len(early) + len(in_order):])
+
+    print('Acks for the early command %s, once in order %s, for the repeat %s' % (early, in_order, repeat))
+    return early == [0xFF] and in_order == [1] and repeat == [1]
+
+  def command(self, command, value):
+    return (self.incoming[command] if command < len(self.incoming) else str(command), value)
+
+  def apply_delta(self, payload):
+    version, crc = payload[0], payload[1]
+    changed = int.from_bytes(payload[2:6], 'little')
+    values = iter(payload[6:])
+
+    for i in range(len(self.mirror)):
+      if changed & (1 << i):
+        self.mirror[i] = next(values)
+
+    if crc8(self.mirror) == crc:
+      self.deltas += 1
+      self.send('A_SYNC_DELTA_ACK', version)
+    else:
+      self.resyncs += 1
+      self.send('A_SYNC_DELTA_RESYNC')
+
+  def run(self, seconds):
+    if self.mode == 'mirror':
+      return self.run_mirror(seconds)
+
+    synced = False
+    switching = False
+    switched = False
+    silent = False
+    fell_back = False
+    reliable = None
+    synced_sent = 0
+    links_sent = None
+    next_links = 0.0
+    offers = 0
+    alive = 0
+    probes = 0
+    fast_rate = 0
+    next_sync = 0.0
+    next_handshake = 0.0
+    deadline = time.monotonic() + seconds
+
+    while time.monotonic() < deadline and self.program.poll() is None:
+      now = time.monotonic()
+
+      for name, value in self.receive():
+        if name == self.sync_end_in and not synced:
+          synced_sent = self.sent
+          self.send(self.sync_ack)
+          synced = True
+
+          if self.batch:
+            self.send(self.batch_ack)
+
+          if self.reliable:
+            self.send('W_RELIABLE')
+
+          next_links = now + 2.0
+          next_handshake = now + 3.25
+          print('Synchronized at %d baud' % self.line_rate())
+        elif name == self.baud_offer:
+          offers += 1
+          print('Offered %d baud' % (value * 100))
+
+          if self.mode != 'legacy':
+            self.send(self.baud_ack, value)
+            fast_rate = value * 100
+            switching = True
+            silent = (self.mode == 'deaf')
+        elif silent:
+          # Anything the pack sends after the switch goes unanswered.
+          pass
+        elif name == self.handshake_in and synced:
+          self.send(self.handshake)
+          probes += 1
+          alive += switched
+        elif name == self.baud_confirm:
+          alive += switched
+        elif name == 'P_RELIABLE' and self.reliable and not self.lose_reliable and reliable is None:
+          # The pack now expects a heartbeat every second.
+          reliable = self.check_reliable()
+          next_handshake = now + 1.0
+
+      if switching and self.line_rate() == fast_rate:
+        print('Pack switched to %d baud' % fast_rate)
+        switching = False
+        switched = True
+
+      if not synced and now >= next_sync:
+        self.send(self.sync_now)
+        next_sync = now + 0.75
+
+      if self.role == 'wand' and synced and not silent and now >= next_handshake:
+        # The wand sends a regular heartbeat; the Attenuator only answers the pack's.
+        self.send(self.handshake)
+        next_handshake = now + (1.0 if reliable is not None else 3.25)
+
+      if self.links and synced and links_sent is None and now >= next_links:
+        # Every frame sent so far should have reached the pack by the time it answers.
+        links_sent = self.sent
+        self.send('A_REQUEST_LINK_STATS')
+        print('Requested link counters after sending %d frames, %d since synchronizing' % (links_sent, links_sent - synced_sent))
+
+      if silent and switched and self.line_rate() == 9600:
+        # The pack gave up on the faster rate; resume at the default rate and sync again.
+        print('Pack fell back to 9600 baud')
+        fell_back = True
+        switched = False
+        silent = False
+        synced = False
+
+      time.sleep(0.002)
+
+    final_rate = self.line_rate()
+    self.program.terminate()
+    self.program.wait()
+
+    print('Frames %d, commands %d' % (self.frames, self.commands))
+    print('Offers %d, packets answered at the faster rate %d, final line rate %d baud' % (offers, alive, final_rate))
+    print('Handshakes from the pack %d' % probes)
+
+    if self.reliable and not self.lose_reliable and not reliable:
+      return False
+
+    if self.lose_reliable and probes > 0:
+      # The pack should only expect the faster heartbeat once the wand has numbered a command.
+      return False
+
+    if self.links:
+      for link, fields in sorted(self.link_reports.items()):
+        print('%s: sent %d, received %d, retransmits %d, CRC errors %d, marker errors %d, handshake %dms, max gap %dms' % (
+          (LINK_NAMES[link] if link < len(LINK_NAMES) else link, fields[1], sum(fields[2:14])) + fields[14:]))
+
+      serial1 = self.link_reports.get(2)
+
+      if len(self.link_reports) != 3 or serial1 is None or sum(serial1[2:14]) < links_sent + 1 - synced_sent:
+        return False
+
+    if self.mode == 'fast':
+      return synced and switched and offers == 1 and alive >= 2 and final_rate == fast_rate
+    elif self.mode == 'legacy':
+      return synced and offers == 1 and final_rate == 9600
+    else:
+      return synced and fell_back and offers == 1 and final_rate == 9600
+
+  def wait(self, seconds, on_command=None):
+    """Services the link for a while, returning the commands received."""
+    commands = []
+    deadline = time.monotonic() + seconds
+
+    while time.monotonic() < deadline and self.program.poll() is None:
+      for name, value in self.receive():
+        commands.append(name)
+
+        if name == 'A_HANDSHAKE':
+          self.send('A_HANDSHAKE')
+
+      time.sleep(0.002)
+
+    return commands
+
+  def volume_burst(self, command, count):
+    """Sends a burst of volume changes, returning (deltas received, mirrored commands received)."""
+    deltas = self.deltas
+
+    for _ in range(count):
+      self.send(command)
+      self.wait(0.01)
+
+    commands = self.wait(1.0)
+    return self.deltas - deltas, len([c for c in commands if c in MIRRORED_COMMANDS])
+
+  def run_mirror(self, seconds):
+    synced = False
+    deadline = time.monotonic() + seconds
+
+    # Synchronise at the default rate, announcing that we mirror the pack state.
+    while not synced and time.monotonic() < deadline and self.program.poll() is None:
+      self.send('A_SYNC_START')
+
+      for name, value in self.receive():
+        if name == 'A_SYNC_END':
+          self.send('A_SYNC_END')
+          self.send('A_SYNC_DELTA_ACK')
+          synced = True
+
+          if self.batch:
+            self.send(self.batch_ack)
+
+      time.sleep(0.75 if not synced else 0)
+
+    self.wait(1.0)
+
+    if not synced or self.mirror is None:
+      self.program.terminate()
+      self.program.wait()
+      return False
+
+    start_volume = self.mirror[SYNC_MASTER_VOLUME]
+    down_deltas, down_reported = self.volume_burst('A_VOLUME_DECREASE', 10)
+    low_volume = self.mirror[SYNC_MASTER_VOLUME]
+    print('Volume %d%% -> %d%% in %d changes, %d mirrored commands' % (start_volume, low_volume, down_deltas, down_reported))
+
+    # Corrupt a field the next change leaves alone; that change must then fail its checksum and bring a full resync.
+    self.mirror[SYNC_SYSTEM_MODE] ^= 0xFF
+    full_syncs = self.full_syncs
+    up_deltas, up_reported = self.volume_burst('A_VOLUME_INCREASE', 1)
+    print('Resyncs %d, full syncs received %d' % (self.resyncs, self.full_syncs - full_syncs))
+
+    # The repaired copy must accept further changes.
+    after_deltas, after_reported = self.volume_burst('A_VOLUME_INCREASE', 1)
+    print('Changes after resync %d, final volume %d%%' % (after_deltas, self.mirror[SYNC_MASTER_VOLUME]))
+
+    self.program.terminate()
+    self.program.wait()
+
+    return (low_volume < start_volume and 0 < down_deltas < 10 and down_reported == 0 and up_reported == 0
+      and self.resyncs == 1 and self.full_syncs - full_syncs == 1 and after_deltas >= 1 and self.mirror[SYNC_MASTER_VOLUME] > low_volume)
+
+def main():
+  parser = argparse.ArgumentParser(description='Serial link peer for the host-native Proton Pack build.')
+  parser.add_argument('--role', choices=['wand', 'attenuator'], default='wand')
+  parser.add_argument('--mode', choices=['fast', 'legacy', 'deaf', 'mirror'], default='fast')
+  parser.add_argument('--batch', action='store_true', help='Accept batched commands from the pack')
+  parser.add_argument('--reliable', action='store_true', help='Wand only: check reliable commands to the pack')
+  parser.add_argument('--lose-reliable', action='store_true', help='Wand only: never hear the pack agree to reliable commands')
+  parser.add_argument('--links', action='store_true', help='Attenuator only: check the link counters reported by the pack')
+  parser.add_argument('--seconds', type=int, default=30, help='Wall time to run (default 30)')
+  parser.add_argument('program', help='Native program, eg. .pio/build/native/program')
+  args = parser.parse_args()
+
+  enums = load_enums(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'ProtonPack', 'Communication.h'))
+  passed = Peer(args, enums).run(args.seconds)
+
+  print('PASS' if passed else 'FAIL')
+  return 0 if passed else 1
+
+
+if __name__ == '__main__':
+  sys.exit(main())
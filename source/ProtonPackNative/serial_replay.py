@@ -0,0 +1,200 @@
+#!/usr/bin/env python3
+#
+#   GPStar Proton Pack - Ghostbusters Proton Pack & Neutrona Wand.
+#   Copyright (C) 2024 Michael Rajotte <michael.rajotte@gpstartechnologies.com>
+#
+#   This program is free software; you can redistribute it and/or modify
+#   it under the terms of the GNU General Public License as published by
+#   the Free Software Foundation; either version 3 of the License, or
+#   (at your option) any later version.
+#
+#   This program is distributed in the hope that it will be useful,
+#   but WITHOUT ANY WARRANTY; without even the implied warranty of
+#   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+#   GNU General Public License for more details.
+#
+#   You should have received a copy of the GNU General Public License
+#   along with this program; if not, see <https://www.gnu.org/licenses/>.
+#
+
+"""
+Serial capture replay for the host-native Proton Pack build.
+
+Feeds the frames the pack received in a serial capture back into the native program at their
+recorded times, then checks that the pack answered as it did when the capture was made. A
+capture is the output of a pack built with GPSTAR_SERIAL_RECORDER, or of the native program
+run with --record; lines not starting with "rec," are ignored.
+
+The replay starts the pack from power on, so the capture must also begin at power on. The
+commands and data the pack sent on each port are compared in order. The replay may send more
+than the capture, such as repeats which depend on timing, but every command in the capture must
+follow in the same order. Commands which depend on timing rather
+than on what the pack received are left out (see IGNORED), as are those given with --ignore.
+
+With --expect NAME the replay must also send the command NAME, such as a state change the
+capture was taken to show.
+
+Usage: serial_replay.py [--ignore NAME] [--expect NAME] [--pin N=V] CAPTURE PROGRAM
+"""
+
+import argparse
+import collections
+import os
+import struct
+import subprocess
+import sys
+import tempfile
+
+from serial_peer import load_enums
+
+PACKET_NAMES = [
+  'PACKET_UNKNOWN', 'PACKET_COMMAND', 'PACKET_DATA', 'PACKET_PACK', 'PACKET_WAND', 'PACKET_SMOKE',
+  'PACKET_SYNC', 'PACKET_PROFILE', 'PACKET_SYNC_DELTA', 'PACKET_COMMAND_BATCH', 'PACKET_RELIABLE',
+  'PACKET_LINK_STATS',
+]
+
+# Sent on a timer, or carrying times and counters which differ on every run.
+IGNORED = {
+  'P_HANDSHAKE', 'A_HANDSHAKE', 'P_BAUD_RATE_CONFIRM', 'A_SEND_LINK_STATS', 'P_REQUEST_LINK_STATS',
+  'PACKET_SYNC_DELTA', 'PACKET_PROFILE', 'PACKET_LINK_STATS',
+}
+
+# Start marker, command ID, optional data and end marker of a command frame.
+COMMAND = struct.Struct('<BBHB')
+BATCHED_COMMAND = struct.Struct('<BH')
+RELIABLE = struct.Struct('<BBBBHB')
+
+
+class Capture:
+  """The commands and data the pack sent in a capture, per port, as (ms, description)."""
+
+  def __init__(self, path, enums):
+    self.names = {
+      'wand': enums['pack_messages'],
+      'serial1': enums['api_messages'],
+    }
+    self.received = 0
+    self.recent = collections.defaultdict(lambda: collections.deque(maxlen=8))
+    self.sent = collections.defaultdict(list)
+    self.last_ms = 0
+
+    with open(path) as f:
+      for line in f:
+        fields = line.strip().split(',')
+
+        if len(fields) != 6 or fields[0] != 'rec':
+          continue
+
+        ms, port, direction = int(fields[1]), fields[2], fields[3]
+        self.last_ms = max(self.last_ms, ms)
+
+        if direction == 'in':
+          self.received += 1
+        else:
+          self.read_frame(ms, port, int(fields[4]), bytes.fromhex(fields[5]))
+
+  def name(self, port, value):
+    names = self.names.get(port, [])
+    return names[value] if value < len(names) else str(value)
+
+  def read_frame(self, ms, port, packet_id, payload):
+    sent = self.sent[port]
+    packet = PACKET_NAMES[packet_id] if packet_id < len(PACKET_NAMES) else str(packet_id)
+
+    if packet == 'PACKET_COMMAND' and len(payload) == COMMAND.size:
+      _, command, data, _ = COMMAND.unpack(payload)
+      sent.append((ms, self.name(port, command), data))
+    elif packet == 'PACKET_COMMAND_BATCH':
+      for i in range(2, len(payload) - BATCHED_COMMAND.size + 1, BATCHED_COMMAND.size):
+        command, data = BATCHED_COMMAND.unpack_from(payload, i)
+        sent.append((ms, self.name(port, command), data))
+    elif packet == 'PACKET_RELIABLE' and len(payload) == RELIABLE.size:
+      _, seq, _, command, data, _ = RELIABLE.unpack(payload)
+      recent = self.recent[port]
+
+      # Leave out acknowledgements and commands sent again.
+      if command != 0 and seq not in recent:
+        recent.append(seq)
+        sent.append((ms, self.name(port, command), data))
+    elif packet == 'PACKET_DATA' and len(payload) > 2:
+      sent.append((ms, self.name(port, payload[1]), payload[2:-1].hex().upper()))
+    else:
+      sent.append((ms, packet, payload.hex().upper()))
+
+  def commands(self, port, ignored):
+    return [(ms, name, data) for ms, name, data in self.sent[port] if name not in ignored]
+
+
+def compare(expected, replayed):
+  """Returns the first expected command which the replay did not send in order, or None."""
+  i = 0
+
+  for command in expected:
+    while i < len(replayed) and replayed[i][1:] != command[1:]:
+      i += 1
+
+    if i == len(replayed):
+      return command
+
+    i += 1
+
+  return None
+
+
+def main():
+  parser = argparse.ArgumentParser(description='Serial capture replay for the host-native Proton Pack build.')
+  parser.add_argument('--ignore', action='append', default=[], help='Also leave out this command or packet type')
+  parser.add_argument('--expect', action='append', default=[], help='The replay must send this command')
+  parser.add_argument('--pin', action='append', default=[], help='Passed to the program, eg. 27=0')
+  parser.add_argument('capture', help='Serial capture to replay')
+  parser.add_argument('program', help='Native program, eg. .pio/build/native/program')
+  args = parser.parse_args()
+
+  enums = load_enums(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'ProtonPack', 'Communication.h'))
+  ignored = IGNORED | set(args.ignore)
+  capture = Capture(args.capture, enums)
+
+  with tempfile.NamedTemporaryFile(suffix='.txt') as record:
+    command = [args.program, '--replay', args.capture, '--record', record.name, '--ms', str(capture.last_ms + 2000)]
+
+    for pin in args.pin:
+      command += ['--pin', pin]
+
+    output = subprocess.run(command, capture_output=True, text=True).stdout
+    replay = Capture(record.name, enums)
+
+  for line in output.splitlines():
+    if line.startswith('Serial replay:'):
+      print(line)
+
+  if capture.received == 0:
+    print('No frames received by the pack in %s' % args.capture)
+    return 1
+
+  passed = replay.received == capture.received
+
+  if not passed:
+    print('Replay received %d of %d frames' % (replay.received, capture.received))
+
+  for port in sorted(set(capture.sent) | set(replay.sent)):
+    expected = capture.commands(port, ignored)
+    replayed = replay.commands(port, ignored)
+    missing = compare(expected, replayed)
+
+    print('%-8s %d sent in the capture, %d in the replay' % (port, len(expected), len(replayed)))
+
+    if missing is not None:
+      passed = False
+      print('  First not sent in order: %s %s at %d ms' % (missing[1], missing[2], missing[0]))
+
+  for name in args.expect:
+    if not any(name == command[1] for port in replay.sent for command in replay.sent[port]):
+      passed = False
+      print('Replay did not send %s' % name)
+
+  print('PASS' if passed else 'FAIL')
+  return 0 if passed else 1
+
+
+if __name__ == '__main__':
+  sys.exit(main())
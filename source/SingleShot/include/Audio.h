@@ -56,11 +56,25 @@ bool b_repeat_track = false;
  * Music Control/Checking
  */
 const uint16_t i_music_check_delay = 2000;
-const uint16_t i_music_next_track_delay = 500;
 millisDelay ms_check_music;
-millisDelay ms_music_next_track;
 millisDelay ms_music_status_check;
 
+/*
+ * Music Playlist
+ *
+ * The tracks to play after the current one are chosen ahead of time and kept in musicQueue, soonest first. The
+ * playlist starts again from the first track after the last, unless b_repeat_track has the board loop the current
+ * track. The Single-Shot Blaster has no control for shuffling, so unlike the pack it always plays in order.
+ *
+ * A WAV Trigger reports each track as it starts and stops, so the next track is started as soon as audio.update()
+ * reads the report that the current one has ended. Until that report has been seen for the current track, and always
+ * for GPStar Audio, the board is asked every i_music_check_delay whether the track is still playing instead.
+ */
+const uint8_t MUSIC_QUEUE_SIZE = 4;
+uint16_t musicQueue[MUSIC_QUEUE_SIZE];
+uint8_t i_music_queue_count = 0;
+bool b_music_track_reported = false; // The board has reported the current track as playing.
+
 /*
  * Volume percentage values (0 to 100)
  */
@@ -87,6 +101,36 @@ void stopEffect(uint16_t i_track_id);
 void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume = i_volume_effects, bool b_fade = false, uint16_t i_fade_time = 0);
 void updateMasterVolume(bool startup = false);
 
+#include "AudioQueue.h"
+
+void audioTrackPlay(uint16_t i_track, bool b_lock) {
+  queueAudioCommand(b_lock ? AUDIO_PLAY_LOCKED : AUDIO_PLAY, i_track);
+}
+
+void audioTrackStop(uint16_t i_track) {
+  queueAudioCommand(AUDIO_STOP, i_track);
+}
+
+void audioTrackGain(uint16_t i_track, int8_t i_gain) {
+  queueAudioCommand(AUDIO_GAIN, i_track, i_gain);
+}
+
+void audioTrackFade(uint16_t i_track, int8_t i_gain, uint16_t i_time) {
+  queueAudioCommand(AUDIO_FADE, i_track, i_gain, i_time);
+}
+
+void audioTrackLoop(uint16_t i_track, bool b_loop) {
+  queueAudioCommand(AUDIO_LOOP, i_track, b_loop);
+}
+
+void audioTrackPause(uint16_t i_track) {
+  queueAudioCommand(AUDIO_PAUSE, i_track);
+}
+
+void audioTrackResume(uint16_t i_track) {
+  queueAudioCommand(AUDIO_RESUME, i_track);
+}
+
 /*
  * Audio playback functions.
  */
@@ -105,20 +149,20 @@ void playEffect(uint16_t i_track_id, bool b_track_loop, int8_t i_track_volume, b
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(b_fade_in) {
-        audio.trackGain(i_track_id, i_volume_abs_min);
-        audio.trackPlayPoly(i_track_id, b_lock);
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackGain(i_track_id, i_volume_abs_min);
+        audioTrackPlay(i_track_id, b_lock);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
-        audio.trackPlayPoly(i_track_id, b_lock);
+        audioTrackGain(i_track_id, i_track_volume);
+        audioTrackPlay(i_track_id, b_lock);
       }
 
       if(b_track_loop) {
-        audio.trackLoop(i_track_id, 1);
+        audioTrackLoop(i_track_id, true);
       }
       else {
-        audio.trackLoop(i_track_id, 0);
+        audioTrackLoop(i_track_id, false);
       }
     break;
 
@@ -133,7 +177,7 @@ void stopEffect(uint16_t i_track_id) {
   switch(AUDIO_DEVICE) {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
-      audio.trackStop(i_track_id);
+      audioTrackStop(i_track_id);
     break;
 
     case A_NONE:
@@ -143,6 +187,72 @@ void stopEffect(uint16_t i_track_id) {
   }
 }
 
+/*
+ * Music playlist functions.
+ */
+
+// The track after the given one, going back to the first after the last.
+uint16_t musicTrackAfter(uint16_t i_track) {
+  if(i_track + 1 > i_music_track_start + i_music_count - 1) {
+    return i_music_track_start;
+  }
+
+  return i_track + 1;
+}
+
+// The track before the given one, going on to the last before the first.
+uint16_t musicTrackBefore(uint16_t i_track) {
+  if(i_track - 1 < i_music_track_start) {
+    return i_music_track_start + (i_music_count - 1);
+  }
+
+  return i_track - 1;
+}
+
+// Chooses the track to add to the end of the queue.
+uint16_t musicPickTrack() {
+  uint16_t i_last = i_music_queue_count > 0 ? musicQueue[i_music_queue_count - 1] : i_current_music_track;
+
+  return musicTrackAfter(i_last);
+}
+
+void musicFillQueue() {
+  while(i_music_count > 0 && i_music_queue_count < MUSIC_QUEUE_SIZE) {
+    musicQueue[i_music_queue_count] = musicPickTrack();
+    i_music_queue_count++;
+  }
+}
+
+// Chooses the upcoming tracks again, after the current track or the play order has changed.
+void musicResetQueue() {
+  i_music_queue_count = 0;
+  musicFillQueue();
+}
+
+// Makes the first queued track the current one.
+void musicAdvance() {
+  musicFillQueue();
+
+  if(i_music_queue_count == 0) {
+    return;
+  }
+
+  i_current_music_track = musicQueue[0];
+  i_music_queue_count--;
+
+  for(uint8_t i = 0; i < i_music_queue_count; i++) {
+    musicQueue[i] = musicQueue[i + 1];
+  }
+
+  musicFillQueue();
+}
+
+// Makes the track numbered before the current one the current one.
+void musicGoBack() {
+  i_current_music_track = musicTrackBefore(i_current_music_track);
+  musicResetQueue();
+}
+
 // Play a music track using certain defaults.
 void playMusic() {
   if(i_music_count > 0 && i_current_music_track >= i_music_track_start) {
@@ -153,17 +263,18 @@ void playMusic() {
       case A_GPSTAR_AUDIO:
         // Loop the music track.
         if(b_repeat_track) {
-          audio.trackLoop(i_current_music_track, 1);
+          audioTrackLoop(i_current_music_track, 1);
         }
         else {
-          audio.trackLoop(i_current_music_track, 0);
+          audioTrackLoop(i_current_music_track, 0);
         }
 
-        audio.trackGain(i_current_music_track, i_volume_music);
-        audio.trackPlayPoly(i_current_music_track, true);
+        audioTrackGain(i_current_music_track, i_volume_music);
+        audioTrackPlay(i_current_music_track, true);
         audio.update();
 
         audio.resetTrackCounter();
+        b_music_track_reported = false;
       break;
 
       case A_NONE:
@@ -182,7 +293,7 @@ void stopMusic() {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(i_music_count > 0 && i_current_music_track >= i_music_track_start) {
-        audio.trackStop(i_current_music_track);
+        audioTrackStop(i_current_music_track);
       }
 
       audio.update();
@@ -207,7 +318,7 @@ void pauseMusic() {
     switch(AUDIO_DEVICE) {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
-        audio.trackPause(i_current_music_track);
+        audioTrackPause(i_current_music_track);
         audio.update();
       break;
 
@@ -231,8 +342,9 @@ void resumeMusic() {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
         audio.resetTrackCounter();
-        audio.trackResume(i_current_music_track);
+        audioTrackResume(i_current_music_track);
         audio.update();
+        b_music_track_reported = false;
       break;
 
       case A_NONE:
@@ -246,58 +358,36 @@ void resumeMusic() {
 }
 
 void musicNextTrack() {
-  uint16_t i_temp_track = i_current_music_track; // Used for music navigation.
-
-  // Determine the next track.
-  if(i_current_music_track + 1 > i_music_track_start + i_music_count - 1) {
-    // Start at the first track if already on the last.
-    i_temp_track = i_music_track_start;
-  }
-  else {
-    i_temp_track++;
-  }
-
   // Switch to the next track.
   if(b_playing_music) {
     // Stops music using the current track number as the identifier.
     stopMusic();
 
-    i_current_music_track = i_temp_track; // Change only AFTER stopping music playback.
+    musicAdvance(); // Change only AFTER stopping music playback.
 
     // Begin playing the new track.
     playMusic();
   }
   else {
     // Set the new track.
-    i_current_music_track = i_temp_track;
+    musicAdvance();
   }
 }
 
 void musicPrevTrack() {
-  uint16_t i_temp_track = i_current_music_track; // Used for music navigation.
-
-  // Determine the previous track.
-  if(i_current_music_track - 1 < i_music_track_start) {
-    // Start at the last track if already on the first.
-    i_temp_track = i_music_track_start + (i_music_count - 1);
-  }
-  else {
-    i_temp_track--;
-  }
-
   // Switch to the previous track.
   if(b_playing_music) {
     // Stops music using the current track number as the identifier.
     stopMusic();
 
-    i_current_music_track = i_temp_track; // Change only AFTER stopping music playback.
+    musicGoBack(); // Change only AFTER stopping music playback.
 
     // Begin playing the new track.
     playMusic();
   }
   else {
     // Set the new track.
-    i_current_music_track = i_temp_track;
+    musicGoBack();
   }
 }
 
@@ -315,10 +405,10 @@ void adjustGainEffect(uint16_t i_track_id, int8_t i_track_volume, bool b_fade, u
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       if(b_fade) {
-        audio.trackFade(i_track_id, i_track_volume, i_fade_time, 0);
+        audioTrackFade(i_track_id, i_track_volume, i_fade_time);
       }
       else {
-        audio.trackGain(i_track_id, i_track_volume);
+        audioTrackGain(i_track_id, i_track_volume);
       }
     break;
 
@@ -435,7 +525,7 @@ void updateEffectsVolume() {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
       // Since adjusting only happens while in the menu mode, only certain effects need to be adjusted on the fly.
-      audio.trackGain(S_IDLE_LOOP, i_volume_effects);
+      audioTrackGain(S_IDLE_LOOP, i_volume_effects);
     break;
 
     case A_NONE:
@@ -484,7 +574,7 @@ void updateMusicVolume() {
     switch(AUDIO_DEVICE) {
       case A_WAV_TRIGGER:
       case A_GPSTAR_AUDIO:
-        audio.trackGain(i_current_music_track, i_volume_music);
+        audioTrackGain(i_current_music_track, i_volume_music);
       break;
 
       case A_NONE:
@@ -534,6 +624,7 @@ void buildMusicCount(uint16_t i_num_tracks) {
   i_music_count = i_num_tracks - i_last_effects_track;
   if(i_music_count > 0 && i_music_count < 4097) {
     i_current_music_track = i_music_track_start; // Set the first track of music as file 500_
+    musicResetQueue();
   }
   else {
     i_music_count = 0; // If the music count is corrupt, make it 0
@@ -583,56 +674,61 @@ bool musicTrackStatus() {
   }
 }
 
-void checkMusic() {
-  if(ms_check_music.justFinished() && !ms_music_next_track.isRunning()) {
-    switch(AUDIO_DEVICE) {
-      case A_WAV_TRIGGER:
-      case A_GPSTAR_AUDIO:
-        ms_check_music.start(i_music_check_delay);
-
-        musicTrackPlayingStatus();
-
-        // Loop through all the tracks if the music is not set to repeat a track.
-        if(b_playing_music && !b_repeat_track && !b_music_paused) {
-          if(!musicTrackStatus() && ms_music_status_check.justFinished() && !musicIsTrackCounterReset()) {
-            ms_check_music.stop();
-            ms_music_status_check.stop();
-
-            stopMusic();
-
-            // Switch to the next track.
-            if(i_current_music_track + 1 > i_music_track_start + i_music_count - 1) {
-              i_current_music_track = i_music_track_start;
-            }
-            else {
-              i_current_music_track++;
-            }
-
-            // Start timer to prepare to play music again.
-            ms_music_next_track.start(i_music_next_track_delay);
-          }
-          else {
-            if(ms_music_status_check.justFinished()) {
-              ms_music_status_check.start(i_music_check_delay * 4);
-            }
-          }
-        }
-      break;
+// Moves straight on to the next track in the playlist once the current one has ended.
+void musicTrackFinished() {
+  musicAdvance();
+  playMusic();
+}
 
-      case A_NONE:
-      default:
-        // None
-      break;
+// Asks the board whether the current track is still playing, for boards which have not reported it.
+void musicPollTrack() {
+  if(ms_check_music.justFinished()) {
+    ms_check_music.start(i_music_check_delay);
+
+    musicTrackPlayingStatus();
+
+    if(!musicTrackStatus() && ms_music_status_check.justFinished() && !musicIsTrackCounterReset()) {
+      ms_music_status_check.stop();
+
+      stopMusic();
+      musicTrackFinished();
+    }
+    else {
+      if(ms_music_status_check.justFinished()) {
+        ms_music_status_check.start(i_music_check_delay * 4);
+      }
     }
   }
+}
 
-  // Start playing music again.
-  if(ms_music_next_track.justFinished()) {
-    ms_music_next_track.stop();
-    ms_check_music.start(i_music_check_delay);
+void checkMusic() {
+  // Nothing can end while the music is stopped or paused, or while the board loops the current track.
+  if(!b_playing_music || b_music_paused || b_repeat_track) {
+    return;
+  }
 
-    // Play the appropriate track on the device.
-    playMusic();
+  switch(AUDIO_DEVICE) {
+    case A_WAV_TRIGGER:
+      if(audio.isTrackPlaying(i_current_music_track)) {
+        b_music_track_reported = true;
+      }
+      else if(b_music_track_reported) {
+        // The board has reported that the track ended.
+        musicTrackFinished();
+      }
+      else {
+        musicPollTrack();
+      }
+    break;
+
+    case A_GPSTAR_AUDIO:
+      musicPollTrack();
+    break;
+
+    case A_NONE:
+    default:
+      // None
+    break;
   }
 }
 
@@ -645,14 +741,14 @@ void toggleMusicLoop() {
         b_repeat_track = true;
 
         if(i_music_count > 0) {
-          audio.trackLoop(i_current_music_track, 1);
+          audioTrackLoop(i_current_music_track, 1);
         }
       }
       else {
         b_repeat_track = false;
 
         if(i_music_count > 0) {
-          audio.trackLoop(i_current_music_track, 0);
+          audioTrackLoop(i_current_music_track, 0);
         }
       }
     break;
@@ -752,6 +848,7 @@ void updateAudio() {
   switch(AUDIO_DEVICE) {
     case A_WAV_TRIGGER:
     case A_GPSTAR_AUDIO:
+      flushAudioQueue();
       audio.update();
     break;
 
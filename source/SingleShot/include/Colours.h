@@ -266,3 +266,27 @@ CRGB getHueAsGRB(uint8_t i_colour, uint8_t i_brightness = 255) {
   // Forward to getHueAsRGB() with the flag set for GRB colour swap.
   return getHueAsRGB(i_colour, i_brightness, true);
 }
+
+/*
+ * LED Frame Commit
+ *
+ * Sending the cyclotron and barrel LEDs holds interrupts off for about 30us per LED, so a frame is only sent
+ * when it differs from the one last sent.
+ */
+CRGB system_leds_sent[CYCLOTRON_LED_COUNT + BARREL_LED_COUNT]; // Colours as last sent.
+uint8_t i_led_brightness_sent = 0;
+bool b_led_frame_sent = false; // A frame has been sent since startup.
+
+// Replaces FastLED.show(), skipping frames which are unchanged.
+void commitLedFrame() {
+  uint8_t i_brightness = FastLED.getBrightness();
+
+  if(b_led_frame_sent && i_brightness == i_led_brightness_sent && memcmp(system_leds, system_leds_sent, sizeof(system_leds)) == 0) {
+    return;
+  }
+
+  FastLED.show();
+  memcpy(system_leds_sent, system_leds, sizeof(system_leds));
+  i_led_brightness_sent = i_brightness;
+  b_led_frame_sent = true;
+}
@@ -174,20 +174,20 @@ void systemPOST() {
   // Sequentially turn on all LEDs in the barrel.
   for(uint8_t i = 0; i < i_num_barrel_leds; i++) {
     system_leds[i] = getHueAsRGB(C_BLUE);
-    FastLED.show();
+    commitLedFrame();
     delay(i_delay);
   }
 
   // Sequentially turn on all LEDs in the cyclotron.
   for(uint8_t i = 0; i < i_num_cyclotron_leds; i++) {
     system_leds[i_cyclotron_led_start + i] = getHueAsRGB(C_RED);
-    FastLED.show();
+    commitLedFrame();
     delay(i_delay);
   }
 
   // Turn on the front barrel.
   system_leds[i_barrel_led] = getHueAsRGB(C_WHITE);
-  FastLED.show();
+  commitLedFrame();
 
   delay(i_delay * 8);
 
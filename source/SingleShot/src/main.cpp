@@ -161,7 +161,7 @@ void animate() {
 
   // Update all addressable LEDs to reflect any changes.
   if(ms_fast_led.justFinished()) {
-    FastLED.show();
+    commitLedFrame();
     ms_fast_led.start(i_fast_led_delay);
   }
 }